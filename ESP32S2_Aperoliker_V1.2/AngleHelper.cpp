@@ -9,27 +9,87 @@
 #include "AngleHelper.h"
 
 //===============================================================
-// Increments the value by the angle distance given
+// Returns how many degrees a value can move towards a border
+// before the distance falls below the given minimum distance.
+// A distance of zero is handled as a full circle.
+//===============================================================
+static int16_t GetMoveLimitDegrees(int16_t distance_Degrees, int16_t minDistance_Degrees)
+{
+  if (distance_Degrees == 0)
+  {
+    distance_Degrees = 360;
+  }
+  if (distance_Degrees < minDistance_Degrees)
+  {
+    return 0;
+  }
+  return distance_Degrees - minDistance_Degrees;
+}
+
+//===============================================================
+// Increments the value by the angle distance given. The value
+// stops at MINANGLE_DEGREES in front of the next border
+// (clockwise) or the previous border (counter clockwise).
 //===============================================================
 void IncrementAngle(int16_t* value, int16_t nextBorder, int16_t previousBorder, int16_t angleDistance_Degrees)
 {
-  bool clockwise = angleDistance_Degrees > 0;
+  if (angleDistance_Degrees > 0)
+  {
+    // Clockwise: distance to the next border must stay >= MINANGLE_DEGREES
+    int16_t moveLimit_Degrees = GetMoveLimitDegrees(GetDistanceDegrees(*value, nextBorder), MINANGLE_DEGREES);
+    *value = Move360(*value, angleDistance_Degrees < moveLimit_Degrees ? angleDistance_Degrees : moveLimit_Degrees);
+  }
+  else if (angleDistance_Degrees < 0)
+  {
+    // Counter clockwise: standing on the previous border counts as 360° distance,
+    // so the limit is calculated one degree shifted
+    int16_t moveLimit_Degrees = GetMoveLimitDegrees(Move360(GetDistanceDegrees(previousBorder, *value), -1), MINANGLE_DEGREES - 1);
+    *value = Move360(*value, angleDistance_Degrees > -moveLimit_Degrees ? angleDistance_Degrees : -moveLimit_Degrees);
+  }
+}
+
+//===============================================================
+// Increments one angle of a circle divided into N sectors. The
+// neighbouring angles are used as borders.
+//===============================================================
+void IncrementSectorAngle(int16_t* angles_Degrees, uint8_t angleCount, uint8_t angleIndex, int16_t angleDistance_Degrees)
+{
+  uint8_t nextIndex = (angleIndex + 1) % angleCount;
+  uint8_t previousIndex = (angleIndex + angleCount - 1) % angleCount;
   
-  for (uint16_t index = 0; index < abs(angleDistance_Degrees); index++)
+  IncrementAngle(&angles_Degrees[angleIndex], angles_Degrees[nextIndex], angles_Degrees[previousIndex], angleDistance_Degrees);
+}
+
+//===============================================================
+// Returns true, if the sector angles are valid borders for
+// IncrementSectorAngle: All angles within 0-359°, each angle at
+// least MINANGLE_DEGREES clockwise behind the previous one and
+// the sectors add up to one full circle (clockwise order)
+//===============================================================
+bool IsValidSectorAngles(const int16_t* angles_Degrees, uint8_t angleCount)
+{
+  int16_t sum_Degrees = 0;
+  for (uint8_t index = 0; index < angleCount; index++)
   {
-    int16_t newValue = Move360(*value, clockwise ? 1 : -1);
-    int16_t distanceToNextBorder_Degrees = GetDistanceDegrees(newValue, clockwise ? nextBorder : previousBorder);
-    distanceToNextBorder_Degrees = clockwise ? distanceToNextBorder_Degrees : 360 - distanceToNextBorder_Degrees;
-    
-    if (distanceToNextBorder_Degrees >= MINANGLE_DEGREES)
+    if (angles_Degrees[index] < 0 || angles_Degrees[index] >= 360)
     {
-      *value = newValue;
+      return false;
     }
-    else
+
+    // One single angle has the full circle as sector
+    if (angleCount == 1)
     {
-      break;
+      return true;
     }
+
+    int16_t distance_Degrees = GetDistanceDegrees(angles_Degrees[index], angles_Degrees[(index + 1) % angleCount]);
+    if (distance_Degrees < MINANGLE_DEGREES)
+    {
+      return false;
+    }
+    sum_Degrees += distance_Degrees;
   }
+  return sum_Degrees == 360;
 }
 
 //===============================================================
@@ -55,15 +115,11 @@ int16_t Move360(int16_t value, int16_t distance)
 //===============================================================
 int16_t GetDistanceDegrees(int16_t startAngle, int16_t stopAngle)
 {
-  // Set inital variables
-  int16_t distance = 0;
-  int16_t runAngle = startAngle;
-  
   // Calculate distance between two angles clock wise with regard to an overflow over 0/360°
-  while(runAngle != stopAngle)
+  int16_t distance = (stopAngle - startAngle) % 360;
+  if (distance < 0)
   {
-    runAngle = Move360(runAngle, 1);
-    distance++;
+    distance += 360;
   }
  
   return distance;
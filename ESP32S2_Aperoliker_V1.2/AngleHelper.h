@@ -27,9 +27,15 @@
 // Declarations
 //===============================================================
 
-// Increments the value by the angle distance given
+// Increments the value by the angle distance given (clamped to the borders, constant time)
 void IncrementAngle(int16_t* value, int16_t nextBorder, int16_t previousBorder, int16_t angleDistance_Degrees);
 
+// Increments one angle of a circle divided into N sectors (borders are the neighbouring angles)
+void IncrementSectorAngle(int16_t* angles_Degrees, uint8_t angleCount, uint8_t angleIndex, int16_t angleDistance_Degrees);
+
+// Returns true, if the sector angles are in clockwise order with at least MINANGLE_DEGREES distance
+bool IsValidSectorAngles(const int16_t* angles_Degrees, uint8_t angleCount);
+
 // Moves a value in 360 degrees space around the specified positive or negative distance
 int16_t Move360(int16_t value, int16_t distance);
 
@@ -0,0 +1,94 @@
+/**
+ * Includes the command queue for liquid angles from wifi
+ *
+ * @author    Florian Staeblein
+ * @date      2024/01/28
+ * @copyright © 2024 Florian Staeblein
+ */
+
+#include "CommandQueue.h"
+
+#if defined(WIFI_MIXER)
+
+//===============================================================
+// Adds a target angle to the queue (thread safe)
+//===============================================================
+bool LiquidCommandQueue::Push(uint32_t clientID, uint8_t liquid, int16_t target_Degrees, uint32_t baseVersion, uint32_t sequence)
+{
+  bool isQueued = false;
+
+  portENTER_CRITICAL(&_mux);
+
+  // Replace the target of the same client and liquid
+  for (uint8_t index = 0; index < _commandCount; index++)
+  {
+    LiquidCommand& command = _commands[index];
+    if (command.ClientID == clientID &&
+      command.Liquid == liquid)
+    {
+      command.Target_Degrees = target_Degrees;
+      command.BaseVersion = max(command.BaseVersion, baseVersion);
+      command.Sequence = max(command.Sequence, sequence);
+      isQueued = true;
+      break;
+    }
+  }
+
+  // Append a new client/liquid pair
+  if (!isQueued && _commandCount < COMMAND_QUEUE_SIZE)
+  {
+    _commands[_commandCount].ClientID = clientID;
+    _commands[_commandCount].Liquid = liquid;
+    _commands[_commandCount].Target_Degrees = target_Degrees;
+    _commands[_commandCount].BaseVersion = baseVersion;
+    _commands[_commandCount].Sequence = sequence;
+    _commands[_commandCount].Received_ms = millis();
+    _commandCount++;
+    isQueued = true;
+  }
+
+  if (isQueued)
+  {
+    _acceptedCount++;
+  }
+  else
+  {
+    _rejectedCount++;
+  }
+
+  portEXIT_CRITICAL(&_mux);
+
+  return isQueued;
+}
+
+//===============================================================
+// Moves all pending commands to the buffer and clears the queue
+//===============================================================
+uint8_t LiquidCommandQueue::Drain(LiquidCommand commands[COMMAND_QUEUE_SIZE])
+{
+  portENTER_CRITICAL(&_mux);
+  uint8_t commandCount = _commandCount;
+  memcpy(commands, _commands, commandCount * sizeof(LiquidCommand));
+  _commandCount = 0;
+  portEXIT_CRITICAL(&_mux);
+
+  return commandCount;
+}
+
+//===============================================================
+// Returns the count of accepted targets
+//===============================================================
+uint32_t LiquidCommandQueue::GetAcceptedCount()
+{
+  return _acceptedCount;
+}
+
+//===============================================================
+// Returns the count of rejected targets
+//===============================================================
+uint32_t LiquidCommandQueue::GetRejectedCount()
+{
+  return _rejectedCount;
+}
+
+#endif
@@ -0,0 +1,69 @@
+/**
+ * Includes the command queue for liquid angles from wifi
+ *
+ * @author    Florian Staeblein
+ * @date      2024/01/28
+ * @copyright © 2024 Florian Staeblein
+ */
+
+#ifndef COMMANDQUEUE_H
+#define COMMANDQUEUE_H
+
+//===============================================================
+// Includes
+//===============================================================
+#include <Arduino.h>
+#include "Config.h"
+
+#if defined(WIFI_MIXER)
+
+//===============================================================
+// Defines
+//===============================================================
+#define COMMAND_QUEUE_SIZE          8     // Maximum pending client/liquid pairs per state machine tick
+
+
+//===============================================================
+// Latest target angle of one liquid from one client
+//===============================================================
+struct LiquidCommand
+{
+  uint32_t ClientID;            // Websocket client, which sent the target angle
+  uint8_t Liquid;               // Liquid of the target angle
+  int16_t Target_Degrees;       // Absolute target angle (latest wins)
+  uint32_t BaseVersion;         // Mixture version the client has seen when sending the target
+  uint32_t Sequence;            // Highest sequence number of the pending targets
+  uint32_t Received_ms;         // Timestamp of the oldest pending target (acknowledge latency)
+};
+
+
+//===============================================================
+// Bounded multi producer queue for liquid target angles. Targets
+// of the same client and liquid replace each other, so the queue
+// only runs full with more than COMMAND_QUEUE_SIZE different
+// client/liquid pairs between two state machine ticks.
+//===============================================================
+class LiquidCommandQueue
+{
+  public:
+    // Adds a target angle to the queue (thread safe), returns false if the queue is full
+    bool Push(uint32_t clientID, uint8_t liquid, int16_t target_Degrees, uint32_t baseVersion, uint32_t sequence);
+
+    // Moves all pending commands to the buffer and clears the queue (thread safe), returns the command count
+    uint8_t Drain(LiquidCommand commands[COMMAND_QUEUE_SIZE]);
+
+    // Returns the count of accepted and rejected targets
+    uint32_t GetAcceptedCount();
+    uint32_t GetRejectedCount();
+
+  private:
+    LiquidCommand _commands[COMMAND_QUEUE_SIZE];
+    uint8_t _commandCount = 0;
+    uint32_t _acceptedCount = 0;
+    uint32_t _rejectedCount = 0;
+    portMUX_TYPE _mux = portMUX_INITIALIZER_UNLOCKED;
+};
+
+
+#endif
+#endif
@@ -25,30 +25,35 @@
 // Define one of these or none for generic colors
 #define APEROLIKER
 //#define HUGOLIKER
+//#define WINEBAR
 
 // This means that the ESP will wait 2 seconds each time it is started
 // because the start of the serial debug output on ESP32S2 takes this time
+// and the alive message prints the diagnostics of all modules
 // Uncomment for debug build
 #define DEBUG_MIXER
 
+// Skips the serial debug delay, the intro time and the help page
+// so that the dashboard is ready for dispensing as early as possible
+// Uncomment for fast boot
+//#define FAST_BOOT
+
 // Using the mixer without wifi makes the firmware more stable
 // Uncomment for wifi usage
 //#define WIFI_MIXER
 
+// Decodes the rotary encoder with the pulse counter (PCNT) hardware
+// Comment out to use the pin change interrupt decoder instead
+#define ENCODER_PCNT
+
+// Pumps pin defines (referenced by the liquid table at the end of this file)
+#define PIN_PUMP_1                        1     // GPIO 1  -> pump 1 power
+#define PIN_PUMP_2                        2     // GPIO 2  -> pump 2 power
+#define PIN_PUMP_3                        4     // GPIO 4  -> pump 3 power
+
 //===============================================================
 // Enums
 //===============================================================
-enum MixtureLiquid : uint16_t
-{
-  eLiquid1 = 0,
-  eLiquid2 = 1,
-  eLiquid3 = 2,
-  eLiquidAll = 3,
-  eLiquidNone = 0xFFFF
-};
-const int MixtureLiquidDashboardMax = 3;
-const int MixtureLiquidCleaningMax = 4;
-
 enum MixerState : uint16_t
 {
   eMenu = 0,
@@ -57,6 +62,7 @@ enum MixerState : uint16_t
   eReset = 3,
   eSettings = 4,
   eScreenSaver = 5,
+  eBar = 6,
 };
 
 enum MixerEvent : uint16_t
@@ -66,6 +72,17 @@ enum MixerEvent : uint16_t
   eExit = 2
 };
 
+enum BarBottle : uint16_t
+{
+  eSparklingWater = 0,
+  eEmpty = 1,
+  eRedWine = 2,
+  eWhiteWine = 3,
+  eRoseWine = 4,
+};
+const int BarBottleMax = 5;
+const char* const BarBottleNames[BarBottleMax] = { "Sparkling Water", "Empty", "Red Wine", "White Wine", "Rose Wine" };
+
 
 //===============================================================
 // Variant specific settings:
@@ -77,6 +94,9 @@ enum MixerEvent : uint16_t
 #define LIQUID1_NAME                      "Aperol"        // Should not exceed 8 characters
 #define LIQUID2_NAME                      "Soda"          // Should not exceed 8 characters
 #define LIQUID3_NAME                      "Prosecco"      // Should not exceed 8 characters
+#define LIQUID1_CAPACITY_ML               700             // Bottle volume after a refill, for fill level tracking
+#define LIQUID2_CAPACITY_ML               1000            // Bottle volume after a refill, for fill level tracking
+#define LIQUID3_CAPACITY_ML               750             // Bottle volume after a refill, for fill level tracking
 
 // Color defines
 #define TFT_COLOR_STARTPAGE               ST77XX_ORANGE
@@ -118,6 +138,9 @@ const String startupImageLogo = "/LogoAperoliker.bmp";
 #define LIQUID1_NAME                      "Syrup"         // Should not exceed 8 characters
 #define LIQUID2_NAME                      "Soda"          // Should not exceed 8 characters
 #define LIQUID3_NAME                      "Prosecco"      // Should not exceed 8 characters
+#define LIQUID1_CAPACITY_ML               700             // Bottle volume after a refill, for fill level tracking
+#define LIQUID2_CAPACITY_ML               1000            // Bottle volume after a refill, for fill level tracking
+#define LIQUID3_CAPACITY_ML               750             // Bottle volume after a refill, for fill level tracking
 
 // Color defines
 #define TFT_COLOR_STARTPAGE               ST77XX_YELLOW
@@ -152,6 +175,50 @@ const String startupImageLogo = "/LogoHugoliker.bmp";
 #define TFT_BOTTLE_POS_X                  40
 #define TFT_BOTTLE_POS_Y                  5
 
+#elif defined(WINEBAR)
+
+// Draw setting
+#define MIXER_NAME                        "WINEBar"       // Should not exceed 15 characters and be a single word -> will be the dns name in lower case and without white spaces for example "http://winebar.local/"
+#define LIQUID1_NAME                      "Wine 1"        // Should not exceed 8 characters
+#define LIQUID2_NAME                      "Wine 2"        // Should not exceed 8 characters
+#define LIQUID3_NAME                      "Wine 3"        // Should not exceed 8 characters
+#define LIQUID1_CAPACITY_ML               750             // Bottle volume after a refill, for fill level tracking
+#define LIQUID2_CAPACITY_ML               750             // Bottle volume after a refill, for fill level tracking
+#define LIQUID3_CAPACITY_ML               750             // Bottle volume after a refill, for fill level tracking
+
+// Color defines
+#define TFT_COLOR_STARTPAGE               0xD000
+#define TFT_COLOR_STARTPAGE_FOREGROUND    0xDF9E
+#define TFT_COLOR_STARTPAGE_BACKGROUND    0xA6DC
+#define TFT_COLOR_TEXT_HEADER             0xD000
+#define TFT_COLOR_TEXT_BODY               ST77XX_WHITE
+#define TFT_COLOR_INFOBOX_BORDER          0xD000
+#define TFT_COLOR_INFOBOX_FOREGROUND      0xD000
+#define TFT_COLOR_INFOBOX_BACKGROUND      ST77XX_WHITE
+#define TFT_COLOR_MENU_SELECTOR           0xD000
+#define TFT_COLOR_LIQUID_1                0xD000
+#define TFT_COLOR_LIQUID_2                0x93AB
+#define TFT_COLOR_LIQUID_3                0x0390
+#define TFT_COLOR_FOREGROUND              ST77XX_WHITE
+#define TFT_COLOR_BACKGROUND              ST77XX_BLACK
+
+#define WIFI_COLOR_LIQUID_1               0xA70000
+#define WIFI_COLOR_LIQUID_2               0x90745E
+#define WIFI_COLOR_LIQUID_3               0x00E784
+
+// Startup image
+const String startupImageBottle = "/BottleWineBar.bmp";
+const String startupImageGlass = "/GlassWineBar.bmp";
+const String startupImageLogo = "/LogoWineBar.bmp";
+
+#define TFT_TRANSPARENCY_COLOR            0x07E0
+#define TFT_LOGO_POS_X                    0
+#define TFT_LOGO_POS_Y                    25
+#define TFT_GLASS_POS_X                   140
+#define TFT_GLASS_POS_Y                   85
+#define TFT_BOTTLE_POS_X                  40
+#define TFT_BOTTLE_POS_Y                  5
+
 #else
 
 // Draw setting
@@ -159,6 +226,9 @@ const String startupImageLogo = "/LogoHugoliker.bmp";
 #define LIQUID1_NAME                      "Liquid 1"        // Should not exceed 8 characters
 #define LIQUID2_NAME                      "Liquid 2"        // Should not exceed 8 characters
 #define LIQUID3_NAME                      "Liquid 3"        // Should not exceed 8 characters
+#define LIQUID1_CAPACITY_ML               1000            // Bottle volume after a refill, for fill level tracking
+#define LIQUID2_CAPACITY_ML               1000            // Bottle volume after a refill, for fill level tracking
+#define LIQUID3_CAPACITY_ML               1000            // Bottle volume after a refill, for fill level tracking
 
 // Color defines
 #define TFT_COLOR_STARTPAGE               ST77XX_RED
@@ -195,4 +265,90 @@ const String startupImageLogo = "/Logo.bmp";
 
 #endif
 
+// Bar stock images (only loaded by products with bar stock)
+const String imageBottleWhiteWine = "/BottleWhiteWine.bmp";
+const String imageBottleRoseWine = "/BottleRoseWine.bmp";
+const String imageBottleSparklingWater = "/BottleSparklingWater.bmp";
+
+
+//===============================================================
+// Product policies: Compile-time behaviour of the product, all
+// products are built from the same sources
+//===============================================================
+// Cocktail mixer (APEROLiker, HUGOliker, generic): The dashboard mixes
+// all liquids by a recipe, which is set with the doughnut chart
+struct CocktailMixerPolicy
+{
+  static constexpr bool HasBarStock = false;              // Dashboard dispenses single bottles of a bar stock
+  static constexpr MixerState ProductState = eReset;      // Product specific menu entry
+};
+
+// Wine bar (WINEBar): The dashboard dispenses one selected bottle of the
+// bar stock, mixed as spritzer if a sparkling water bottle is available
+struct WineBarPolicy
+{
+  static constexpr bool HasBarStock = true;               // Dashboard dispenses single bottles of a bar stock
+  static constexpr MixerState ProductState = eBar;        // Product specific menu entry
+};
+
+#if defined(WINEBAR)
+typedef WineBarPolicy ProductPolicy;
+#else
+typedef CocktailMixerPolicy ProductPolicy;
+#endif
+
+// Menu entries from top to bottom
+const MixerState MenuTable[] = { eDashboard, eCleaning, ProductPolicy::ProductState, eSettings };
+constexpr uint8_t MenuCount = sizeof(MenuTable) / sizeof(MenuTable[0]);
+
+// Returns the position of a state in the menu table (0 for states without menu entry)
+inline uint8_t GetMenuIndex(MixerState state)
+{
+  for (uint8_t index = 0; index < MenuCount; index++)
+  {
+    if (MenuTable[index] == state)
+    {
+      return index;
+    }
+  }
+  return 0;
+}
+
+
+//===============================================================
+// Liquid table: One entry per pump. Add or remove entries to build
+// a mixer with a different count of pumps (2-6)
+//===============================================================
+struct LiquidConfig
+{
+  const char* Name;               // Should not exceed 8 characters
+  uint8_t PinPump;                // GPIO of the pump power output
+  uint16_t TftColor;              // Display color (RGB565)
+  uint32_t WifiColor;             // Web interface color (RGB888)
+  int16_t DefaultAngle_Degrees;   // Start angle of the liquid in the default recipe
+  uint32_t BottleCapacity_ml;     // Bottle volume after a refill (0 = no fill level tracking)
+};
+
+// Default recipe: Aperol: 34%, Soda: 16%, Prosecco: 50% (Official Aperol recipe)
+const LiquidConfig LiquidTable[] =
+{
+  { LIQUID1_NAME, PIN_PUMP_1, TFT_COLOR_LIQUID_1, WIFI_COLOR_LIQUID_1, 0,   LIQUID1_CAPACITY_ML },  // 33,33%
+  { LIQUID2_NAME, PIN_PUMP_2, TFT_COLOR_LIQUID_2, WIFI_COLOR_LIQUID_2, 120, LIQUID2_CAPACITY_ML },  // 15,83%
+  { LIQUID3_NAME, PIN_PUMP_3, TFT_COLOR_LIQUID_3, WIFI_COLOR_LIQUID_3, 177, LIQUID3_CAPACITY_ML },  // 50,84%
+};
+
+// Count of liquids and pumps
+constexpr uint8_t LiquidCount = sizeof(LiquidTable) / sizeof(LiquidTable[0]);
+static_assert(LiquidCount >= 2 && LiquidCount <= 6, "Liquid table must contain 2-6 entries");
+
+// Liquid index (0 - LiquidCount-1) or one of the special values
+enum MixtureLiquid : uint16_t
+{
+  eLiquid1 = 0,
+  eLiquidAll = LiquidCount,
+  eLiquidNone = 0xFFFF
+};
+const int MixtureLiquidDashboardMax = LiquidCount;
+const int MixtureLiquidCleaningMax = LiquidCount + 1;
+
 #endif
@@ -8,6 +8,9 @@
 
 #include "DisplayDriver.h"
 
+// The bar stock page has space for 3 bottles only
+static_assert(!ProductPolicy::HasBarStock || LiquidCount <= 3, "Products with bar stock support up to 3 liquids");
+
 //===============================================================
 // Global variables
 //===============================================================
@@ -36,6 +39,12 @@ void DisplayDriver::Begin(Adafruit_ST7789* tft, bool spiffsAvailable)
   _tft->setFont(&FreeSans9pt7b);
   _tft->fillScreen(TFT_COLOR_BACKGROUND);
 
+  // Initialize text renderer with the same font
+  _textRenderer.Begin(_tft, &FreeSans9pt7b);
+
+  // Build doughnut chart geometry once
+  BuildDoughnutCache();
+
   int16_t x = TFT_WIDTH / 2;
   int16_t y = TFT_HEIGHT / 2;
 
@@ -43,6 +52,19 @@ void DisplayDriver::Begin(Adafruit_ST7789* tft, bool spiffsAvailable)
   _tft->setTextColor(TFT_COLOR_FOREGROUND);
   DrawCenteredString("Booting...", x, y, false, 0);
 
+  // Debug information on display
+  if (!spiffsAvailable)
+  {
+    DrawCenteredString("SPIFFS Failed", x, y + SHORTLINEOFFSET, false, 0);
+    delay(3000);
+  }
+}
+
+//===============================================================
+// Loads the images to RAM (no display access, may run in a boot task)
+//===============================================================
+void DisplayDriver::LoadImages(bool spiffsAvailable)
+{
   // Create image objects
   _imageBottle = new SPIFFSImage();
   _imageGlass = new SPIFFSImage();
@@ -55,12 +77,24 @@ void DisplayDriver::Begin(Adafruit_ST7789* tft, bool spiffsAvailable)
     _imagesAvailable = (reader.LoadBMP(startupImageBottle.c_str(), _imageBottle) == IMAGE_SUCCESS &&
       reader.LoadBMP(startupImageGlass.c_str(), _imageGlass) == IMAGE_SUCCESS &&
       reader.LoadBMP(startupImageLogo.c_str(), _imageLogo) == IMAGE_SUCCESS) ? IMAGE_SUCCESS : IMAGE_ERR_FILE_NOT_FOUND;
-  }
-  else
-  {
-    // Debug information on display
-    DrawCenteredString("SPIFFS Failed", x, y + SHORTLINEOFFSET, false, 0);
-    delay(3000);
+
+    // Create logo mask for the screen saver
+    if (_imagesAvailable == IMAGE_SUCCESS)
+    {
+      _imageLogo->PrepareMove(TFT_TRANSPARENCY_COLOR);
+    }
+
+    // Load bar stock images to RAM
+    if (ProductPolicy::HasBarStock && _imagesAvailable == IMAGE_SUCCESS)
+    {
+      _imageBottleWhiteWine = new SPIFFSImage();
+      _imageBottleRoseWine = new SPIFFSImage();
+      _imageBottleSparklingWater = new SPIFFSImage();
+      
+      _imagesAvailable = (reader.LoadBMP(imageBottleWhiteWine.c_str(), _imageBottleWhiteWine) == IMAGE_SUCCESS &&
+        reader.LoadBMP(imageBottleRoseWine.c_str(), _imageBottleRoseWine) == IMAGE_SUCCESS &&
+        reader.LoadBMP(imageBottleSparklingWater.c_str(), _imageBottleSparklingWater) == IMAGE_SUCCESS) ? IMAGE_SUCCESS : IMAGE_ERR_FILE_NOT_FOUND;
+    }
   }
 }
 
@@ -91,21 +125,45 @@ void DisplayDriver::SetCleaningLiquid(MixtureLiquid liquid)
 //===============================================================
 // Sets the angles values
 //===============================================================
-void DisplayDriver::SetAngles(int16_t liquid1Angle_Degrees, int16_t liquid2Angle_Degrees, int16_t liquid3Angle_Degrees)
+void DisplayDriver::SetAngles(const int16_t liquidAngles_Degrees[LiquidCount])
 {
-  _liquid1Angle_Degrees = liquid1Angle_Degrees;
-  _liquid2Angle_Degrees = liquid2Angle_Degrees;
-  _liquid3Angle_Degrees = liquid3Angle_Degrees;
+  for (uint8_t index = 0; index < LiquidCount; index++)
+  {
+    _liquidAngles_Degrees[index] = liquidAngles_Degrees[index];
+  }
+}
+
+//===============================================================
+// Sets the mixture shares (0-SHARE_FULLSCALE)
+//===============================================================
+void DisplayDriver::SetShares(const MixtureShare liquidShares[LiquidCount])
+{
+  for (uint8_t index = 0; index < LiquidCount; index++)
+  {
+    _liquidShares[index] = liquidShares[index];
+  }
 }
 
 //===============================================================
-// Sets the percentage values
+// Sets the bar stock
 //===============================================================
-void DisplayDriver::SetPercentages(double liquid1_Percentage, double liquid2_Percentage, double liquid3_Percentage)
+void DisplayDriver::SetBarStock(const BarBottle barBottles[LiquidCount])
 {
-  _liquid1_Percentage = liquid1_Percentage;
-  _liquid2_Percentage = liquid2_Percentage;
-  _liquid3_Percentage = liquid3_Percentage;
+  for (uint8_t index = 0; index < LiquidCount; index++)
+  {
+    _barBottles[index] = barBottles[index];
+  }
+}
+
+//===============================================================
+// Sets the spritzer percentages
+//===============================================================
+void DisplayDriver::SetSpritzerPercentages(const int16_t spritzerPercentages[LiquidCount])
+{
+  for (uint8_t index = 0; index < LiquidCount; index++)
+  {
+    _spritzerPercentages[index] = spritzerPercentages[index];
+  }
 }
 
 //===============================================================
@@ -125,9 +183,7 @@ void DisplayDriver::ShowIntroPage()
     _imageLogo->Draw(TFT_LOGO_POS_X,     TFT_LOGO_POS_Y,   _tft, TFT_TRANSPARENCY_COLOR);
 
     // Free memory
-    delete _imageBottle;
-    delete _imageGlass;
-    //delete _imageLogo; // Do NOT delete logo image for usage with screen saver!
+    ReleaseIntroImages();
   }
   else
   {
@@ -136,6 +192,22 @@ void DisplayDriver::ShowIntroPage()
   }
 }
 
+//===============================================================
+// Frees the images only used by the intro page
+//===============================================================
+void DisplayDriver::ReleaseIntroImages()
+{
+  // Bottle image is still used as red wine bottle of the bar stock
+  if (!ProductPolicy::HasBarStock)
+  {
+    delete _imageBottle;
+    _imageBottle = NULL;
+  }
+  delete _imageGlass;
+  _imageGlass = NULL;
+  //delete _imageLogo; // Do NOT delete logo image for usage with screen saver!
+}
+
 //===============================================================
 // Shows help page
 //===============================================================
@@ -159,20 +231,20 @@ void DisplayDriver::ShowHelpPage()
   _tft->print("Short Press:");
   _tft->setCursor(x, y += SHORTLINEOFFSET);
   _tft->print(" -> Change Setting");
-  _tft->setCursor(x, y += SHORTLINEOFFSET);
-  _tft->print("    ~ ");
-  _tft->print(LIQUID1_NAME);
-  _tft->setCursor(x, y += SHORTLINEOFFSET);
-  _tft->print("    ~ ");
-  _tft->print(LIQUID2_NAME);
-  _tft->setCursor(x, y += SHORTLINEOFFSET);
-  _tft->print("    ~ ");
-  _tft->print(LIQUID3_NAME);
+
+  // Draw liquid names (a second column is used for more liquids)
+  for (uint8_t index = 0; index < LiquidCount; index++)
+  {
+    _tft->setCursor(x + (index / LIQUIDS_PER_COLUMN) * LIQUIDS_COLUMN_WIDTH, y + (index % LIQUIDS_PER_COLUMN + 1) * SHORTLINEOFFSET);
+    _tft->print("    ~ ");
+    _tft->print(LiquidTable[index].Name);
+  }
+  y += min((int)LiquidCount, LIQUIDS_PER_COLUMN) * SHORTLINEOFFSET;
   
   _tft->setCursor(x, y += LONGLINEOFFSET);
   _tft->print("Rotate:");
   _tft->setCursor(x, y += SHORTLINEOFFSET);
-  _tft->print(" -> Change Value");
+  _tft->print(ProductPolicy::HasBarStock ? " -> Change Spritzer" : " -> Change Value");
 
   _tft->setCursor(x, y += LONGLINEOFFSET);
   _tft->print("Long Press:");
@@ -205,9 +277,20 @@ void DisplayDriver::ShowDashboardPage()
   
   // Draw header information
   DrawHeader();
+
+  // Draw fill level warning over the header text
+  _lastDraw_LevelWarning[0] = '\0';
+  DrawLevelWarning();
+
+  if (ProductPolicy::HasBarStock)
+  {
+    // Draw bar
+    DrawBar(true, true);
+    return;
+  }
   
   // Draw chart in first draw mode
-  DrawDoughnutChart3();
+  DrawDoughnutChart(true);
 
   // Draw legend
   DrawLegend();
@@ -235,8 +318,27 @@ void DisplayDriver::ShowCleaningPage()
   // Draw header information
   DrawHeader("Cleaning Mode");
 
+  // Print selection text
+  _tft->setTextColor(TFT_COLOR_FOREGROUND);
+  DrawCenteredString("Select pumps for cleaning:", TFT_WIDTH / 2, TFT_HEIGHT / 3, false, 0);
+
   // Draw checkboxes
-  DrawCheckBoxes();
+  DrawCheckBoxes(_cleaningLiquid);
+}
+
+//===============================================================
+// Shows bar page
+//===============================================================
+void DisplayDriver::ShowBarPage()
+{
+  // Clear screen
+  _tft->fillScreen(TFT_COLOR_BACKGROUND);
+  
+  // Draw header information
+  DrawHeader("Bar Stock");
+  
+  // Draw bar
+  DrawBar(false, true);
 }
 
 //===============================================================
@@ -253,10 +355,6 @@ void DisplayDriver::ShowSettingsPage()
   // Draw header information
   DrawHeader("Settings");
 
-  double valueLiquid1 = FlowMeter.GetValueLiquid1();
-  double valueLiquid2 = FlowMeter.GetValueLiquid2();
-  double valueLiquid3 = FlowMeter.GetValueLiquid3();
-
   // Fill in settings text
   _tft->setTextSize(1);
   _tft->setTextColor(TFT_COLOR_TEXT_BODY);
@@ -270,32 +368,24 @@ void DisplayDriver::ShowSettingsPage()
   _tft->setCursor(x, y += (SHORTLINEOFFSET + 2 * LONGLINEOFFSET));
   _tft->print("Volume of liquid filled:");
   
-  // Draw liquid 1 flow meter value
-  _tft->setTextColor(TFT_COLOR_LIQUID_1);
-  _tft->setCursor(x, y += SHORTLINEOFFSET);
-  _tft->print(LIQUID1_NAME);
-  _tft->print(":");
-  _tft->setCursor(x + 120, y);
-  _tft->print(FormatValue(valueLiquid1, 4, 2));
-  _tft->print(" L");
-  
-  // Draw liquid 2 flow meter value
-  _tft->setTextColor(TFT_COLOR_LIQUID_2);
-  _tft->setCursor(x, y += SHORTLINEOFFSET);
-  _tft->print(LIQUID2_NAME);
-  _tft->print(":");
-  _tft->setCursor(x + 120, y);
-  _tft->print(FormatValue(valueLiquid2, 4, 2));
-  _tft->print(" L");  
-  
-  // Draw liquid 3 flow meter value
-  _tft->setTextColor(TFT_COLOR_LIQUID_3);
-  _tft->setCursor(x, y += SHORTLINEOFFSET);
-  _tft->print(LIQUID3_NAME);
-  _tft->print(":");
-  _tft->setCursor(x + 120, y);
-  _tft->print(FormatValue(valueLiquid3, 4, 2));
-  _tft->print(" L");
+  // Draw flow meter values (with more liquids in two columns, values only in liquid color)
+  for (uint8_t index = 0; index < LiquidCount; index++)
+  {
+    int16_t x_liquid = x + (index / LIQUIDS_PER_COLUMN) * LIQUIDS_COLUMN_WIDTH;
+    int16_t y_liquid = y + (index % LIQUIDS_PER_COLUMN + 1) * SHORTLINEOFFSET;
+
+    _tft->setTextColor(LiquidTable[index].TftColor);
+    if (LiquidCount <= LIQUIDS_PER_COLUMN)
+    {
+      _tft->setCursor(x_liquid, y_liquid);
+      _tft->print(LiquidTable[index].Name);
+      _tft->print(":");
+      x_liquid += 120;
+    }
+    _tft->setCursor(x_liquid, y_liquid);
+    _tft->print(FormatFixedPoint(RescaleRounded<1000, 100>(FlowMeter.GetValue(index)), 4, 2));
+    _tft->print(" L");
+  }
   
   x = 40;
   y = TFT_HEIGHT - 20;
@@ -319,7 +409,24 @@ void DisplayDriver::ShowScreenSaverPage()
   // Clear screen
   _tft->fillScreen(TFT_COLOR_BACKGROUND);
 
+  // Restart all stars
+  for (uint8_t index = 0; index < SCREENSAVER_STARCOUNT; index++)
+  {
+    _stars[index].Size = 0;
+    _stars[index].MaxSize = 0;
+  }
+
+  // Draw logo once, the screen saver frames only write the changes
+  if (_imagesAvailable == IMAGE_SUCCESS)
+  {
+    _imageLogo->Draw(_lastLogo_x, _lastLogo_y, _tft, TFT_TRANSPARENCY_COLOR);
+  }
+
   // Draw inital screen saver
+  _lastFrameTimestamp_ms = millis() - SCREENSAVER_FRAMETIME_MS;
+  _statsTimestamp_ms = millis();
+  _frameCount = 0;
+  _renderTime_us = 0;
   DrawScreenSaver();
 }
 
@@ -375,19 +482,20 @@ void DisplayDriver::DrawWifiIcons(bool isfullUpdate)
   wifi_mode_t wifiMode = Wifihandler.GetWifiMode();
   uint16_t connectedClients = Wifihandler.GetConnectedClients();
 
-   // Check connected clients for changed value
-  if (_lastDraw_ConnectedClients == connectedClients && !isfullUpdate)
+   // Check wifi mode and connected clients for changed value
+  if (_lastDraw_ConnectedClients == connectedClients && _lastDraw_WifiIconsMode == wifiMode && !isfullUpdate)
   {
     return;
   }
   _lastDraw_ConnectedClients = connectedClients;
+  _lastDraw_WifiIconsMode = wifiMode;
 
   // Clear wifi icon
   _tft->drawXBitmap(x, y, icon_wifi, width, height, TFT_COLOR_BACKGROUND);
   _tft->drawXBitmap(x, y, icon_noWifi, width, height, TFT_COLOR_BACKGROUND);
 
   // Draw new wifi icon
-  _tft->drawXBitmap(x, y, wifiMode == WIFI_MODE_AP ? icon_wifi : icon_noWifi, width, height, TFT_COLOR_FOREGROUND);
+  _tft->drawXBitmap(x, y, wifiMode != WIFI_MODE_NULL ? icon_wifi : icon_noWifi, width, height, TFT_COLOR_FOREGROUND);
 
   x = 5;
   y += 2;
@@ -395,7 +503,7 @@ void DisplayDriver::DrawWifiIcons(bool isfullUpdate)
   // Clear connected clients
   _tft->fillRect(x, y, width, height, TFT_COLOR_BACKGROUND);
 
-  if (wifiMode == WIFI_MODE_AP)
+  if (wifiMode != WIFI_MODE_NULL)
   {
     // Draw new connected clients
     _tft->drawXBitmap(x, y, icon_device, width, height, TFT_COLOR_FOREGROUND);
@@ -406,6 +514,68 @@ void DisplayDriver::DrawWifiIcons(bool isfullUpdate)
 }
 #endif
 
+//===============================================================
+// Draws a fill level warning instead of the header text
+//===============================================================
+void DisplayDriver::DrawLevelWarning(bool isfullUpdate)
+{
+  char warning[sizeof(_lastDraw_LevelWarning)] = "";
+
+  uint8_t refusedLiquid = Pumps.GetRefusedLiquid();
+  if (refusedLiquid < LiquidCount)
+  {
+    snprintf(warning, sizeof(warning), "Refill %s!", LiquidTable[refusedLiquid].Name);
+  }
+  else
+  {
+    // Warn for the bottle, which is predicted to be empty first
+    uint8_t lowLiquid = LiquidCount;
+    uint32_t lowTimeToEmpty_min = LEVEL_TIME_UNKNOWN;
+    for (uint8_t index = 0; index < LiquidCount; index++)
+    {
+      LevelStatus status = FlowMeter.GetLevelStatus(index);
+      uint32_t timeToEmpty_min = (status == eLevelEmpty) ? 0 : FlowMeter.GetTimeToEmpty(index);
+      if ((status == eLevelLow || status == eLevelEmpty) &&
+        (lowLiquid == LiquidCount || timeToEmpty_min < lowTimeToEmpty_min))
+      {
+        lowLiquid = index;
+        lowTimeToEmpty_min = timeToEmpty_min;
+      }
+    }
+
+    if (lowLiquid < LiquidCount)
+    {
+      snprintf(warning, sizeof(warning), "%s low: %u ml", LiquidTable[lowLiquid].Name, (unsigned int)FlowMeter.GetRemaining(lowLiquid));
+    }
+  }
+
+  // Check for changed value
+  if (!isfullUpdate && strcmp(warning, _lastDraw_LevelWarning) == 0)
+  {
+    return;
+  }
+  bool wasWarning = _lastDraw_LevelWarning[0] != '\0';
+  strcpy(_lastDraw_LevelWarning, warning);
+
+  // Same baseline as the header text
+  String headerText = String("-- ") + MIXER_NAME + " --";
+  uint16_t w, h;
+  _textRenderer.GetTextSize(headerText.c_str(), &w, &h);
+  int16_t x = LEVELWARNING_MARGIN_HORI;
+  int16_t y = HEADEROFFSET_Y / 2 + h / 2;
+  int16_t width = TFT_WIDTH - 2 * LEVELWARNING_MARGIN_HORI;
+
+  if (warning[0] != '\0')
+  {
+    _textRenderer.DrawText(warning, x, y, width, TFT_COLOR_BACKGROUND, TFT_COLOR_LEVEL_WARNING, eAlignCenter);
+  }
+  else if (wasWarning)
+  {
+    // Restore header text
+    _textRenderer.DrawText(headerText.c_str(), x, y, width, TFT_COLOR_TEXT_HEADER, TFT_COLOR_BACKGROUND, eAlignCenter);
+  }
+}
+
 //===============================================================
 // Draws the info box
 //===============================================================
@@ -451,38 +621,33 @@ void DisplayDriver::DrawMenu(bool isfullUpdate)
     height = 32;
 
     // Draw icons
-    _tft->drawXBitmap(x, y,                    icon_dashboard, width, height, TFT_COLOR_FOREGROUND);
-    _tft->drawXBitmap(x, y += MENU_LINEOFFSET, icon_cleaning,  width, height, TFT_COLOR_FOREGROUND);
-    _tft->drawXBitmap(x, y += MENU_LINEOFFSET, icon_reset,     width, height, TFT_COLOR_FOREGROUND);
-    _tft->drawXBitmap(x, y += MENU_LINEOFFSET, icon_settings,  width, height, TFT_COLOR_FOREGROUND);
+    for (uint8_t index = 0; index < MenuCount; index++)
+    {
+      _tft->drawXBitmap(x, y + index * MENU_LINEOFFSET, GetMenuIcon(MenuTable[index]), width, height, TFT_COLOR_FOREGROUND);
+    }
 
     x = MENU_MARGIN_HORI + MENU_MARGIN_ICON + MENU_MARGIN_TEXT;
     y = HEADEROFFSET_Y + marginToHeader;
 
-    // Draw menu text
-    _tft->setTextSize(1);
-    _tft->setTextColor(TFT_COLOR_TEXT_BODY);
-    _tft->setCursor(x, y);
-    _tft->print("Dashboard");
-    _tft->setCursor(x, y += MENU_LINEOFFSET);
-    _tft->print("Cleaning Mode");
-    _tft->setCursor(x, y += MENU_LINEOFFSET);
-    _tft->print("Reset Mixture");
-    _tft->setCursor(x, y += MENU_LINEOFFSET);
-    _tft->print("Settings");
+    // Draw menu text (text field ends inside the menu selector)
+    width = TFT_WIDTH - MENU_MARGIN_HORI - x - 4;
+    for (uint8_t index = 0; index < MenuCount; index++)
+    {
+      _textRenderer.DrawText(GetMenuText(MenuTable[index]), x, y + index * MENU_LINEOFFSET, width, TFT_COLOR_TEXT_BODY, TFT_COLOR_BACKGROUND);
+    }
   }
 
   if (_lastDraw_MenuState != _menuState || isfullUpdate)
   {
     x = MENU_MARGIN_HORI - 2;
-    y = HEADEROFFSET_Y + marginToHeader + ((uint16_t)_lastDraw_MenuState - 1) * MENU_LINEOFFSET - 6 - MENU_SELECTOR_HEIGHT / 2;
+    y = HEADEROFFSET_Y + marginToHeader + GetMenuIndex(_lastDraw_MenuState) * MENU_LINEOFFSET - 6 - MENU_SELECTOR_HEIGHT / 2;
     width = TFT_WIDTH - 2 * MENU_MARGIN_HORI;
     height = MENU_SELECTOR_HEIGHT;
 
     // Reset old menu selection on display
     _tft->drawRoundRect(x, y, width, height, MENU_SELECTOR_CORNERRADIUS, TFT_COLOR_BACKGROUND);
 
-    y = HEADEROFFSET_Y + marginToHeader + ((uint16_t)_menuState - 1) * MENU_LINEOFFSET - 6 - MENU_SELECTOR_HEIGHT / 2;
+    y = HEADEROFFSET_Y + marginToHeader + GetMenuIndex(_menuState) * MENU_LINEOFFSET - 6 - MENU_SELECTOR_HEIGHT / 2;
 
     // Draw new menu selection on display
     _tft->drawRoundRect(x, y, width, height, MENU_SELECTOR_CORNERRADIUS, TFT_COLOR_MENU_SELECTOR);
@@ -493,51 +658,122 @@ void DisplayDriver::DrawMenu(bool isfullUpdate)
 }
 
 //===============================================================
-// Draw checkboxes
+// Returns the icon of a menu entry
 //===============================================================
-void DisplayDriver::DrawCheckBoxes()
+const unsigned char* DisplayDriver::GetMenuIcon(MixerState state)
 {
-  int16_t x = TFT_WIDTH / 2;
-  int16_t y = TFT_HEIGHT / 3;
-  
-  // Print selection text
-  _tft->setTextColor(TFT_COLOR_FOREGROUND);
-  DrawCenteredString("Select pumps for cleaning:", x, y, false, 0);
+  switch (state)
+  {
+    case eCleaning:
+      return icon_cleaning;
+    case eReset:
+      return icon_reset;
+    case eBar:
+      return icon_cocktails;
+    case eSettings:
+      return icon_settings;
+    case eDashboard:
+    default:
+      return icon_dashboard;
+  }
+}
+
+//===============================================================
+// Returns the text of a menu entry
+//===============================================================
+const char* DisplayDriver::GetMenuText(MixerState state)
+{
+  switch (state)
+  {
+    case eCleaning:
+      return "Cleaning Mode";
+    case eReset:
+      return "Reset Mixture";
+    case eBar:
+      return "Bar Stock";
+    case eSettings:
+      return "Settings";
+    case eDashboard:
+    default:
+      return "Dashboard";
+  }
+}
 
+//===============================================================
+// Draw checkboxes
+//===============================================================
+void DisplayDriver::DrawCheckBoxes(MixtureLiquid liquid)
+{
+  int16_t x = 0;
+  int16_t y = HEADEROFFSET_Y + TFT_HEIGHT / 3;
   int16_t boxWidth = 30;
   int16_t boxHeight = 30;
-  int16_t boxDistance = TFT_WIDTH * 2 / 7;
-
-  x = TFT_WIDTH / 7;
-  y = HEADEROFFSET_Y + TFT_HEIGHT / 3;
-  
-  // Draw checkboxes
-  _tft->drawRect(x,                y, boxWidth, boxHeight, TFT_COLOR_FOREGROUND);
-  _tft->drawRect(x += boxDistance, y, boxWidth, boxHeight, TFT_COLOR_FOREGROUND);
-  _tft->drawRect(x += boxDistance, y, boxWidth, boxHeight, TFT_COLOR_FOREGROUND);
-
-  // Reduce rectangle for infill
-  x = TFT_WIDTH / 7 + 4;
-  y += 4;
-  boxWidth -= 8;
-  boxHeight -= 8;
+  int16_t boxDistance = TFT_WIDTH * 2 / (2 * LiquidCount + 1);
   
-  // Draw activated checkboxes
-  _tft->fillRect(x,                y, boxWidth, boxHeight, _cleaningLiquid == eLiquidAll || _cleaningLiquid == eLiquid1 ? TFT_COLOR_STARTPAGE : TFT_COLOR_BACKGROUND);
-  _tft->fillRect(x += boxDistance, y, boxWidth, boxHeight, _cleaningLiquid == eLiquidAll || _cleaningLiquid == eLiquid2 ? TFT_COLOR_STARTPAGE : TFT_COLOR_BACKGROUND);
-  _tft->fillRect(x += boxDistance, y, boxWidth, boxHeight, _cleaningLiquid == eLiquidAll || _cleaningLiquid == eLiquid3 ? TFT_COLOR_STARTPAGE : TFT_COLOR_BACKGROUND);
+  for (uint8_t index = 0; index < LiquidCount; index++)
+  {
+    x = TFT_WIDTH / (2 * LiquidCount + 1) + index * boxDistance;
+
+    // Draw checkbox
+    _tft->drawRect(x, y, boxWidth, boxHeight, TFT_COLOR_FOREGROUND);
 
-  // Move under the boxes for liquid names
-  x = TFT_WIDTH / 7 + boxWidth / 2;
-  y += 2 * boxHeight;
+    // Draw activated checkbox (reduced rectangle for infill)
+    _tft->fillRect(x + 4, y + 4, boxWidth - 8, boxHeight - 8, liquid == eLiquidAll || liquid == index ? TFT_COLOR_STARTPAGE : TFT_COLOR_BACKGROUND);
 
-  // Draw liquid names
-  _tft->setTextColor(TFT_COLOR_LIQUID_1);
-  DrawCenteredString(LIQUID1_NAME, x,                y, false, 0);
-  _tft->setTextColor(TFT_COLOR_LIQUID_2);
-  DrawCenteredString(LIQUID2_NAME, x += boxDistance, y, false, 0);
-  _tft->setTextColor(TFT_COLOR_LIQUID_3);
-  DrawCenteredString(LIQUID3_NAME, x += boxDistance, y, false, 0);
+    // Draw liquid name under the box
+    _tft->setTextColor(LiquidTable[index].TftColor);
+    DrawCenteredString(LiquidTable[index].Name, x + (boxWidth - 8) / 2, y + 4 + 2 * (boxHeight - 8), false, 0);
+  }
+}
+
+//===============================================================
+// Draw bar
+//===============================================================
+void DisplayDriver::DrawBar(bool isDashboard, bool isfullUpdate)
+{
+  int16_t x0 = TFT_WIDTH / 2; // Mid screen
+  int16_t y = HEADEROFFSET_Y + 10;
+
+  bool isBarStockEmpty = true;
+  for (uint8_t index = 0; index < LiquidCount; index++)
+  {
+    isBarStockEmpty &= _barBottles[index] == eEmpty;
+  }
+
+  // Draw only check boxes if complete bar stock is empty
+  if (isDashboard && isBarStockEmpty)
+  {
+    // Print selection text
+    _tft->setTextColor(TFT_COLOR_FOREGROUND);
+    DrawCenteredString("Select WINE for dispensing:", x0, y + 25, false, 0, true, 0x528A); // Gray
+
+    // Draw checkboxes
+    DrawCheckBoxes(_dashboardLiquid);
+  }
+  else
+  {
+    // Draw each bottle, centered around the middle of the screen
+    for (uint8_t index = 0; index < LiquidCount; index++)
+    {
+      DrawBarPart(x0 + (2 * index - (LiquidCount - 1)) * BAR_SPACING / 2, y, index, isDashboard, isfullUpdate);
+    }
+
+    if (isDashboard &&
+      (isfullUpdate || _dashboardLiquid != _lastDraw_SelectedLiquid))
+    {
+      // Print selection text
+      _tft->setTextColor(TFT_COLOR_FOREGROUND);
+      DrawCenteredString("Select WINE for dispensing:", x0, y + 25, false, 0, true, 0x528A); // Gray
+    }
+
+    // Save last drawn values
+    _lastDraw_SelectedLiquid = _dashboardLiquid;
+    for (uint8_t index = 0; index < LiquidCount; index++)
+    {
+      _lastDraw_barBottles[index] = _barBottles[index];
+      _lastDraw_spritzerPercentages[index] = _spritzerPercentages[index];
+    }
+  }
 }
 
 //===============================================================
@@ -557,28 +793,24 @@ void DisplayDriver::DrawLegend()
   int16_t marginBetween = 21;
   int16_t boxWidth = 30;
   int16_t boxHeight = 10;
+  int16_t lineOffset = (HEIGHT_LEGEND - marginTop) / LiquidCount; // LOONGLINEOFFSET for 3 liquids
 
-  // Move to inner info
-  x = X_LEGEND + WIDTH_LEGEND / 2 - boxWidth / 2;
-  y = Y_LEGEND + marginTop;
-  width = boxWidth;
-  height = boxHeight;
-
-  // Draw liquid color boxes
-  _tft->fillRect(x, y,                    width, height, TFT_COLOR_LIQUID_1);
-  _tft->fillRect(x, y += LOONGLINEOFFSET, width, height, TFT_COLOR_LIQUID_2);
-  _tft->fillRect(x, y += LOONGLINEOFFSET, width, height, TFT_COLOR_LIQUID_3);
-
-  // Move to inner text
-  x = X_LEGEND + WIDTH_LEGEND / 2;
-  y = Y_LEGEND + marginTop + marginBetween;
-
-  // Draw liquid text
+  // Set text settings
   _tft->setTextSize(1);
   _tft->setTextColor(TFT_COLOR_TEXT_BODY);  
-  DrawCenteredString(LIQUID1_NAME, x, y,                    true, _dashboardLiquid == eLiquid1 ? TFT_COLOR_FOREGROUND : TFT_COLOR_BACKGROUND);
-  DrawCenteredString(LIQUID2_NAME, x, y += LOONGLINEOFFSET, true, _dashboardLiquid == eLiquid2 ? TFT_COLOR_FOREGROUND : TFT_COLOR_BACKGROUND);
-  DrawCenteredString(LIQUID3_NAME, x, y += LOONGLINEOFFSET, true, _dashboardLiquid == eLiquid3 ? TFT_COLOR_FOREGROUND : TFT_COLOR_BACKGROUND);
+
+  for (uint8_t index = 0; index < LiquidCount; index++)
+  {
+    // Draw liquid color box
+    x = X_LEGEND + WIDTH_LEGEND / 2 - boxWidth / 2;
+    y = Y_LEGEND + marginTop + index * lineOffset;
+    _tft->fillRect(x, y, boxWidth, boxHeight, LiquidTable[index].TftColor);
+
+    // Draw liquid text
+    x = X_LEGEND + WIDTH_LEGEND / 2;
+    y += marginBetween;
+    DrawCenteredString(LiquidTable[index].Name, x, y, true, _dashboardLiquid == index ? TFT_COLOR_FOREGROUND : TFT_COLOR_BACKGROUND);
+  }
 }
 
 //===============================================================
@@ -586,9 +818,8 @@ void DisplayDriver::DrawLegend()
 //===============================================================
 void DisplayDriver::DrawCurrentValues(bool isfullUpdate)
 {
-  String liquid1_PercentageString = FormatValue(_liquid1_Percentage, 2, 0) + String("%");
-  String liquid2_PercentageString = FormatValue(_liquid2_Percentage, 2, 0) + String("%");
-  String liquid3_PercentageString = FormatValue(_liquid3_Percentage, 2, 0) + String("%");
+  // Width of one value including separator (50 px for 3 liquids)
+  int16_t valueWidth = 150 / LiquidCount;
 
   // Set text size
   _tft->setTextSize(1);
@@ -605,179 +836,196 @@ void DisplayDriver::DrawCurrentValues(bool isfullUpdate)
   }
 
   x += 40;
-  if (_lastDraw_Liquid1String != liquid1_PercentageString || isfullUpdate)
+  for (uint8_t index = 0; index < LiquidCount; index++)
   {
-    // Reset old string on display
-    _tft->setTextColor(TFT_COLOR_BACKGROUND);
-    _tft->setCursor(x, y);
-    _tft->print(_lastDraw_Liquid1String);
-    
-    // Draw new string on display
-    _tft->setTextColor(TFT_COLOR_LIQUID_1);
-    _tft->setCursor(x, y);
-    _tft->print(liquid1_PercentageString);
-    
-    // Save last drawn string
-    _lastDraw_Liquid1String = liquid1_PercentageString;
+    String liquid_PercentageString = FormatFixedPoint(ShareToPercent(_liquidShares[index]), 2, 0) + String("%");
+
+    if (index > 0 && isfullUpdate)
+    {
+      _tft->setTextColor(TFT_COLOR_TEXT_BODY);
+      _tft->setCursor(x - 10, y);
+      _tft->print(",");
+    }
+
+    if (_lastDraw_LiquidStrings[index] != liquid_PercentageString || isfullUpdate)
+    {
+      // Draw new string in a field up to the next separator (overwrites the old string)
+      _textRenderer.DrawText(liquid_PercentageString.c_str(), x, y, valueWidth - 10, LiquidTable[index].TftColor, TFT_COLOR_BACKGROUND);
+      
+      // Save last drawn string
+      _lastDraw_LiquidStrings[index] = liquid_PercentageString;
+    }
+
+    x += valueWidth;
   }
 
-  x += 40;
+  x -= 5;
   if (isfullUpdate)
   {
     _tft->setTextColor(TFT_COLOR_TEXT_BODY);
     _tft->setCursor(x, y);
-    _tft->print(",");
+    _tft->print("]");
+  }
+}
+
+//===============================================================
+// Draws doughnut chart
+//===============================================================
+void DisplayDriver::DrawDoughnutChart(bool isfullUpdate)
+{
+  // Count moved borders since the last draw
+  uint8_t movedCount = 0;
+  for (uint8_t index = 0; index < LiquidCount; index++)
+  {
+    movedCount += _liquidAngles_Degrees[index] != _lastDraw_liquidAngles_Degrees[index] ? 1 : 0;
   }
 
-  x += 10;
-  if (_lastDraw_Liquid2String != liquid2_PercentageString || isfullUpdate)
+  // Mark dirty degrees (full chart, if more than one border moved at once)
+  memset(_doughnutDirty, isfullUpdate || movedCount > 1 ? 0xFF : 0x00, sizeof(_doughnutDirty));
+  for (uint8_t index = 0; index < LiquidCount; index++)
   {
-    // Reset old string on display
-    _tft->setTextColor(TFT_COLOR_BACKGROUND);
-    _tft->setCursor(x, y);
-    _tft->print(_lastDraw_Liquid2String);
-    
-    // Draw new string on display
-    _tft->setTextColor(TFT_COLOR_LIQUID_2);
-    _tft->setCursor(x, y);
-    _tft->print(liquid2_PercentageString);
+    int16_t newAngle = _liquidAngles_Degrees[index];
+    int16_t lastAngle = _lastDraw_liquidAngles_Degrees[index];
+
+    if (newAngle != lastAngle)
+    {
+      // The border moved on the side without the next border
+      int16_t startAngle = lastAngle;
+      int16_t distance_Degrees = GetDistanceDegrees(lastAngle, newAngle);
+      if (GetDistanceDegrees(lastAngle, _liquidAngles_Degrees[(index + 1) % LiquidCount]) < distance_Degrees)
+      {
+        startAngle = newAngle;
+        distance_Degrees = 360 - distance_Degrees;
+      }
 
-    // Save last drawn string
-    _lastDraw_Liquid2String = liquid2_PercentageString;
+      // Include the spacers at the old and new position
+      MarkDoughnutDirty(Move360(startAngle, -SPACERANGLE_DEGREES), distance_Degrees + 2 * SPACERANGLE_DEGREES);
+    }
+
+    // Spacer color changes with the selected liquid
+    if ((index == _dashboardLiquid) != (index == _lastDraw_DashboardLiquid))
+    {
+      MarkDoughnutDirty(Move360(newAngle, -SPACERANGLE_DEGREES), 2 * SPACERANGLE_DEGREES);
+    }
   }
-  
-  x += 40;
-  if (isfullUpdate)
+
+  // Calculate color of each degree (sector color or black spacer and selected white)
+  for (int16_t angle = 0; angle < 360; angle++)
   {
-    _tft->setTextColor(TFT_COLOR_TEXT_BODY);
-    _tft->setCursor(x, y);
-    _tft->print(",");
+    for (uint8_t index = 0; index < LiquidCount; index++)
+    {
+      int16_t sectorAngle = _liquidAngles_Degrees[index];
+      if (GetDistanceDegrees(sectorAngle, angle) < GetDistanceDegrees(sectorAngle, _liquidAngles_Degrees[(index + 1) % LiquidCount]))
+      {
+        _doughnutColors[angle] = LiquidTable[index].TftColor;
+      }
+    }
   }
-  
-  x += 10;
-  if (_lastDraw_Liquid3String != liquid3_PercentageString || isfullUpdate)
+  for (uint8_t index = 0; index < LiquidCount; index++)
   {
-    // Reset old string on display
-    _tft->setTextColor(TFT_COLOR_BACKGROUND);
-    _tft->setCursor(x, y);
-    _tft->print(_lastDraw_Liquid3String);
-    
-    // Draw new string on display
-    _tft->setTextColor(TFT_COLOR_LIQUID_3);
-    _tft->setCursor(x, y);
-    _tft->print(liquid3_PercentageString);
+    for (int16_t distance = -SPACERANGLE_DEGREES; distance < SPACERANGLE_DEGREES; distance++)
+    {
+      _doughnutColors[Move360(_liquidAngles_Degrees[index], distance)] = _dashboardLiquid == index ? TFT_COLOR_FOREGROUND : TFT_COLOR_BACKGROUND;
+    }
+  }
+
+  // Write dirty pixels as horizontal runs of the same color (degrees from the geometry
+  // cache or, if the cache could not be allocated, calculated for every pixel)
+  _tft->startWrite();
+  for (int16_t row = 0; row < DOUGHNUT_CACHE_SIZE; row++)
+  {
+    const uint16_t* angles = _doughnutAngles != NULL ? &_doughnutAngles[row * DOUGHNUT_CACHE_SIZE] : NULL;
+    int16_t runStart = -1;
+    uint16_t runColor = 0;
 
-    // Save last drawn string
-    _lastDraw_Liquid3String = liquid3_PercentageString;
+    for (int16_t column = 0; column <= DOUGHNUT_CACHE_SIZE; column++)
+    {
+      // Pixel is drawn, if it is in the annulus and its degree is dirty
+      uint16_t angle = column == DOUGHNUT_CACHE_SIZE ? DOUGHNUT_NO_ANGLE : (angles != NULL ? angles[column] : GetDoughnutAngle(column, row));
+      bool isDirty = angle != DOUGHNUT_NO_ANGLE &&
+        (_doughnutDirty[angle >> 3] & (1 << (angle & 7)));
+      uint16_t color = isDirty ? _doughnutColors[angle] : 0;
+
+      // Close current run at the end or on a color change
+      if (runStart >= 0 && (!isDirty || color != runColor))
+      {
+        _tft->writeFillRect(X0_DOUGHNUTCHART - R_OUTER_DOUGHNUTCHART + runStart, Y0_DOUGHNUTCHART - R_OUTER_DOUGHNUTCHART + row, column - runStart, 1, runColor);
+        runStart = -1;
+      }
+
+      // Open new run
+      if (isDirty && runStart < 0)
+      {
+        runStart = column;
+        runColor = color;
+      }
+    }
   }
+  _tft->endWrite();
 
-  x += 45;
-  if (isfullUpdate)
+  // Set last drawn angles and selection
+  for (uint8_t index = 0; index < LiquidCount; index++)
   {
-    _tft->setTextColor(TFT_COLOR_TEXT_BODY);
-    _tft->setCursor(x, y);
-    _tft->print("]");
+    _lastDraw_liquidAngles_Degrees[index] = _liquidAngles_Degrees[index];
   }
+  _lastDraw_DashboardLiquid = _dashboardLiquid;
 }
 
 //===============================================================
-// Draws full doughnut chart
+// Marks a range of degrees as dirty for the next doughnut draw
 //===============================================================
-void DisplayDriver::DrawDoughnutChart3()
+void DisplayDriver::MarkDoughnutDirty(int16_t startAngle, int16_t distance_Degrees)
 {
-  DrawDoughnutChart3(false, true);
-}
-
-//===============================================================
-// Draws doughnut chart
-//===============================================================
-void DisplayDriver::DrawDoughnutChart3(bool clockwise, bool isfullUpdate)
-{ 
-  if (isfullUpdate)
-  {
-    // Calculate count of draw_Angle's to draw
-    int16_t liquid1Distance_Degrees = GetDistanceDegrees(_liquid1Angle_Degrees, _liquid2Angle_Degrees);
-    int16_t liquid2Distance_Degrees = GetDistanceDegrees(_liquid2Angle_Degrees, _liquid3Angle_Degrees);
-    int16_t liquid3Distance_Degrees = GetDistanceDegrees(_liquid3Angle_Degrees, _liquid1Angle_Degrees);
-  
-    // Draw doughnut chart parts
-    FillArc(_liquid1Angle_Degrees, liquid1Distance_Degrees, TFT_COLOR_LIQUID_1);
-    FillArc(_liquid2Angle_Degrees, liquid2Distance_Degrees, TFT_COLOR_LIQUID_2);
-    FillArc(_liquid3Angle_Degrees, liquid3Distance_Degrees, TFT_COLOR_LIQUID_3);
-  }
-  else
+  for (int16_t distance = 0; distance < distance_Degrees && distance < 360; distance++)
   {
-    DrawPartial(_liquid1Angle_Degrees, _lastDraw_liquid1Angle_Degrees, TFT_COLOR_LIQUID_1, TFT_COLOR_LIQUID_3, clockwise);
-    DrawPartial(_liquid2Angle_Degrees, _lastDraw_liquid2Angle_Degrees, TFT_COLOR_LIQUID_2, TFT_COLOR_LIQUID_1, clockwise);
-    DrawPartial(_liquid3Angle_Degrees, _lastDraw_liquid3Angle_Degrees, TFT_COLOR_LIQUID_3, TFT_COLOR_LIQUID_2, clockwise);
+    int16_t angle = Move360(startAngle, distance);
+    _doughnutDirty[angle >> 3] |= 1 << (angle & 7);
   }
-
-  // Draw black spacer and selected white
-  FillArc(Move360(_liquid1Angle_Degrees, -SPACERANGLE_DEGREES), 2 * SPACERANGLE_DEGREES, _dashboardLiquid == eLiquid1 ? TFT_COLOR_FOREGROUND : TFT_COLOR_BACKGROUND);
-  FillArc(Move360(_liquid2Angle_Degrees, -SPACERANGLE_DEGREES), 2 * SPACERANGLE_DEGREES, _dashboardLiquid == eLiquid2 ? TFT_COLOR_FOREGROUND : TFT_COLOR_BACKGROUND);
-  FillArc(Move360(_liquid3Angle_Degrees, -SPACERANGLE_DEGREES), 2 * SPACERANGLE_DEGREES, _dashboardLiquid == eLiquid3 ? TFT_COLOR_FOREGROUND : TFT_COLOR_BACKGROUND);
-  
-  // Set last drawn angles
-  _lastDraw_liquid1Angle_Degrees = _liquid1Angle_Degrees;
-  _lastDraw_liquid2Angle_Degrees = _liquid2Angle_Degrees;
-  _lastDraw_liquid3Angle_Degrees = _liquid3Angle_Degrees;
 }
 
 //===============================================================
-// Only draws partial update of arcs
+// Builds the doughnut geometry cache (degree of every pixel in the
+// annulus, clockwise from the top like the liquid angles). Without
+// the cache the doughnut chart calculates the degrees while drawing
 //===============================================================
-void DisplayDriver::DrawPartial(int16_t newAngle, int16_t lastAngle,  uint16_t colorAfter, uint16_t colorBefore, bool clockwise)
+void DisplayDriver::BuildDoughnutCache()
 {
-  if (lastAngle != newAngle)
+  size_t size = DOUGHNUT_CACHE_SIZE * DOUGHNUT_CACHE_SIZE * sizeof(uint16_t);
+  _doughnutAngles = (uint16_t*)(psramFound() ? ps_malloc(size) : malloc(size));
+  if (_doughnutAngles == NULL)
   {
-    // Calculate start angle and color
-    // Draw from last angle to new angle
-    int16_t startAngle = Move360(lastAngle, clockwise ? -SPACERANGLE_DEGREES : SPACERANGLE_DEGREES);
-    uint16_t color = clockwise ? colorBefore : colorAfter;
+    Serial.println("[DISPLAY] Doughnut cache allocation failed, degrees are calculated while drawing");
+    return;
+  }
 
-    // Calculate draw distance
-    int16_t distance_Degrees = clockwise ? GetDistanceDegrees(lastAngle, newAngle) : -360 + GetDistanceDegrees(lastAngle, newAngle);
-    
-    // Draw doughnut part
-    FillArc(startAngle, distance_Degrees, color);
+  for (int16_t row = 0; row < DOUGHNUT_CACHE_SIZE; row++)
+  {
+    for (int16_t column = 0; column < DOUGHNUT_CACHE_SIZE; column++)
+    {
+      _doughnutAngles[row * DOUGHNUT_CACHE_SIZE + column] = GetDoughnutAngle(column, row);
+    }
   }
 }
 
 //===============================================================
-// Draw an arc with a defined thickness
+// Returns the degree of a pixel of the doughnut chart area
+// (DOUGHNUT_NO_ANGLE outside of the annulus)
 //===============================================================
-void DisplayDriver::FillArc(int16_t start_angle, int16_t distance_Degrees, uint16_t color)
+uint16_t DisplayDriver::GetDoughnutAngle(int16_t column, int16_t row)
 {
-  // x,y == coords of centre of arc
-  // start_angle = 0 - 359
-  // distance_Degrees = absolut distance to draw in degrees
-  // r_inner = inner radius
-  // r_outer = outer radius
-  // color = 16 bit color value
+  int16_t dx = column - R_OUTER_DOUGHNUTCHART;
+  int16_t dy = row - R_OUTER_DOUGHNUTCHART;
+  int32_t radiusSquared = (int32_t)dx * dx + (int32_t)dy * dy;
 
-  // Draw color blocks every 1°
-  int16_t drawAngle_Degrees = distance_Degrees > 0 ? 1 : - 1;
-  for (int16_t i = start_angle; i != start_angle + distance_Degrees; i += drawAngle_Degrees)
+  if (radiusSquared < R_INNER_DOUGHNUTCHART * R_INNER_DOUGHNUTCHART ||
+    radiusSquared > R_OUTER_DOUGHNUTCHART * R_OUTER_DOUGHNUTCHART)
   {
-    // Calculate pair of coordinates for segment start
-    float sx = cos((i - 90) * TFT_DEG2RAD);
-    float sy = sin((i - 90) * TFT_DEG2RAD);
-    int16_t x0 = sx * R_INNER_DOUGHNUTCHART + X0_DOUGHNUTCHART;
-    int16_t y0 = sy * R_INNER_DOUGHNUTCHART + Y0_DOUGHNUTCHART;
-    int16_t x1 = sx * R_OUTER_DOUGHNUTCHART + X0_DOUGHNUTCHART;
-    int16_t y1 = sy * R_OUTER_DOUGHNUTCHART + Y0_DOUGHNUTCHART;
-
-    // Calculate pair of coordinates for segment end
-    float sx2 = cos((i + drawAngle_Degrees - 90) * TFT_DEG2RAD);
-    float sy2 = sin((i + drawAngle_Degrees - 90) * TFT_DEG2RAD);
-    int16_t x2 = sx2 * R_INNER_DOUGHNUTCHART + X0_DOUGHNUTCHART;
-    int16_t y2 = sy2 * R_INNER_DOUGHNUTCHART + Y0_DOUGHNUTCHART;
-    int16_t x3 = sx2 * R_OUTER_DOUGHNUTCHART + X0_DOUGHNUTCHART;
-    int16_t y3 = sy2 * R_OUTER_DOUGHNUTCHART + Y0_DOUGHNUTCHART;
-
-    _tft->fillTriangle(x0, y0, x1, y1, x2, y2, color);
-    _tft->fillTriangle(x1, y1, x2, y2, x3, y3, color);
+    return DOUGHNUT_NO_ANGLE;
   }
+
+  // 0° is at the top, angles increase clockwise (display y axis points down)
+  int16_t degrees = (int16_t)floorf(atan2f(dx, -dy) / TFT_DEG2RAD);
+  return Move360(degrees, 0);
 }
 
 //===============================================================
@@ -799,17 +1047,11 @@ void DisplayDriver::DrawSettings(bool isfullUpdate)
 
   if (_lastDraw_cycleTimespan_ms != cycleTimespan_ms || isfullUpdate)
   {
-    // Clear old value
-    _tft->setCursor(x + 145, y);
-    _tft->setTextColor(TFT_COLOR_BACKGROUND);
-    _tft->print(_lastDraw_cycleTimespan_ms);
-    _tft->print(" ms");
-
-    // Set new value
-    _tft->setCursor(x + 145, y);
-    _tft->setTextColor(TFT_COLOR_TEXT_BODY);
-    _tft->print(cycleTimespan_ms);
-    _tft->print(" ms");
+    // Draw new value (overwrites the old value)
+    String cycleTimespanString = (cycleTimespan_ms == AUTO_CYCLE_TIMESPAN_MS) ?
+      "Auto (" + String(Pumps.GetActiveCycleTimespan()) + " ms)" :
+      String(cycleTimespan_ms) + " ms";
+    _textRenderer.DrawText(cycleTimespanString.c_str(), x + 145, y, TFT_WIDTH - x - 145, TFT_COLOR_TEXT_BODY, TFT_COLOR_BACKGROUND);
 
     _lastDraw_cycleTimespan_ms = cycleTimespan_ms;
   }
@@ -829,15 +1071,8 @@ void DisplayDriver::DrawSettings(bool isfullUpdate)
 
   if (_lastDraw_wifiMode != wifiMode || isfullUpdate)
   {
-    // Clear old value
-    _tft->setCursor(x + 98, y);
-    _tft->setTextColor(TFT_COLOR_BACKGROUND);
-    _tft->print(_lastDraw_wifiMode == WIFI_MODE_AP ? "AP" : "OFF");
-
-    // Set new value
-    _tft->setCursor(x + 98, y);
-    _tft->setTextColor(TFT_COLOR_TEXT_BODY);
-    _tft->print(wifiMode == WIFI_MODE_AP ? "AP" : "OFF");
+    // Draw new value (overwrites the old value)
+    _textRenderer.DrawText(Wifihandler.GetWifiModeString().c_str(), x + 98, y, TFT_WIDTH - x - 98, TFT_COLOR_TEXT_BODY, TFT_COLOR_BACKGROUND);
     
     _lastDraw_wifiMode = wifiMode;
   }
@@ -845,10 +1080,18 @@ void DisplayDriver::DrawSettings(bool isfullUpdate)
 }
 
 //===============================================================
-// Draws screen saver
+// Draws screen saver (one frame within the frame time budget)
 //===============================================================
 void DisplayDriver::DrawScreenSaver()
 {
+  // Frame pacing
+  if (millis() - _lastFrameTimestamp_ms < SCREENSAVER_FRAMETIME_MS)
+  {
+    return;
+  }
+  _lastFrameTimestamp_ms = millis();
+  uint32_t frameStart_us = micros();
+
   bool hasLogo = _imagesAvailable == IMAGE_SUCCESS;
   int16_t logoWidth = hasLogo ? _imageLogo->Width() : 0;
   int16_t logoHeight = hasLogo ? _imageLogo->Height() : 0;
@@ -857,10 +1100,10 @@ void DisplayDriver::DrawScreenSaver()
   int16_t logo_x = _lastLogo_x + _xDir;
   int16_t logo_y = _lastLogo_y + _yDir;
 
-  // Move logo if image is available
+  // Move logo if image is available (only the changed pixels are written)
   if (hasLogo)
   {
-    _imageLogo->Move(_lastLogo_x, _lastLogo_y, logo_x, logo_y, _tft, TFT_COLOR_BACKGROUND, TFT_TRANSPARENCY_COLOR);
+    _imageLogo->MoveDirty(_lastLogo_x, _lastLogo_y, logo_x, logo_y, _tft, TFT_COLOR_BACKGROUND, TFT_TRANSPARENCY_COLOR);
   }
 
   // Impact collision with the left or right edge
@@ -875,124 +1118,317 @@ void DisplayDriver::DrawScreenSaver()
     _yDir = -_yDir;
   }
 
-  // Draw stars
-  for (int index = 0; index < SCREENSAVER_STARCOUNT; index++)
+  _tft->startWrite();
+
+  // Redraw star pixels uncovered by the moving logo
+  if (hasLogo)
   {
-    // Init new star, if star animation finished
-    if (_stars[index].Size >= _stars[index].MaxSize)
+    for (uint8_t index = 0; index < SCREENSAVER_STARCOUNT; index++)
     {
-      // Clear old star only outside of the non-transparent part of the logo
-      if (!hasLogo ||
-        !(_stars[index].X > logo_x && _stars[index].X < logo_x + logoWidth &&
-        _stars[index].Y > logo_y && _stars[index].Y < logo_y + logoHeight &&
-        _imageLogo->GetPixel(_stars[index].X - logo_x, _stars[index].Y - logo_y) != TFT_TRANSPARENCY_COLOR))
+      Star &star = _stars[index];
+      int16_t radius = star.Size > 1 ? StarRaySegments[star.Size - 2] + 1 : 0;
+      if (star.X + radius >= logo_x - 1 && star.X - radius <= logo_x + logoWidth &&
+        star.Y + radius >= logo_y - 1 && star.Y - radius <= logo_y + logoHeight)
       {
-        DrawStar(_stars[index].X, _stars[index].Y, _stars[index].FullStars, TFT_COLOR_BACKGROUND, _stars[index].Size);
+        for (int16_t ring = 0; ring < star.Size; ring++)
+        {
+          DrawStarRing(star, ring, TFT_COLOR_FOREGROUND, logo_x, logo_y, true);
+        }
       }
+    }
+  }
 
-      _stars[index].X = random(0, TFT_WIDTH);
-      _stars[index].Y = random(0, TFT_HEIGHT);
-      _stars[index].MaxSize = random(1, 6);
-      _stars[index].FullStars = random(0, 12) < 6 ? true : false;
-      _stars[index].Size = 0;
+  _lastLogo_x = logo_x;
+  _lastLogo_y = logo_y;
+
+  // Animate stars (round robin, as long as the frame time budget allows)
+  for (uint8_t count = 0; count < SCREENSAVER_STARCOUNT; count++)
+  {
+    if (micros() - frameStart_us > SCREENSAVER_BUDGET_US)
+    {
+      break;
     }
 
-    // Draw new star only outside of the non-transparent part of the logo
-    if (!hasLogo || 
-      !(_stars[index].X > logo_x && _stars[index].X < logo_x + logoWidth &&
-      _stars[index].Y > logo_y && _stars[index].Y < logo_y + logoHeight &&
-      _imageLogo->GetPixel(_stars[index].X - logo_x, _stars[index].Y - logo_y) != TFT_TRANSPARENCY_COLOR))
+    Star &star = _stars[_nextStarIndex];
+    _nextStarIndex = (_nextStarIndex + 1) % SCREENSAVER_STARCOUNT;
+
+    // Init new star, if star animation finished
+    if (star.Size >= star.MaxSize)
     {
-      DrawStar(_stars[index].X, _stars[index].Y, _stars[index].FullStars, TFT_COLOR_FOREGROUND, _stars[index].Size);
+      // Clear old star
+      for (int16_t ring = 0; ring < star.Size; ring++)
+      {
+        DrawStarRing(star, ring, TFT_COLOR_BACKGROUND, logo_x, logo_y);
+      }
+
+      star.X = random(0, TFT_WIDTH);
+      star.Y = random(0, TFT_HEIGHT);
+      star.MaxSize = random(1, 6);
+      star.FullStars = random(0, 12) < 6 ? true : false;
+      star.Size = 0;
     }
 
+    // Draw only the next ring of the star
+    DrawStarRing(star, star.Size, TFT_COLOR_FOREGROUND, logo_x, logo_y);
+
     // Increment star size
-    _stars[index].Size++;
+    star.Size++;
   }
 
-  _lastLogo_x = logo_x;
-  _lastLogo_y = logo_y;
+  _tft->endWrite();
+
+  // Save frame statistics
+  _frameCount++;
+  _renderTime_us += micros() - frameStart_us;
+}
+
+//===============================================================
+// Enables or disables the display sleep mode
+//===============================================================
+void DisplayDriver::SetSleep(bool enable)
+{
+  _tft->enableSleep(enable);
 }
 
 //===============================================================
-// Draws a star
+// Returns the screen saver frame rate and cpu share as string
 //===============================================================
-void DisplayDriver::DrawStar(int16_t x0, int16_t y0, bool fullStars, uint16_t color, int16_t size)
+String DisplayDriver::GetScreenSaverString()
 {
-  _tft->writePixel(x0, y0, color);
+  uint32_t elapsed_ms = max((uint32_t)1, millis() - _statsTimestamp_ms);
+  String result = String("Screen saver: ") + FormatFixedPoint(_frameCount * 10000 / elapsed_ms, 5, 1) + " FPS, CPU " +
+    FormatFixedPoint(_renderTime_us / elapsed_ms, 5, 1) + "%";
 
-  if (size > 0)
+  // Start new statistics window
+  _statsTimestamp_ms = millis();
+  _frameCount = 0;
+  _renderTime_us = 0;
+
+  return result;
+}
+
+//===============================================================
+// Draws one ring of a star (ring 0 is the center pixel), hidden
+// by the non-transparent part of the logo at logo_x/logo_y.
+// With onlyUncovered, only pixels hidden by the last drawn logo
+// position and visible now are drawn.
+//===============================================================
+void DisplayDriver::DrawStarRing(const Star &star, int16_t ring, uint16_t color, int16_t logo_x, int16_t logo_y, bool onlyUncovered)
+{
+  bool hasLogo = _imagesAvailable == IMAGE_SUCCESS;
+
+  // Precomputed sprite: center pixel or two pixels per ray
+  uint8_t rayCount = ring == 0 ? 1 : (star.FullStars ? 8 : 4);
+  for (uint8_t ray = 0; ray < rayCount; ray++)
   {
-    DrawStarTail(x0, y0, 1, 2, fullStars, color);
+    for (uint8_t offset = 0; offset < (ring == 0 ? 1 : 2); offset++)
+    {
+      int16_t distance = ring == 0 ? 0 : StarRaySegments[ring - 1] + offset;
+      int16_t x = star.X + StarRayDirections[ray][0] * distance;
+      int16_t y = star.Y + StarRayDirections[ray][1] * distance;
+
+      // Occlusion test with the logo mask
+      if (!hasLogo ||
+        (!_imageLogo->IsOpaque(x - logo_x, y - logo_y) &&
+        (!onlyUncovered || _imageLogo->IsOpaque(x - _lastLogo_x, y - _lastLogo_y))))
+      {
+        _tft->writePixel(x, y, color);
+      }
+    }
   }
-  if (size > 1)
+}
+
+//===============================================================
+// Draws a part of the bar
+//===============================================================
+void DisplayDriver::DrawBarPart(int16_t x0, int16_t y, uint8_t liquidIndex, bool isDashboard, bool isfullUpdate)
+{
+  int16_t namesOffsetX = 15;
+  int16_t namesOffsetY = 175;
+
+  BarBottle barBottle = _barBottles[liquidIndex];
+  BarBottle lastDraw_barBottle = _lastDraw_barBottles[liquidIndex];
+  int16_t liquid_Percentage = _spritzerPercentages[liquidIndex];
+  uint16_t color = LiquidTable[liquidIndex].TftColor;
+  
+  bool isEmpty = barBottle == eEmpty;
+  bool selectedChanged = _dashboardLiquid != _lastDraw_SelectedLiquid;
+  bool bottleChanged = barBottle != lastDraw_barBottle;
+  bool sparklingWaterChanged = liquid_Percentage != _lastDraw_spritzerPercentages[liquidIndex];
+  bool isSelected = _dashboardLiquid == liquidIndex;
+  bool wasSelected = _lastDraw_SelectedLiquid == liquidIndex;
+  bool hasSparklingWater = false;
+  for (uint8_t index = 0; index < LiquidCount; index++)
   {
-    DrawStarTail(x0, y0, 4, 5, fullStars, color);
+    hasSparklingWater |= _barBottles[index] == eSparklingWater;
   }
-  if (size > 2)
+
+  // Reset old bottle type selection -> only if bottle type changed
+  if (bottleChanged)
   {
-    DrawStarTail(x0, y0, 7, 8, fullStars, color);
+    SelectBarBottle(lastDraw_barBottle, x0, y, TFT_COLOR_BACKGROUND);
   }
-  if (size > 3)
+
+  // Reset current bottle type selection -> only if selection changed and was selected
+  if (selectedChanged && wasSelected)
   {
-    DrawStarTail(x0, y0, 10, 11, fullStars, color);
+    SelectBarBottle(barBottle, x0, y, TFT_COLOR_BACKGROUND);
   }
-  if (size > 4)
+
+  // Clear current bottle type -> only if bottle type changed
+  if (bottleChanged)
   {
-    DrawStarTail(x0, y0, 13, 14, fullStars, color);
+    ClearBarBottle(lastDraw_barBottle, barBottle, x0, y, TFT_COLOR_BACKGROUND);
+  }
+  
+  // Draw current bottle selection -> only if selected AND (full update OR bottle changed OR selected changed)
+  if (isSelected &&
+    (isfullUpdate || bottleChanged || selectedChanged))
+  {
+    SelectBarBottle(barBottle, x0, y, TFT_COLOR_FOREGROUND);
+  }
+  
+  // Draw current bottle and checkbox -> only if full update or bottle type changed
+  if (isfullUpdate || bottleChanged)
+  {
+    // Draw bottle image
+    DrawBarBottle(barBottle, x0, y);
+  }
+
+  // Draw liquid name -> only if full update, bottle type changed or selected changed
+  if (isfullUpdate || bottleChanged || selectedChanged)
+  {
+    // Draw liquid name
+    _tft->setTextColor(color);
+    _tft->fillRect(x0 - namesOffsetX - 17, y + namesOffsetY - 15, 54, 30, TFT_COLOR_BACKGROUND);
+    DrawCenteredString(LiquidTable[liquidIndex].Name, x0 - namesOffsetX, y + namesOffsetY, false, 0);
+  }
+
+  // Draw sparkling water percentage -> only if any sparkling water is present and not beside itself
+  if (isDashboard &&
+    !isEmpty &&
+    hasSparklingWater &&
+    barBottle != eSparklingWater &&
+    (isfullUpdate || sparklingWaterChanged))
+  {
+    int16_t x = x0 - 37;
+    int16_t yTop = y + namesOffsetY - 120;
+
+    // Draw bar graph
+    _tft->fillRect(x, yTop, 3, 100 - liquid_Percentage, color);
+    _tft->fillRect(x, yTop + 100 - liquid_Percentage, 3, liquid_Percentage, TFT_COLOR_FOREGROUND);
+
+    // Draw percentage
+    _tft->fillRect(x - 10, yTop - 15, 27, 20, TFT_COLOR_BACKGROUND);
+    _tft->setTextColor(color);
+    DrawCenteredString(String(liquid_Percentage), x + 3, yTop - 5, false, 0);
   }
 }
 
 //===============================================================
-// Draws a star tail
+// Clears the difference from a bar bottle to the next bottle
 //===============================================================
-void DisplayDriver::DrawStarTail(int16_t x0, int16_t y0, int16_t start, int16_t end, bool fullStars, uint16_t color)
+void DisplayDriver::ClearBarBottle(BarBottle lastDraw_barBottle, BarBottle barBottle, int16_t x0, int16_t y, uint16_t clearColor)
 {
-  // Nach oben
-  _tft->writeLine(x0, y0 - start, x0, y0 - end, color);
+  if (_imagesAvailable != IMAGE_SUCCESS ||
+    lastDraw_barBottle == eEmpty)
+  {
+    return;
+  }
 
-  // Nach unten
-  _tft->writeLine(x0, y0 + start, x0, y0 + end, color);
+  // Determine image pointers
+  SPIFFSImage* barBottlePointerLast = GetBarBottlePointer(lastDraw_barBottle);
+  SPIFFSImage* barBottlePointerNew = GetBarBottlePointer(barBottle);
 
-  // Nach rechts
-  _tft->writeLine(x0 + start, y0, x0 + end, y0, color);
+  // Clear difference from last to new image
+  int16_t xLast = x0 - barBottlePointerLast->Width() / 2;
+  int16_t xNew = x0 - barBottlePointerNew->Width() / 2;
+  barBottlePointerLast->ClearDiff(xLast, y, xNew, y, barBottlePointerNew, _tft, TFT_TRANSPARENCY_COLOR, clearColor);
+}
 
-  // Nach links
-  _tft->writeLine(x0 - start, y0, x0 - end, y0, color);
+//===============================================================
+// Draws a bar bottle
+//===============================================================
+void DisplayDriver::DrawBarBottle(BarBottle barBottle, int16_t x0, int16_t y)
+{
+  if (_imagesAvailable != IMAGE_SUCCESS)
+  {
+    return;
+  }
+  
+  // Determine correct pointer
+  SPIFFSImage* barBottlePointer = GetBarBottlePointer(barBottle);
 
-  if (fullStars)
+  // Draw bottle
+  int16_t x = x0 - barBottlePointer->Width() / 2;
+  barBottlePointer->Draw(x, y, _tft, TFT_TRANSPARENCY_COLOR, TFT_COLOR_BACKGROUND, barBottle == eEmpty); // Use red wine bottle for empty selection (draw as shadow -> black)
+}
+
+//===============================================================
+// Draws a selection around a bar bottle
+//===============================================================
+void DisplayDriver::SelectBarBottle(BarBottle barBottle, int16_t x0, int16_t y, uint16_t color)
+{
+  if (_imagesAvailable != IMAGE_SUCCESS)
   {
-    // Nach rechts oben
-    _tft->writeLine(x0 + start, y0 - start, x0 + end, y0 - end, color);
+    return;
+  }
 
-    // Nach links oben
-    _tft->writeLine(x0 - start, y0 - start, x0 - end, y0 - end, color);
+  // Determine correct pointer
+  SPIFFSImage* barBottlePointer = GetBarBottlePointer(barBottle);
 
-    // Nach rechts unten
-    _tft->writeLine(x0 + start, y0 + start, x0 + end, y0 + end, color);
+  // Draw selection shadow with move function
+  int16_t selectionWidth = 3;
+  int16_t x = x0 - barBottlePointer->Width() / 2;
+  barBottlePointer->Move(x - selectionWidth, y, x, y, _tft, color, TFT_TRANSPARENCY_COLOR, true);
+  barBottlePointer->Move(x + selectionWidth, y, x, y, _tft, color, TFT_TRANSPARENCY_COLOR, true);
+  barBottlePointer->Move(x, y - selectionWidth, x, y, _tft, color, TFT_TRANSPARENCY_COLOR, true);
+}
 
-    // Nach links unten
-    _tft->writeLine(x0 - start, y0 + start, x0 - end, y0 + end, color);
+//===============================================================
+// Returns a pointer to the requested bar bottle image
+//===============================================================
+SPIFFSImage* DisplayDriver::GetBarBottlePointer(BarBottle barBottle)
+{
+  switch (barBottle)
+  {
+    case eWhiteWine:
+      return _imageBottleWhiteWine;
+    case eRoseWine:
+      return _imageBottleRoseWine;
+    case eSparklingWater:
+      return _imageBottleSparklingWater;
+    case eRedWine:
+    case eEmpty:
+    default:
+      return _imageBottle;
   }
 }
 
 //===============================================================
 // Draws a string centered
 //===============================================================
-void DisplayDriver::DrawCenteredString(const String &text, int16_t x, int16_t y, bool underlined, uint16_t lineColor)
+void DisplayDriver::DrawCenteredString(const String &text, int16_t x, int16_t y, bool underlined, uint16_t lineColor, bool backGround, uint16_t backGroundColor)
 {
-  // Get text bounds
-  int16_t x1, y1;
+  // Get text size from the glyph metrics
   uint16_t w, h;
-  _tft->getTextBounds(text, x, y, &x1, &y1, &w, &h);
+  _textRenderer.GetTextSize(text.c_str(), &w, &h);
 
   // Calculate cursor position
   int16_t x_text = x - w / 2;
   int16_t y_text = y + h / 2;
-  _tft->setCursor(x_text, y_text);
-  
-  // Print text
-  _tft->print(text);
+
+  if (backGround)
+  {
+    // Draw text in foreground color with background in one pass
+    _textRenderer.DrawText(text.c_str(), x_text - 2, y_text, w + 4, TFT_COLOR_FOREGROUND, backGroundColor, eAlignCenter);
+  }
+  else
+  {
+    // Print text transparent (e.g. over images)
+    _tft->setCursor(x_text, y_text);
+    _tft->print(text);
+  }
 
   // Underline if active
   if (underlined)
@@ -1000,16 +1436,3 @@ void DisplayDriver::DrawCenteredString(const String &text, int16_t x, int16_t y,
     _tft->drawLine(x_text, y + h, x_text + w, y + h, lineColor);
   }
 }
-
-//===============================================================
-// Formats double value
-//===============================================================
-String DisplayDriver::FormatValue(double value, int mainPlaces, int decimalPlaces)
-{
-  String returnValue = "";
-
-  dtostrf(value, mainPlaces, decimalPlaces, _output);
-  returnValue += String(_output);
-
-  return returnValue;
-}
@@ -22,7 +22,9 @@
 #include "Config.h"
 #include "StateMachine.h"
 #include "SPIFFSImageReader.h"
+#include "TextRenderer.h"
 #include "AngleHelper.h"
+#include "FixedPointHelper.h"
 #include "FlowMeterDriver.h"
 
 
@@ -55,12 +57,23 @@
 #define MENU_SELECTOR_CORNERRADIUS  8
 #define MENU_LINEOFFSET             43
 
+#define LEVELWARNING_MARGIN_HORI    35  // Level warning is drawn in the header between the wifi icons
+#define TFT_COLOR_LEVEL_WARNING     ST77XX_YELLOW
+
+#define LIQUIDS_PER_COLUMN          3   // Liquid lists on help and settings page use a second column for more liquids
+#define LIQUIDS_COLUMN_WIDTH        110
+
 #define SHORTLINEOFFSET             20
 #define LONGLINEOFFSET              30
 #define LOONGLINEOFFSET             50
 #define SPACERANGLE_DEGREES         1  // Angle which will be displayed as spacer between pie elements (will be multiplied by 2, left and right of the setting angle)
+#define DOUGHNUT_CACHE_SIZE         (2 * R_OUTER_DOUGHNUTCHART + 1)  // Width and height of the doughnut geometry cache
+#define DOUGHNUT_NO_ANGLE           0xFFFF                           // Cache value for pixels outside of the annulus
+#define BAR_SPACING                 78 // Distance between two bottles of the bar stock
 
 #define SCREENSAVER_STARCOUNT       30
+#define SCREENSAVER_FRAMETIME_MS    40    // Frame pacing (max 25 FPS), leaves time for wifi
+#define SCREENSAVER_BUDGET_US       3000  // Render time budget per frame, remaining stars are animated in the next frame
 
 //===============================================================
 // Icons
@@ -113,6 +126,18 @@ const unsigned char icon_reset [] PROGMEM =
 	0x18, 0x78, 0x00, 0x00, 0x38, 0x1c, 0x00, 0x00, 0xfc, 0x3f, 0x00, 0x00, 0xfe, 0x3f, 0x00, 0x00, 
 	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
 };
+// 'cocktails', 32x32px
+const unsigned char icon_cocktails [] PROGMEM =
+{
+	0x00, 0x00, 0x00, 0x03, 0x00, 0x00, 0xc0, 0x02, 0x00, 0x00, 0xa0, 0x01, 0x00, 0x3e, 0xd0, 0x00, 
+	0x00, 0x7f, 0x50, 0x00, 0x80, 0xb7, 0x30, 0x00, 0xc0, 0x55, 0x21, 0x00, 0xc0, 0xff, 0x39, 0x00, 
+	0xc0, 0xfc, 0xff, 0x01, 0xc0, 0x0f, 0x1a, 0x01, 0xc0, 0xed, 0x7f, 0x01, 0x80, 0xaf, 0x43, 0x01, 
+	0x00, 0xaf, 0x42, 0x01, 0x00, 0xae, 0x44, 0x01, 0x00, 0xb8, 0xc3, 0x00, 0x00, 0x30, 0xc0, 0x00, 
+	0x00, 0x70, 0xe0, 0x00, 0x00, 0x50, 0xa0, 0x00, 0x00, 0x50, 0xa0, 0x00, 0x00, 0x50, 0xa0, 0x00, 
+	0x00, 0x50, 0xe0, 0x00, 0x00, 0x70, 0xe0, 0x00, 0x00, 0x60, 0x60, 0x00, 0x00, 0x60, 0x60, 0x00, 
+	0x00, 0x60, 0x60, 0x00, 0x00, 0xe0, 0x70, 0x00, 0x00, 0xa0, 0x5f, 0x00, 0x00, 0xa0, 0x5f, 0x00, 
+	0x00, 0xa0, 0x50, 0x00, 0x00, 0xa0, 0x5f, 0x00, 0x00, 0x20, 0x40, 0x00, 0x00, 0xc0, 0x3f, 0x00
+};
 // 'settings', 32x32px
 const unsigned char icon_settings [] PROGMEM =
 {
@@ -162,6 +187,18 @@ const unsigned char icon_copyright [] PROGMEM = {
 	0x18, 0x80, 0x01, 0x70, 0xe0, 0x00, 0xe0, 0x7f, 0x00, 0x80, 0x1f, 0x00
 };
 
+//===============================================================
+// Screen saver star sprites
+//===============================================================
+// Ray directions (first 4 for simple stars, all 8 for full stars)
+const int8_t StarRayDirections[8][2] =
+{
+  { 0, -1 }, { 0, 1 }, { 1, 0 }, { -1, 0 },
+  { 1, -1 }, { -1, -1 }, { 1, 1 }, { -1, 1 }
+};
+// Distance of the 2 pixel ray segment for each ring
+const int8_t StarRaySegments[5] = { 1, 4, 7, 10, 13 };
+
 //===============================================================
 // Class for screen saver stars
 //===============================================================
@@ -187,6 +224,9 @@ class DisplayDriver
     // Initializes the display driver
     void Begin(Adafruit_ST7789* tft, bool spiffsAvailable);
 
+    // Loads the images to RAM (no display access, may run in a boot task)
+    void LoadImages(bool spiffsAvailable);
+
     // Sets the menu state
     void SetMenuState(MixerState state);
 
@@ -196,14 +236,23 @@ class DisplayDriver
     // Sets the cleaning liquid value
     void SetCleaningLiquid(MixtureLiquid liquid);
 
-    // Sets the angles values
-    void SetAngles(int16_t liquid1Angle_Degrees, int16_t liquid2Angle_Degrees, int16_t liquid3Angle_Degrees);
+    // Sets the angles values (one value per liquid)
+    void SetAngles(const int16_t liquidAngles_Degrees[LiquidCount]);
+
+    // Sets the mixture shares (0-SHARE_FULLSCALE, one value per liquid)
+    void SetShares(const MixtureShare liquidShares[LiquidCount]);
 
-    // Sets the percentage values
-    void SetPercentages(double liquid1_Percentage, double liquid2_Percentage, double liquid3_Percentage);
+    // Sets the bar stock (one bottle per liquid)
+    void SetBarStock(const BarBottle barBottles[LiquidCount]);
+
+    // Sets the spritzer percentages (one value per liquid)
+    void SetSpritzerPercentages(const int16_t spritzerPercentages[LiquidCount]);
 
     // Shows intro page
     void ShowIntroPage();
+
+    // Frees the images only used by the intro page
+    void ReleaseIntroImages();
     
     // Shows help page
     void ShowHelpPage();
@@ -217,6 +266,9 @@ class DisplayDriver
     // Shows cleaning page
     void ShowCleaningPage();
 
+    // Shows bar page
+    void ShowBarPage();
+
     // Shows settings page
     void ShowSettingsPage();
 
@@ -229,11 +281,17 @@ class DisplayDriver
     // Draws the info box
     void DrawInfoBox(const String &line1, const String &line2);
 
+    // Draws a fill level warning instead of the header text (refused pour, empty or low bottle)
+    void DrawLevelWarning(bool isfullUpdate = false);
+
     // Draws the menu partially
     void DrawMenu(bool isfullUpdate = false);
 
     // Draw checkboxes
-    void DrawCheckBoxes();
+    void DrawCheckBoxes(MixtureLiquid liquid);
+
+    // Draw bar
+    void DrawBar(bool isDashboard, bool isfullUpdate = false);
     
     // Draws the legend
     void DrawLegend();
@@ -241,11 +299,8 @@ class DisplayDriver
     // Draws current values partially
     void DrawCurrentValues(bool isfullUpdate = false);
 
-    // Draws full doughnut chart
-    void DrawDoughnutChart3();
-    
-    // Draws doughnut chart partially
-    void DrawDoughnutChart3(bool clockwise, bool isfullUpdate = false);
+    // Draws doughnut chart partially (only changed degrees)
+    void DrawDoughnutChart(bool isfullUpdate = false);
 
     // Draws settings partially
     void DrawSettings(bool isfullUpdate = false);
@@ -253,43 +308,56 @@ class DisplayDriver
     // Draws screen saver
     void DrawScreenSaver();
 
+    // Enables or disables the display sleep mode
+    void SetSleep(bool enable);
+
+    // Returns the screen saver frame rate and cpu share as string (starts a new measurement)
+    String GetScreenSaverString();
+
   private:
     // Display variable
     Adafruit_ST7789* _tft;
-    char _output[30];
 
     // Image pointer
     SPIFFSImage* _imageBottle;
     SPIFFSImage* _imageGlass;
     SPIFFSImage* _imageLogo;
+    SPIFFSImage* _imageBottleWhiteWine = NULL;
+    SPIFFSImage* _imageBottleRoseWine = NULL;
+    SPIFFSImage* _imageBottleSparklingWater = NULL;
     SPIFFSImageReader reader;
+
+    // Text renderer for text fields with opaque background
+    TextRenderer _textRenderer;
     ImageReturnCode _imagesAvailable = IMAGE_ERR_FILE_NOT_FOUND;
 
     // Current mixture settings
     MixerState _menuState = eDashboard;
     MixtureLiquid _dashboardLiquid = eLiquid1;
     MixtureLiquid _cleaningLiquid = eLiquidAll;
-    int16_t _liquid1Angle_Degrees = 0;
-    int16_t _liquid2Angle_Degrees = 0;
-    int16_t _liquid3Angle_Degrees = 0;
-    double _liquid1_Percentage = 0.0;
-    double _liquid2_Percentage = 0.0;
-    double _liquid3_Percentage = 0.0;
+    int16_t _liquidAngles_Degrees[LiquidCount] = {};
+    MixtureShare _liquidShares[LiquidCount] = {};
+    BarBottle _barBottles[LiquidCount] = {};
+    int16_t _spritzerPercentages[LiquidCount] = {};
         
     // Last draw values
     MixerState _lastDraw_MenuState = eDashboard;
-    int16_t _lastDraw_liquid1Angle_Degrees = 0;
-    int16_t _lastDraw_liquid2Angle_Degrees = 0;
-    int16_t _lastDraw_liquid3Angle_Degrees = 0;
-    double _lastDraw_liquid1_Percentage = 0.0;
-    double _lastDraw_liquid2_Percentage = 0.0;
-    double _lastDraw_liquid3_Percentage = 0.0;
-    String _lastDraw_Liquid1String = "";
-    String _lastDraw_Liquid2String = "";
-    String _lastDraw_Liquid3String = "";
+    int16_t _lastDraw_liquidAngles_Degrees[LiquidCount] = {};
+    MixtureLiquid _lastDraw_DashboardLiquid = eLiquidNone;
+    String _lastDraw_LiquidStrings[LiquidCount];
+    MixtureLiquid _lastDraw_SelectedLiquid = eLiquidNone;
+    BarBottle _lastDraw_barBottles[LiquidCount] = {};
+    int16_t _lastDraw_spritzerPercentages[LiquidCount] = {};
     uint32_t _lastDraw_cycleTimespan_ms = 0;
     wifi_mode_t _lastDraw_wifiMode = WIFI_MODE_NULL;
     uint16_t _lastDraw_ConnectedClients = 0;
+    wifi_mode_t _lastDraw_WifiIconsMode = WIFI_MODE_NULL;
+    char _lastDraw_LevelWarning[32] = "";
+
+    // Doughnut chart geometry cache (degree of each pixel), dirty degrees and color per degree
+    uint16_t* _doughnutAngles = NULL;
+    uint8_t _doughnutDirty[360 / 8] = {};
+    uint16_t _doughnutColors[360] = {};
 
     // Screen saver variables
     Star _stars[SCREENSAVER_STARCOUNT];
@@ -297,6 +365,13 @@ class DisplayDriver
     int16_t _lastLogo_y = TFT_HEIGHT / 2;
     int16_t _xDir = 1;
     int16_t _yDir = 1;
+    uint8_t _nextStarIndex = 0;
+    uint32_t _lastFrameTimestamp_ms = 0;
+
+    // Screen saver statistics
+    uint32_t _statsTimestamp_ms = 0;
+    uint32_t _frameCount = 0;
+    uint32_t _renderTime_us = 0;
 
     // Draws default header Text
     void DrawHeader();
@@ -304,23 +379,41 @@ class DisplayDriver
     // Draws header Text
     void DrawHeader(const String &text, bool withIcons = true);
     
-    // Draws only partial update of arcs
-    void DrawPartial(int16_t angle, int16_t lastAngle,  uint16_t colorAfter, uint16_t colorBefore, bool clockwise);
-    
-    // Draws an arc with a defined thickness
-    void FillArc(int16_t start_angle, int16_t distance_Degrees, uint16_t color);
+    // Marks a range of degrees as dirty for the next doughnut draw
+    void MarkDoughnutDirty(int16_t startAngle, int16_t distance_Degrees);
+
+    // Builds the doughnut geometry cache
+    void BuildDoughnutCache();
+
+    // Returns the degree of a pixel of the doughnut chart area (DOUGHNUT_NO_ANGLE outside of the annulus)
+    uint16_t GetDoughnutAngle(int16_t column, int16_t row);
+
+    // Draws a part of the bar
+    void DrawBarPart(int16_t x0, int16_t y, uint8_t liquidIndex, bool isDashboard, bool isfullUpdate);
+
+    // Clears the difference from a bar bottle to the next bottle
+    void ClearBarBottle(BarBottle lastDraw_barBottle, BarBottle barBottle, int16_t x0, int16_t y, uint16_t clearColor);
+
+    // Draws a bar bottle
+    void DrawBarBottle(BarBottle barBottle, int16_t x0, int16_t y);
+
+    // Draws a selection around a bar bottle
+    void SelectBarBottle(BarBottle barBottle, int16_t x0, int16_t y, uint16_t color);
+
+    // Returns a pointer to the requested bar bottle image
+    SPIFFSImage* GetBarBottlePointer(BarBottle barBottle);
+
+    // Returns the icon of a menu entry
+    const unsigned char* GetMenuIcon(MixerState state);
+
+    // Returns the text of a menu entry
+    const char* GetMenuText(MixerState state);
     
     // Draws a string centered
-    void DrawCenteredString(const String &text, int16_t x, int16_t y, bool underlined, uint16_t lineColor);
-    
-    // Formats double value
-    String FormatValue(double value, int mainPlaces, int decimalPlaces);
-
-    // Draws a star
-    void DrawStar(int16_t x0, int16_t y0, bool fullStars, uint16_t color, int16_t size = 0);
+    void DrawCenteredString(const String &text, int16_t x, int16_t y, bool underlined, uint16_t lineColor, bool backGround = false, uint16_t backGroundColor = 0);
     
-    // Draws a star tail
-    void DrawStarTail(int16_t x0, int16_t y0, int16_t start, int16_t end, bool fullStars, uint16_t color);
+    // Draws one ring of a star
+    void DrawStarRing(const Star &star, int16_t ring, uint16_t color, int16_t logo_x, int16_t logo_y, bool onlyUncovered = false);
 };
 
 
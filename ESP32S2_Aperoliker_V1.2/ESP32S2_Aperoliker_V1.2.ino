@@ -50,6 +50,9 @@
 #include "DisplayDriver.h"
 #include "FlowMeterDriver.h"
 #include "WifiHandler.h"
+#include "PowerManager.h"
+#include "SettingsStore.h"
+#include "PourLog.h"
 
 
 //===============================================================
@@ -60,10 +63,7 @@
 #define PIN_ENCODER_OUTB        11    // GPIO 11 -> rotary encoder output B
 #define PIN_ENCODER_BUTTON      10    // GPIO 10 -> rotary encoder button
 
-// Pumps pin defines
-#define PIN_PUMP_1              1     // GPIO 1  -> pump 1 power
-#define PIN_PUMP_2              2     // GPIO 2  -> pump 2 power
-#define PIN_PUMP_3              4     // GPIO 4  -> pump 3 power
+// Pumps pin defines (pump power pins are defined in the liquid table in Config.h)
 #define PIN_PUMPS_ENABLE        12    // GPIO 12 -> dispensing lever pumps enable, input
 #define PIN_PUMPS_ENABLE_GND    13    // GPIO 13 -> dispensing lever pumps enable, GND
 
@@ -83,6 +83,10 @@
 // Intro defines
 #define INTRO_TIME_MS           3000  // Wait for 3 seconds at startup and show intro page
 
+// Boot dependency bits (set by the boot tasks when finished)
+#define BOOT_BIT_IMAGES         (1 << 0)  // Images are decoded to RAM
+#define BOOT_BIT_WIFI           (1 << 1)  // Wifi, webserver and mDNS are started
+
 
 //===============================================================
 // Global variables
@@ -93,6 +97,9 @@ Adafruit_ST7789* tft = NULL;
 // Timer variables for alive counter
 uint32_t aliveTimestamp = 0;
 const uint32_t AliveTime_ms = 2000;
+#if defined(DEBUG_MIXER)
+IdleTier lastTier = eTierActive;
+#endif
 
 // Timer variables for blink counter
 uint32_t blinkTimestamp = 0;
@@ -102,6 +109,10 @@ const uint32_t BlinkTime_ms = 100;
 TaskHandle_t mainTaskHandle = NULL;
 TaskHandle_t timerTaskHandle = NULL;
 
+// Boot task synchronization
+EventGroupHandle_t bootEvents = NULL;
+bool bootSpiffsAvailable = false;
+
 //===============================================================
 // Interrupt on pumps enable changing state
 //===============================================================
@@ -132,22 +143,6 @@ void IRAM_ATTR ISR_EncoderButton()
   EncoderButton.ButtonEvent();
 }
 
-//===============================================================
-// Interrupt on encoder out A
-//===============================================================
-void IRAM_ATTR ISR_EncoderA()
-{
-  EncoderButton.DoEncoderA();
-}
-
-//===============================================================
-// Interrupt on encoder out B
-//===============================================================
-void IRAM_ATTR ISR_EncoderB()
-{
-  EncoderButton.DoEncoderB();
-}
-
 //===============================================================
 // Setup function
 //===============================================================
@@ -159,9 +154,10 @@ void setup(void)
 
   // Initialize serial communication
   Serial.begin(115200);
-#if defined(DEBUG_MIXER)
+#if defined(DEBUG_MIXER) && !defined(FAST_BOOT)
   delay(2000);
 #endif
+  uint32_t bootStart_ms = millis();
   Serial.println("[SETUP] " + String(MIXER_NAME) + " " + String(APP_VERSION));
   Serial.println(GetSystemInfoString());
   Serial.println();
@@ -171,25 +167,6 @@ void setup(void)
   Serial.println(GetResetReasonString(0));
   Serial.println();
 
-  // Initialize SPIFFS
-  SPIFFS.end(); // Close first for begin with 'formatOnFail'
-  bool spiffsAvailable = SPIFFS.begin(true);
-  size_t spiffsTotal = SPIFFS.totalBytes();
-  size_t spiffsUsed = SPIFFS.usedBytes();
-  Serial.println(String("[SETUP] SPIFFS: ") + String(spiffsUsed) + "/" + String(spiffsTotal) + " Bytes used (SPIFFS Available: " + (spiffsAvailable ? "true" : "false") + ")");
-
-  // Initialize SPI
-  SPIClass* spi = new SPIClass(HSPI);
-  spi->begin(PIN_TFT_SCL, -1, PIN_TFT_SDA, PIN_TFT_CS);
-
-  // Initialize display
-  tft = new Adafruit_ST7789(spi, PIN_TFT_CS, PIN_TFT_DC, PIN_TFT_RST);
-  Display.Begin(tft, spiffsAvailable);
-
-  // Show intro page
-  Display.ShowIntroPage();
-  uint32_t startupTime_ms = millis();
-
   // Initialize GPIOs
   pinMode(PIN_PUMPS_ENABLE, INPUT_PULLUP);
   pinMode(PIN_PUMPS_ENABLE_GND, OUTPUT);
@@ -201,34 +178,80 @@ void setup(void)
   digitalWrite(PIN_LEDLIGHT, LOW);
   digitalWrite(PIN_BUZZER, LOW);
 
-  // Play startup sound
-	for (uint8_t index = 1; index <= 8; index++)
-	{
-    tone(PIN_BUZZER, index * 100, 65);
-    delay(85);
-  }
+  // Play startup sound in the background
+  xTaskCreate(Boot_Sound_Task, "Boot_Sound_Task", 2048, NULL, 1, NULL);
+
+  // Initialize SPIFFS (images and webserver files depend on it)
+  uint32_t phaseStart_ms = millis();
+  SPIFFS.end(); // Close first for begin with 'formatOnFail'
+  bootSpiffsAvailable = SPIFFS.begin(true);
+  size_t spiffsTotal = SPIFFS.totalBytes();
+  size_t spiffsUsed = SPIFFS.usedBytes();
+  Serial.println(String("[SETUP] SPIFFS: ") + String(spiffsUsed) + "/" + String(spiffsTotal) + " Bytes used (SPIFFS Available: " + (bootSpiffsAvailable ? "true" : "false") + ")");
+  LogBootPhase("SPIFFS", phaseStart_ms);
+
+  // Restore all persistent values in one pass (wifi reads them in its boot task)
+  phaseStart_ms = millis();
+  Settings.Begin();
+  LogBootPhase("Flash", phaseStart_ms);
+
+  // Decode images and start wifi while the display and the settings are initialized
+  bootEvents = xEventGroupCreate();
+  xTaskCreate(Boot_Images_Task, "Boot_Images_Task", 4096, NULL, 1, NULL);
+#if defined(WIFI_MIXER)
+  xTaskCreate(Boot_Wifi_Task, "Boot_Wifi_Task", 8192, NULL, 1, NULL);
+#endif
+
+  // Initialize SPI
+  phaseStart_ms = millis();
+  SPIClass* spi = new SPIClass(HSPI);
+  spi->begin(PIN_TFT_SCL, -1, PIN_TFT_SDA, PIN_TFT_CS);
+
+  // Initialize display
+  tft = new Adafruit_ST7789(spi, PIN_TFT_CS, PIN_TFT_DC, PIN_TFT_RST);
+  Display.Begin(tft, bootSpiffsAvailable);
+  LogBootPhase("Display", phaseStart_ms);
 
-  // Initialize encoder button
+  // Initialize encoder button (encoder backend is selected in Config.h)
+  phaseStart_ms = millis();
   EncoderButton.Begin(PIN_ENCODER_OUTA, PIN_ENCODER_OUTB, PIN_ENCODER_BUTTON);
-  attachInterrupt(digitalPinToInterrupt(PIN_ENCODER_OUTA), ISR_EncoderA, CHANGE);
-  attachInterrupt(digitalPinToInterrupt(PIN_ENCODER_OUTB), ISR_EncoderB, CHANGE);
   attachInterrupt(digitalPinToInterrupt(PIN_ENCODER_BUTTON), ISR_EncoderButton, CHANGE);
 
-  // Initialize flow values from EEPROM
+  // Initialize flow values from the settings store
   FlowMeter.Load();
+
+  // Initialize pour log (records are flushed to SPIFFS)
+  Pours.Begin(bootSpiffsAvailable);
   
   // Initialize pump driver
-  Pumps.Begin(PIN_PUMP_1, PIN_PUMP_2, PIN_PUMP_3);
+  Pumps.Begin();
 
   // Initialize state machine
   Statemachine.Begin(PIN_BUZZER);
-  
-  // Wait for the rest of the intro time
-  while ((millis() - startupTime_ms) < INTRO_TIME_MS) { };
+  LogBootPhase("Settings", phaseStart_ms);
+
+  // Wait for the images before drawing any page
+  phaseStart_ms = millis();
+  xEventGroupWaitBits(bootEvents, BOOT_BIT_IMAGES, pdFALSE, pdTRUE, portMAX_DELAY);
+  LogBootPhase("Wait for images", phaseStart_ms);
 
   // Allow interrupts for encoder button
   sei();
 
+#if defined(FAST_BOOT)
+  // Intro page is skipped, free its images
+  Display.ReleaseIntroImages();
+#else
+  // Show intro page
+  Display.ShowIntroPage();
+  uint32_t introStart_ms = millis();
+
+  // Wait for the rest of the intro time (wifi continues in the background)
+  while ((millis() - introStart_ms) < INTRO_TIME_MS)
+  {
+    vTaskDelay(pdMS_TO_TICKS(10));
+  }
+
   // Show help page until button is pressed
   Display.ShowHelpPage();
   bool infoBoxShown = false;
@@ -255,10 +278,6 @@ void setup(void)
     // Contains yield() for ESP32
     delay(1);
   }
-
-#if defined(WIFI_MIXER)
-  // Initialize wifi
-  Wifihandler.Begin();
 #endif
 
   // Initial run of state machine with entry event
@@ -267,10 +286,22 @@ void setup(void)
   // Initialize interrupt for dispenser lever
   attachInterrupt(digitalPinToInterrupt(PIN_PUMPS_ENABLE), ISR_Pumps_Enable, CHANGE);
 
+  // Wake up from light sleep on encoder, button or dispenser lever
+#if defined(ENCODER_PCNT)
+  Power.AddWakePin(PIN_ENCODER_OUTA, false);
+  Power.AddWakePin(PIN_ENCODER_OUTB, false);
+#else
+  Power.AddWakePin(PIN_ENCODER_OUTA, true);
+  Power.AddWakePin(PIN_ENCODER_OUTB, true);
+#endif
+  Power.AddWakePin(PIN_ENCODER_BUTTON, true);
+  Power.AddWakePin(PIN_PUMPS_ENABLE, true);
+
   // Start main task
   xTaskCreate(Main_Task, "Main_Task", 4096, NULL, 10, &mainTaskHandle);
 
   // Final output
+  LogBootPhase("Dashboard ready", bootStart_ms);
   Serial.println("[SETUP] Finished");
 }
 
@@ -279,8 +310,9 @@ void setup(void)
 //===============================================================
 void loop()
 {
-  // Show debug alive message
-  if ((millis() - aliveTimestamp) > AliveTime_ms)
+  // Show debug alive message (not in the idle tiers, the device is left alone there)
+  IdleTier tier = Power.GetTier();
+  if (tier == eTierActive && (millis() - aliveTimestamp) > AliveTime_ms)
   {
     aliveTimestamp = millis();
     Serial.println("[LOOP] Alive");
@@ -288,10 +320,48 @@ void loop()
     // Print mixture information
     Serial.println(Statemachine.GetMixtureString());
 
+#if defined(DEBUG_MIXER)
+    // Print state transition information
+    Serial.println(Statemachine.GetTransitionString());
+
+#if defined(WIFI_MIXER)
+    // Print fleet order latencies and load balance
+    Serial.println(Fleet.GetFleetString());
+
+    // Print websocket latencies, traffic and clients
+    Serial.println(Wifihandler.GetNetworkString());
+#endif
+
+    // Print bottle fill levels and consumption rates
+    Serial.println(FlowMeter.GetLevelString());
+
+    // Print pump cycle timespan and predicted ratio error
+    Serial.println(Pumps.GetPumpString());
+
+    // Print flash commits of the settings store
+    Serial.println(Settings.GetSettingsString());
+
+    // Print pour statistics
+    Serial.println(Pours.GetPourString());
+#endif
+
     // Print memory information
     Serial.println(GetMemoryInfoString());
   }
 
+#if defined(DEBUG_MIXER)
+  // Print the idle statistics once, when the user returns from the idle tiers
+  if (tier == eTierActive && lastTier != eTierActive)
+  {
+    // Print screen saver frame rate and cpu share
+    Serial.println(Display.GetScreenSaverString());
+
+    // Print idle tier duty cycle and wake latency
+    Serial.println(Power.GetPowerString());
+  }
+  lastTier = tier;
+#endif
+
   // Flash LED light if dispensing is in progress
   if (Pumps.IsEnabled() &&
     (Statemachine.GetCurrentState() == eDashboard ||
@@ -304,6 +374,11 @@ void loop()
       digitalWrite(PIN_LEDLIGHT, !digitalRead(PIN_LEDLIGHT));
     }
   }
+  else if (Power.GetTier() >= eTierStatic)
+  {
+    // Set LED to off in the static and sleep idle tiers
+    digitalWrite(PIN_LEDLIGHT, LOW);
+  }
   else
   {
     // Set LED to on
@@ -313,12 +388,25 @@ void loop()
   // Update pump outputs
   Pumps.Update();
 
-  // Save flow meter values to flash if requested
+  // Update bottle fill levels and refuse pours, which a bottle can't cover
+  FlowMeter.UpdateLevels();
+  Pumps.UpdatePourCheck();
+
+  // Save flow meter values to the settings store if requested
   FlowMeter.SaveAsync();
 
+  // Record pours on the dashboard (cleaning is not counted)
+  Pours.Update(Pumps.IsEnabled() && Statemachine.GetCurrentState() == eDashboard);
+
+  // Commit changed settings to flash after a quiet period or on request (never while pouring)
+  Settings.Update(Pumps.IsEnabled());
+
 #if defined(WIFI_MIXER)
-  // Update wifi, webserver and clients
-  Wifihandler.Update();
+  // Update wifi, webserver and clients (as soon as the boot task has started them)
+  if (xEventGroupGetBits(bootEvents) & BOOT_BIT_WIFI)
+  {
+    Wifihandler.Update();
+  }
 #endif
 }
 
@@ -337,3 +425,49 @@ void Main_Task(void *arg)
   }
 }
 
+//===============================================================
+// Boot task function for the startup sound
+//===============================================================
+void Boot_Sound_Task(void *arg)
+{
+  // Play melody without blocking the setup
+  for (uint8_t index = 1; index <= 8; index++)
+  {
+    tone(PIN_BUZZER, index * 100, 65);
+    vTaskDelay(pdMS_TO_TICKS(85));
+  }
+
+  vTaskDelete(NULL);
+}
+
+//===============================================================
+// Boot task function for decoding the images
+//===============================================================
+void Boot_Images_Task(void *arg)
+{
+  uint32_t start_ms = millis();
+
+  // Load images from SPIFFS to RAM
+  Display.LoadImages(bootSpiffsAvailable);
+  LogBootPhase("Images", start_ms);
+
+  xEventGroupSetBits(bootEvents, BOOT_BIT_IMAGES);
+  vTaskDelete(NULL);
+}
+
+#if defined(WIFI_MIXER)
+//===============================================================
+// Boot task function for starting wifi
+//===============================================================
+void Boot_Wifi_Task(void *arg)
+{
+  uint32_t start_ms = millis();
+
+  // Initialize wifi
+  Wifihandler.Begin();
+  LogBootPhase("Wifi", start_ms);
+
+  xEventGroupSetBits(bootEvents, BOOT_BIT_WIFI);
+  vTaskDelete(NULL);
+}
+#endif
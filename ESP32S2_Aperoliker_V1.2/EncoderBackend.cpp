@@ -0,0 +1,131 @@
+/**
+ * Includes encoder backend functions
+ *
+ * @author    Florian Staeblein
+ * @date      2024/01/28
+ * @copyright © 2024 Florian Staeblein
+ */
+ 
+#include "EncoderBackend.h"
+
+#if defined(ENCODER_PCNT)
+//===============================================================
+// Initializes the pulse counter for the encoder pins
+//===============================================================
+void EncoderBackendPCNT::Begin(uint8_t pinEncoderOutA, uint8_t pinEncoderOutB)
+{
+  pinMode(pinEncoderOutA, INPUT_PULLUP);
+  pinMode(pinEncoderOutB, INPUT_PULLUP);
+
+  // Channel 0 counts the edges of A, B is the direction
+  // Forward sequence (B leads A) is 00 -> 01 -> 11 -> 10 -> 00 (state is A << 1 | B)
+  pcnt_config_t config = {};
+  config.pulse_gpio_num = pinEncoderOutA;
+  config.ctrl_gpio_num = pinEncoderOutB;
+  config.pos_mode = PCNT_COUNT_INC;
+  config.neg_mode = PCNT_COUNT_DEC;
+  config.lctrl_mode = PCNT_MODE_REVERSE;
+  config.hctrl_mode = PCNT_MODE_KEEP;
+  config.counter_h_lim = ENCODER_PCNT_LIMIT;
+  config.counter_l_lim = -ENCODER_PCNT_LIMIT;
+  config.unit = ENCODER_PCNT_UNIT;
+  config.channel = PCNT_CHANNEL_0;
+  pcnt_unit_config(&config);
+
+  // Channel 1 counts the edges of B, A is the direction (all 4 transitions per step are counted)
+  config.pulse_gpio_num = pinEncoderOutB;
+  config.ctrl_gpio_num = pinEncoderOutA;
+  config.pos_mode = PCNT_COUNT_DEC;
+  config.neg_mode = PCNT_COUNT_INC;
+  config.channel = PCNT_CHANNEL_1;
+  pcnt_unit_config(&config);
+
+  // Reject bounces shorter than the filter time
+  pcnt_set_filter_value(ENCODER_PCNT_UNIT, ENCODER_PCNT_FILTER);
+  pcnt_filter_enable(ENCODER_PCNT_UNIT);
+
+  // Start counting
+  pcnt_counter_pause(ENCODER_PCNT_UNIT);
+  pcnt_counter_clear(ENCODER_PCNT_UNIT);
+  pcnt_counter_resume(ENCODER_PCNT_UNIT);
+}
+
+//===============================================================
+// Returns the hardware counter value and clears the counter
+//===============================================================
+int16_t EncoderBackendPCNT::ReadAndClear()
+{
+  int16_t quarterSteps = 0;
+  pcnt_get_counter_value(ENCODER_PCNT_UNIT, &quarterSteps);
+  if (quarterSteps != 0)
+  {
+    pcnt_counter_clear(ENCODER_PCNT_UNIT);
+  }
+  return quarterSteps;
+}
+#else
+//===============================================================
+// Quadrature transition table, index is last state << 2 | new
+// state. Invalid transitions (both channels changed, e.g. by
+// bouncing) and unchanged states count zero.
+//===============================================================
+static const int8_t DRAM_ATTR QuadratureTable[16] =
+{
+   0,  1, -1,  0,
+  -1,  0,  0,  1,
+   1,  0,  0, -1,
+   0, -1,  1,  0
+};
+
+//===============================================================
+// Interrupt on encoder out A or B
+//===============================================================
+static void IRAM_ATTR ISR_EncoderEdge(void* backend)
+{
+  ((EncoderBackendISR*)backend)->DoEncoderEdge();
+}
+
+//===============================================================
+// Initializes the pins and attaches the interrupts
+//===============================================================
+void EncoderBackendISR::Begin(uint8_t pinEncoderOutA, uint8_t pinEncoderOutB)
+{
+  _pinEncoderOutA = pinEncoderOutA;
+  _pinEncoderOutB = pinEncoderOutB;
+
+  pinMode(_pinEncoderOutA, INPUT_PULLUP);
+  pinMode(_pinEncoderOutB, INPUT_PULLUP);
+
+  // Read initial quadrature state
+  _quadratureState = (digitalRead(_pinEncoderOutA) << 1) | digitalRead(_pinEncoderOutB);
+
+  attachInterruptArg(digitalPinToInterrupt(_pinEncoderOutA), ISR_EncoderEdge, this, CHANGE);
+  attachInterruptArg(digitalPinToInterrupt(_pinEncoderOutB), ISR_EncoderEdge, this, CHANGE);
+}
+
+//===============================================================
+// Returns the software counter value and clears the counter
+//===============================================================
+int16_t EncoderBackendISR::ReadAndClear()
+{
+  portENTER_CRITICAL(&_mux);
+  int16_t quarterSteps = _quarterSteps;
+  _quarterSteps = 0;
+  portEXIT_CRITICAL(&_mux);
+  return quarterSteps;
+}
+
+//===============================================================
+// Decodes a quadrature transition (bounces move back and forth
+// and cancel each other out)
+//===============================================================
+void EncoderBackendISR::DoEncoderEdge()
+{
+  uint8_t state = (digitalRead(_pinEncoderOutA) << 1) | digitalRead(_pinEncoderOutB);
+
+  portENTER_CRITICAL_ISR(&_mux);
+  _quarterSteps = _quarterSteps + QuadratureTable[(_quadratureState << 2) | state];
+  portEXIT_CRITICAL_ISR(&_mux);
+  _quadratureState = state;
+}
+#endif
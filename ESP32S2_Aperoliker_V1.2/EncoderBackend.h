@@ -0,0 +1,86 @@
+/**
+ * Includes all encoder backend functions
+ *
+ * @author    Florian Staeblein
+ * @date      2024/01/28
+ * @copyright © 2024 Florian Staeblein
+ */
+ 
+#ifndef ENCODERBACKEND_H
+#define ENCODERBACKEND_H
+
+//===============================================================
+// Includes
+//===============================================================
+#include <Arduino.h>
+#include "Config.h"
+#if defined(ENCODER_PCNT)
+#include <driver/pcnt.h>
+#endif
+
+
+//===============================================================
+// Defines
+//===============================================================
+#define ENCODER_PCNT_UNIT         PCNT_UNIT_0
+#define ENCODER_PCNT_FILTER       1023    // Glitch filter in APB clock cycles (1023 = 12.8 us at 80 MHz, max value)
+#define ENCODER_PCNT_LIMIT        10000   // Counter limit (never reached, the counter is cleared at every read)
+
+
+//===============================================================
+// Interface for encoder backends (hardware abstraction). A
+// backend counts valid quadrature transitions (4 per step).
+//===============================================================
+class EncoderBackend
+{
+  public:
+    // Initializes the backend for the encoder pins
+    virtual void Begin(uint8_t pinEncoderOutA, uint8_t pinEncoderOutB) = 0;
+
+    // Returns the counted quadrature transitions since the last query and resets the counter
+    virtual int16_t ReadAndClear() = 0;
+};
+
+#if defined(ENCODER_PCNT)
+//===============================================================
+// Encoder backend using the pulse counter (PCNT) hardware
+//===============================================================
+class EncoderBackendPCNT : public EncoderBackend
+{
+  public:
+    // Initializes the pulse counter for the encoder pins
+    void Begin(uint8_t pinEncoderOutA, uint8_t pinEncoderOutB) override;
+
+    // Returns the hardware counter value and clears the counter
+    int16_t ReadAndClear() override;
+};
+#else
+//===============================================================
+// Encoder backend using pin change interrupts
+//===============================================================
+class EncoderBackendISR : public EncoderBackend
+{
+  public:
+    // Initializes the pins and attaches the interrupts
+    void Begin(uint8_t pinEncoderOutA, uint8_t pinEncoderOutB) override;
+
+    // Returns the software counter value and clears the counter
+    int16_t ReadAndClear() override;
+
+    // Decodes a quadrature transition (called by both pin interrupts)
+    void IRAM_ATTR DoEncoderEdge();
+
+  private:
+    // Pin definitions
+    uint8_t _pinEncoderOutA;
+    uint8_t _pinEncoderOutB;
+
+    // Quadrature decoder variables (state is A << 1 | B)
+    uint8_t _quadratureState = 0;
+    volatile int16_t _quarterSteps = 0;
+    portMUX_TYPE _mux = portMUX_INITIALIZER_UNLOCKED;
+};
+#endif
+
+
+#endif
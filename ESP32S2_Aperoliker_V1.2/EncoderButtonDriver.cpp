@@ -13,6 +13,13 @@
 //===============================================================
  EncoderButtonDriver EncoderButton;
 
+// Encoder backend selected in Config.h
+#if defined(ENCODER_PCNT)
+static EncoderBackendPCNT encoderBackend;
+#else
+static EncoderBackendISR encoderBackend;
+#endif
+
 //===============================================================
 // Constructor
 //===============================================================
@@ -31,9 +38,11 @@ void EncoderButtonDriver::Begin(uint8_t pinEncoderOutA, uint8_t pinEncoderOutB,
   _pinEncoderButton = pinEncoderButton;
 
   // Initialize GPIOs
-  pinMode(_pinEncoderOutA, INPUT_PULLUP);
-  pinMode(_pinEncoderOutB, INPUT_PULLUP);
   pinMode(_pinEncoderButton, INPUT_PULLUP);
+
+  // Initialize encoder backend
+  _backend = &encoderBackend;
+  _backend->Begin(_pinEncoderOutA, _pinEncoderOutB);
   
   // Reset timestamp of last user action
   _lastUserAction = millis();
@@ -47,6 +56,25 @@ uint32_t EncoderButtonDriver::GetLastUserAction()
   return _lastUserAction;
 }
 
+//===============================================================
+// Sets the timestamp of the last user action to now
+//===============================================================
+void EncoderButtonDriver::SetUserAction()
+{
+  _lastUserAction = millis();
+}
+
+//===============================================================
+// Ignores the release of a currently pressed button
+//===============================================================
+void EncoderButtonDriver::IgnoreCurrentButtonPress()
+{
+  if (!digitalRead(_pinEncoderButton))
+  {
+    _suppressShortButtonPress = true;
+  }
+}
+
 //===============================================================
 // Return true, if a button press is pending. Otherwise false
 //===============================================================
@@ -105,11 +133,24 @@ bool EncoderButtonDriver::IsLongButtonPress()
 //===============================================================
 int16_t EncoderButtonDriver::GetEncoderIncrements()
 {
-  // Save current increments value
-  int16_t currentEncoderIncrements = _encoderIncrements;
-  
-  // Reset the counter
-  _encoderIncrements = 0;
+  // Collect quadrature transitions from the backend (remainder is kept for the next query)
+  _quarterSteps += _backend->ReadAndClear();
+  int16_t steps = _quarterSteps / ENCODER_QUARTERSTEPS;
+  _quarterSteps -= steps * ENCODER_QUARTERSTEPS;
+
+  int16_t currentEncoderIncrements = 0;
+  if (steps != 0)
+  {
+    uint32_t now_us = micros();
+    int8_t direction = steps > 0 ? 1 : -1;
+
+    // Velocity from the mean time per step since the last step (direction changes start slow)
+    int16_t factor = direction == _lastStepDirection ? GetAccelerationFactor((now_us - _lastStep_us) / abs(steps)) : 1;
+    currentEncoderIncrements = steps * factor;
+
+    _lastStepDirection = direction;
+    _lastStep_us = now_us;
+  }
 
   if (currentEncoderIncrements != 0)
   {
@@ -143,35 +184,20 @@ void EncoderButtonDriver::ButtonEvent()
 }
 
 //===============================================================
-// Should be called if encoder edge A changed
+// Returns the acceleration factor for the time between two
+// encoder steps
 //===============================================================
-void EncoderButtonDriver::DoEncoderA()
+int16_t EncoderButtonDriver::GetAccelerationFactor(uint32_t stepInterval_us)
 {
-  if (digitalRead(_pinEncoderOutA) != _A_set)
+  if (stepInterval_us >= ENCODER_ACCEL_SLOW_US)
   {
-    _A_set = !_A_set;
-    
-    // Adjust counter -1 if A leads B
-    if (_A_set && !_B_set) 
-    {
-      _encoderIncrements = _encoderIncrements - 1;
-    }
+    return 1;
   }
-}
-
-//===============================================================
-// Should be called if encoder edge B changed
-//===============================================================
-void EncoderButtonDriver::DoEncoderB()
-{
-  if (digitalRead(_pinEncoderOutB) != _B_set)
+  if (stepInterval_us <= ENCODER_ACCEL_FAST_US)
   {
-    _B_set = !_B_set;
-    
-    //  Adjust counter +1 if B leads A
-    if (_B_set && !_A_set) 
-    {
-      _encoderIncrements = _encoderIncrements + 1;
-    }
+    return ENCODER_ACCEL_MAXFACTOR;
   }
+
+  // Linear curve between slow and fast step interval
+  return 1 + (ENCODER_ACCEL_MAXFACTOR - 1) * (ENCODER_ACCEL_SLOW_US - stepInterval_us) / (ENCODER_ACCEL_SLOW_US - ENCODER_ACCEL_FAST_US);
 }
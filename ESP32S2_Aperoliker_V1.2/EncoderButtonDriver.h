@@ -14,6 +14,7 @@
 //===============================================================
 #include <Arduino.h>
 #include "Config.h"
+#include "EncoderBackend.h"
 
 
 //===============================================================
@@ -21,6 +22,13 @@
 //===============================================================
 #define MINIMUMLONGTIMEPRESS_MS   500
 
+// Encoder acceleration curve: Steps slower than ENCODER_ACCEL_SLOW_US count once, steps
+// faster than ENCODER_ACCEL_FAST_US count ENCODER_ACCEL_MAXFACTOR times (linear in between)
+#define ENCODER_ACCEL_SLOW_US     40000
+#define ENCODER_ACCEL_FAST_US     5000
+#define ENCODER_ACCEL_MAXFACTOR   5
+#define ENCODER_QUARTERSTEPS      4     // Valid quadrature transitions per encoder step (detent)
+
 
 //===============================================================
 // Class for handling encoder and button functions
@@ -43,14 +51,17 @@ class EncoderButtonDriver
     // Return true, if a long button press is pending. Otherwise false
     bool IsLongButtonPress();
 
+    // Sets the timestamp of the last user action to now
+    void SetUserAction();
+
+    // Ignores the release of a currently pressed button (no short button press)
+    void IgnoreCurrentButtonPress();
+
     // Returns the counted encoder pulses since the last query and resets the counter
     int16_t GetEncoderIncrements();
 
-    // Should be called if encoder edge A changed
-    void IRAM_ATTR DoEncoderA();
-
-    // Should be called if encoder edge B changed
-    void IRAM_ATTR DoEncoderB();
+    // Returns the acceleration factor for the time between two encoder steps
+    static int16_t GetAccelerationFactor(uint32_t stepInterval_us);
     
     // Should be called if button was pressed or released
     void IRAM_ATTR ButtonEvent();
@@ -61,12 +72,13 @@ class EncoderButtonDriver
     uint8_t _pinEncoderOutB;
     uint8_t _pinEncoderButton;
 
-    // Interrupt service routine variables
-    bool _A_set = false;
-    bool _B_set = false;
+    // Encoder backend (pulse counter or interrupts, see Config.h)
+    EncoderBackend* _backend = NULL;
 
     // Rotary encoder variables
-    int16_t _encoderIncrements = 0;
+    int16_t _quarterSteps = 0;
+    int8_t _lastStepDirection = 0;
+    uint32_t _lastStep_us = 0;
 
     // Encoder state variables
     bool _isButtonPress = false;
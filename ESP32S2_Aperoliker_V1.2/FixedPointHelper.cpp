@@ -0,0 +1,56 @@
+/**
+ * Includes all fixed point helper functions
+ *
+ * @author    Florian Staeblein
+ * @date      2024/01/28
+ * @copyright © 2024 Florian Staeblein
+ */
+
+#include "FixedPointHelper.h"
+
+//===============================================================
+// Formats a fixed point value (value in 1/10^decimalPlaces units)
+// like dtostrf(value, mainPlaces, decimalPlaces)
+//===============================================================
+String FormatFixedPoint(uint32_t value, int mainPlaces, int decimalPlaces)
+{
+  // Two full uint32_t fields, the dot and the zero terminator (places are clamped to fit)
+  char output[24];
+  mainPlaces = constrain(mainPlaces, 0, 10);
+  decimalPlaces = constrain(decimalPlaces, 0, 9);
+
+  // Calculate divisor for the decimal places
+  uint32_t divisor = 1;
+  for (int index = 0; index < decimalPlaces; index++)
+  {
+    divisor *= 10;
+  }
+
+  if (decimalPlaces > 0)
+  {
+    // Integer part is padded to the remaining width (same as dtostrf)
+    int integerPlaces = max(0, mainPlaces - decimalPlaces - 1);
+    snprintf(output, sizeof(output), "%*lu.%0*lu", integerPlaces, (unsigned long)(value / divisor), decimalPlaces, (unsigned long)(value % divisor));
+  }
+  else
+  {
+    snprintf(output, sizeof(output), "%*lu", mainPlaces, (unsigned long)value);
+  }
+
+  return String(output);
+}
+
+//===============================================================
+// Scales a value by the ratio of two shares (64 bit product,
+// rounded half up). The former double math truncated, so results
+// differ from it by at most 1 (e.g. 5/6 * 204 = 170, the double
+// math gave 169.99999999999997 -> 169).
+//===============================================================
+uint32_t ScaleShareRatio(uint32_t value, uint32_t numerator_Share, uint32_t denominator_Share)
+{
+  if (denominator_Share == 0)
+  {
+    return 0;
+  }
+  return (uint32_t)(((uint64_t)value * numerator_Share + denominator_Share / 2) / denominator_Share);
+}
@@ -0,0 +1,111 @@
+/**
+ * Includes all fixed point helper functions
+ *
+ * @author    Florian Staeblein
+ * @date      2024/01/28
+ * @copyright © 2024 Florian Staeblein
+ */
+
+#ifndef FIXEDPOINTHELPER_H
+#define FIXEDPOINTHELPER_H
+
+//===============================================================
+// Includes
+//===============================================================
+#include <Arduino.h>
+
+
+//===============================================================
+// Defines
+//===============================================================
+// Fixed point scale of a mixture share. 100% equals 360° equals 36000,
+// so degrees, percent and per-mille can be converted without loss
+#define SHARE_FULLSCALE         36000
+#define SHARE_PER_DEGREE        (SHARE_FULLSCALE / 360)
+#define SHARE_PER_PERCENT       (SHARE_FULLSCALE / 100)
+
+
+//===============================================================
+// Types
+//===============================================================
+// Share of a liquid in the mixture (0 - SHARE_FULLSCALE)
+typedef uint16_t MixtureShare;
+
+
+//===============================================================
+// Conversion templates
+//===============================================================
+
+// Rescales a value from one fixed point scale to another (truncated)
+template <uint32_t FromScale, uint32_t ToScale, typename T = uint32_t>
+constexpr T Rescale(T value)
+{
+  return (T)((value * ToScale) / FromScale);
+}
+
+// Rescales a value from one fixed point scale to another (rounded half up)
+template <uint32_t FromScale, uint32_t ToScale, typename T = uint32_t>
+constexpr T RescaleRounded(T value)
+{
+  return (T)((value * ToScale + FromScale / 2) / FromScale);
+}
+
+// Rescales a value from one fixed point scale to another (rounded half to even, same as dtostrf
+// for values, which are exact halves in double)
+template <uint32_t FromScale, uint32_t ToScale, typename T = uint32_t>
+constexpr T RescaleRoundedEven(T value)
+{
+  return (T)((value * ToScale) / FromScale +
+    (((value * ToScale) % FromScale * 2 > FromScale ||
+    ((value * ToScale) % FromScale * 2 == FromScale && ((value * ToScale) / FromScale) % 2 == 1)) ? 1 : 0));
+}
+
+// Scales a value by the ratio numerator/denominator (truncated)
+template <typename T = uint32_t>
+constexpr T ScaleRatio(T value, T numerator, T denominator)
+{
+  return (T)((value * numerator) / denominator);
+}
+
+
+//===============================================================
+// Mixture share conversions
+//===============================================================
+
+// Returns the share of an angle distance in degrees (0-360°)
+constexpr MixtureShare DegreesToShare(int16_t distance_Degrees)
+{
+  return (MixtureShare)(distance_Degrees * SHARE_PER_DEGREE);
+}
+
+// Returns the share in percent (0-100%), rounded like the former dtostrf output (e.g. 2.5% -> 2%)
+constexpr uint32_t ShareToPercent(MixtureShare share)
+{
+  return RescaleRoundedEven<SHARE_FULLSCALE, 100>((uint32_t)share);
+}
+
+// Returns the share in hundredths of a percent (0-10000), rounded
+constexpr uint32_t ShareToCentiPercent(MixtureShare share)
+{
+  return RescaleRounded<SHARE_FULLSCALE, 10000>((uint32_t)share);
+}
+
+// Returns the share in per-mille (0-1000), rounded
+constexpr uint32_t ShareToPermille(MixtureShare share)
+{
+  return RescaleRounded<SHARE_FULLSCALE, 1000>((uint32_t)share);
+}
+
+
+//===============================================================
+// Declarations
+//===============================================================
+
+// Formats a fixed point value (value in 1/10^decimalPlaces units) like dtostrf(value, mainPlaces, decimalPlaces)
+String FormatFixedPoint(uint32_t value, int mainPlaces, int decimalPlaces);
+
+// Scales a value by the ratio of two shares (rounded, at most 1 above the former truncated double math)
+uint32_t ScaleShareRatio(uint32_t value, uint32_t numerator_Share, uint32_t denominator_Share);
+
+
+#endif
@@ -0,0 +1,811 @@
+/**
+ * Includes all fleet controller functions
+ *
+ * @author    Florian Staeblein
+ * @date      2024/01/28
+ * @copyright © 2024 Florian Staeblein
+ */
+
+#include "FleetController.h"
+#include "StateMachine.h"
+#include "PumpDriver.h"
+#include "FlowMeterDriver.h"
+
+#if defined(WIFI_MIXER)
+
+//===============================================================
+// Global variables
+//===============================================================
+FleetController Fleet;
+
+// Fleet transport of the joined network
+static FleetTransportUDP fleetTransportUDP;
+
+// Status of this mixer
+static FleetMixerLocal fleetMixerLocal;
+
+//===============================================================
+// Returns a field of a '|' separated protocol message
+//===============================================================
+static String GetMessageField(const String& message, uint8_t fieldIndex)
+{
+  int start = 0;
+  for (uint8_t index = 0; index < fieldIndex; index++)
+  {
+    start = message.indexOf('|', start);
+    if (start < 0)
+    {
+      return "";
+    }
+    start++;
+  }
+
+  int end = message.indexOf('|', start);
+  return (end < 0) ? message.substring(start) : message.substring(start, end);
+}
+
+//===============================================================
+// Returns a hexadecimal message field as device or order ID
+//===============================================================
+static uint32_t GetMessageId(const String& message, uint8_t fieldIndex)
+{
+  return (uint32_t)strtoul(GetMessageField(message, fieldIndex).c_str(), NULL, 16);
+}
+
+//===============================================================
+// Returns the device ID of this device (lower 32 bits of the MAC)
+//===============================================================
+static uint32_t GetLocalId()
+{
+  return (uint32_t)ESP.getEfuseMac();
+}
+
+//===============================================================
+// Starts the UDP multicast transport
+//===============================================================
+bool FleetTransportUDP::Begin()
+{
+  _isStarted = _udp.beginMulticast(IPAddress(FLEET_MULTICAST_IP), FLEET_PORT);
+  return _isStarted;
+}
+
+//===============================================================
+// Stops the UDP multicast transport
+//===============================================================
+void FleetTransportUDP::End()
+{
+  if (_isStarted)
+  {
+    _udp.stop();
+    _isStarted = false;
+  }
+}
+
+//===============================================================
+// Sends a message to the multicast group
+//===============================================================
+void FleetTransportUDP::Send(const String& message)
+{
+  if (!_isStarted)
+  {
+    return;
+  }
+
+  _udp.beginMulticastPacket();
+  _udp.write((const uint8_t*)message.c_str(), message.length());
+  _udp.endPacket();
+}
+
+//===============================================================
+// Returns true and the next received message, if available
+//===============================================================
+bool FleetTransportUDP::Receive(String& message)
+{
+  if (!_isStarted || _udp.parsePacket() <= 0)
+  {
+    return false;
+  }
+
+  char buffer[FLEET_MESSAGE_MAX_LENGTH + 1];
+  int length = _udp.read((uint8_t*)buffer, FLEET_MESSAGE_MAX_LENGTH);
+  buffer[max(length, 0)] = '\0';
+  message = buffer;
+  return length > 0;
+}
+
+//===============================================================
+// Returns the name of the current mixer state
+//===============================================================
+String FleetMixerLocal::GetStateName()
+{
+  return Statemachine.GetCurrentStateName();
+}
+
+//===============================================================
+// Returns true, if the mixer is ready for dispensing (dashboard
+// or screen saver)
+//===============================================================
+bool FleetMixerLocal::IsAvailable()
+{
+  MixerState state = Statemachine.GetCurrentState();
+  return state == eDashboard || state == eScreenSaver;
+}
+
+//===============================================================
+// Returns true, while the pumps are enabled
+//===============================================================
+bool FleetMixerLocal::IsDispensing()
+{
+  return Pumps.IsEnabled();
+}
+
+//===============================================================
+// Returns the offered liquids and the offered liquids with a low
+// fill level. Cocktail mixers offer the mixture and every liquid,
+// the wine bar offers its bar stock. Empty bottles are not
+// offered, the mixture only if every bottle covers its share of a
+// glass.
+//===============================================================
+void FleetMixerLocal::GetLiquids(String& liquids, String& lowLiquids)
+{
+  liquids = "";
+  lowLiquids = "";
+
+  bool isMixtureLow = false;
+  for (uint8_t index = 0; index < LiquidCount; index++)
+  {
+    String name = LiquidTable[index].Name;
+    if (ProductPolicy::HasBarStock)
+    {
+      BarBottle barBottle = Statemachine.GetBarBottle((MixtureLiquid)index);
+      if (barBottle == eEmpty)
+      {
+        continue;
+      }
+      name = BarBottleNames[barBottle];
+    }
+
+    // The shares of the mixture are unknown here -> every low bottle counts
+    LevelStatus status = FlowMeter.GetLevelStatus(index);
+    isMixtureLow |= (status == eLevelLow || status == eLevelEmpty);
+    if (status == eLevelEmpty)
+    {
+      continue;
+    }
+
+    liquids += (liquids.length() > 0 ? "," : "") + name;
+    if (status == eLevelLow)
+    {
+      lowLiquids += (lowLiquids.length() > 0 ? "," : "") + name;
+    }
+  }
+
+  if (!ProductPolicy::HasBarStock && Pumps.GetRefusedLiquid() >= LiquidCount)
+  {
+    liquids = MIXER_NAME + String(liquids.length() > 0 ? "," : "") + liquids;
+    if (isMixtureLow)
+    {
+      lowLiquids = MIXER_NAME + String(lowLiquids.length() > 0 ? "," : "") + lowLiquids;
+    }
+  }
+}
+
+//===============================================================
+// Returns the dispensed ml per liquid as comma separated list
+//===============================================================
+String FleetMixerLocal::GetDispensed()
+{
+  String dispensed;
+  for (uint8_t index = 0; index < LiquidCount; index++)
+  {
+    dispensed += (index > 0 ? "," : "") + String(FlowMeter.GetValue(index));
+  }
+  return dispensed;
+}
+
+//===============================================================
+// Constructor
+//===============================================================
+FleetController::FleetController()
+{
+  _transport = &fleetTransportUDP;
+  _mixer = &fleetMixerLocal;
+}
+
+//===============================================================
+// Replaces the transport (e.g. by a loopback)
+//===============================================================
+void FleetController::SetTransport(FleetTransport* transport)
+{
+  _transport = transport;
+}
+
+//===============================================================
+// Replaces the status of this device (e.g. by a simulated mixer)
+//===============================================================
+void FleetController::SetMixer(FleetMixer* mixer)
+{
+  _mixer = mixer;
+}
+
+//===============================================================
+// Starts the fleet protocol
+//===============================================================
+void FleetController::Begin(const String& ip)
+{
+  End();
+
+  if (!_mutex)
+  {
+    _mutex = xSemaphoreCreateMutex();
+  }
+
+  // This device is always the first device of the fleet
+  _devices[0] = FleetDevice();
+  _devices[0].Id = GetLocalId();
+  _devices[0].Name = MIXER_NAME;
+  _devices[0].IP = ip;
+  _deviceCount = 1;
+  UpdateLocalDevice();
+
+  _isStarted = _transport->Begin();
+  _lastHeartbeat_ms = millis() - FLEET_HEARTBEAT_MS;
+  Serial.println("[FLEET] Started as " + String(_devices[0].Id, HEX) + (_isStarted ? "" : " (transport failed)"));
+}
+
+//===============================================================
+// Stops the fleet protocol
+//===============================================================
+void FleetController::End()
+{
+  if (!_isStarted)
+  {
+    return;
+  }
+
+  _transport->End();
+  _isStarted = false;
+  _deviceCount = 1;
+}
+
+//===============================================================
+// Sends heartbeats, handles messages and supervises the orders
+//===============================================================
+void FleetController::Update()
+{
+  if (!_isStarted)
+  {
+    return;
+  }
+
+  UpdateLocalDevice();
+
+  // Handle all received messages
+  String message;
+  while (_transport->Receive(message))
+  {
+    HandleMessage(message);
+  }
+
+  RemoveLostDevices();
+
+  // Take over new order requests from the web server task
+  xSemaphoreTake(_mutex, portMAX_DELAY);
+  for (uint8_t index = 0; index < _requestedCount; index++)
+  {
+    if (_originOrderCount >= FLEET_ORDER_QUEUE_SIZE)
+    {
+      _ordersRejected++;
+      continue;
+    }
+
+    FleetOrder& order = _originOrders[_originOrderCount++];
+    order.Id = (_devices[0].Id << 16) | ++_orderSequence;
+    order.OriginId = _devices[0].Id;
+    order.TargetId = 0;
+    order.Liquid = _requestedLiquids[index];
+    order.Created_ms = millis();
+    order.Sent_ms = 0;
+  }
+  _requestedCount = 0;
+  xSemaphoreGive(_mutex);
+
+  SendOrderRequests();
+  CompleteLocalOrder();
+
+  // Send own status every second
+  if ((millis() - _lastHeartbeat_ms) >= FLEET_HEARTBEAT_MS)
+  {
+    _lastHeartbeat_ms = millis();
+    SendHeartbeat();
+    UpdateFleetJson();
+  }
+}
+
+//===============================================================
+// Adds the fleet URL handlers to a web server
+//===============================================================
+void FleetController::AddWebHandlers(AsyncWebServer* webserver)
+{
+  // Add fleet status URL handler to web server
+  webserver->on("/fleet", HTTP_GET, [](AsyncWebServerRequest * request)
+  {
+    request->send(200, "application/json", Fleet.GetFleetJson());
+  });
+
+  // Add order URL handler to web server (form parameter 'liquid')
+  webserver->on("/order", HTTP_POST, [](AsyncWebServerRequest * request)
+  {
+    String liquid = request->hasParam("liquid", true) ? request->getParam("liquid", true)->value() : String("");
+
+    if (Fleet.RequestOrder(liquid))
+    {
+      request->send(200, "text/plain", "Order accepted!");
+    }
+    else
+    {
+      request->send(400, "text/plain", "Invalid order!");
+    }
+  });
+}
+
+//===============================================================
+// Requests an order for a liquid (thread safe)
+//===============================================================
+bool FleetController::RequestOrder(const String& liquid)
+{
+  // Separators are not allowed in liquid names
+  if (!_isStarted || !_mutex ||
+    liquid.length() == 0 || liquid.length() > FLEET_NAME_MAX_LENGTH ||
+    liquid.indexOf('|') >= 0 || liquid.indexOf(',') >= 0)
+  {
+    return false;
+  }
+
+  xSemaphoreTake(_mutex, portMAX_DELAY);
+  bool isAccepted = _requestedCount < FLEET_ORDER_QUEUE_SIZE;
+  if (isAccepted)
+  {
+    _requestedLiquids[_requestedCount++] = liquid;
+  }
+  xSemaphoreGive(_mutex);
+
+  return isAccepted;
+}
+
+//===============================================================
+// Returns the ID of the current coordinator (lowest device ID)
+//===============================================================
+uint32_t FleetController::GetCoordinatorId()
+{
+  uint32_t coordinatorId = _devices[0].Id;
+  for (uint8_t index = 1; index < _deviceCount; index++)
+  {
+    coordinatorId = min(coordinatorId, _devices[index].Id);
+  }
+  return coordinatorId;
+}
+
+//===============================================================
+// Returns the count of open orders dispensed by this device
+//===============================================================
+uint8_t FleetController::GetLocalOrderCount()
+{
+  return _localOrderCount;
+}
+
+//===============================================================
+// Returns the fleet status and the orders as JSON
+//===============================================================
+String FleetController::GetFleetJson()
+{
+  if (!_mutex)
+  {
+    return "{\"coordinator\":\"\",\"devices\":[],\"orders\":[]}";
+  }
+
+  xSemaphoreTake(_mutex, portMAX_DELAY);
+  String json = _fleetJson;
+  xSemaphoreGive(_mutex);
+  return json;
+}
+
+//===============================================================
+// Returns order latencies and load balance as string
+//===============================================================
+String FleetController::GetFleetString()
+{
+  String returnString = "Fleet: " + String(_deviceCount) + " devices, Coordinator: " + String(GetCoordinatorId(), HEX) +
+    ", Orders: " + String(_ordersCompleted) + " done, " + String(_ordersRejected) + " rejected, " + String(_originOrderCount) + " open" +
+    ", Route: " + String(_ordersRouted > 0 ? _routeLatencySum_ms / _ordersRouted : 0) + "ms avg, " + String(_routeLatencyMax_ms) + "ms max" +
+    ", Complete: " + String(_ordersCompleted > 0 ? _completeLatencySum_ms / _ordersCompleted : 0) + "ms avg, " + String(_completeLatencyMax_ms) + "ms max" +
+    ", Assigned:";
+
+  for (uint8_t index = 0; index < _deviceCount; index++)
+  {
+    returnString += " " + String(_devices[index].Id, HEX) + "=" + String(_devices[index].Assigned);
+  }
+  return returnString;
+}
+
+//===============================================================
+// Returns the index of the least busy available device offering
+// the liquid (equal load -> lowest device ID). Devices with a low
+// fill level of the liquid are only selected, if no other device
+// offers it.
+//===============================================================
+int8_t FleetController::SelectDevice(const FleetDevice devices[], uint8_t deviceCount, const String& liquid)
+{
+  int8_t selectedIndex = -1;
+  bool isSelectedLow = false;
+  String searchString = "," + liquid + ",";
+
+  for (uint8_t index = 0; index < deviceCount; index++)
+  {
+    const FleetDevice& device = devices[index];
+    if (!device.IsAvailable || ("," + device.Liquids + ",").indexOf(searchString) < 0)
+    {
+      continue;
+    }
+
+    bool isLow = ("," + device.LowLiquids + ",").indexOf(searchString) >= 0;
+    if (selectedIndex < 0 || (isSelectedLow && !isLow) ||
+      (isSelectedLow == isLow && device.Load < devices[selectedIndex].Load) ||
+      (isSelectedLow == isLow && device.Load == devices[selectedIndex].Load && device.Id < devices[selectedIndex].Id))
+    {
+      selectedIndex = index;
+      isSelectedLow = isLow;
+    }
+  }
+
+  return selectedIndex;
+}
+
+//===============================================================
+// Updates the status of this device
+//===============================================================
+void FleetController::UpdateLocalDevice()
+{
+  FleetDevice& device = _devices[0];
+  device.State = _mixer->GetStateName();
+  device.IsAvailable = _mixer->IsAvailable();
+  device.Load = _localOrderCount + (_mixer->IsDispensing() ? 1 : 0);
+  device.LastSeen_ms = millis();
+  _mixer->GetLiquids(device.Liquids, device.LowLiquids);
+  device.Dispensed = _mixer->GetDispensed();
+}
+
+//===============================================================
+// Sends the status of this device
+// Format: HB|sender|name|ip|state|load|available|liquids|dispensed|low
+//===============================================================
+void FleetController::SendHeartbeat()
+{
+  const FleetDevice& device = _devices[0];
+  _transport->Send("HB|" + String(device.Id, HEX) + "|" + device.Name + "|" + device.IP + "|" + device.State + "|" +
+    String(device.Load) + "|" + String(device.IsAvailable ? 1 : 0) + "|" + device.Liquids + "|" + device.Dispensed + "|" + device.LowLiquids);
+}
+
+//===============================================================
+// Handles a received protocol message
+//===============================================================
+void FleetController::HandleMessage(const String& message)
+{
+  String type = GetMessageField(message, 0);
+  uint32_t senderId = GetMessageId(message, 1);
+
+  // Own messages are already applied when sent
+  if (senderId == 0 || senderId == _devices[0].Id)
+  {
+    return;
+  }
+
+  if (type == "HB")
+  {
+    // Add unknown devices (fleet full -> ignore device)
+    int8_t deviceIndex = FindDevice(senderId);
+    if (deviceIndex < 0)
+    {
+      if (_deviceCount >= FLEET_MAX_DEVICES)
+      {
+        return;
+      }
+      deviceIndex = _deviceCount++;
+      _devices[deviceIndex] = FleetDevice();
+      _devices[deviceIndex].Id = senderId;
+      Serial.println("[FLEET] Device " + String(senderId, HEX) + " joined");
+    }
+
+    FleetDevice& device = _devices[deviceIndex];
+    device.Name = GetMessageField(message, 2);
+    device.IP = GetMessageField(message, 3);
+    device.State = GetMessageField(message, 4);
+    device.Load = (uint8_t)GetMessageField(message, 5).toInt();
+    device.IsAvailable = GetMessageField(message, 6).toInt() != 0;
+    device.Liquids = GetMessageField(message, 7);
+    device.Dispensed = GetMessageField(message, 8);
+    device.LowLiquids = GetMessageField(message, 9);
+    device.LastSeen_ms = millis();
+  }
+  else if (type == "ORDER" && GetCoordinatorId() == _devices[0].Id)
+  {
+    // Format: ORDER|sender|order|origin|liquid
+    FleetOrder order;
+    order.Id = GetMessageId(message, 2);
+    order.OriginId = GetMessageId(message, 3);
+    order.TargetId = 0;
+    order.Liquid = GetMessageField(message, 4);
+    RouteOrder(order);
+  }
+  else if (type == "ASSIGN")
+  {
+    // Format: ASSIGN|sender|order|origin|target|liquid
+    ApplyAssignment(GetMessageId(message, 2), GetMessageId(message, 3), GetMessageId(message, 4), GetMessageField(message, 5));
+  }
+  else if (type == "DONE")
+  {
+    // Format: DONE|sender|order|origin
+    ApplyCompletion(GetMessageId(message, 2), GetMessageId(message, 3));
+  }
+}
+
+//===============================================================
+// Removes devices with missing heartbeats
+//===============================================================
+void FleetController::RemoveLostDevices()
+{
+  for (uint8_t index = 1; index < _deviceCount; )
+  {
+    if ((millis() - _devices[index].LastSeen_ms) <= FLEET_PEER_TIMEOUT_MS)
+    {
+      index++;
+      continue;
+    }
+
+    uint32_t lostId = _devices[index].Id;
+    Serial.println("[FLEET] Device " + String(lostId, HEX) + " lost");
+
+    // Route the orders of the lost device again
+    for (uint8_t orderIndex = 0; orderIndex < _originOrderCount; orderIndex++)
+    {
+      if (_originOrders[orderIndex].TargetId == lostId)
+      {
+        _originOrders[orderIndex].TargetId = 0;
+        _originOrders[orderIndex].Sent_ms = 0;
+      }
+    }
+
+    _devices[index] = _devices[--_deviceCount];
+  }
+}
+
+//===============================================================
+// Routes an order as coordinator and announces the assignment
+//===============================================================
+void FleetController::RouteOrder(FleetOrder& order)
+{
+  uint32_t targetId = 0;
+
+  // Repeated request -> repeat the assignment
+  for (uint8_t index = 0; index < FLEET_ORDER_QUEUE_SIZE; index++)
+  {
+    if (_routedOrderIds[index] == order.Id)
+    {
+      targetId = _routedTargetIds[index];
+      break;
+    }
+  }
+
+  if (targetId == 0)
+  {
+    int8_t deviceIndex = SelectDevice(_devices, _deviceCount, order.Liquid);
+    if (deviceIndex >= 0)
+    {
+      // Count the order until the next heartbeat of the device
+      targetId = _devices[deviceIndex].Id;
+      _devices[deviceIndex].Load++;
+      _devices[deviceIndex].Assigned++;
+
+      _routedOrderIds[_routedIndex] = order.Id;
+      _routedTargetIds[_routedIndex] = targetId;
+      _routedIndex = (_routedIndex + 1) % FLEET_ORDER_QUEUE_SIZE;
+    }
+  }
+
+  // Target ID 0 -> no device offers the liquid
+  _transport->Send("ASSIGN|" + String(_devices[0].Id, HEX) + "|" + String(order.Id, HEX) + "|" + String(order.OriginId, HEX) + "|" + String(targetId, HEX) + "|" + order.Liquid);
+  ApplyAssignment(order.Id, order.OriginId, targetId, order.Liquid);
+}
+
+//===============================================================
+// Sends routing requests for unassigned orders
+//===============================================================
+void FleetController::SendOrderRequests()
+{
+  bool isCoordinator = GetCoordinatorId() == _devices[0].Id;
+
+  for (uint8_t index = 0; index < _originOrderCount; index++)
+  {
+    FleetOrder& order = _originOrders[index];
+    if (order.TargetId != 0 ||
+      (order.Sent_ms != 0 && (millis() - order.Sent_ms) < FLEET_ORDER_RETRY_MS))
+    {
+      continue;
+    }
+
+    order.Sent_ms = max((uint32_t)1, millis());
+    if (isCoordinator)
+    {
+      // May remove the order (no device offers the liquid)
+      FleetOrder requestedOrder = order;
+      RouteOrder(requestedOrder);
+      return;
+    }
+
+    _transport->Send("ORDER|" + String(_devices[0].Id, HEX) + "|" + String(order.Id, HEX) + "|" + String(order.OriginId, HEX) + "|" + order.Liquid);
+  }
+}
+
+//===============================================================
+// Applies an assignment
+//===============================================================
+void FleetController::ApplyAssignment(uint32_t orderId, uint32_t originId, uint32_t targetId, const String& liquid)
+{
+  // Queue the order, if this device dispenses it
+  if (targetId == _devices[0].Id)
+  {
+    bool isQueued = false;
+    for (uint8_t index = 0; index < _localOrderCount; index++)
+    {
+      isQueued |= _localOrders[index].Id == orderId;
+    }
+
+    if (!isQueued && _localOrderCount < FLEET_ORDER_QUEUE_SIZE)
+    {
+      FleetOrder& order = _localOrders[_localOrderCount++];
+      order.Id = orderId;
+      order.OriginId = originId;
+      order.TargetId = targetId;
+      order.Liquid = liquid;
+      order.Created_ms = millis();
+      order.Sent_ms = 0;
+      Serial.println("[FLEET] Order " + String(orderId, HEX) + ": " + liquid);
+    }
+  }
+
+  // Update the order, if this device received it
+  int8_t orderIndex = FindOriginOrder(orderId);
+  if (originId != _devices[0].Id || orderIndex < 0 || _originOrders[orderIndex].TargetId != 0)
+  {
+    return;
+  }
+
+  FleetOrder& order = _originOrders[orderIndex];
+  if (targetId == 0)
+  {
+    // No device offers the liquid
+    _ordersRejected++;
+    _originOrders[orderIndex] = _originOrders[--_originOrderCount];
+    return;
+  }
+
+  uint32_t latency_ms = millis() - order.Created_ms;
+  order.TargetId = targetId;
+  _ordersRouted++;
+  _routeLatencySum_ms += latency_ms;
+  _routeLatencyMax_ms = max(_routeLatencyMax_ms, latency_ms);
+}
+
+//===============================================================
+// Applies a completion
+//===============================================================
+void FleetController::ApplyCompletion(uint32_t orderId, uint32_t originId)
+{
+  int8_t orderIndex = FindOriginOrder(orderId);
+  if (originId != _devices[0].Id || orderIndex < 0)
+  {
+    return;
+  }
+
+  uint32_t latency_ms = millis() - _originOrders[orderIndex].Created_ms;
+  _ordersCompleted++;
+  _completeLatencySum_ms += latency_ms;
+  _completeLatencyMax_ms = max(_completeLatencyMax_ms, latency_ms);
+
+  // Keep the order of the remaining orders
+  for (uint8_t index = orderIndex; index + 1 < _originOrderCount; index++)
+  {
+    _originOrders[index] = _originOrders[index + 1];
+  }
+  _originOrderCount--;
+}
+
+//===============================================================
+// Completes the first local order after a finished dispensing
+//===============================================================
+void FleetController::CompleteLocalOrder()
+{
+  bool isDispensing = _mixer->IsDispensing();
+  bool isFinished = _wasDispensing && !isDispensing;
+  _wasDispensing = isDispensing;
+
+  if (!isFinished || _localOrderCount == 0)
+  {
+    return;
+  }
+
+  FleetOrder order = _localOrders[0];
+  for (uint8_t index = 0; index + 1 < _localOrderCount; index++)
+  {
+    _localOrders[index] = _localOrders[index + 1];
+  }
+  _localOrderCount--;
+
+  _transport->Send("DONE|" + String(_devices[0].Id, HEX) + "|" + String(order.Id, HEX) + "|" + String(order.OriginId, HEX));
+  ApplyCompletion(order.Id, order.OriginId);
+}
+
+//===============================================================
+// Rebuilds the fleet status JSON for the web server task
+//===============================================================
+void FleetController::UpdateFleetJson()
+{
+  String json = "{\"coordinator\":\"" + String(GetCoordinatorId(), HEX) + "\",\"devices\":[";
+  for (uint8_t index = 0; index < _deviceCount; index++)
+  {
+    const FleetDevice& device = _devices[index];
+    json += String(index > 0 ? "," : "") + "{\"id\":\"" + String(device.Id, HEX) +
+      "\",\"name\":\"" + device.Name +
+      "\",\"ip\":\"" + device.IP +
+      "\",\"state\":\"" + device.State +
+      "\",\"load\":" + String(device.Load) +
+      ",\"available\":" + (device.IsAvailable ? "true" : "false") +
+      ",\"liquids\":\"" + device.Liquids +
+      "\",\"low\":\"" + device.LowLiquids +
+      "\",\"dispensed\":\"" + device.Dispensed +
+      "\",\"assigned\":" + String(device.Assigned) + "}";
+  }
+
+  json += "],\"orders\":[";
+  for (uint8_t index = 0; index < _localOrderCount; index++)
+  {
+    json += String(index > 0 ? "," : "") + "{\"id\":\"" + String(_localOrders[index].Id, HEX) + "\",\"liquid\":\"" + _localOrders[index].Liquid + "\"}";
+  }
+  json += "]}";
+
+  xSemaphoreTake(_mutex, portMAX_DELAY);
+  _fleetJson = json;
+  xSemaphoreGive(_mutex);
+}
+
+//===============================================================
+// Returns the index of a device
+//===============================================================
+int8_t FleetController::FindDevice(uint32_t id)
+{
+  for (uint8_t index = 0; index < _deviceCount; index++)
+  {
+    if (_devices[index].Id == id)
+    {
+      return index;
+    }
+  }
+  return -1;
+}
+
+//===============================================================
+// Returns the index of an origin order
+//===============================================================
+int8_t FleetController::FindOriginOrder(uint32_t id)
+{
+  for (uint8_t index = 0; index < _originOrderCount; index++)
+  {
+    if (_originOrders[index].Id == id)
+    {
+      return index;
+    }
+  }
+  return -1;
+}
+
+#endif
@@ -0,0 +1,274 @@
+/**
+ * Includes all fleet controller functions
+ *
+ * @author    Florian Staeblein
+ * @date      2024/01/28
+ * @copyright © 2024 Florian Staeblein
+ */
+
+#ifndef FLEETCONTROLLER_H
+#define FLEETCONTROLLER_H
+
+//===============================================================
+// Includes
+//===============================================================
+#include <Arduino.h>
+#include <WiFi.h>
+#include <WiFiUdp.h>
+#include <ESPAsyncWebServer.h>
+#include "Config.h"
+
+#if defined(WIFI_MIXER)
+
+//===============================================================
+// Defines
+//===============================================================
+#define FLEET_MULTICAST_IP          239, 255, 77, 77  // Multicast group of all mixers in a network
+#define FLEET_PORT                  47777             // UDP port of the fleet protocol
+#define FLEET_MAX_DEVICES           8                 // Maximum devices in a fleet (including this device)
+#define FLEET_ORDER_QUEUE_SIZE      8                 // Maximum open orders per device
+#define FLEET_HEARTBEAT_MS          1000              // Send own status every second
+#define FLEET_PEER_TIMEOUT_MS       3500              // Remove a device after 3 missing heartbeats
+#define FLEET_ORDER_RETRY_MS        2000              // Resend an unassigned order to the (new) coordinator
+#define FLEET_MESSAGE_MAX_LENGTH    256               // Maximum length of a protocol message
+#define FLEET_NAME_MAX_LENGTH       24                // Maximum length of an ordered liquid name
+
+
+//===============================================================
+// Interface for fleet transports. Every message is delivered to
+// all devices of the fleet (including the sender is allowed).
+//===============================================================
+class FleetTransport
+{
+  public:
+    // Starts the transport
+    virtual bool Begin() = 0;
+
+    // Stops the transport
+    virtual void End() = 0;
+
+    // Sends a message to all devices
+    virtual void Send(const String& message) = 0;
+
+    // Returns true and the next received message, if available
+    virtual bool Receive(String& message) = 0;
+};
+
+//===============================================================
+// Fleet transport using UDP multicast in the joined network
+//===============================================================
+class FleetTransportUDP : public FleetTransport
+{
+  public:
+    bool Begin() override;
+    void End() override;
+    void Send(const String& message) override;
+    bool Receive(String& message) override;
+
+  private:
+    WiFiUDP _udp;
+    bool _isStarted = false;
+};
+
+//===============================================================
+// Interface for the status of this device (the mixer itself or a
+// simulated mixer)
+//===============================================================
+class FleetMixer
+{
+  public:
+    // Returns the name of the current mixer state
+    virtual String GetStateName() = 0;
+
+    // Returns true, if the mixer is ready for dispensing
+    virtual bool IsAvailable() = 0;
+
+    // Returns true, while the mixer is dispensing
+    virtual bool IsDispensing() = 0;
+
+    // Returns the offered liquids and the offered liquids with a low fill level as comma separated lists
+    virtual void GetLiquids(String& liquids, String& lowLiquids) = 0;
+
+    // Returns the dispensed ml per liquid as comma separated list
+    virtual String GetDispensed() = 0;
+};
+
+//===============================================================
+// Status of this mixer (state machine, pumps and flow meter)
+//===============================================================
+class FleetMixerLocal : public FleetMixer
+{
+  public:
+    String GetStateName() override;
+    bool IsAvailable() override;
+    bool IsDispensing() override;
+    void GetLiquids(String& liquids, String& lowLiquids) override;
+    String GetDispensed() override;
+};
+
+//===============================================================
+// Status of a device in the fleet
+//===============================================================
+struct FleetDevice
+{
+  uint32_t Id;              // Device ID (lower 32 bits of the MAC)
+  String Name;              // Product name, e.g. "APEROLiker"
+  String IP;                // Web interface address
+  String State;             // Current mixer state name
+  String Liquids;           // Offered liquids as comma separated list (empty bottles are not offered)
+  String LowLiquids;        // Offered liquids with a low fill level as comma separated list
+  String Dispensed;         // Dispensed ml per liquid as comma separated list
+  uint8_t Load;             // Open orders plus running dispensing
+  bool IsAvailable;         // Ready for dispensing (dashboard or screen saver)
+  uint32_t LastSeen_ms;     // Timestamp of the last heartbeat
+  uint32_t Assigned;        // Orders assigned by this device as coordinator
+};
+
+//===============================================================
+// Order in the fleet order queue
+//===============================================================
+struct FleetOrder
+{
+  uint32_t Id;              // Order ID (origin device ID + sequence)
+  uint32_t OriginId;        // Device, which received the order
+  uint32_t TargetId;        // Device, which dispenses the order (0 = not assigned)
+  String Liquid;            // Ordered liquid
+  uint32_t Created_ms;      // Timestamp of the order (origin device only)
+  uint32_t Sent_ms;         // Timestamp of the last routing request (origin device only)
+};
+
+
+//===============================================================
+// Class for coordinating several mixers in one network
+//===============================================================
+class FleetController
+{
+  public:
+    // Constructor
+    FleetController();
+
+    // Replaces the transport (e.g. by a loopback), call before Begin()
+    void SetTransport(FleetTransport* transport);
+
+    // Replaces the status of this device (e.g. by a simulated mixer), call before Begin()
+    void SetMixer(FleetMixer* mixer);
+
+    // Starts the fleet protocol (network must be started)
+    void Begin(const String& ip);
+
+    // Stops the fleet protocol
+    void End();
+
+    // Sends heartbeats, handles messages and supervises the orders
+    void Update();
+
+    // Adds the fleet URL handlers to a web server
+    void AddWebHandlers(AsyncWebServer* webserver);
+
+    // Requests an order for a liquid (thread safe, routed in Update())
+    bool RequestOrder(const String& liquid);
+
+    // Returns the ID of the current coordinator
+    uint32_t GetCoordinatorId();
+
+    // Returns the count of open orders dispensed by this device
+    uint8_t GetLocalOrderCount();
+
+    // Returns the fleet status and the orders as JSON
+    String GetFleetJson();
+
+    // Returns order latencies and load balance as string
+    String GetFleetString();
+
+    // Returns the index of the least busy available device offering the liquid, low fill levels last (-1 = none)
+    static int8_t SelectDevice(const FleetDevice devices[], uint8_t deviceCount, const String& liquid);
+
+  private:
+    // Transport variables
+    FleetTransport* _transport;
+    FleetMixer* _mixer;
+    bool _isStarted = false;
+
+    // Devices of the fleet (index 0 is this device)
+    FleetDevice _devices[FLEET_MAX_DEVICES];
+    uint8_t _deviceCount = 0;
+
+    // Orders received by this device (waiting for assignment or completion)
+    FleetOrder _originOrders[FLEET_ORDER_QUEUE_SIZE];
+    uint8_t _originOrderCount = 0;
+    uint16_t _orderSequence = 0;
+
+    // Orders assigned to this device (first entry is dispensed next)
+    FleetOrder _localOrders[FLEET_ORDER_QUEUE_SIZE];
+    uint8_t _localOrderCount = 0;
+
+    // Orders routed by this device as coordinator (answers repeated requests)
+    uint32_t _routedOrderIds[FLEET_ORDER_QUEUE_SIZE] = {};
+    uint32_t _routedTargetIds[FLEET_ORDER_QUEUE_SIZE] = {};
+    uint8_t _routedIndex = 0;
+
+    // Order requests and status for the web server task
+    String _requestedLiquids[FLEET_ORDER_QUEUE_SIZE];
+    uint8_t _requestedCount = 0;
+    String _fleetJson;
+    SemaphoreHandle_t _mutex = NULL;
+
+    // Timer and dispensing variables
+    uint32_t _lastHeartbeat_ms = 0;
+    bool _wasDispensing = false;
+
+    // Order statistics (origin device)
+    uint32_t _ordersCompleted = 0;
+    uint32_t _ordersRejected = 0;
+    uint32_t _routeLatencySum_ms = 0;
+    uint32_t _routeLatencyMax_ms = 0;
+    uint32_t _completeLatencySum_ms = 0;
+    uint32_t _completeLatencyMax_ms = 0;
+    uint32_t _ordersRouted = 0;
+
+    // Updates the status of this device
+    void UpdateLocalDevice();
+
+    // Sends the status of this device
+    void SendHeartbeat();
+
+    // Handles a received protocol message
+    void HandleMessage(const String& message);
+
+    // Removes devices with missing heartbeats
+    void RemoveLostDevices();
+
+    // Routes an order as coordinator and announces the assignment
+    void RouteOrder(FleetOrder& order);
+
+    // Sends routing requests for unassigned orders
+    void SendOrderRequests();
+
+    // Applies an assignment (queues local orders, updates origin orders)
+    void ApplyAssignment(uint32_t orderId, uint32_t originId, uint32_t targetId, const String& liquid);
+
+    // Applies a completion (updates origin orders)
+    void ApplyCompletion(uint32_t orderId, uint32_t originId);
+
+    // Rebuilds the fleet status JSON for the web server task
+    void UpdateFleetJson();
+
+    // Completes the first local order after a finished dispensing
+    void CompleteLocalOrder();
+
+    // Returns the index of a device (-1 = unknown)
+    int8_t FindDevice(uint32_t id);
+
+    // Returns the index of an origin order (-1 = unknown)
+    int8_t FindOriginOrder(uint32_t id);
+};
+
+
+//===============================================================
+// Global variables
+//===============================================================
+extern FleetController Fleet;
+
+
+#endif
+#endif
@@ -7,6 +7,7 @@
  */
  
 #include "FlowMeterDriver.h"
+#include "SettingsStore.h"
 
 //===============================================================
 // Global variables
@@ -21,36 +22,41 @@ FlowMeterDriver::FlowMeterDriver()
 }
 
 //===============================================================
-// Load settings from flash
+// Load values from the settings store
 //===============================================================
 void FlowMeterDriver::Load()
 {
-  if (_preferences.begin(SETTINGS_NAME, true))
+  for (uint8_t index = 0; index < LiquidCount; index++)
   {
-    _valueLiquid1_L = _preferences.getDouble(KEY_FLOW_LIQUID1, 0.0);
-    _valueLiquid2_L = _preferences.getDouble(KEY_FLOW_LIQUID2, 0.0);
-    _valueLiquid3_L = _preferences.getDouble(KEY_FLOW_LIQUID3, 0.0);
-    _preferences.end();
+    uint64_t flowTime_ms = Settings.GetFlowTime(index);
+    _capacities_ml[index] = Settings.GetCapacity(index);
+    uint64_t emptyFlowTime_ms = (_capacities_ml[index] > 0) ? Settings.GetEmptyFlowTime(index) : 0;
+
+    portENTER_CRITICAL(&_mux);
+    _flowTimes_ms[index] = flowTime_ms;
+    _emptyFlowTimes_ms[index] = emptyFlowTime_ms;
+    portEXIT_CRITICAL(&_mux);
+    _rateFlowTimes_ms[index] = flowTime_ms;
   }
 }
 
 //===============================================================
-// Save settings to flash
+// Save values to the settings store
 //===============================================================
 void FlowMeterDriver::Save()
 {
-  if (_preferences.begin(SETTINGS_NAME, false))
+  for (uint8_t index = 0; index < LiquidCount; index++)
   {
-    _preferences.putDouble(KEY_FLOW_LIQUID1, _valueLiquid1_L);
-    _preferences.putDouble(KEY_FLOW_LIQUID2, _valueLiquid2_L);
-    _preferences.putDouble(KEY_FLOW_LIQUID3, _valueLiquid3_L); 
-    _preferences.end();
+    uint64_t flowTime_ms, emptyFlowTime_ms;
+    GetFlowTimes(index, flowTime_ms, emptyFlowTime_ms);
+    Settings.SetFlowMeter(index, flowTime_ms, _capacities_ml[index], emptyFlowTime_ms);
   }
 }
 
 //===============================================================
-// Returns true, if a save call is pending to be executed by the
-// loop task
+// Save values to the settings store and request a commit if
+// async request is pending (lever released, bottle empty or
+// refilled)
 //===============================================================
 void FlowMeterDriver::SaveAsync()
 {
@@ -58,47 +64,254 @@ void FlowMeterDriver::SaveAsync()
   {
     _isSavePending = false;
     Save();
+    Settings.RequestCommit();
   }
 }
 
 //===============================================================
-// Returns current flow meter value for liquid 1
+// Returns current flow meter value of a liquid in ml
 //===============================================================
-double FlowMeterDriver::GetValueLiquid1()
+uint32_t FlowMeterDriver::GetValue(uint8_t liquidIndex)
 {
-  return _valueLiquid1_L;
+  if (liquidIndex >= LiquidCount)
+  {
+    return 0;
+  }
+
+  uint64_t flowTime_ms, emptyFlowTime_ms;
+  GetFlowTimes(liquidIndex, flowTime_ms, emptyFlowTime_ms);
+  return (uint32_t)Rescale<60000, FLOWRATE_ML_PER_MIN, uint64_t>(flowTime_ms);
 }
 
 //===============================================================
-// Returns current flow meter value for liquid 2
+// Adds flow time (@100% pump power) of a liquid to flow meter
 //===============================================================
-double FlowMeterDriver::GetValueLiquid2()
+void FlowMeterDriver::AddFlowTime(uint8_t liquidIndex, uint32_t value_ms)
 {
-  return _valueLiquid2_L;
+  if (liquidIndex < LiquidCount)
+  {
+    portENTER_CRITICAL_ISR(&_mux);
+    _flowTimes_ms[liquidIndex] += value_ms;
+    portEXIT_CRITICAL_ISR(&_mux);
+  }
 }
 
 //===============================================================
-// Returns current flow meter value for liquid 3
+// Returns the flow time and the empty flow time of a liquid
+// (64 bit values can't be read atomically on the 32 bit core)
 //===============================================================
-double FlowMeterDriver::GetValueLiquid3()
+void FlowMeterDriver::GetFlowTimes(uint8_t liquidIndex, uint64_t& flowTime_ms, uint64_t& emptyFlowTime_ms)
 {
-  return _valueLiquid3_L;
+  portENTER_CRITICAL_ISR(&_mux);
+  flowTime_ms = _flowTimes_ms[liquidIndex];
+  emptyFlowTime_ms = _emptyFlowTimes_ms[liquidIndex];
+  portEXIT_CRITICAL_ISR(&_mux);
 }
 
 //===============================================================
-// Adds flow time (@100% pump power) to flow meter
+// Requests a save values from interrupt service routine
 //===============================================================
-void FlowMeterDriver::AddFlowTime(uint32_t valueLiquid1_ms, uint32_t valueLiquid2_ms, uint32_t valueLiquid3_ms)
+void FlowMeterDriver::RequestSaveAsync()
 {
-  _valueLiquid1_L += (double)valueLiquid1_ms * FLOWRATE;
-  _valueLiquid2_L += (double)valueLiquid2_ms * FLOWRATE;
-  _valueLiquid3_L += (double)valueLiquid3_ms * FLOWRATE;
+  _isSavePending = true;
 }
 
 //===============================================================
-// Requests a save values from interrupt service routine
+// Sets a new bottle of a liquid (capacity 0 -> no fill level
+// tracking)
 //===============================================================
-void FlowMeterDriver::RequestSaveAsync()
+void FlowMeterDriver::SetBottle(uint8_t liquidIndex, uint32_t capacity_ml)
 {
-  _isSavePending = true;
+  if (liquidIndex >= LiquidCount)
+  {
+    return;
+  }
+
+  // The bottle is empty after the capacity has flown (@100% pump power)
+  _capacities_ml[liquidIndex] = capacity_ml;
+  portENTER_CRITICAL(&_mux);
+  _emptyFlowTimes_ms[liquidIndex] = (capacity_ml > 0) ? _flowTimes_ms[liquidIndex] + Rescale<FLOWRATE_ML_PER_MIN, 60000, uint64_t>(capacity_ml) : 0;
+  portEXIT_CRITICAL(&_mux);
+  RequestSaveAsync();
+}
+
+//===============================================================
+// Requests a refill with the capacity of the liquid table
+//===============================================================
+void FlowMeterDriver::RequestRefill(uint8_t liquidIndex)
+{
+  if (liquidIndex < LiquidCount)
+  {
+    portENTER_CRITICAL(&_mux);
+    _refillRequests |= (1 << liquidIndex);
+    portEXIT_CRITICAL(&_mux);
+  }
+}
+
+//===============================================================
+// Returns the remaining volume of a bottle in ml
+//===============================================================
+uint32_t FlowMeterDriver::GetRemaining(uint8_t liquidIndex)
+{
+  if (liquidIndex >= LiquidCount)
+  {
+    return 0;
+  }
+
+  uint64_t flowTime_ms, emptyFlowTime_ms;
+  GetFlowTimes(liquidIndex, flowTime_ms, emptyFlowTime_ms);
+  if (emptyFlowTime_ms <= flowTime_ms)
+  {
+    return 0;
+  }
+  return (uint32_t)Rescale<60000, FLOWRATE_ML_PER_MIN, uint64_t>(emptyFlowTime_ms - flowTime_ms);
+}
+
+//===============================================================
+// Returns the bottle capacity of the last refill in ml
+//===============================================================
+uint32_t FlowMeterDriver::GetCapacity(uint8_t liquidIndex)
+{
+  if (liquidIndex >= LiquidCount)
+  {
+    return 0;
+  }
+  return _capacities_ml[liquidIndex];
+}
+
+//===============================================================
+// Returns the consumption rate of a liquid in ml per hour
+//===============================================================
+uint32_t FlowMeterDriver::GetConsumptionRate(uint8_t liquidIndex)
+{
+  if (liquidIndex >= LiquidCount)
+  {
+    return 0;
+  }
+  return _rates_mlph[liquidIndex];
+}
+
+//===============================================================
+// Returns the predicted time to empty in minutes
+//===============================================================
+uint32_t FlowMeterDriver::GetTimeToEmpty(uint8_t liquidIndex)
+{
+  if (liquidIndex >= LiquidCount || _rates_mlph[liquidIndex] == 0)
+  {
+    return LEVEL_TIME_UNKNOWN;
+  }
+  return (uint32_t)((uint64_t)GetRemaining(liquidIndex) * 60 / _rates_mlph[liquidIndex]);
+}
+
+//===============================================================
+// Returns the fill level status of a bottle
+//===============================================================
+LevelStatus FlowMeterDriver::GetLevelStatus(uint8_t liquidIndex)
+{
+  if (liquidIndex >= LiquidCount || _capacities_ml[liquidIndex] == 0)
+  {
+    return eLevelUntracked;
+  }
+
+  uint32_t remaining_ml = GetRemaining(liquidIndex);
+  if (remaining_ml == 0)
+  {
+    return eLevelEmpty;
+  }
+  if (remaining_ml < LEVEL_LOW_ML || GetTimeToEmpty(liquidIndex) < LEVEL_LOW_MINUTES)
+  {
+    return eLevelLow;
+  }
+  return eLevelOk;
+}
+
+//===============================================================
+// Returns true, if a bottle is empty after the pending flow time
+//===============================================================
+bool FlowMeterDriver::IsEmpty(uint8_t liquidIndex, uint32_t pendingFlowTime_ms)
+{
+  if (liquidIndex >= LiquidCount)
+  {
+    return false;
+  }
+
+  uint64_t flowTime_ms, emptyFlowTime_ms;
+  GetFlowTimes(liquidIndex, flowTime_ms, emptyFlowTime_ms);
+  return emptyFlowTime_ms != 0 &&
+    flowTime_ms + pendingFlowTime_ms >= emptyFlowTime_ms;
+}
+
+//===============================================================
+// Applies refills and updates the consumption rates
+//===============================================================
+void FlowMeterDriver::UpdateLevels()
+{
+  // Apply requested refills (taken in the critical section, a request of the web server task is not lost)
+  portENTER_CRITICAL(&_mux);
+  uint8_t refillRequests = _refillRequests;
+  _refillRequests = 0;
+  portEXIT_CRITICAL(&_mux);
+  if (refillRequests != 0)
+  {
+    for (uint8_t index = 0; index < LiquidCount; index++)
+    {
+      if (refillRequests & (1 << index))
+      {
+        SetBottle(index, LiquidTable[index].BottleCapacity_ml);
+      }
+    }
+  }
+
+  // Sample the consumption of the last window
+  uint32_t window_ms = millis() - _rateTimestamp_ms;
+  if (window_ms < LEVEL_RATE_WINDOW_MS)
+  {
+    return;
+  }
+  _rateTimestamp_ms = millis();
+
+  for (uint8_t index = 0; index < LiquidCount; index++)
+  {
+    uint64_t flowTime_ms, emptyFlowTime_ms;
+    GetFlowTimes(index, flowTime_ms, emptyFlowTime_ms);
+    uint64_t consumption_ml = Rescale<60000, FLOWRATE_ML_PER_MIN, uint64_t>(flowTime_ms - _rateFlowTimes_ms[index]);
+    _rateFlowTimes_ms[index] = flowTime_ms;
+
+    // Exponential average of the consumption in ml per hour (rounded step, a truncated step
+    // would stop some ml/h above the sample)
+    int32_t sample_mlph = (int32_t)(consumption_ml * 3600000 / window_ms);
+    int32_t rate_mlph = (int32_t)_rates_mlph[index];
+    int32_t delta_mlph = sample_mlph - rate_mlph;
+    rate_mlph += (delta_mlph + (delta_mlph >= 0 ? LEVEL_RATE_WEIGHT / 2 : -(LEVEL_RATE_WEIGHT / 2))) / LEVEL_RATE_WEIGHT;
+
+    // Without consumption the rounded step ends below the weight -> no consumption
+    if (sample_mlph == 0 && rate_mlph < LEVEL_RATE_WEIGHT)
+    {
+      rate_mlph = 0;
+    }
+    _rates_mlph[index] = (uint32_t)rate_mlph;
+  }
+}
+
+//===============================================================
+// Returns the fill levels as string
+//===============================================================
+String FlowMeterDriver::GetLevelString()
+{
+  String returnString = "Levels: ";
+  for (uint8_t index = 0; index < LiquidCount; index++)
+  {
+    returnString += String(index > 0 ? ", " : "") + LiquidTable[index].Name + ": ";
+    if (GetLevelStatus(index) == eLevelUntracked)
+    {
+      returnString += "untracked";
+      continue;
+    }
+
+    uint32_t timeToEmpty_min = GetTimeToEmpty(index);
+    returnString += String(GetRemaining(index)) + "/" + String(_capacities_ml[index]) + "ml " +
+      String(_rates_mlph[index]) + "ml/h " +
+      (timeToEmpty_min == LEVEL_TIME_UNKNOWN ? String("~?min") : "~" + String(timeToEmpty_min) + "min");
+  }
+  return returnString;
 }
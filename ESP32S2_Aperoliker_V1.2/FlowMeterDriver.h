@@ -13,18 +13,34 @@
 // Includes
 //===============================================================
 #include <Arduino.h>
-#include <Preferences.h>
 #include "Config.h"
+#include "FixedPointHelper.h"
 
 
 //===============================================================
 // Defines
 //===============================================================
-#define FLOWRATE              0.00000416667   // 250 ml/min (pump specification @ 20V) => 5e-6 l/ms
+#define FLOWRATE_ML_PER_MIN   250             // 250 ml/min (pump specification @ 20V)
+#define LEGACY_FLOWRATE       0.00000416667   // 250 ml/min in l/ms, only used to convert old flash values
 
-#define KEY_FLOW_LIQUID1      "FlowLiquid1"   // Key name: Maximum string length is 15 bytes, excluding a zero terminator.
-#define KEY_FLOW_LIQUID2      "FlowLiquid2"   // Key name: Maximum string length is 15 bytes, excluding a zero terminator.
-#define KEY_FLOW_LIQUID3      "FlowLiquid3"   // Key name: Maximum string length is 15 bytes, excluding a zero terminator.
+// Fill level defines
+#define LEVEL_LOW_ML          150             // Low level warning below 150 ml remaining
+#define LEVEL_LOW_MINUTES     15              // Low level warning if the bottle is predicted to be empty within 15 minutes
+#define LEVEL_RATE_WINDOW_MS  60000           // Consumption rate is sampled every minute
+#define LEVEL_RATE_WEIGHT     4               // A new rate sample has a weight of 1/4 in the average
+#define LEVEL_TIME_UNKNOWN    UINT32_MAX      // Time to empty without consumption
+
+
+//===============================================================
+// Enums
+//===============================================================
+enum LevelStatus : uint8_t
+{
+  eLevelUntracked = 0,    // No bottle capacity set
+  eLevelOk = 1,
+  eLevelLow = 2,          // Below LEVEL_LOW_ML or empty within LEVEL_LOW_MINUTES
+  eLevelEmpty = 3,
+};
 
 //===============================================================
 // Class for flow measuring
@@ -35,34 +51,73 @@ class FlowMeterDriver
     // Constructor
     FlowMeterDriver();
     
-    // Load settings from flash
+    // Load values from the settings store
     void Load();
 
-    // Save settings to flash
+    // Save values to the settings store (committed to flash by the store)
     void Save();
 
-    // Save settings to flash if async request is pending
+    // Save values to the settings store and request a commit if async request is pending
     void SaveAsync();
 
-    // Returns current flow meter values
-    double GetValueLiquid1();
-    double GetValueLiquid2();
-    double GetValueLiquid3();
+    // Returns current flow meter value of a liquid in ml
+    uint32_t GetValue(uint8_t liquidIndex);
 
-    // Adds flow time (@100% pump power) to flow meter
-    void IRAM_ATTR AddFlowTime(uint32_t valueLiquid1_ms, uint32_t valueLiquid2_ms, uint32_t valueLiquid3_ms);
+    // Adds flow time (@100% pump power) of a liquid to flow meter
+    void IRAM_ATTR AddFlowTime(uint8_t liquidIndex, uint32_t value_ms);
 
     // Requests a save values from interrupt service routine
     void IRAM_ATTR RequestSaveAsync();
+
+    // Sets a new bottle of a liquid (capacity 0 -> no fill level tracking)
+    void SetBottle(uint8_t liquidIndex, uint32_t capacity_ml);
+
+    // Requests a refill with the capacity of the liquid table (thread safe, applied in UpdateLevels())
+    void RequestRefill(uint8_t liquidIndex);
+
+    // Returns the remaining volume of a bottle in ml
+    uint32_t GetRemaining(uint8_t liquidIndex);
+
+    // Returns the bottle capacity of the last refill in ml
+    uint32_t GetCapacity(uint8_t liquidIndex);
+
+    // Returns the consumption rate of a liquid in ml per hour
+    uint32_t GetConsumptionRate(uint8_t liquidIndex);
+
+    // Returns the predicted time to empty in minutes (LEVEL_TIME_UNKNOWN without consumption)
+    uint32_t GetTimeToEmpty(uint8_t liquidIndex);
+
+    // Returns the fill level status of a bottle
+    LevelStatus GetLevelStatus(uint8_t liquidIndex);
+
+    // Returns true, if a bottle is empty after the pending flow time (allocation free, for the pump update)
+    bool IRAM_ATTR IsEmpty(uint8_t liquidIndex, uint32_t pendingFlowTime_ms);
+
+    // Applies refills and updates the consumption rates, should be called by the loop task
+    void UpdateLevels();
+
+    // Returns the fill levels as string
+    String GetLevelString();
     
   private:
-    // Flow meter variables
-    Preferences _preferences;
-    double _valueLiquid1_L;
-    double _valueLiquid2_L;
-    double _valueLiquid3_L;
+    // Flow meter variables (64 bit values are written by the lever interrupt, access only in the critical section)
+    uint64_t _flowTimes_ms[LiquidCount] = {};
+    portMUX_TYPE _mux = portMUX_INITIALIZER_UNLOCKED;
+
+    // Fill level variables (empty flow time 0 -> no tracking)
+    uint32_t _capacities_ml[LiquidCount] = {};
+    uint64_t _emptyFlowTimes_ms[LiquidCount] = {};
+    volatile uint8_t _refillRequests = 0;           // Requests of the web server task, access only in the critical section
+
+    // Consumption rate variables
+    uint32_t _rates_mlph[LiquidCount] = {};
+    uint64_t _rateFlowTimes_ms[LiquidCount] = {};
+    uint32_t _rateTimestamp_ms = 0;
     
     bool _isSavePending = false;
+
+    // Returns the flow time and the empty flow time of a liquid (consistent 64 bit read)
+    void IRAM_ATTR GetFlowTimes(uint8_t liquidIndex, uint64_t& flowTime_ms, uint64_t& emptyFlowTime_ms);
 };
 
 
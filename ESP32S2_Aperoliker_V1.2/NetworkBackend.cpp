@@ -0,0 +1,137 @@
+/**
+ * Includes network backend functions
+ *
+ * @author    Florian Staeblein
+ * @date      2024/01/28
+ * @copyright © 2024 Florian Staeblein
+ */
+ 
+#include "NetworkBackend.h"
+
+#if defined(WIFI_MIXER)
+
+//===============================================================
+// Starts an access point with fixed IP 192.168.1.1
+//===============================================================
+bool NetworkBackendESP32::StartAccessPoint(const char* ssid, const char* password)
+{
+  IPAddress local_ip(192, 168, 1, 1);
+  IPAddress gateway(192, 168, 1, 1);
+  IPAddress subnet(255, 255, 255, 0);
+
+  // Set wifi TX power
+  WiFi.mode(WIFI_AP);
+  WiFi.setTxPower(WIFI_POWER_19_5dBm);
+
+  // Start access point
+  bool result = WiFi.softAP(ssid, password);
+  WiFi.softAPConfig(local_ip, gateway, subnet);
+  delay(100);
+
+  return result;
+}
+
+//===============================================================
+// Starts joining a network (bssid = NULL and channel = 0 -> full scan)
+//===============================================================
+bool NetworkBackendESP32::StartStation(const char* hostname, const char* ssid, const char* password, const uint8_t* bssid, int32_t channel)
+{
+  WiFi.mode(WIFI_STA);
+  WiFi.setHostname(hostname);
+  WiFi.setTxPower(WIFI_POWER_19_5dBm);
+  WiFi.setAutoReconnect(true);
+
+  // Known BSSID and channel skip the scan of all channels
+  WiFi.disconnect();
+  return WiFi.begin(ssid, password, channel, bssid) != WL_CONNECT_FAILED;
+}
+
+//===============================================================
+// Stops access point and station
+//===============================================================
+void NetworkBackendESP32::Stop()
+{
+  WiFi.softAPdisconnect(true);
+  WiFi.disconnect(true);
+  WiFi.mode(WIFI_OFF);
+}
+
+//===============================================================
+// Returns true, if the station is connected to a network
+//===============================================================
+bool NetworkBackendESP32::IsStationConnected()
+{
+  return WiFi.status() == WL_CONNECTED;
+}
+
+//===============================================================
+// Returns BSSID and channel of the joined network
+//===============================================================
+bool NetworkBackendESP32::GetStationNetwork(uint8_t bssid[NETWORK_BSSID_LENGTH], int32_t& channel)
+{
+  uint8_t* currentBssid = WiFi.BSSID();
+  if (!currentBssid)
+  {
+    return false;
+  }
+
+  memcpy(bssid, currentBssid, NETWORK_BSSID_LENGTH);
+  channel = WiFi.channel();
+  return true;
+}
+
+//===============================================================
+// Returns the local IP address (station or access point)
+//===============================================================
+String NetworkBackendESP32::GetLocalIP()
+{
+  return (WiFi.getMode() == WIFI_AP) ? WiFi.softAPIP().toString() : WiFi.localIP().toString();
+}
+
+//===============================================================
+// Returns the amount of stations connected to the access point
+//===============================================================
+uint16_t NetworkBackendESP32::GetAccessPointStations()
+{
+  return WiFi.softAPgetStationNum();
+}
+
+//===============================================================
+// Starts the mDNS responder with the http service
+//===============================================================
+bool NetworkBackendESP32::StartDiscovery(const char* hostname, uint16_t port)
+{
+  StopDiscovery();
+
+  _discoveryStarted = MDNS.begin(hostname);
+  if (_discoveryStarted)
+  {
+    MDNS.addService("http", "tcp", port);
+  }
+  return _discoveryStarted;
+}
+
+//===============================================================
+// Adds or replaces a TXT record of the http service
+//===============================================================
+void NetworkBackendESP32::SetDiscoveryRecord(const char* key, const String& value)
+{
+  if (_discoveryStarted)
+  {
+    MDNS.addServiceTxt("http", "tcp", key, value.c_str());
+  }
+}
+
+//===============================================================
+// Stops the mDNS responder
+//===============================================================
+void NetworkBackendESP32::StopDiscovery()
+{
+  if (_discoveryStarted)
+  {
+    MDNS.end();
+    _discoveryStarted = false;
+  }
+}
+
+#endif
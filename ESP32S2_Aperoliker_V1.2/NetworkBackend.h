@@ -0,0 +1,91 @@
+/**
+ * Includes all network backend functions
+ *
+ * @author    Florian Staeblein
+ * @date      2024/01/28
+ * @copyright © 2024 Florian Staeblein
+ */
+ 
+#ifndef NETWORKBACKEND_H
+#define NETWORKBACKEND_H
+
+//===============================================================
+// Includes
+//===============================================================
+#include <Arduino.h>
+#include <WiFi.h>
+#include <ESPmDNS.h>
+#include "Config.h"
+
+#if defined(WIFI_MIXER)
+
+//===============================================================
+// Defines
+//===============================================================
+#define NETWORK_BSSID_LENGTH      6       // Length of an access point MAC address
+
+
+//===============================================================
+// Interface for network backends (hardware abstraction). The
+// wifi handler only talks to the radio and the mDNS responder
+// through this interface, so a local stand-in can replace it.
+//===============================================================
+class NetworkBackend
+{
+  public:
+    // Starts an access point with fixed IP 192.168.1.1
+    virtual bool StartAccessPoint(const char* ssid, const char* password) = 0;
+
+    // Starts joining a network (bssid = NULL and channel = 0 -> full scan)
+    virtual bool StartStation(const char* hostname, const char* ssid, const char* password, const uint8_t* bssid, int32_t channel) = 0;
+
+    // Stops access point and station
+    virtual void Stop() = 0;
+
+    // Returns true, if the station is connected to a network
+    virtual bool IsStationConnected() = 0;
+
+    // Returns BSSID and channel of the joined network
+    virtual bool GetStationNetwork(uint8_t bssid[NETWORK_BSSID_LENGTH], int32_t& channel) = 0;
+
+    // Returns the local IP address (station or access point)
+    virtual String GetLocalIP() = 0;
+
+    // Returns the amount of stations connected to the access point
+    virtual uint16_t GetAccessPointStations() = 0;
+
+    // Starts the mDNS responder with the http service
+    virtual bool StartDiscovery(const char* hostname, uint16_t port) = 0;
+
+    // Adds or replaces a TXT record of the http service
+    virtual void SetDiscoveryRecord(const char* key, const String& value) = 0;
+
+    // Stops the mDNS responder
+    virtual void StopDiscovery() = 0;
+};
+
+//===============================================================
+// Network backend using the ESP32 wifi and mDNS libraries
+//===============================================================
+class NetworkBackendESP32 : public NetworkBackend
+{
+  public:
+    bool StartAccessPoint(const char* ssid, const char* password) override;
+    bool StartStation(const char* hostname, const char* ssid, const char* password, const uint8_t* bssid, int32_t channel) override;
+    void Stop() override;
+    bool IsStationConnected() override;
+    bool GetStationNetwork(uint8_t bssid[NETWORK_BSSID_LENGTH], int32_t& channel) override;
+    String GetLocalIP() override;
+    uint16_t GetAccessPointStations() override;
+    bool StartDiscovery(const char* hostname, uint16_t port) override;
+    void SetDiscoveryRecord(const char* key, const String& value) override;
+    void StopDiscovery() override;
+
+  private:
+    // Discovery variables
+    bool _discoveryStarted = false;
+};
+
+
+#endif
+#endif
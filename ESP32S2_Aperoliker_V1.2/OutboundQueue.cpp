@@ -0,0 +1,391 @@
+/**
+ * Includes the outbound message queues of the websocket clients
+ *
+ * @author    Florian Staeblein
+ * @date      2024/01/28
+ * @copyright © 2024 Florian Staeblein
+ */
+
+#include "OutboundQueue.h"
+
+#if defined(WIFI_MIXER)
+
+//===============================================================
+// Constructor
+//===============================================================
+OutboundQueue::OutboundQueue()
+{
+  for (uint8_t index = 0; index < OUTBOUND_MAX_CLIENTS; index++)
+  {
+    _clients[index].ClientID = 0;
+    _clients[index].Topics = 0;
+    _clients[index].Head = 0;
+    _clients[index].Count = 0;
+    _clients[index].Bytes = 0;
+    _clients[index].OverLimit_ms = 0;
+    _clients[index].MixtureVersion = 0;
+  }
+}
+
+//===============================================================
+// Adds a client
+//===============================================================
+void OutboundQueue::AddClient(uint32_t clientID)
+{
+  if (!_mutex)
+  {
+    _mutex = xSemaphoreCreateMutex();
+  }
+
+  xSemaphoreTake(_mutex, portMAX_DELAY);
+  if (!FindClient(clientID))
+  {
+    // Use the first free slot (untracked clients are sent to directly)
+    OutboundClient* client = FindClient(0);
+    if (client)
+    {
+      client->ClientID = clientID;
+      client->Topics = 0;
+      client->Head = 0;
+      client->Count = 0;
+      client->Bytes = 0;
+      client->OverLimit_ms = 0;
+      client->MixtureVersion = 0;
+    }
+  }
+  xSemaphoreGive(_mutex);
+}
+
+//===============================================================
+// Removes a client and its messages
+//===============================================================
+void OutboundQueue::RemoveClient(uint32_t clientID)
+{
+  if (!_mutex || clientID == 0)
+  {
+    return;
+  }
+
+  xSemaphoreTake(_mutex, portMAX_DELAY);
+  OutboundClient* client = FindClient(clientID);
+  if (client)
+  {
+    for (uint8_t index = 0; index < OUTBOUND_MAX_MESSAGES; index++)
+    {
+      client->Messages[index] = String();
+    }
+    client->ClientID = 0;
+    client->Topics = 0;
+    client->Count = 0;
+    client->Bytes = 0;
+    client->OverLimit_ms = 0;
+    client->MixtureVersion = 0;
+  }
+  xSemaphoreGive(_mutex);
+}
+
+//===============================================================
+// Replaces the subscribed push topics of a client
+//===============================================================
+void OutboundQueue::Subscribe(uint32_t clientID, uint8_t topics)
+{
+  if (!_mutex || clientID == 0)
+  {
+    return;
+  }
+
+  xSemaphoreTake(_mutex, portMAX_DELAY);
+  OutboundClient* client = FindClient(clientID);
+  if (client)
+  {
+    client->Topics = topics;
+  }
+  xSemaphoreGive(_mutex);
+}
+
+//===============================================================
+// Returns true, if the client is subscribed to the push topic
+//===============================================================
+bool OutboundQueue::IsSubscribed(uint32_t clientID, uint8_t topic)
+{
+  if (!_mutex || clientID == 0)
+  {
+    return false;
+  }
+
+  xSemaphoreTake(_mutex, portMAX_DELAY);
+  OutboundClient* client = FindClient(clientID);
+  bool isSubscribed = client && (client->Topics & topic);
+  xSemaphoreGive(_mutex);
+
+  return isSubscribed;
+}
+
+//===============================================================
+// Returns true, if the client has no queued messages
+//===============================================================
+bool OutboundQueue::IsEmpty(uint32_t clientID)
+{
+  if (!_mutex)
+  {
+    return true;
+  }
+
+  xSemaphoreTake(_mutex, portMAX_DELAY);
+  OutboundClient* client = FindClient(clientID);
+  bool isEmpty = !client || client->Count == 0;
+  xSemaphoreGive(_mutex);
+
+  return isEmpty;
+}
+
+//===============================================================
+// Queues a message (thread safe)
+//===============================================================
+bool OutboundQueue::Push(uint32_t clientID, const String& text, uint32_t mixtureVersion)
+{
+  if (!_mutex)
+  {
+    return false;
+  }
+
+  xSemaphoreTake(_mutex, portMAX_DELAY);
+  OutboundClient* client = FindClient(clientID);
+  bool isQueued = false;
+  if (client)
+  {
+    // Replace a queued message of the same topic (keeps the position in the queue)
+    bool isTopicQueued = false;
+    for (uint8_t offset = 0; offset < client->Count; offset++)
+    {
+      uint8_t messageIndex = (client->Head + offset) % OUTBOUND_MAX_MESSAGES;
+      String& message = client->Messages[messageIndex];
+      if (IsSameTopic(message, text))
+      {
+        isTopicQueued = true;
+        if (client->Bytes - message.length() + text.length() <= OUTBOUND_MAX_BYTES)
+        {
+          client->Bytes = client->Bytes - message.length() + text.length();
+          message = text;
+          client->MixtureVersions[messageIndex] = mixtureVersion;
+          isQueued = true;
+        }
+        break;
+      }
+    }
+
+    // Append a new topic
+    if (!isTopicQueued &&
+      client->Count < OUTBOUND_MAX_MESSAGES &&
+      client->Bytes + text.length() <= OUTBOUND_MAX_BYTES)
+    {
+      uint8_t messageIndex = (client->Head + client->Count) % OUTBOUND_MAX_MESSAGES;
+      client->Messages[messageIndex] = text;
+      client->MixtureVersions[messageIndex] = mixtureVersion;
+      client->Count++;
+      client->Bytes += text.length();
+      isQueued = true;
+    }
+
+    // Remember the start of the limit violation for the eviction
+    if (!isQueued && client->OverLimit_ms == 0)
+    {
+      client->OverLimit_ms = max(millis(), (uint32_t)1);
+    }
+  }
+  xSemaphoreGive(_mutex);
+
+  return isQueued;
+}
+
+//===============================================================
+// Removes the oldest message of a client and returns it
+//===============================================================
+bool OutboundQueue::Pop(uint32_t clientID, String& text)
+{
+  if (!_mutex)
+  {
+    return false;
+  }
+
+  xSemaphoreTake(_mutex, portMAX_DELAY);
+  OutboundClient* client = FindClient(clientID);
+  bool isAvailable = client && client->Count > 0;
+  if (isAvailable)
+  {
+    String& message = client->Messages[client->Head];
+    text = message;
+    client->Bytes -= message.length();
+    client->MixtureVersion = max(client->MixtureVersion, client->MixtureVersions[client->Head]);
+    message = String();
+    client->Head = (client->Head + 1) % OUTBOUND_MAX_MESSAGES;
+    client->Count--;
+
+    // Client makes progress, the limit supervision starts again
+    client->OverLimit_ms = 0;
+  }
+  xSemaphoreGive(_mutex);
+
+  return isAvailable;
+}
+
+//===============================================================
+// Raises the mixture version of a client
+//===============================================================
+void OutboundQueue::SetMixtureVersion(uint32_t clientID, uint32_t mixtureVersion)
+{
+  if (!_mutex || clientID == 0)
+  {
+    return;
+  }
+
+  xSemaphoreTake(_mutex, portMAX_DELAY);
+  OutboundClient* client = FindClient(clientID);
+  if (client)
+  {
+    client->MixtureVersion = max(client->MixtureVersion, mixtureVersion);
+  }
+  xSemaphoreGive(_mutex);
+}
+
+//===============================================================
+// Returns the mixture version of a client
+//===============================================================
+uint32_t OutboundQueue::GetMixtureVersion(uint32_t clientID)
+{
+  if (!_mutex || clientID == 0)
+  {
+    return 0;
+  }
+
+  xSemaphoreTake(_mutex, portMAX_DELAY);
+  OutboundClient* client = FindClient(clientID);
+  uint32_t mixtureVersion = client ? client->MixtureVersion : 0;
+  xSemaphoreGive(_mutex);
+
+  return mixtureVersion;
+}
+
+//===============================================================
+// Returns the client ID of a queue slot
+//===============================================================
+uint32_t OutboundQueue::GetClientID(uint8_t index)
+{
+  if (index >= OUTBOUND_MAX_CLIENTS)
+  {
+    return 0;
+  }
+
+  return _clients[index].ClientID;
+}
+
+//===============================================================
+// Returns a client, which has to be closed
+//===============================================================
+uint32_t OutboundQueue::GetEvictionCandidate(bool isLowHeap)
+{
+  if (!_mutex)
+  {
+    return 0;
+  }
+
+  xSemaphoreTake(_mutex, portMAX_DELAY);
+  uint32_t candidateID = 0;
+  uint32_t candidateBytes = 0;
+  for (uint8_t index = 0; index < OUTBOUND_MAX_CLIENTS; index++)
+  {
+    const OutboundClient& client = _clients[index];
+    if (client.ClientID == 0)
+    {
+      continue;
+    }
+
+    // Client stays over its limit without taking messages
+    if (client.OverLimit_ms != 0 &&
+      (millis() - client.OverLimit_ms) > OUTBOUND_EVICT_MS)
+    {
+      candidateID = client.ClientID;
+      break;
+    }
+
+    // Low heap: client with the most queued bytes
+    if (isLowHeap && client.Bytes > candidateBytes)
+    {
+      candidateID = client.ClientID;
+      candidateBytes = client.Bytes;
+    }
+  }
+  xSemaphoreGive(_mutex);
+
+  return candidateID;
+}
+
+//===============================================================
+// Returns the queued messages of all clients
+//===============================================================
+uint32_t OutboundQueue::GetQueuedMessages()
+{
+  uint32_t messages = 0;
+  for (uint8_t index = 0; index < OUTBOUND_MAX_CLIENTS; index++)
+  {
+    messages += _clients[index].Count;
+  }
+  return messages;
+}
+
+//===============================================================
+// Returns the queued bytes of all clients
+//===============================================================
+uint32_t OutboundQueue::GetQueuedBytes()
+{
+  uint32_t bytes = 0;
+  for (uint8_t index = 0; index < OUTBOUND_MAX_CLIENTS; index++)
+  {
+    bytes += _clients[index].Bytes;
+  }
+  return bytes;
+}
+
+//===============================================================
+// Returns the maximum queued bytes of one client
+//===============================================================
+uint32_t OutboundQueue::GetMaxClientBytes()
+{
+  uint32_t bytes = 0;
+  for (uint8_t index = 0; index < OUTBOUND_MAX_CLIENTS; index++)
+  {
+    bytes = max(bytes, _clients[index].Bytes);
+  }
+  return bytes;
+}
+
+//===============================================================
+// Returns the client entry of an ID
+//===============================================================
+OutboundClient* OutboundQueue::FindClient(uint32_t clientID)
+{
+  for (uint8_t index = 0; index < OUTBOUND_MAX_CLIENTS; index++)
+  {
+    if (_clients[index].ClientID == clientID)
+    {
+      return &_clients[index];
+    }
+  }
+  return NULL;
+}
+
+//===============================================================
+// Returns true, if both messages have the same topic
+//===============================================================
+bool OutboundQueue::IsSameTopic(const String& text1, const String& text2)
+{
+  int topicLength1 = text1.indexOf(':');
+  int topicLength2 = text2.indexOf(':');
+  topicLength1 = topicLength1 < 0 ? text1.length() : topicLength1;
+  topicLength2 = topicLength2 < 0 ? text2.length() : topicLength2;
+
+  return topicLength1 == topicLength2 &&
+    strncmp(text1.c_str(), text2.c_str(), topicLength1) == 0;
+}
+
+#endif
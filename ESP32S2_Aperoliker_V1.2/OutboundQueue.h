@@ -0,0 +1,110 @@
+/**
+ * Includes the outbound message queues of the websocket clients
+ *
+ * @author    Florian Staeblein
+ * @date      2024/01/28
+ * @copyright © 2024 Florian Staeblein
+ */
+
+#ifndef OUTBOUNDQUEUE_H
+#define OUTBOUNDQUEUE_H
+
+//===============================================================
+// Includes
+//===============================================================
+#include <Arduino.h>
+#include "Config.h"
+
+#if defined(WIFI_MIXER)
+
+//===============================================================
+// Defines
+//===============================================================
+#define OUTBOUND_MAX_CLIENTS        8       // Maximum tracked websocket clients (AsyncWebSocket default)
+#define OUTBOUND_MAX_MESSAGES       12      // Maximum queued messages per client (one per topic)
+#define OUTBOUND_MAX_BYTES          2048    // Maximum queued payload bytes per client
+#define OUTBOUND_EVICT_MS           5000    // Clients over their limit for this time are closed
+#define OUTBOUND_MIN_FREE_HEAP      20000   // Below this free heap the client with the most queued bytes is closed
+
+
+//===============================================================
+// Outbound messages and push topics of one websocket client
+// (ring buffer)
+//===============================================================
+struct OutboundClient
+{
+  uint32_t ClientID;                        // Websocket client ID (0 = unused)
+  uint8_t Topics;                           // Subscribed push topics (bit mask, 0 = none)
+  String Messages[OUTBOUND_MAX_MESSAGES];   // Queued messages, "<topic>:<value>" or plain text
+  uint32_t MixtureVersions[OUTBOUND_MAX_MESSAGES];  // Mixture version of a queued message (0 = no mixture)
+  uint32_t MixtureVersion;                  // Mixture version handed over to the websocket (delivered in order or the connection closes)
+  uint8_t Head;                             // Index of the oldest message
+  uint8_t Count;                            // Count of queued messages
+  uint32_t Bytes;                           // Queued payload bytes
+  uint32_t OverLimit_ms;                    // Timestamp of the first rejected message (0 = within limit)
+};
+
+
+//===============================================================
+// Bounded outbound queues with latest value wins per topic. The
+// topic is the text before the first ':', a queued message of
+// the same topic is replaced by the newer one.
+//===============================================================
+class OutboundQueue
+{
+  public:
+    // Constructor
+    OutboundQueue();
+
+    // Adds a client (websocket connect)
+    void AddClient(uint32_t clientID);
+
+    // Removes a client and its messages (websocket disconnect or eviction)
+    void RemoveClient(uint32_t clientID);
+
+    // Replaces the subscribed push topics of a client (bit mask)
+    void Subscribe(uint32_t clientID, uint8_t topics);
+
+    // Returns true, if the client is subscribed to the push topic
+    bool IsSubscribed(uint32_t clientID, uint8_t topic);
+
+    // Returns true, if the client has no queued messages
+    bool IsEmpty(uint32_t clientID);
+
+    // Queues a message with an optional mixture version (thread safe), returns false if the client is over its limit
+    bool Push(uint32_t clientID, const String& text, uint32_t mixtureVersion = 0);
+
+    // Removes the oldest message of a client and returns it, takes over its mixture version (thread safe)
+    bool Pop(uint32_t clientID, String& text);
+
+    // Raises the mixture version of a client (message handed over to the websocket)
+    void SetMixtureVersion(uint32_t clientID, uint32_t mixtureVersion);
+
+    // Returns the mixture version of a client, diffs are sent from this version (0 = unknown client)
+    uint32_t GetMixtureVersion(uint32_t clientID);
+
+    // Returns the client ID of a queue slot (0 = unused)
+    uint32_t GetClientID(uint8_t index);
+
+    // Returns a client, which has to be closed (over limit for too long or most bytes at low heap), 0 = none
+    uint32_t GetEvictionCandidate(bool isLowHeap);
+
+    // Returns the queued messages and bytes of all clients and the maximum bytes of one client
+    uint32_t GetQueuedMessages();
+    uint32_t GetQueuedBytes();
+    uint32_t GetMaxClientBytes();
+
+  private:
+    OutboundClient _clients[OUTBOUND_MAX_CLIENTS];
+    SemaphoreHandle_t _mutex = NULL;
+
+    // Returns the client entry of an ID (NULL = unknown)
+    OutboundClient* FindClient(uint32_t clientID);
+
+    // Returns true, if both messages have the same topic
+    static bool IsSameTopic(const String& text1, const String& text2);
+};
+
+
+#endif
+#endif
@@ -0,0 +1,572 @@
+/**
+ * Includes the pour log (per-pour records, usage statistics and export)
+ *
+ * @author    Florian Staeblein
+ * @date      2024/01/28
+ * @copyright © 2024 Florian Staeblein
+ */
+
+#include "PourLog.h"
+
+//===============================================================
+// Global variables
+//===============================================================
+PourLog Pours;
+
+//===============================================================
+// Writes a value little endian and moves the buffer
+//===============================================================
+static void WriteValue(uint8_t*& buffer, uint32_t value, uint8_t bytes)
+{
+  for (uint8_t index = 0; index < bytes; index++)
+  {
+    *buffer++ = (uint8_t)(value >> (8 * index));
+  }
+}
+
+//===============================================================
+// Reads a value little endian and moves the buffer
+//===============================================================
+static uint32_t ReadValue(const uint8_t*& buffer, uint8_t bytes)
+{
+  uint32_t value = 0;
+  for (uint8_t index = 0; index < bytes; index++)
+  {
+    value |= (uint32_t)(*buffer++) << (8 * index);
+  }
+  return value;
+}
+
+//===============================================================
+// Constructor
+//===============================================================
+PourLog::PourLog()
+{
+}
+
+//===============================================================
+// Initializes the pour log
+//===============================================================
+void PourLog::Begin(bool isSpiffsAvailable)
+{
+  if (!_mutex)
+  {
+    _mutex = xSemaphoreCreateMutex();
+  }
+  _isSpiffsAvailable = isSpiffsAvailable;
+}
+
+//===============================================================
+// Detects pours by the pump state and flushes new records
+//===============================================================
+void PourLog::Update(bool isPouring)
+{
+  // Lever pressed, remember the flow meter values
+  if (isPouring && !_isPouring)
+  {
+    _pourStart_ms = millis();
+    for (uint8_t index = 0; index < LiquidCount; index++)
+    {
+      _pourStartVolumes_ml[index] = FlowMeter.GetValue(index);
+    }
+  }
+  // Lever released
+  else if (!isPouring && _isPouring)
+  {
+    FinishPour();
+  }
+  _isPouring = isPouring;
+
+  // Flush new records (not while pouring, flash writes stall the pump timing)
+  if (!_isPouring &&
+    _isSpiffsAvailable &&
+    _flushedCount != _recordCount &&
+    (_recordCount - _flushedCount >= POURLOG_FLUSH_RECORDS || (millis() - _firstUnflushed_ms) > POURLOG_FLUSH_MS))
+  {
+    Flush();
+  }
+}
+
+//===============================================================
+// Creates a record from the flow meter at the end of a pour
+//===============================================================
+void PourLog::FinishPour()
+{
+  PourRecord record = {};
+  uint32_t volume_ml = 0;
+  for (uint8_t index = 0; index < LiquidCount; index++)
+  {
+    uint32_t liquidVolume_ml = min(FlowMeter.GetValue(index) - _pourStartVolumes_ml[index], (uint32_t)UINT16_MAX);
+    record.Volumes_ml[index] = (uint16_t)liquidVolume_ml;
+    volume_ml += liquidVolume_ml;
+  }
+
+  // Short lever presses without volume are no pours
+  if (volume_ml == 0)
+  {
+    return;
+  }
+
+  for (uint8_t index = 0; index < LiquidCount; index++)
+  {
+    record.Mixture_Percent[index] = (uint8_t)((record.Volumes_ml[index] * 100 + volume_ml / 2) / volume_ml);
+  }
+  record.Timestamp_s = millis() / 1000;
+  record.Duration_ms = millis() - _pourStart_ms;
+  record.RecipeId = GetRecipeId(record.Mixture_Percent);
+
+  Add(record);
+}
+
+//===============================================================
+// Adds a record and updates the statistics
+//===============================================================
+void PourLog::Add(const PourRecord& record)
+{
+  if (_mutex)
+  {
+    xSemaphoreTake(_mutex, portMAX_DELAY);
+  }
+
+  // Overwrite the oldest record
+  _records[_recordCount % POURLOG_SIZE] = record;
+  _recordCount++;
+  if (_firstUnflushed_ms == 0)
+  {
+    _firstUnflushed_ms = max(millis(), (uint32_t)1);
+  }
+
+  // Update statistics
+  uint32_t volume_ml = 0;
+  for (uint8_t index = 0; index < LiquidCount; index++)
+  {
+    _liquidVolumes_ml[index] += record.Volumes_ml[index];
+    volume_ml += record.Volumes_ml[index];
+  }
+  _volume_ml += volume_ml;
+
+  uint32_t hour = record.Timestamp_s / 3600;
+  AdvanceHours(hour);
+  _hourPours[hour % POURLOG_HOURS]++;
+  _hourVolumes_ml[hour % POURLOG_HOURS] += volume_ml;
+
+  CountRecipe(record);
+
+  if (_mutex)
+  {
+    xSemaphoreGive(_mutex);
+  }
+}
+
+//===============================================================
+// Returns the record with an absolute number
+//===============================================================
+bool PourLog::GetRecord(uint32_t number, PourRecord& record)
+{
+  if (_mutex)
+  {
+    xSemaphoreTake(_mutex, portMAX_DELAY);
+  }
+
+  // Only the last POURLOG_SIZE records are available
+  bool isAvailable = number < _recordCount && (_recordCount - number) <= POURLOG_SIZE;
+  if (isAvailable)
+  {
+    record = _records[number % POURLOG_SIZE];
+  }
+
+  if (_mutex)
+  {
+    xSemaphoreGive(_mutex);
+  }
+  return isAvailable;
+}
+
+//===============================================================
+// Returns the count of all records since boot
+//===============================================================
+uint32_t PourLog::GetRecordCount()
+{
+  return _recordCount;
+}
+
+//===============================================================
+// Appends new records to the SPIFFS log
+//===============================================================
+void PourLog::Flush()
+{
+  // Records overwritten before the flush are lost
+  uint32_t recordCount = _recordCount;
+  uint32_t firstRecord = max(_flushedCount, (recordCount > POURLOG_SIZE) ? recordCount - POURLOG_SIZE : (uint32_t)0);
+  uint32_t bytes = (recordCount - firstRecord) * POURLOG_RECORD_BYTES;
+
+  File file = SPIFFS.open(POURLOG_FILE_NAME, "a");
+  if (file && file.size() + bytes > POURLOG_FILE_MAX_BYTES)
+  {
+    // Keep one previous log
+    file.close();
+    SPIFFS.remove(POURLOG_FILE_OLD_NAME);
+    SPIFFS.rename(POURLOG_FILE_NAME, POURLOG_FILE_OLD_NAME);
+    file = SPIFFS.open(POURLOG_FILE_NAME, "a");
+  }
+
+  bool isWritten = (bool)file;
+  if (isWritten && file.size() == 0)
+  {
+    const uint8_t header[POURLOG_HEADER_BYTES] = { 'P', 'L', POURLOG_FILE_VERSION, LiquidCount };
+    isWritten = file.write(header, POURLOG_HEADER_BYTES) == POURLOG_HEADER_BYTES;
+  }
+
+  PourRecord record;
+  uint8_t buffer[POURLOG_RECORD_BYTES];
+  for (uint32_t number = firstRecord; isWritten && number < recordCount; number++)
+  {
+    if (GetRecord(number, record))
+    {
+      EncodeRecord(record, buffer);
+      isWritten = file.write(buffer, POURLOG_RECORD_BYTES) == POURLOG_RECORD_BYTES;
+    }
+  }
+
+  if (file)
+  {
+    file.close();
+  }
+
+  // Failed records are not repeated (e.g. SPIFFS is full), the next flush continues
+  _flushErrors += isWritten ? 0 : 1;
+  _flushedCount = recordCount;
+  _firstUnflushed_ms = 0;
+}
+
+//===============================================================
+// Clears the hours passed since the last pour
+//===============================================================
+void PourLog::AdvanceHours(uint32_t hour)
+{
+  if (hour <= _currentHour)
+  {
+    return;
+  }
+
+  uint32_t passedHours = min(hour - _currentHour, (uint32_t)POURLOG_HOURS);
+  for (uint32_t offset = 1; offset <= passedHours; offset++)
+  {
+    uint32_t index = (_currentHour + offset) % POURLOG_HOURS;
+    _hourPours[index] = 0;
+    _hourVolumes_ml[index] = 0;
+  }
+  _currentHour = hour;
+}
+
+//===============================================================
+// Counts a recipe (the least poured recipe is replaced by a new
+// one, which takes over its count as upper bound)
+//===============================================================
+void PourLog::CountRecipe(const PourRecord& record)
+{
+  uint8_t minIndex = 0;
+  for (uint8_t index = 0; index < POURLOG_MAX_RECIPES; index++)
+  {
+    PourRecipe& recipe = _recipes[index];
+    if (recipe.Count > 0 && recipe.Id == record.RecipeId)
+    {
+      recipe.Count++;
+      return;
+    }
+
+    if (recipe.Count < _recipes[minIndex].Count)
+    {
+      minIndex = index;
+    }
+  }
+
+  PourRecipe& recipe = _recipes[minIndex];
+  recipe.Id = record.RecipeId;
+  memcpy(recipe.Mixture_Percent, record.Mixture_Percent, LiquidCount);
+  recipe.Count++;
+}
+
+//===============================================================
+// Starts a streamed export
+//===============================================================
+void PourLog::StartExport(PourExport& state, bool isCsv)
+{
+  state.IsCsv = isCsv;
+  state.Section = 0;
+  state.HasRecords = false;
+  state.EndRecord = _recordCount;
+  state.NextRecord = (state.EndRecord > POURLOG_SIZE) ? state.EndRecord - POURLOG_SIZE : 0;
+  state.Pending = "";
+  state.PendingOffset = 0;
+}
+
+//===============================================================
+// Fills the buffer with the next export bytes
+//===============================================================
+size_t PourLog::FillExport(PourExport& state, uint8_t* buffer, size_t maxLength)
+{
+  size_t length = 0;
+  while (length < maxLength)
+  {
+    // Create the next line, if the current one is sent
+    if (state.PendingOffset >= state.Pending.length())
+    {
+      if (!GetExportLine(state, state.Pending))
+      {
+        break;
+      }
+      state.PendingOffset = 0;
+      continue;
+    }
+
+    size_t count = min(maxLength - length, (size_t)(state.Pending.length() - state.PendingOffset));
+    memcpy(buffer + length, state.Pending.c_str() + state.PendingOffset, count);
+    state.PendingOffset += count;
+    length += count;
+  }
+  return length;
+}
+
+//===============================================================
+// Creates the next export line
+//===============================================================
+bool PourLog::GetExportLine(PourExport& state, String& line)
+{
+  switch (state.Section)
+  {
+    case 0:
+      {
+        // Summary (JSON) or header (CSV)
+        state.Section = 1;
+        if (!state.IsCsv)
+        {
+          line = GetSummaryJson() + "\"records\":[";
+          return true;
+        }
+
+        line = "timestamp_s,duration_ms";
+        for (uint8_t index = 0; index < LiquidCount; index++)
+        {
+          line += String(",") + LiquidTable[index].Name + "_ml";
+        }
+        for (uint8_t index = 0; index < LiquidCount; index++)
+        {
+          line += String(",") + LiquidTable[index].Name + "_percent";
+        }
+        line += ",recipe\n";
+        return true;
+      }
+    case 1:
+      {
+        // Records of the start of the export (records overwritten meanwhile are skipped)
+        PourRecord record;
+        while (state.NextRecord < state.EndRecord)
+        {
+          if (!GetRecord(state.NextRecord++, record))
+          {
+            continue;
+          }
+
+          String volumes;
+          String mixture;
+          for (uint8_t index = 0; index < LiquidCount; index++)
+          {
+            volumes += (index > 0 ? "," : "") + String(record.Volumes_ml[index]);
+            mixture += (index > 0 ? "," : "") + String(record.Mixture_Percent[index]);
+          }
+
+          if (state.IsCsv)
+          {
+            line = String(record.Timestamp_s) + "," + String(record.Duration_ms) + "," + volumes + "," + mixture + "," + String(record.RecipeId) + "\n";
+          }
+          else
+          {
+            line = String(state.HasRecords ? "," : "") + "{\"t\":" + String(record.Timestamp_s) + ",\"d\":" + String(record.Duration_ms) +
+              ",\"v\":[" + volumes + "],\"m\":[" + mixture + "],\"r\":" + String(record.RecipeId) + "}";
+          }
+          state.HasRecords = true;
+          return true;
+        }
+
+        state.Section = 2;
+        return GetExportLine(state, line);
+      }
+    case 2:
+      {
+        // Closing of the JSON records and object
+        state.Section = 3;
+        if (state.IsCsv)
+        {
+          return false;
+        }
+        line = "]}";
+        return true;
+      }
+    default:
+      return false;
+  }
+}
+
+//===============================================================
+// Returns the statistics as JSON object start
+//===============================================================
+String PourLog::GetSummaryJson()
+{
+  if (_mutex)
+  {
+    xSemaphoreTake(_mutex, portMAX_DELAY);
+  }
+
+  // Hours without pours since the last pour are empty
+  AdvanceHours(millis() / 1000 / 3600);
+
+  String json = "{\"uptime_s\":" + String(millis() / 1000) +
+    ",\"pours\":" + String(_recordCount) +
+    ",\"volume_ml\":" + String(_volume_ml) +
+    ",\"average_ml\":" + String(_recordCount > 0 ? _volume_ml / _recordCount : 0);
+
+  // Mixture distribution
+  String names;
+  String volumes;
+  for (uint8_t index = 0; index < LiquidCount; index++)
+  {
+    names += String(index > 0 ? "," : "") + "\"" + LiquidTable[index].Name + "\"";
+    volumes += (index > 0 ? "," : "") + String(_liquidVolumes_ml[index]);
+  }
+  json += ",\"liquids\":[" + names + "],\"liquid_ml\":[" + volumes + "]";
+
+  // Pours per hour (oldest hour first, the last entry is the current hour)
+  String pours;
+  volumes = "";
+  for (uint8_t offset = 1; offset <= POURLOG_HOURS; offset++)
+  {
+    uint32_t index = (_currentHour + offset) % POURLOG_HOURS;
+    pours += (offset > 1 ? "," : "") + String(_hourPours[index]);
+    volumes += (offset > 1 ? "," : "") + String(_hourVolumes_ml[index]);
+  }
+  json += ",\"hours\":[" + pours + "],\"hour_ml\":[" + volumes + "]";
+
+  // Top recipes (most poured first)
+  PourRecipe recipes[POURLOG_MAX_RECIPES];
+  memcpy(recipes, _recipes, sizeof(recipes));
+  json += ",\"recipes\":[";
+  for (uint8_t rank = 0; rank < POURLOG_MAX_RECIPES; rank++)
+  {
+    uint8_t maxIndex = rank;
+    for (uint8_t index = rank + 1; index < POURLOG_MAX_RECIPES; index++)
+    {
+      if (recipes[index].Count > recipes[maxIndex].Count)
+      {
+        maxIndex = index;
+      }
+    }
+
+    PourRecipe recipe = recipes[maxIndex];
+    recipes[maxIndex] = recipes[rank];
+    recipes[rank] = recipe;
+    if (recipe.Count == 0)
+    {
+      break;
+    }
+
+    String mixture;
+    for (uint8_t index = 0; index < LiquidCount; index++)
+    {
+      mixture += (index > 0 ? "," : "") + String(recipe.Mixture_Percent[index]);
+    }
+    json += String(rank > 0 ? "," : "") + "{\"id\":" + String(recipe.Id) + ",\"mixture\":[" + mixture + "],\"count\":" + String(recipe.Count) + "}";
+  }
+  json += "],";
+
+  if (_mutex)
+  {
+    xSemaphoreGive(_mutex);
+  }
+  return json;
+}
+
+#if defined(WIFI_MIXER)
+//===============================================================
+// Adds the statistics URL handler to a web server
+//===============================================================
+void PourLog::AddWebHandlers(AsyncWebServer* webserver)
+{
+  // Add statistics URL handler to web server (parameter 'format=csv' exports the records only)
+  webserver->on("/stats", HTTP_GET, [](AsyncWebServerRequest * request)
+  {
+    bool isCsv = request->hasParam("format") && request->getParam("format")->value() == "csv";
+
+    // Streamed in chunks, the records are never copied as a whole
+    std::shared_ptr<PourExport> state(new PourExport());
+    Pours.StartExport(*state, isCsv);
+    request->send(request->beginChunkedResponse(isCsv ? "text/csv" : "application/json", [state](uint8_t* buffer, size_t maxLength, size_t /*index*/) -> size_t
+    {
+      return Pours.FillExport(*state, buffer, maxLength);
+    }));
+  });
+}
+#endif
+
+//===============================================================
+// Returns the pour statistics as string
+//===============================================================
+String PourLog::GetPourString()
+{
+  uint32_t currentHour = (millis() / 1000 / 3600);
+  return String("Pours: ") + String(_recordCount) + " (" + String(_volume_ml) + "ml" +
+    ", avg " + String(_recordCount > 0 ? _volume_ml / _recordCount : 0) + "ml)" +
+    ", Current hour: " + String(currentHour == _currentHour ? _hourPours[_currentHour % POURLOG_HOURS] : 0) +
+    ", Flushed: " + String(_flushedCount) + " (" + String(_flushErrors) + " errors)";
+}
+
+//===============================================================
+// Encodes a record in the binary log format
+//===============================================================
+void PourLog::EncodeRecord(const PourRecord& record, uint8_t* buffer)
+{
+  WriteValue(buffer, record.Timestamp_s, 4);
+  WriteValue(buffer, record.Duration_ms, 4);
+  for (uint8_t index = 0; index < LiquidCount; index++)
+  {
+    WriteValue(buffer, record.Volumes_ml[index], 2);
+  }
+  for (uint8_t index = 0; index < LiquidCount; index++)
+  {
+    WriteValue(buffer, record.Mixture_Percent[index], 1);
+  }
+  WriteValue(buffer, record.RecipeId, 2);
+}
+
+//===============================================================
+// Decodes a record of the binary log format
+//===============================================================
+void PourLog::DecodeRecord(const uint8_t* buffer, PourRecord& record)
+{
+  record.Timestamp_s = ReadValue(buffer, 4);
+  record.Duration_ms = ReadValue(buffer, 4);
+  for (uint8_t index = 0; index < LiquidCount; index++)
+  {
+    record.Volumes_ml[index] = (uint16_t)ReadValue(buffer, 2);
+  }
+  for (uint8_t index = 0; index < LiquidCount; index++)
+  {
+    record.Mixture_Percent[index] = (uint8_t)ReadValue(buffer, 1);
+  }
+  record.RecipeId = (uint16_t)ReadValue(buffer, 2);
+}
+
+//===============================================================
+// Returns the recipe ID of a mixture (FNV-1a hash of the mixture
+// in POURLOG_RECIPE_STEP steps)
+//===============================================================
+uint16_t PourLog::GetRecipeId(const uint8_t mixture_Percent[LiquidCount])
+{
+  uint32_t hash = 2166136261UL;
+  for (uint8_t index = 0; index < LiquidCount; index++)
+  {
+    hash ^= (uint32_t)((mixture_Percent[index] + POURLOG_RECIPE_STEP / 2) / POURLOG_RECIPE_STEP);
+    hash *= 16777619UL;
+  }
+  return (uint16_t)(hash ^ (hash >> 16));
+}
@@ -0,0 +1,177 @@
+/**
+ * Includes the pour log (per-pour records, usage statistics and export)
+ *
+ * @author    Florian Staeblein
+ * @date      2024/01/28
+ * @copyright © 2024 Florian Staeblein
+ */
+
+#ifndef POURLOG_H
+#define POURLOG_H
+
+//===============================================================
+// Includes
+//===============================================================
+#include <Arduino.h>
+#include <SPIFFS.h>
+#include "Config.h"
+#include "FlowMeterDriver.h"
+
+#if defined(WIFI_MIXER)
+#include <ESPAsyncWebServer.h>
+#endif
+
+//===============================================================
+// Defines
+//===============================================================
+#define POURLOG_SIZE              64                // Records in RAM (the oldest record is overwritten)
+#define POURLOG_HOURS             24                // Pours per hour for the last 24 hours of uptime
+#define POURLOG_MAX_RECIPES       8                 // Tracked recipes, the least poured one is replaced
+#define POURLOG_RECIPE_STEP       5                 // Mixtures within 5% steps are the same recipe
+#define POURLOG_FLUSH_RECORDS     16                // Flush to SPIFFS after 16 new records ...
+#define POURLOG_FLUSH_MS          60000             // ... or one minute after the first new record
+#define POURLOG_FILE_NAME         "/pours.bin"      // Binary log in SPIFFS
+#define POURLOG_FILE_OLD_NAME     "/pours.old"      // Previous log after a rotation
+#define POURLOG_FILE_MAX_BYTES    32768             // Rotate the log at 32 kB
+#define POURLOG_FILE_VERSION      1                 // Version of the binary record format
+#define POURLOG_HEADER_BYTES      4                 // 'P', 'L', version, liquid count
+#define POURLOG_RECORD_BYTES      (10 + 3 * LiquidCount)  // Timestamp, duration, volumes, mixture, recipe (little endian)
+
+
+//===============================================================
+// Record of one pour
+//===============================================================
+struct PourRecord
+{
+  uint32_t Timestamp_s;                 // Uptime at the end of the pour
+  uint32_t Duration_ms;                 // Time from lever press to release
+  uint16_t Volumes_ml[LiquidCount];     // Dispensed volume per pump
+  uint8_t Mixture_Percent[LiquidCount]; // Share of every liquid in the pour
+  uint16_t RecipeId;                    // Hash of the mixture in POURLOG_RECIPE_STEP steps
+};
+
+//===============================================================
+// Pour count of a recipe
+//===============================================================
+struct PourRecipe
+{
+  uint16_t Id;
+  uint8_t Mixture_Percent[LiquidCount];
+  uint32_t Count;                       // 0 = unused
+};
+
+//===============================================================
+// Progress of one streamed export
+//===============================================================
+struct PourExport
+{
+  bool IsCsv;
+  uint8_t Section;                      // 0 = summary or header, 1 = records, 2 = end of JSON, 3 = finished
+  bool HasRecords;                      // A record was exported (JSON separator)
+  uint32_t NextRecord;                  // Absolute number of the next record
+  uint32_t EndRecord;                   // Absolute number after the last record at the start
+  String Pending;                       // Rest of the current line
+  uint32_t PendingOffset;
+};
+
+
+//===============================================================
+// Class for logging pours in a ring buffer with incremental
+// statistics (pours per hour, average size, top recipes)
+//===============================================================
+class PourLog
+{
+  public:
+    // Constructor
+    PourLog();
+
+    // Initializes the pour log (SPIFFS log only if available)
+    void Begin(bool isSpiffsAvailable);
+
+    // Detects pours by the pump state and flushes new records, should be called by the loop task
+    void Update(bool isPouring);
+
+    // Adds a record and updates the statistics (thread safe)
+    void Add(const PourRecord& record);
+
+    // Returns the record with an absolute number (false -> overwritten or not available)
+    bool GetRecord(uint32_t number, PourRecord& record);
+
+    // Returns the count of all records since boot
+    uint32_t GetRecordCount();
+
+    // Starts a streamed export (JSON statistics and records or CSV records)
+    void StartExport(PourExport& state, bool isCsv);
+
+    // Fills the buffer with the next export bytes, returns 0 at the end
+    size_t FillExport(PourExport& state, uint8_t* buffer, size_t maxLength);
+
+#if defined(WIFI_MIXER)
+    // Adds the statistics URL handler to a web server
+    void AddWebHandlers(AsyncWebServer* webserver);
+#endif
+
+    // Returns the pour statistics as string
+    String GetPourString();
+
+    // Encodes a record in the binary log format (POURLOG_RECORD_BYTES)
+    static void EncodeRecord(const PourRecord& record, uint8_t* buffer);
+
+    // Decodes a record of the binary log format
+    static void DecodeRecord(const uint8_t* buffer, PourRecord& record);
+
+    // Returns the recipe ID of a mixture
+    static uint16_t GetRecipeId(const uint8_t mixture_Percent[LiquidCount]);
+
+  private:
+    // Ring buffer (records are numbered from boot, the record number modulo the size is the index)
+    PourRecord _records[POURLOG_SIZE];
+    uint32_t _recordCount = 0;
+    uint32_t _flushedCount = 0;
+    SemaphoreHandle_t _mutex = NULL;
+
+    // Statistics since boot
+    uint32_t _volume_ml = 0;
+    uint32_t _liquidVolumes_ml[LiquidCount] = {};
+    uint32_t _hourPours[POURLOG_HOURS] = {};
+    uint32_t _hourVolumes_ml[POURLOG_HOURS] = {};
+    uint32_t _currentHour = 0;
+    PourRecipe _recipes[POURLOG_MAX_RECIPES] = {};
+
+    // Pour detection variables
+    bool _isPouring = false;
+    uint32_t _pourStart_ms = 0;
+    uint32_t _pourStartVolumes_ml[LiquidCount] = {};
+
+    // SPIFFS log variables
+    bool _isSpiffsAvailable = false;
+    uint32_t _firstUnflushed_ms = 0;
+    uint32_t _flushErrors = 0;
+
+    // Creates a record from the flow meter at the end of a pour
+    void FinishPour();
+
+    // Appends new records to the SPIFFS log (rotates a full log)
+    void Flush();
+
+    // Clears the hours passed since the last pour (call with taken mutex)
+    void AdvanceHours(uint32_t hour);
+
+    // Counts a recipe (call with taken mutex)
+    void CountRecipe(const PourRecord& record);
+
+    // Creates the next export line, returns false at the end
+    bool GetExportLine(PourExport& state, String& line);
+
+    // Returns the statistics as JSON object start (without the closing records)
+    String GetSummaryJson();
+};
+
+
+//===============================================================
+// Global variables
+//===============================================================
+extern PourLog Pours;
+
+
+#endif
@@ -0,0 +1,140 @@
+/**
+ * Includes all power management functions
+ *
+ * @author    Florian Staeblein
+ * @date      2024/01/28
+ * @copyright © 2024 Florian Staeblein
+ */
+
+#include "PowerManager.h"
+
+//===============================================================
+// Global variables
+//===============================================================
+PowerManager Power;
+
+//===============================================================
+// Constructor
+//===============================================================
+PowerManager::PowerManager()
+{
+}
+
+//===============================================================
+// Adds an input pin, which wakes up from light sleep
+//===============================================================
+void PowerManager::AddWakePin(uint8_t pin, bool hasInterrupt)
+{
+  if (_wakePinCount < MAX_WAKEPINS)
+  {
+    _wakePins[_wakePinCount] = pin;
+    _wakePinInterrupts[_wakePinCount] = hasInterrupt;
+    _wakePinCount++;
+  }
+}
+
+//===============================================================
+// Sets the current idle tier, returns true if the tier changed
+//===============================================================
+bool PowerManager::SetTier(IdleTier tier)
+{
+  if (tier == _tier)
+  {
+    return false;
+  }
+
+  UpdateTierTime();
+  _tier = tier;
+  return true;
+}
+
+//===============================================================
+// Returns the current idle tier
+//===============================================================
+IdleTier PowerManager::GetTier()
+{
+  return _tier;
+}
+
+//===============================================================
+// Enters light sleep until one of the wake pins changes its level
+//===============================================================
+void PowerManager::LightSleep()
+{
+  // Wake up on the opposite of the current level of each pin
+  for (uint8_t index = 0; index < _wakePinCount; index++)
+  {
+    gpio_wakeup_enable((gpio_num_t)_wakePins[index], digitalRead(_wakePins[index]) ? GPIO_INTR_LOW_LEVEL : GPIO_INTR_HIGH_LEVEL);
+  }
+  esp_sleep_enable_gpio_wakeup();
+
+#if defined(DEBUG_MIXER)
+  // Send pending debug output (USB serial is disconnected while sleeping)
+  Serial.println("[POWER] Enter light sleep");
+  Serial.flush();
+#endif
+
+  // Sleep (returns after wake up, the timer keeps running)
+  UpdateTierTime();
+  esp_light_sleep_start();
+  _wakeTimestamp_us = esp_timer_get_time();
+
+  // Restore edge interrupts (wake up configuration replaced the interrupt type)
+  for (uint8_t index = 0; index < _wakePinCount; index++)
+  {
+    gpio_wakeup_disable((gpio_num_t)_wakePins[index]);
+    gpio_set_intr_type((gpio_num_t)_wakePins[index], _wakePinInterrupts[index] ? GPIO_INTR_ANYEDGE : GPIO_INTR_DISABLE);
+  }
+}
+
+//===============================================================
+// Should be called after the page was restored after wake up
+//===============================================================
+void PowerManager::WakeFinished()
+{
+  if (_wakeTimestamp_us != 0)
+  {
+    _lastWakeLatency_us = esp_timer_get_time() - _wakeTimestamp_us;
+    _maxWakeLatency_us = max(_maxWakeLatency_us, _lastWakeLatency_us);
+    _wakeCount++;
+    _wakeTimestamp_us = 0;
+  }
+}
+
+//===============================================================
+// Returns the duty cycle of each tier and the wake latency as
+// string (starts a new measurement)
+//===============================================================
+String PowerManager::GetPowerString()
+{
+  const char* tierNames[IdleTierCount] = { "Active", "ScreenSaver", "Static", "Sleep" };
+
+  UpdateTierTime();
+  uint32_t total_ms = 0;
+  for (uint8_t index = 0; index < IdleTierCount; index++)
+  {
+    total_ms += _tierTime_ms[index];
+  }
+  total_ms = max(total_ms, (uint32_t)1);
+
+  String result = "Power:";
+  for (uint8_t index = 0; index < IdleTierCount; index++)
+  {
+    // Percentage with one decimal place (uint64 avoids overflow for long periods)
+    result += String(" ") + tierNames[index] + " " + FormatFixedPoint((uint64_t)_tierTime_ms[index] * 1000 / total_ms, 4, 1) + "%";
+    _tierTime_ms[index] = 0;
+  }
+  result += ", Wakes: " + String(_wakeCount) + ", Last: " + String(_lastWakeLatency_us / 1000) + "ms, Max: " + String(_maxWakeLatency_us / 1000) + "ms";
+
+  return result;
+}
+
+//===============================================================
+// Adds the time since the last tier change to the current tier
+//===============================================================
+void PowerManager::UpdateTierTime()
+{
+  uint32_t now_ms = millis();
+  _tierTime_ms[_tier] += now_ms - _tierTimestamp_ms;
+  _tierTimestamp_ms = now_ms;
+}
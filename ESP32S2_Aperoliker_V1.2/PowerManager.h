@@ -0,0 +1,96 @@
+/**
+ * Includes all power management functions
+ *
+ * @author    Florian Staeblein
+ * @date      2024/01/28
+ * @copyright © 2024 Florian Staeblein
+ */
+ 
+#ifndef POWERMANAGER_H
+#define POWERMANAGER_H
+
+//===============================================================
+// Includes
+//===============================================================
+#include <Arduino.h>
+#include <esp_sleep.h>
+#include <driver/gpio.h>
+#include "Config.h"
+#include "FixedPointHelper.h"
+
+
+//===============================================================
+// Defines
+//===============================================================
+#define MAX_WAKEPINS      4
+
+
+//===============================================================
+// Enums
+//===============================================================
+enum IdleTier : uint8_t
+{
+  eTierActive = 0,        // User interaction, all functions active
+  eTierScreenSaver = 1,   // Screen saver animation
+  eTierStatic = 2,        // Static screen saver frame, LED light off
+  eTierSleep = 3,         // Light sleep, wake up on input pins
+};
+const uint8_t IdleTierCount = 4;
+
+
+//===============================================================
+// Class for power management
+//===============================================================
+class PowerManager
+{
+  public:
+    // Constructor
+    PowerManager();
+
+    // Adds an input pin, which wakes up from light sleep (restores the edge interrupt, if the pin has one)
+    void AddWakePin(uint8_t pin, bool hasInterrupt);
+
+    // Sets the current idle tier, returns true if the tier changed
+    bool SetTier(IdleTier tier);
+
+    // Returns the current idle tier
+    IdleTier GetTier();
+
+    // Enters light sleep until one of the wake pins changes its level
+    void LightSleep();
+
+    // Should be called after the page was restored after wake up (measures wake latency)
+    void WakeFinished();
+
+    // Returns the duty cycle of each tier and the wake latency as string (starts a new measurement)
+    String GetPowerString();
+
+  private:
+    // Wake pin definitions
+    uint8_t _wakePins[MAX_WAKEPINS] = {};
+    bool _wakePinInterrupts[MAX_WAKEPINS] = {};
+    uint8_t _wakePinCount = 0;
+
+    // Idle tier variables
+    IdleTier _tier = eTierActive;
+    uint32_t _tierTimestamp_ms = 0;
+    uint32_t _tierTime_ms[IdleTierCount] = {};
+
+    // Wake up variables
+    int64_t _wakeTimestamp_us = 0;
+    uint32_t _lastWakeLatency_us = 0;
+    uint32_t _maxWakeLatency_us = 0;
+    uint32_t _wakeCount = 0;
+
+    // Adds the time since the last tier change to the current tier
+    void UpdateTierTime();
+};
+
+
+//===============================================================
+// Global variables
+//===============================================================
+extern PowerManager Power;
+
+
+#endif
@@ -7,6 +7,7 @@
  */
  
 #include "PumpDriver.h"
+#include "SettingsStore.h"
 
 //===============================================================
 // Global variables
@@ -23,13 +24,8 @@ PumpDriver::PumpDriver()
 //===============================================================
 // Initializes the pump driver
 //===============================================================
-void PumpDriver::Begin(uint8_t pinPump1, uint8_t pinPump2, uint8_t pinPump3)
+void PumpDriver::Begin()
 {
-  // Set pins
-  _pinPump1 = pinPump1;
-  _pinPump2 = pinPump2;
-  _pinPump3 = pinPump3;
-
   // Load settings
   Pumps.Load();
 
@@ -49,29 +45,19 @@ uint32_t PumpDriver::GetLastUserAction()
 }
 
 //===============================================================
-// Load settings from flash
+// Load settings from the settings store
 //===============================================================
 void PumpDriver::Load()
 {
-  if (_preferences.begin(SETTINGS_NAME, true))
-  {
-    _preferences.begin(SETTINGS_NAME, false);
-    _cycleTimespan_ms = _preferences.getLong(KEY_CYCLETIMESPAN_MS, DEFAULT_CYCLE_TIMESPAN_MS);
-    _preferences.end();
-  }
-}
-
-//===============================================================
-// Save settings to flash
-//===============================================================
-void PumpDriver::Save()
-{
-  if (_preferences.begin(SETTINGS_NAME, false))
+  // Unsaved or invalid values keep the default
+  uint32_t cycleTimespan_ms = Settings.GetCycleTimespan();
+  if (cycleTimespan_ms == AUTO_CYCLE_TIMESPAN_MS ||
+    (cycleTimespan_ms >= MIN_CYCLE_TIMESPAN_MS &&
+    cycleTimespan_ms <= MAX_CYCLE_TIMESPAN_MS))
   {
-    _preferences.begin(SETTINGS_NAME, false);
-    _preferences.putLong(KEY_CYCLETIMESPAN_MS, _cycleTimespan_ms);
-    _preferences.end();
+    _cycleTimespan_ms = cycleTimespan_ms;
   }
+  UpdatePwm();
 }
 
 //===============================================================
@@ -84,17 +70,24 @@ void PumpDriver::Enable()
     return;
   }
 
+  // Set timestamp of last user action
+  _lastUserAction = millis();
+
+  // A bottle can't cover its share of a glass
+  if (_refusedLiquid < LiquidCount)
+  {
+    return;
+  }
+
   // Set pins to output direction (enable)
-  pinMode(_pinPump1, OUTPUT);
-  pinMode(_pinPump2, OUTPUT);
-  pinMode(_pinPump3, OUTPUT);
+  for (uint8_t index = 0; index < LiquidCount; index++)
+  {
+    pinMode(LiquidTable[index].PinPump, OUTPUT);
+  }
  
   // Set enabled flag to true
   // -> Update function is unlocked
   _isPumpEnabled = true;
-
-  // Set timestamp of last user action
-  _lastUserAction = millis();
 }
 
 //===============================================================
@@ -122,31 +115,28 @@ void PumpDriver::Disable()
 //===============================================================
 void PumpDriver::DisableInternal()
 {
-  // Set pins to input direction (disable)
-  pinMode(_pinPump1, INPUT);
-  pinMode(_pinPump2, INPUT);
-  pinMode(_pinPump3, INPUT);
-  
-  // Disable pumps, just to be sure
-  digitalWrite(_pinPump1, LOW);
-  digitalWrite(_pinPump2, LOW);
-  digitalWrite(_pinPump3, LOW);
-
   // Save timestamp
   uint32_t onTimestamp_ms = _lastPumpCycleStart_ms;
   uint32_t offTimestamp_ms = millis();
-
-  // Add already passed flow time to flow meter if pump is not already off
   uint32_t passedFlowTime = offTimestamp_ms - onTimestamp_ms;
-  uint32_t flowTime1_ms = _lastEnablePump1 == true ? passedFlowTime : 0;
-  uint32_t flowTime2_ms = _lastEnablePump2 == true ? passedFlowTime : 0;
-  uint32_t flowTime3_ms = _lastEnablePump3 == true ? passedFlowTime : 0;
-  FlowMeter.AddFlowTime(flowTime1_ms, flowTime2_ms, flowTime3_ms);
 
-  // All pumps are now disabled
-  _lastEnablePump1 = false;
-  _lastEnablePump2 = false;
-  _lastEnablePump3 = false;
+  for (uint8_t index = 0; index < LiquidCount; index++)
+  {
+    // Set pin to input direction (disable)
+    pinMode(LiquidTable[index].PinPump, INPUT);
+
+    // Disable pump, just to be sure
+    digitalWrite(LiquidTable[index].PinPump, LOW);
+
+    // Add already passed flow time to flow meter if pump is not already off
+    if (_lastEnablePumps[index])
+    {
+      FlowMeter.AddFlowTime(index, passedFlowTime);
+    }
+
+    // Pump is now disabled
+    _lastEnablePumps[index] = false;
+  }
 }
 
 //===============================================================
@@ -158,37 +148,131 @@ bool PumpDriver::IsEnabled()
 }
 
 //===============================================================
-// Sets pumps from percentage (0-100%)
+// Sets pumps from mixture shares (0-SHARE_FULLSCALE, one value
+// per liquid)
+//===============================================================
+void PumpDriver::SetPumps(const MixtureShare values_Share[LiquidCount])
+{
+  _maxValue_Share = SHARE_PER_PERCENT; // 1%->avoid divison by zero if all values are zero
+
+  // Check max border (0-100%) and search highest value
+  for (uint8_t index = 0; index < LiquidCount; index++)
+  {
+    _clip_Share[index] = min((uint32_t)values_Share[index], (uint32_t)SHARE_FULLSCALE);
+    _maxValue_Share = max(_maxValue_Share, _clip_Share[index]);
+  }
+
+  UpdatePwm();
+}
+
+//===============================================================
+// Calculates the cycle timespan and the pwm timings of the last
+// mixture
 //===============================================================
-void PumpDriver::SetPumps(double value1_Percentage, double value2_Percentage, double value3_Percentage)
+void PumpDriver::UpdatePwm()
 {
-  // Check min and max borders (0-100%)
-  double pump1Clip_Percentage = min(max(value1_Percentage, 0.0), 100.0);
-  double pump2Clip_Percentage = min(max(value2_Percentage, 0.0), 100.0);
-  double pump3Clip_Percentage = min(max(value3_Percentage, 0.0), 100.0);
+  // Automatic mode selects the cycle timespan per mixture
+  uint32_t cycleTimespan_ms = _cycleTimespan_ms;
+  if (cycleTimespan_ms == AUTO_CYCLE_TIMESPAN_MS)
+  {
+    cycleTimespan_ms = SelectCycleTimespan(_clip_Share, _maxValue_Share);
+  }
 
   // Calculate pwm timings (pump with the highest value is set
-  // to 100% pwm and the other two in relative to the max one)
-  double maxValue_Percentage = max(1.0, max(pump1Clip_Percentage, max(pump2Clip_Percentage, pump3Clip_Percentage))); // 1.0->avoid divison by zero if all values are zero
-  _pwmPump1_ms = (uint32_t)(pump1Clip_Percentage / maxValue_Percentage * _cycleTimespan_ms);
-  _pwmPump2_ms = (uint32_t)(pump2Clip_Percentage / maxValue_Percentage * _cycleTimespan_ms);
-  _pwmPump3_ms = (uint32_t)(pump3Clip_Percentage / maxValue_Percentage * _cycleTimespan_ms);
+  // to 100% pwm and the others in relative to the max one)
+  for (uint8_t index = 0; index < LiquidCount; index++)
+  {
+    _pwmPumps_ms[index] = ScaleShareRatio(cycleTimespan_ms, _clip_Share[index], _maxValue_Share);
+  }
+  _activeCycleTimespan_ms = cycleTimespan_ms;
+  _ratioError_Permille = GetRatioError(_pwmPumps_ms, cycleTimespan_ms);
+}
+
+//===============================================================
+// Returns the shortest cycle timespan, which meets the ratio
+// error target (shortest pulse MIN_PULSE_MS). Short cycles mix
+// better in the glass, long cycles lose less flow to the pump
+// spin-up.
+//===============================================================
+uint32_t PumpDriver::SelectCycleTimespan(const uint32_t clip_Share[LiquidCount], uint32_t maxValue_Share)
+{
+  // Smallest pulsed share (the pump with the highest share runs the whole cycle)
+  uint32_t minValue_Share = maxValue_Share;
+  for (uint8_t index = 0; index < LiquidCount; index++)
+  {
+    if (clip_Share[index] > 0)
+    {
+      minValue_Share = min(minValue_Share, clip_Share[index]);
+    }
+  }
+
+  // No pulsed pump -> no ratio error
+  if (minValue_Share >= maxValue_Share)
+  {
+    return MIN_CYCLE_TIMESPAN_MS;
+  }
+
+  // Cycle timespan of the shortest pulse, which meets the ratio error target (the pwm
+  // timing is rounded, so a pulse of MIN_PULSE_MS - 0.5ms is enough), rounded up to the next step
+  uint32_t cycleTimespan_ms = ((2 * MIN_PULSE_MS - 1) * maxValue_Share + 2 * minValue_Share - 1) / (2 * minValue_Share);
+  cycleTimespan_ms = ((cycleTimespan_ms + STEP_CYCLE_TIMESPAN_MS - 1) / STEP_CYCLE_TIMESPAN_MS) * STEP_CYCLE_TIMESPAN_MS;
+
+  // Very small shares can't meet the target, the longest cycle comes closest
+  return constrain(cycleTimespan_ms, MIN_CYCLE_TIMESPAN_MS, MAX_CYCLE_TIMESPAN_MS);
+}
+
+//===============================================================
+// Returns the predicted ratio error of pwm timings in permille
+// (every pulse loses PUMP_RESPONSE_MS, a pump running the whole
+// cycle doesn't restart)
+//===============================================================
+uint32_t PumpDriver::GetRatioError(const uint32_t pwmPumps_ms[LiquidCount], uint32_t cycleTimespan_ms)
+{
+  uint32_t ratioError_Permille = 0;
+  for (uint8_t index = 0; index < LiquidCount; index++)
+  {
+    if (pwmPumps_ms[index] == 0 ||
+      pwmPumps_ms[index] >= cycleTimespan_ms)
+    {
+      continue;
+    }
+
+    uint32_t lostFlowTime_ms = min(PUMP_RESPONSE_MS, pwmPumps_ms[index]);
+    ratioError_Permille = max(ratioError_Permille, ScaleRatio<uint32_t>(1000, lostFlowTime_ms, pwmPumps_ms[index]));
+  }
+  return ratioError_Permille;
+}
+
+//===============================================================
+// Sets all pumps to the same mixture share (0-SHARE_FULLSCALE)
+//===============================================================
+void PumpDriver::SetAllPumps(MixtureShare value_Share)
+{
+  MixtureShare values_Share[LiquidCount];
+  for (uint8_t index = 0; index < LiquidCount; index++)
+  {
+    values_Share[index] = value_Share;
+  }
+  SetPumps(values_Share);
 }
 
 //===============================================================
-// Sets the cycle timespan in ms (200-1000ms)
+// Sets the cycle timespan in ms (200-1000ms or automatic mode)
 //===============================================================
 bool PumpDriver::SetCycleTimespan(uint32_t value_ms)
 {
   // Check for min and max value
-  if (value_ms < MIN_CYCLE_TIMESPAN_MS ||
-  value_ms > MAX_CYCLE_TIMESPAN_MS)
+  if (value_ms != AUTO_CYCLE_TIMESPAN_MS &&
+    (value_ms < MIN_CYCLE_TIMESPAN_MS ||
+    value_ms > MAX_CYCLE_TIMESPAN_MS))
   {
     return false;
   }
 
-  // Set new value
+  // Set new value (committed to flash after a quiet period)
   _cycleTimespan_ms = value_ms;
+  Settings.SetCycleTimespan(value_ms);
+  UpdatePwm();
   
   // Set timestamp of last user action
   _lastUserAction = millis();
@@ -197,13 +281,40 @@ bool PumpDriver::SetCycleTimespan(uint32_t value_ms)
 }
 
 //===============================================================
-// Returns the current cycle timespan
+// Returns the cycle timespan setting
 //===============================================================
 uint32_t PumpDriver::GetCycleTimespan()
 {
   return _cycleTimespan_ms;
 }
 
+//===============================================================
+// Returns the cycle timespan of the current mixture
+//===============================================================
+uint32_t PumpDriver::GetActiveCycleTimespan()
+{
+  return _activeCycleTimespan_ms;
+}
+
+//===============================================================
+// Returns the predicted ratio error of the current mixture
+//===============================================================
+uint32_t PumpDriver::GetActiveRatioError()
+{
+  return _ratioError_Permille;
+}
+
+//===============================================================
+// Returns the cycle timespan and the predicted ratio error as
+// string
+//===============================================================
+String PumpDriver::GetPumpString()
+{
+  return String("Pumps: Cycle ") + String(_activeCycleTimespan_ms) + "ms" +
+    ((_cycleTimespan_ms == AUTO_CYCLE_TIMESPAN_MS) ? " (Auto)" : "") +
+    ", Ratio error: " + FormatFixedPoint(_ratioError_Permille, 3, 1) + "%";
+}
+
 //===============================================================
 // Should be called every < 50 ms
 //===============================================================
@@ -218,7 +329,7 @@ void PumpDriver::Update()
   uint32_t absoluteTime_ms = millis();
 
   // New cycle starts, reset last pump cycle timestamp
-  if ((absoluteTime_ms - _lastPumpCycleStart_ms) > _cycleTimespan_ms)
+  if ((absoluteTime_ms - _lastPumpCycleStart_ms) > _activeCycleTimespan_ms)
   {
     _lastPumpCycleStart_ms = absoluteTime_ms;
   }
@@ -226,24 +337,83 @@ void PumpDriver::Update()
   // Calculate relative time within cycle
   uint32_t relativeTime_ms = absoluteTime_ms - _lastPumpCycleStart_ms;
 
-  // Check if pumps must be powered on or off
-  bool enablePump1 = relativeTime_ms < _pwmPump1_ms;
-  bool enablePump2 = relativeTime_ms < _pwmPump2_ms;
-  bool enablePump3 = relativeTime_ms < _pwmPump3_ms;
-
-  // Write digital pins
-  digitalWrite(_pinPump1, enablePump1 ? HIGH : LOW);
-  digitalWrite(_pinPump2, enablePump2 ? HIGH : LOW);
-  digitalWrite(_pinPump3, enablePump3 ? HIGH : LOW);
-
-  // Add flow times when powering off (falling edge)
-  uint32_t flowTime1_ms = _lastEnablePump1 == true && enablePump1 == false ? _pwmPump1_ms : 0;
-  uint32_t flowTime2_ms = _lastEnablePump2 == true && enablePump2 == false ? _pwmPump2_ms : 0;
-  uint32_t flowTime3_ms = _lastEnablePump3 == true && enablePump3 == false ? _pwmPump3_ms : 0;
-  FlowMeter.AddFlowTime(flowTime1_ms, flowTime2_ms, flowTime3_ms);
-
-  // Save enabled state for next update
-  _lastEnablePump1 = enablePump1;
-  _lastEnablePump2 = enablePump2;
-  _lastEnablePump3 = enablePump3;
+  for (uint8_t index = 0; index < LiquidCount; index++)
+  {
+    // Check if pump must be powered on or off
+    bool enablePump = relativeTime_ms < _pwmPumps_ms[index];
+
+    // Stop pouring before the pump runs dry
+    if (enablePump && _isLevelProtectionEnabled && FlowMeter.IsEmpty(index, relativeTime_ms))
+    {
+      _refusedLiquid = index;
+      _isPumpEnabled = false;
+      DisableInternal();
+      FlowMeter.RequestSaveAsync();
+      return;
+    }
+
+    // Write digital pin
+    digitalWrite(LiquidTable[index].PinPump, enablePump ? HIGH : LOW);
+
+    // Add flow time when powering off (falling edge)
+    if (_lastEnablePumps[index] && !enablePump)
+    {
+      FlowMeter.AddFlowTime(index, _pwmPumps_ms[index]);
+    }
+
+    // Save enabled state for next update
+    _lastEnablePumps[index] = enablePump;
+  }
+}
+
+//===============================================================
+// Checks the fill levels for the next pour
+//===============================================================
+void PumpDriver::UpdatePourCheck()
+{
+  uint32_t sumPwm_ms = 0;
+  for (uint8_t index = 0; index < LiquidCount; index++)
+  {
+    sumPwm_ms += _pwmPumps_ms[index];
+  }
+
+  // Every bottle must cover its share of a glass (shares are the pwm ratios)
+  uint8_t refusedLiquid = LiquidCount;
+  for (uint8_t index = 0; index < LiquidCount && sumPwm_ms > 0 && _isLevelProtectionEnabled; index++)
+  {
+    if (_pwmPumps_ms[index] == 0 ||
+      FlowMeter.GetLevelStatus(index) == eLevelUntracked)
+    {
+      continue;
+    }
+
+    uint32_t required_ml = ScaleRatio(POUR_VOLUME_ML, _pwmPumps_ms[index], sumPwm_ms);
+    if (FlowMeter.GetRemaining(index) < required_ml)
+    {
+      refusedLiquid = index;
+      break;
+    }
+  }
+
+  // A running pour is only stopped by an empty bottle (in Update())
+  if (!_isPumpEnabled)
+  {
+    _refusedLiquid = refusedLiquid;
+  }
+}
+
+//===============================================================
+// Returns the liquid, which refuses pouring
+//===============================================================
+uint8_t PumpDriver::GetRefusedLiquid()
+{
+  return _refusedLiquid;
+}
+
+//===============================================================
+// Enables or disables the fill level protection
+//===============================================================
+void PumpDriver::SetLevelProtection(bool isEnabled)
+{
+  _isLevelProtectionEnabled = isEnabled;
 }
@@ -14,6 +14,7 @@
 //===============================================================
 #include <Arduino.h>
 #include "Config.h"
+#include "FixedPointHelper.h"
 #include "FlowMeterDriver.h"
 
 
@@ -23,8 +24,19 @@
 #define DEFAULT_CYCLE_TIMESPAN_MS     (uint32_t)1000
 #define MIN_CYCLE_TIMESPAN_MS         (uint32_t)200
 #define MAX_CYCLE_TIMESPAN_MS         (uint32_t)1000
+#define STEP_CYCLE_TIMESPAN_MS        (uint32_t)20
+#define AUTO_CYCLE_TIMESPAN_MS        (uint32_t)0     // Cycle timespan setting of the automatic mode
 
-#define KEY_CYCLETIMESPAN_MS          "CycleTimespan" // Key name: Maximum string length is 15 bytes, excluding a zero terminator.
+// Pump response model of the automatic mode: Every pulse loses the spin-up time of the pump,
+// the shortest pulse (smallest share) decides about the ratio error of the mixture
+#define PUMP_RESPONSE_MS              (uint32_t)10    // Lost flow time per pulse (motor spin-up)
+#define RATIO_ERROR_TARGET_PERMILLE   (uint32_t)100   // Ratio error target of the automatic mode (10%)
+
+// Shortest pulse of the automatic mode: The ratio error is PUMP_RESPONSE_MS / pulse,
+// so the target is met from PUMP_RESPONSE_MS / RATIO_ERROR_TARGET (100ms) on
+#define MIN_PULSE_MS                  ((PUMP_RESPONSE_MS * 1000 + RATIO_ERROR_TARGET_PERMILLE - 1) / RATIO_ERROR_TARGET_PERMILLE)
+
+#define POUR_VOLUME_ML                (uint32_t)200   // Volume of one glass, a pour is refused if a bottle can't cover its share
 
 
 //===============================================================
@@ -36,18 +48,15 @@ class PumpDriver
     // Constructor
     PumpDriver();
 
-    // Initializes the pump driver
-    void Begin(uint8_t pinPump1, uint8_t pinPump2, uint8_t pinPump3);
+    // Initializes the pump driver (pins are taken from the liquid table)
+    void Begin();
 
     // Return the timestamp of the last user action
     uint32_t GetLastUserAction();
     
-    // Load settings from flash
+    // Load settings from the settings store
     void Load();
 
-    // Save settings to flash
-    void Save();
-
     // Enables pump output
     void IRAM_ATTR Enable();
     
@@ -57,38 +66,63 @@ class PumpDriver
     // Return true, if the pumps are enabled. Otherwise false
     bool IsEnabled();
 
-    // Sets pumps from percentage (0-100%)
-    void SetPumps(double value1_Percentage, double value2_Percentage, double value3_Percentage);
+    // Sets pumps from mixture shares (0-SHARE_FULLSCALE, one value per liquid)
+    void SetPumps(const MixtureShare values_Share[LiquidCount]);
+
+    // Sets all pumps to the same mixture share (0-SHARE_FULLSCALE)
+    void SetAllPumps(MixtureShare value_Share);
 
-    // Sets the cycle timespan in ms (200-1000ms)
+    // Sets the cycle timespan in ms (200-1000ms or AUTO_CYCLE_TIMESPAN_MS, saved by the settings store)
     bool SetCycleTimespan(uint32_t value_ms);
 
-    // Returns the current cycle timespan
+    // Returns the cycle timespan setting (AUTO_CYCLE_TIMESPAN_MS -> automatic mode)
     uint32_t GetCycleTimespan();
+
+    // Returns the cycle timespan of the current mixture (selected by the automatic mode)
+    uint32_t GetActiveCycleTimespan();
+
+    // Returns the predicted ratio error of the current mixture in permille
+    uint32_t GetActiveRatioError();
+
+    // Returns the cycle timespan and the predicted ratio error as string
+    String GetPumpString();
+
+    // Returns the predicted ratio error of pwm timings in permille (pump response model)
+    static uint32_t GetRatioError(const uint32_t pwmPumps_ms[LiquidCount], uint32_t cycleTimespan_ms);
+
+    // Returns the shortest cycle timespan, which meets the ratio error target (pulses of MIN_PULSE_MS and more)
+    static uint32_t SelectCycleTimespan(const uint32_t clip_Share[LiquidCount], uint32_t maxValue_Share);
     
     // Should be called every < 50 ms
     void IRAM_ATTR Update();
 
-  private:
-    // Preferences variable
-    Preferences _preferences;
+    // Checks the fill levels for the next pour, should be called by the loop task
+    void UpdatePourCheck();
 
-    // Pin definitions
-    uint8_t _pinPump1;
-    uint8_t _pinPump2;
-    uint8_t _pinPump3;
+    // Returns the liquid, which refuses pouring (LiquidCount -> pouring allowed)
+    uint8_t GetRefusedLiquid();
 
+    // Enables or disables the fill level protection (e.g. disabled while cleaning)
+    void SetLevelProtection(bool isEnabled);
+
+  private:
     // Timing values
     uint32_t _cycleTimespan_ms = DEFAULT_CYCLE_TIMESPAN_MS;
+    volatile uint32_t _activeCycleTimespan_ms = DEFAULT_CYCLE_TIMESPAN_MS;
     bool _isPumpEnabled = false;
-    uint32_t _pwmPump1_ms = 0;
-    uint32_t _pwmPump2_ms = 0;
-    uint32_t _pwmPump3_ms = 0;
+    uint32_t _pwmPumps_ms[LiquidCount] = {};
+    uint32_t _ratioError_Permille = 0;
+
+    // Mixture of the last SetPumps() call (recalculated on a new cycle timespan)
+    uint32_t _clip_Share[LiquidCount] = {};
+    uint32_t _maxValue_Share = SHARE_PER_PERCENT;
+
+    // Liquid, which refuses pouring (LiquidCount -> pouring allowed)
+    volatile uint8_t _refusedLiquid = LiquidCount;
+    bool _isLevelProtectionEnabled = true;
 
     // Last variables for edge detection
-    bool _lastEnablePump1 = false;
-    bool _lastEnablePump2 = false;
-    bool _lastEnablePump3 = false;
+    bool _lastEnablePumps[LiquidCount] = {};
     uint32_t _lastPumpCycleStart_ms = 0;
     
     // Timestamp of last user action
@@ -96,6 +130,9 @@ class PumpDriver
 
     // Disables pump output (internal)
     void DisableInternal();
+
+    // Calculates the cycle timespan and the pwm timings of the last mixture
+    void UpdatePwm();
 };
 
 
@@ -41,16 +41,60 @@ void SPIFFSImage::Dealloc()
     delete Canvas16;
     Canvas16 = NULL;
   }
+  if (_mask)
+  {
+    free(_mask);
+    _mask = NULL;
+  }
+  if (_lineBuffer)
+  {
+    free(_lineBuffer);
+    _lineBuffer = NULL;
+  }
 }
 
 //===============================================================
 // Draws the canvas on the tft
 //===============================================================
-void SPIFFSImage::Draw(int16_t x, int16_t y, Adafruit_SPITFT *tft, uint16_t transparencyColor)
+void SPIFFSImage::Draw(int16_t x, int16_t y, Adafruit_SPITFT *tft, uint16_t transparencyColor, uint16_t shadowColor, bool asShadow)
+{
+  uint16_t* buffer = Canvas16->getBuffer();
+  int16_t height = Canvas16->height();
+  int16_t width = Canvas16->width();
+
+  // Write pixels
+  tft->startWrite();
+  for (int16_t row = 0; row < height; row++)
+  {
+    for (int16_t column = 0; column < width; column++)
+    {
+      uint16_t currentColor = buffer[row * width + column];
+      if (currentColor != transparencyColor)
+      {
+        tft->writePixel(x + column, y + row, asShadow ? shadowColor : currentColor);
+      }
+    }
+  }
+  tft->endWrite();
+}
+
+//===============================================================
+// Clears the difference between two images
+//===============================================================
+void SPIFFSImage::ClearDiff(int16_t x0, int16_t y0, int16_t x1, int16_t y1, SPIFFSImage* otherImage, Adafruit_SPITFT *tft, uint16_t transparencyColor, uint16_t clearColor)
 {
+  if (otherImage == NULL)
+  {
+    return;
+  }
+
   uint16_t* buffer = Canvas16->getBuffer();
   int16_t height = Canvas16->height();
   int16_t width = Canvas16->width();
+  
+  uint16_t* otherBuffer = otherImage->Canvas16->getBuffer();
+  int16_t otherHeight = otherImage->Canvas16->height();
+  int16_t otherWidth = otherImage->Canvas16->width();
 
   // Write pixels
   tft->startWrite();
@@ -58,10 +102,24 @@ void SPIFFSImage::Draw(int16_t x, int16_t y, Adafruit_SPITFT *tft, uint16_t tran
   {
     for (int16_t column = 0; column < width; column++)
     {
-      uint16_t currentPixel = buffer[row * width + column];
-      if (currentPixel != transparencyColor)
+      uint16_t currentColor = buffer[row * width + column];
+      
+      // Calculate other indexes
+      int16_t otherColumn = column - (x1 - x0);
+      int16_t otherRow = row - (y1 - y0);
+
+      uint16_t otherColor = transparencyColor + 1; // Use color != transparencyColor
+      if (otherColumn > 0 && otherColumn < otherWidth &&
+        otherRow > 0 && otherRow < otherHeight)
       {
-        tft->writePixel(x + column, y + row, currentPixel);
+        otherColor = otherBuffer[otherRow * otherWidth + otherColumn];
+      }
+
+      // Clear color, if current color is not transparent and other color is (must be reset)
+      if (currentColor != transparencyColor &&
+        otherColor == transparencyColor)
+      {
+        tft->writePixel(x0 + column, y0 + row, clearColor);
       }
     }
   }
@@ -71,7 +129,7 @@ void SPIFFSImage::Draw(int16_t x, int16_t y, Adafruit_SPITFT *tft, uint16_t tran
 //===============================================================
 // Moves the canvas on the tft
 //===============================================================
-void SPIFFSImage::Move(int16_t x0, int16_t y0, int16_t x1, int16_t y1, Adafruit_SPITFT *tft, uint16_t clearColor, uint16_t transparencyColor)
+void SPIFFSImage::Move(int16_t x0, int16_t y0, int16_t x1, int16_t y1, Adafruit_SPITFT *tft, uint16_t clearColor, uint16_t transparencyColor, bool onlyClear)
 {
   uint16_t* buffer = Canvas16->getBuffer();
   int16_t height = Canvas16->height();
@@ -108,8 +166,11 @@ void SPIFFSImage::Move(int16_t x0, int16_t y0, int16_t x1, int16_t y1, Adafruit_
   }
   tft->endWrite();
 
-  // Draw new (moved) image
-  Draw(x1, y1, tft, transparencyColor);
+  if (!onlyClear)
+  {
+    // Draw new (moved) image
+    Draw(x1, y1, tft, transparencyColor);
+  }
 }
 
 //===============================================================
@@ -131,6 +192,97 @@ uint16_t SPIFFSImage::GetPixel(int16_t x, int16_t y)
   return 0;
 }
 
+//===============================================================
+// Creates the opacity mask and the line buffer for MoveDirty
+//===============================================================
+bool SPIFFSImage::PrepareMove(uint16_t transparencyColor)
+{
+  if (Canvas16 == NULL)
+  {
+    return false;
+  }
+
+  uint16_t* buffer = Canvas16->getBuffer();
+  int16_t height = Canvas16->height();
+  int16_t width = Canvas16->width();
+  int32_t pixelCount = (int32_t)width * height;
+
+  // Line buffer has space for moves up to the image width
+  if (_mask == NULL)
+  {
+    _mask = (uint8_t*)calloc((pixelCount + 7) / 8, 1);
+  }
+  if (_lineBuffer == NULL)
+  {
+    _lineBuffer = (uint16_t*)malloc(2 * width * sizeof(uint16_t));
+  }
+  if (_mask == NULL || _lineBuffer == NULL)
+  {
+    return false;
+  }
+
+  // Set mask bit for every non transparent pixel
+  for (int32_t index = 0; index < pixelCount; index++)
+  {
+    if (buffer[index] != transparencyColor)
+    {
+      _mask[index >> 3] |= 0x80 >> (index & 7);
+    }
+  }
+  return true;
+}
+
+//===============================================================
+// Moves the canvas on the tft and writes only the changed span
+// of each row (dirty rectangle per row)
+//===============================================================
+void SPIFFSImage::MoveDirty(int16_t x0, int16_t y0, int16_t x1, int16_t y1, Adafruit_SPITFT *tft, uint16_t clearColor, uint16_t transparencyColor)
+{
+  uint16_t* buffer = Canvas16->getBuffer();
+  int16_t height = Canvas16->height();
+  int16_t width = Canvas16->width();
+
+  // Bounding box of old and new image
+  int16_t left = min(x0, x1);
+  int16_t top = min(y0, y1);
+  int16_t right = max(x0, x1) + width;
+  int16_t bottom = max(y0, y1) + height;
+
+  // Fall back to a full clear and draw for large moves
+  if (_mask == NULL || _lineBuffer == NULL || right - left > 2 * width)
+  {
+    Move(x0, y0, x1, y1, tft, clearColor, transparencyColor);
+    return;
+  }
+
+  for (int16_t y = top; y < bottom; y++)
+  {
+    int16_t first = right;
+    int16_t last = left - 1;
+
+    for (int16_t x = left; x < right; x++)
+    {
+      // Old and new color at this display position (transparent parts show the clear color)
+      uint16_t colorOld = IsOpaque(x - x0, y - y0) ? buffer[(y - y0) * width + (x - x0)] : clearColor;
+      uint16_t colorNew = IsOpaque(x - x1, y - y1) ? buffer[(y - y1) * width + (x - x1)] : clearColor;
+      _lineBuffer[x - left] = colorNew;
+
+      // Extend the dirty span of this row
+      if (colorOld != colorNew)
+      {
+        first = min(first, x);
+        last = x;
+      }
+    }
+
+    // Write the dirty span in one address window
+    if (last >= first)
+    {
+      tft->drawRGBBitmap(first, y, &_lineBuffer[first - left], last - first + 1, 1);
+    }
+  }
+}
+
 //===============================================================
 // Constructor
 //===============================================================
@@ -49,18 +49,38 @@ class SPIFFSImage
     int16_t Width() { return Canvas16->width(); }
     
     // Draws the canvas on the tft
-    void Draw(int16_t x, int16_t y, Adafruit_SPITFT *tft, uint16_t transparencyColor);
+    void Draw(int16_t x, int16_t y, Adafruit_SPITFT *tft, uint16_t transparencyColor, uint16_t shadowColor = 0, bool asShadow = false);
+
+    // Clears the difference between two images
+    void ClearDiff(int16_t x0, int16_t y0, int16_t x1, int16_t y1, SPIFFSImage* otherImage, Adafruit_SPITFT *tft, uint16_t transparencyColor, uint16_t clearColor);
 
     // Moves the canvas on the tft
-    void Move(int16_t x0, int16_t y0, int16_t x1, int16_t y1, Adafruit_SPITFT *tft, uint16_t clearColor, uint16_t transparencyColor);
+    void Move(int16_t x0, int16_t y0, int16_t x1, int16_t y1, Adafruit_SPITFT *tft, uint16_t clearColor, uint16_t transparencyColor, bool onlyClear = false);
 
     // Return a pixel at the requested position
     uint16_t GetPixel(int16_t x, int16_t y);
 
+    // Creates the opacity mask and the line buffer for MoveDirty
+    bool PrepareMove(uint16_t transparencyColor);
+
+    // Moves the canvas on the tft and writes only the changed span of each row
+    void MoveDirty(int16_t x0, int16_t y0, int16_t x1, int16_t y1, Adafruit_SPITFT *tft, uint16_t clearColor, uint16_t transparencyColor);
+
+    // Returns true, if the pixel at the requested position is not transparent (requires PrepareMove)
+    bool IsOpaque(int16_t x, int16_t y)
+    {
+      return _mask != NULL && x >= 0 && y >= 0 && x < Canvas16->width() && y < Canvas16->height() &&
+        (_mask[(y * Canvas16->width() + x) >> 3] & (0x80 >> ((y * Canvas16->width() + x) & 7)));
+    }
+
   private:
     // Canvas which stores the pixel data
     GFXcanvas16* Canvas16;
 
+    // Opacity mask (one bit per pixel) and line buffer for MoveDirty
+    uint8_t* _mask = NULL;
+    uint16_t* _lineBuffer = NULL;
+
     // Free/deinitializes variables
     void Dealloc();      
 
@@ -0,0 +1,484 @@
+/**
+ * Includes the settings store (persistent values in RAM, batched flash commits)
+ *
+ * @author    Florian Staeblein
+ * @date      2024/01/28
+ * @copyright © 2024 Florian Staeblein
+ */
+
+#include "SettingsStore.h"
+#include "FlowMeterDriver.h"
+#include "PumpDriver.h"
+
+//===============================================================
+// Global variables
+//===============================================================
+SettingsStore Settings;
+
+//===============================================================
+// Constructor
+//===============================================================
+SettingsStore::SettingsStore()
+{
+  for (uint8_t index = 0; index < LiquidCount; index++)
+  {
+    _mixtureAngles_Degrees[index] = SETTINGS_UNSET;
+  }
+}
+
+//===============================================================
+// Restores all values from flash
+//===============================================================
+void SettingsStore::Begin()
+{
+  if (!_mutex)
+  {
+    _mutex = xSemaphoreCreateMutex();
+  }
+
+  if (!_preferences.begin(SETTINGS_NAME, true))
+  {
+    return;
+  }
+
+  char key[16];
+  for (uint8_t index = 0; index < LiquidCount; index++)
+  {
+    // Mixture angle (invalid values are ignored)
+    snprintf(key, sizeof(key), KEY_MIXTURE_ANGLE, index + 1);
+    int16_t angle_Degrees = _preferences.getShort(key, SETTINGS_UNSET);
+    _mixtureAngles_Degrees[index] = (angle_Degrees >= 0 && angle_Degrees < 360) ? angle_Degrees : SETTINGS_UNSET;
+
+    // Flow time (older firmware saved liters as double, converted once at boot)
+    snprintf(key, sizeof(key), KEY_FLOWTIME_LIQUID, index + 1);
+    if (_preferences.isKey(key))
+    {
+      _flowTimes_ms[index] = _preferences.getULong64(key, 0);
+    }
+    else
+    {
+      snprintf(key, sizeof(key), KEY_FLOW_LIQUID, index + 1);
+      _flowTimes_ms[index] = (uint64_t)(_preferences.getDouble(key, 0.0) / LEGACY_FLOWRATE);
+    }
+
+    // Fill level
+    snprintf(key, sizeof(key), KEY_CAPACITY_LIQUID, index + 1);
+    _capacities_ml[index] = _preferences.getULong(key, 0);
+
+    snprintf(key, sizeof(key), KEY_EMPTYTIME_LIQUID, index + 1);
+    _emptyFlowTimes_ms[index] = (_capacities_ml[index] > 0) ? _preferences.getULong64(key, 0) : 0;
+  }
+
+  _cycleTimespan_ms = (uint32_t)_preferences.getLong(KEY_CYCLETIMESPAN_MS, SETTINGS_UNSET);
+
+#if defined(WIFI_MIXER)
+  _isWifiEnabled = _preferences.getBool(KEY_WIFIMODE, false);
+  _staSsid = _preferences.getString(KEY_STA_SSID, "");
+  _staPassword = _preferences.getString(KEY_STA_PASSWORD, "");
+  _staChannel = _preferences.getInt(KEY_STA_CHANNEL, 0);
+  if (_preferences.getBytes(KEY_STA_BSSID, _staBssid, NETWORK_BSSID_LENGTH) != NETWORK_BSSID_LENGTH)
+  {
+    _staChannel = 0;
+  }
+#endif
+
+  _preferences.end();
+}
+
+//===============================================================
+// Returns a saved mixture angle in degrees
+//===============================================================
+int16_t SettingsStore::GetMixtureAngle(uint8_t liquidIndex)
+{
+  return (liquidIndex < LiquidCount) ? _mixtureAngles_Degrees[liquidIndex] : SETTINGS_UNSET;
+}
+
+//===============================================================
+// Sets a mixture angle in degrees
+//===============================================================
+void SettingsStore::SetMixtureAngle(uint8_t liquidIndex, int16_t angle_Degrees)
+{
+  if (liquidIndex >= LiquidCount ||
+    _mixtureAngles_Degrees[liquidIndex] == angle_Degrees)
+  {
+    return;
+  }
+
+  Lock();
+  _mixtureAngles_Degrees[liquidIndex] = angle_Degrees;
+  _dirtyMixture |= (1UL << liquidIndex);
+  MarkChanged();
+  Unlock();
+}
+
+//===============================================================
+// Returns the saved cycle timespan
+//===============================================================
+uint32_t SettingsStore::GetCycleTimespan()
+{
+  return _cycleTimespan_ms;
+}
+
+//===============================================================
+// Sets the cycle timespan
+//===============================================================
+void SettingsStore::SetCycleTimespan(uint32_t value_ms)
+{
+  if (_cycleTimespan_ms == value_ms)
+  {
+    return;
+  }
+
+  Lock();
+  _cycleTimespan_ms = value_ms;
+  _isCycleTimespanDirty = true;
+  MarkChanged();
+  Unlock();
+}
+
+//===============================================================
+// Returns the flow meter values of a liquid
+//===============================================================
+uint64_t SettingsStore::GetFlowTime(uint8_t liquidIndex)
+{
+  return (liquidIndex < LiquidCount) ? _flowTimes_ms[liquidIndex] : 0;
+}
+
+uint32_t SettingsStore::GetCapacity(uint8_t liquidIndex)
+{
+  return (liquidIndex < LiquidCount) ? _capacities_ml[liquidIndex] : 0;
+}
+
+uint64_t SettingsStore::GetEmptyFlowTime(uint8_t liquidIndex)
+{
+  return (liquidIndex < LiquidCount) ? _emptyFlowTimes_ms[liquidIndex] : 0;
+}
+
+//===============================================================
+// Sets the flow meter values of a liquid
+//===============================================================
+void SettingsStore::SetFlowMeter(uint8_t liquidIndex, uint64_t flowTime_ms, uint32_t capacity_ml, uint64_t emptyFlowTime_ms)
+{
+  if (liquidIndex >= LiquidCount ||
+    (_flowTimes_ms[liquidIndex] == flowTime_ms &&
+    _capacities_ml[liquidIndex] == capacity_ml &&
+    _emptyFlowTimes_ms[liquidIndex] == emptyFlowTime_ms))
+  {
+    return;
+  }
+
+  Lock();
+  _flowTimes_ms[liquidIndex] = flowTime_ms;
+  _capacities_ml[liquidIndex] = capacity_ml;
+  _emptyFlowTimes_ms[liquidIndex] = emptyFlowTime_ms;
+  _dirtyFlowMeter |= (1UL << liquidIndex);
+  MarkChanged();
+  Unlock();
+}
+
+#if defined(WIFI_MIXER)
+//===============================================================
+// Returns true, if the wifi was switched on
+//===============================================================
+bool SettingsStore::GetWifiMode()
+{
+  return _isWifiEnabled;
+}
+
+//===============================================================
+// Sets the wifi mode
+//===============================================================
+void SettingsStore::SetWifiMode(bool isEnabled)
+{
+  if (_isWifiEnabled == isEnabled)
+  {
+    return;
+  }
+
+  Lock();
+  _isWifiEnabled = isEnabled;
+  _isWifiModeDirty = true;
+  MarkChanged();
+  Unlock();
+}
+
+//===============================================================
+// Returns the station credentials and the cached network
+//===============================================================
+void SettingsStore::GetStation(String& ssid, String& password, uint8_t bssid[NETWORK_BSSID_LENGTH], int32_t& channel)
+{
+  Lock();
+  ssid = _staSsid;
+  password = _staPassword;
+  memcpy(bssid, _staBssid, NETWORK_BSSID_LENGTH);
+  channel = _staChannel;
+  Unlock();
+}
+
+//===============================================================
+// Sets the station credentials and the cached network
+//===============================================================
+void SettingsStore::SetStation(const String& ssid, const String& password, const uint8_t bssid[NETWORK_BSSID_LENGTH], int32_t channel)
+{
+  Lock();
+  if (_staSsid != ssid ||
+    _staPassword != password ||
+    memcmp(_staBssid, bssid, NETWORK_BSSID_LENGTH) != 0 ||
+    _staChannel != channel)
+  {
+    _staSsid = ssid;
+    _staPassword = password;
+    memcpy(_staBssid, bssid, NETWORK_BSSID_LENGTH);
+    _staChannel = channel;
+    _isStationDirty = true;
+    MarkChanged();
+  }
+  Unlock();
+}
+#endif
+
+//===============================================================
+// Requests a commit without waiting for the quiet period
+//===============================================================
+void SettingsStore::RequestCommit()
+{
+  _isCommitRequested = true;
+}
+
+//===============================================================
+// Commits changed values after the quiet period or on request
+//===============================================================
+void SettingsStore::Update(bool isBusy)
+{
+  // Flash writes stall the cpu, never while busy
+  if (isBusy)
+  {
+    return;
+  }
+
+  Lock();
+  bool isDirty = IsDirty();
+  bool isQuiet = (millis() - _lastChange_ms) > SETTINGS_QUIET_MS;
+  Unlock();
+
+  if (isDirty && (isQuiet || _isCommitRequested))
+  {
+    Commit();
+  }
+  _isCommitRequested = false;
+}
+
+//===============================================================
+// Commits all changed values to flash now. Each put is a flash
+// write of its own (no transaction), so the pumps are checked
+// again before every key: If they start during the commit, the
+// commit stops and the remaining values stay dirty for the next
+// one (values of several keys are only clean after all of them
+// are written).
+//===============================================================
+void SettingsStore::Commit()
+{
+  Lock();
+  _isCommitStopped = false;
+  if (!IsDirty() ||
+    IsCommitStopped() ||
+    !_preferences.begin(SETTINGS_NAME, false))
+  {
+    Unlock();
+    return;
+  }
+
+  uint32_t start_us = micros();
+  char key[16];
+  for (uint8_t index = 0; index < LiquidCount && !IsCommitStopped(); index++)
+  {
+    if (_dirtyMixture & (1UL << index))
+    {
+      snprintf(key, sizeof(key), KEY_MIXTURE_ANGLE, index + 1);
+      _preferences.putShort(key, _mixtureAngles_Degrees[index]);
+      _dirtyMixture &= ~(1UL << index);
+      _keysWritten++;
+    }
+
+    if ((_dirtyFlowMeter & (1UL << index)) &&
+      CommitFlowMeter(index))
+    {
+      _dirtyFlowMeter &= ~(1UL << index);
+    }
+  }
+
+  if (_isCycleTimespanDirty &&
+    !IsCommitStopped())
+  {
+    _preferences.putLong(KEY_CYCLETIMESPAN_MS, _cycleTimespan_ms);
+    _isCycleTimespanDirty = false;
+    _keysWritten++;
+  }
+
+#if defined(WIFI_MIXER)
+  if (_isWifiModeDirty &&
+    !IsCommitStopped())
+  {
+    _preferences.putBool(KEY_WIFIMODE, _isWifiEnabled);
+    _isWifiModeDirty = false;
+    _keysWritten++;
+  }
+
+  if (_isStationDirty &&
+    CommitStation())
+  {
+    _isStationDirty = false;
+  }
+#endif
+
+  _preferences.end();
+
+  // Update statistics
+  if (_isCommitStopped)
+  {
+    _stoppedCommitCount++;
+  }
+  else
+  {
+    _commitCount++;
+  }
+  _lastCommit_us = micros() - start_us;
+  _maxCommit_us = max(_maxCommit_us, _lastCommit_us);
+  Unlock();
+}
+
+//===============================================================
+// Writes the flow meter keys of a liquid, returns false if the
+// commit stopped before all keys are written
+//===============================================================
+bool SettingsStore::CommitFlowMeter(uint8_t liquidIndex)
+{
+  char key[16];
+  if (IsCommitStopped())
+  {
+    return false;
+  }
+  snprintf(key, sizeof(key), KEY_FLOWTIME_LIQUID, liquidIndex + 1);
+  _preferences.putULong64(key, _flowTimes_ms[liquidIndex]);
+  _keysWritten++;
+
+  if (IsCommitStopped())
+  {
+    return false;
+  }
+  snprintf(key, sizeof(key), KEY_CAPACITY_LIQUID, liquidIndex + 1);
+  _preferences.putULong(key, _capacities_ml[liquidIndex]);
+  _keysWritten++;
+
+  if (IsCommitStopped())
+  {
+    return false;
+  }
+  snprintf(key, sizeof(key), KEY_EMPTYTIME_LIQUID, liquidIndex + 1);
+  _preferences.putULong64(key, _emptyFlowTimes_ms[liquidIndex]);
+  _keysWritten++;
+  return true;
+}
+
+#if defined(WIFI_MIXER)
+//===============================================================
+// Writes the station keys, returns false if the commit stopped
+// before all keys are written
+//===============================================================
+bool SettingsStore::CommitStation()
+{
+  if (IsCommitStopped())
+  {
+    return false;
+  }
+  _preferences.putString(KEY_STA_SSID, _staSsid);
+  _keysWritten++;
+
+  if (IsCommitStopped())
+  {
+    return false;
+  }
+  _preferences.putString(KEY_STA_PASSWORD, _staPassword);
+  _keysWritten++;
+
+  if (IsCommitStopped())
+  {
+    return false;
+  }
+  _preferences.putBytes(KEY_STA_BSSID, _staBssid, NETWORK_BSSID_LENGTH);
+  _keysWritten++;
+
+  if (IsCommitStopped())
+  {
+    return false;
+  }
+  _preferences.putInt(KEY_STA_CHANNEL, _staChannel);
+  _keysWritten++;
+  return true;
+}
+#endif
+
+//===============================================================
+// Returns true, if the running commit has to stop (pumps started,
+// flash writes would stall the pump task). Stays true until the
+// next commit.
+//===============================================================
+bool SettingsStore::IsCommitStopped()
+{
+  _isCommitStopped = _isCommitStopped || Pumps.IsEnabled();
+  return _isCommitStopped;
+}
+
+//===============================================================
+// Returns the commit statistics as string
+//===============================================================
+String SettingsStore::GetSettingsString()
+{
+  return String("Settings: ") + String(_commitCount) + " commits" +
+    ", Stopped: " + String(_stoppedCommitCount) +
+    ", Keys: " + String(_keysWritten) +
+    ", Commit last/max: " + String(_lastCommit_us) + "/" + String(_maxCommit_us) + "us" +
+    ", Dirty: " + (IsDirty() ? "true" : "false");
+}
+
+//===============================================================
+// Returns true, if any value is changed
+//===============================================================
+bool SettingsStore::IsDirty()
+{
+  return _dirtyMixture != 0 ||
+    _dirtyFlowMeter != 0 ||
+    _isCycleTimespanDirty ||
+    _isWifiModeDirty ||
+    _isStationDirty;
+}
+
+//===============================================================
+// Marks a change
+//===============================================================
+void SettingsStore::MarkChanged()
+{
+  _lastChange_ms = millis();
+}
+
+//===============================================================
+// Locks the values
+//===============================================================
+void SettingsStore::Lock()
+{
+  if (_mutex)
+  {
+    xSemaphoreTake(_mutex, portMAX_DELAY);
+  }
+}
+
+//===============================================================
+// Unlocks the values
+//===============================================================
+void SettingsStore::Unlock()
+{
+  if (_mutex)
+  {
+    xSemaphoreGive(_mutex);
+  }
+}
@@ -0,0 +1,167 @@
+/**
+ * Includes the settings store (persistent values in RAM, batched flash commits)
+ *
+ * @author    Florian Staeblein
+ * @date      2024/01/28
+ * @copyright © 2024 Florian Staeblein
+ */
+
+#ifndef SETTINGSSTORE_H
+#define SETTINGSSTORE_H
+
+//===============================================================
+// Includes
+//===============================================================
+#include <Arduino.h>
+#include <Preferences.h>
+#include "Config.h"
+#include "NetworkBackend.h"
+
+//===============================================================
+// Defines
+//===============================================================
+// Key names: Maximum string length is 15 bytes, excluding a zero terminator.
+#define KEY_MIXTURE_ANGLE     "MixAngle%u"    // Key name + liquid number (1-6): Mixture angle in degrees
+#define KEY_CYCLETIMESPAN_MS  "CycleTimespan"
+#define KEY_FLOW_LIQUID       "FlowLiquid%u"  // Key name + liquid number (1-6): Legacy value in liters
+#define KEY_FLOWTIME_LIQUID   "FlowTime%u"    // Key name + liquid number (1-6): Flow time (@100% pump power)
+#define KEY_CAPACITY_LIQUID   "Capacity%u"    // Key name + liquid number (1-6): Bottle capacity in ml of the last refill
+#define KEY_EMPTYTIME_LIQUID  "EmptyTime%u"   // Key name + liquid number (1-6): Flow time at which the bottle is empty
+#define KEY_WIFIMODE          "WifiMode"
+#define KEY_STA_SSID          "StaSsid"
+#define KEY_STA_PASSWORD      "StaPassword"
+#define KEY_STA_BSSID         "StaBssid"
+#define KEY_STA_CHANNEL       "StaChannel"
+
+#define SETTINGS_QUIET_MS     5000            // Changed values are committed after 5 seconds without changes
+#define SETTINGS_UNSET        -1              // Mixture angle or cycle timespan, which was never saved
+
+
+//===============================================================
+// Class for holding all persistent values in RAM. Changed values
+// are marked dirty and committed to flash after a quiet period or
+// on request (e.g. lever release). Each key is a flash write of
+// its own, a commit stops as soon as the pumps start.
+//===============================================================
+class SettingsStore
+{
+  public:
+    // Constructor
+    SettingsStore();
+
+    // Restores all values from flash, call before the other modules load their values
+    void Begin();
+
+    // Returns a saved mixture angle in degrees (SETTINGS_UNSET -> not saved)
+    int16_t GetMixtureAngle(uint8_t liquidIndex);
+
+    // Sets a mixture angle in degrees
+    void SetMixtureAngle(uint8_t liquidIndex, int16_t angle_Degrees);
+
+    // Returns the saved cycle timespan ((uint32_t)SETTINGS_UNSET -> not saved, 0 -> automatic mode)
+    uint32_t GetCycleTimespan();
+
+    // Sets the cycle timespan
+    void SetCycleTimespan(uint32_t value_ms);
+
+    // Returns the flow meter values of a liquid
+    uint64_t GetFlowTime(uint8_t liquidIndex);
+    uint32_t GetCapacity(uint8_t liquidIndex);
+    uint64_t GetEmptyFlowTime(uint8_t liquidIndex);
+
+    // Sets the flow meter values of a liquid
+    void SetFlowMeter(uint8_t liquidIndex, uint64_t flowTime_ms, uint32_t capacity_ml, uint64_t emptyFlowTime_ms);
+
+#if defined(WIFI_MIXER)
+    // Returns true, if the wifi was switched on
+    bool GetWifiMode();
+
+    // Sets the wifi mode (true -> on)
+    void SetWifiMode(bool isEnabled);
+
+    // Returns the station credentials and the cached network of the last connection (channel 0 -> no cache)
+    void GetStation(String& ssid, String& password, uint8_t bssid[NETWORK_BSSID_LENGTH], int32_t& channel);
+
+    // Sets the station credentials and the cached network
+    void SetStation(const String& ssid, const String& password, const uint8_t bssid[NETWORK_BSSID_LENGTH], int32_t channel);
+#endif
+
+    // Requests a commit of the changed values without waiting for the quiet period (thread safe)
+    void RequestCommit();
+
+    // Commits changed values after the quiet period or on request, not while busy (e.g. pumps running)
+    void Update(bool isBusy);
+
+    // Commits all changed values to flash now (stops if the pumps start, the remaining values stay dirty)
+    void Commit();
+
+    // Returns the commit statistics as string
+    String GetSettingsString();
+
+  private:
+    Preferences _preferences;
+    SemaphoreHandle_t _mutex = NULL;
+
+    // Mixture and pump values
+    int16_t _mixtureAngles_Degrees[LiquidCount];
+    uint32_t _cycleTimespan_ms = (uint32_t)SETTINGS_UNSET;
+
+    // Flow meter values
+    uint64_t _flowTimes_ms[LiquidCount] = {};
+    uint32_t _capacities_ml[LiquidCount] = {};
+    uint64_t _emptyFlowTimes_ms[LiquidCount] = {};
+
+#if defined(WIFI_MIXER)
+    // Wifi values
+    bool _isWifiEnabled = false;
+    String _staSsid;
+    String _staPassword;
+    uint8_t _staBssid[NETWORK_BSSID_LENGTH] = {};
+    int32_t _staChannel = 0;
+#endif
+
+    // Dirty values (one bit per liquid or value)
+    uint32_t _dirtyMixture = 0;
+    uint32_t _dirtyFlowMeter = 0;
+    bool _isCycleTimespanDirty = false;
+    bool _isWifiModeDirty = false;
+    bool _isStationDirty = false;
+    uint32_t _lastChange_ms = 0;
+    volatile bool _isCommitRequested = false;
+    bool _isCommitStopped = false;
+
+    // Commit statistics
+    uint32_t _commitCount = 0;
+    uint32_t _stoppedCommitCount = 0;
+    uint32_t _keysWritten = 0;
+    uint32_t _lastCommit_us = 0;
+    uint32_t _maxCommit_us = 0;
+
+    // Writes the keys of a value group, returns false if the commit stopped (call with taken mutex)
+    bool CommitFlowMeter(uint8_t liquidIndex);
+#if defined(WIFI_MIXER)
+    bool CommitStation();
+#endif
+
+    // Returns true, if the commit has to stop because the pumps started (call with taken mutex)
+    bool IsCommitStopped();
+
+    // Returns true, if any value is changed (call with taken mutex)
+    bool IsDirty();
+
+    // Marks a change (call with taken mutex)
+    void MarkChanged();
+
+    // Locks and unlocks the values (the wifi boot task and the web server task read and write values)
+    void Lock();
+    void Unlock();
+};
+
+
+//===============================================================
+// Global variables
+//===============================================================
+extern SettingsStore Settings;
+
+
+#endif
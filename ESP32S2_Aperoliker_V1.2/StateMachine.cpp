@@ -30,6 +30,10 @@ void StateMachine::Begin(uint8_t pinBuzzer)
 
   // Set Defaults
   SetMixtureDefaults();
+  SetBarStockDefaults();
+
+  // Restore the mixture of the last power cycle
+  LoadMixture();
 
   // Update all values
   UpdateValues();
@@ -41,9 +45,10 @@ void StateMachine::Begin(uint8_t pinBuzzer)
 //===============================================================
 bool StateMachine::UpdateValuesFromWifi(uint32_t clientID, uint32_t cycleTimespan_ms)
 {
-  // Check for min and max value
-  if (cycleTimespan_ms < MIN_CYCLE_TIMESPAN_MS ||
-    cycleTimespan_ms > MAX_CYCLE_TIMESPAN_MS)
+  // Check for min and max value (0 -> automatic mode)
+  if (cycleTimespan_ms != AUTO_CYCLE_TIMESPAN_MS &&
+    (cycleTimespan_ms < MIN_CYCLE_TIMESPAN_MS ||
+    cycleTimespan_ms > MAX_CYCLE_TIMESPAN_MS))
   {
     return false;
   }
@@ -65,38 +70,63 @@ bool StateMachine::UpdateValuesFromWifi(uint32_t clientID, uint32_t cycleTimespa
 //===============================================================
 // Updates non volatile values from wifi
 //===============================================================
-bool StateMachine::UpdateValuesFromWifi(uint32_t clientID, bool save)
+bool StateMachine::UpdateValuesFromWifi(uint32_t /*clientID*/, bool /*save*/)
 {
-  // Save cycle timespan value
-  Pumps.Save();
-
+  // Changed values are committed by the settings store after a quiet period
+  // (clients send a save after every slider change)
   return true;
 }
 
 //===============================================================
-// Updates a liquid value from wifi
+// Queues an absolute liquid angle from wifi
 //===============================================================
-bool StateMachine::UpdateValuesFromWifi(uint32_t clientID, MixtureLiquid liquid, int16_t increments_Degrees)
+bool StateMachine::UpdateValuesFromWifi(uint32_t clientID, MixtureLiquid liquid, int16_t angle_Degrees, uint32_t baseVersion, uint32_t sequence)
 {
-  // Check angle for 360 degrees increment or decrement max
-  if (increments_Degrees < -360 ||
-    increments_Degrees > 360)
+  // Products with bar stock have no mixture recipe
+  if (ProductPolicy::HasBarStock)
   {
     return false;
   }
 
-  // Check if ready for update
-  if (_newLiquid != eLiquidNone)
+  // Check angle for 360 degrees space
+  if (angle_Degrees < 0 ||
+    angle_Degrees >= 360)
   {
     return false;
   }
 
-  // Signalize new data to state machine
-  _newLiquidClientID = clientID;
-  _newLiquid = liquid;
-  _newLiquidIncrements_Degrees = increments_Degrees;
+  // Check for valid liquid
+  if (liquid >= LiquidCount)
+  {
+    return false;
+  }
 
-  return true;
+  // Queue target for the state machine (only rejected if the queue is full)
+  return _liquidCommands.Push(clientID, liquid, angle_Degrees, baseVersion, sequence);
+}
+
+//===============================================================
+// Returns the mixture version
+//===============================================================
+uint32_t StateMachine::GetMixtureVersion()
+{
+  return _mixtureVersion;
+}
+
+//===============================================================
+// Returns the mixture version of the last change of a liquid
+// angle and its writer
+//===============================================================
+uint32_t StateMachine::GetAngleVersion(MixtureLiquid liquid, uint32_t& clientID)
+{
+  if (liquid >= LiquidCount)
+  {
+    clientID = 0;
+    return 0;
+  }
+
+  clientID = _angleClientIDs[liquid];
+  return _angleVersions[liquid];
 }
 #endif
 
@@ -105,19 +135,25 @@ bool StateMachine::UpdateValuesFromWifi(uint32_t clientID, MixtureLiquid liquid,
 //===============================================================
 int16_t StateMachine::GetAngle(MixtureLiquid liquid)
 {
-  switch (liquid)
+  if (liquid >= LiquidCount)
   {
-    case eLiquid1:
-      return _liquid1Angle_Degrees;
-    case eLiquid2:
-      return _liquid2Angle_Degrees;
-    case eLiquid3:
-      return _liquid3Angle_Degrees;
-    default:
-      break;
+    return -1;
+  }
+
+  return _liquidAngles_Degrees[liquid];
+}
+
+//===============================================================
+// Returns the bar bottle of a given liquid
+//===============================================================
+BarBottle StateMachine::GetBarBottle(MixtureLiquid liquid)
+{
+  if (liquid >= LiquidCount)
+  {
+    return eEmpty;
   }
 
-  return -1;
+  return _barBottles[liquid];
 }
 
 //===============================================================
@@ -128,51 +164,71 @@ MixerState StateMachine::GetCurrentState()
   return _currentState;
 }
 
+//===============================================================
+// Returns the name of the current mixer state
+//===============================================================
+const char* StateMachine::GetCurrentStateName()
+{
+  return GetStateConfig(_currentState).Name;
+}
+
 #if defined(WIFI_MIXER)
 //===============================================================
 // Handles new wifi data, should be called in state machine
 //===============================================================
 void StateMachine::HandleNewWifiData(MixerEvent event)
 {
-  // General new wifi liquid data handler
-  if (_newLiquid != eLiquidNone)
+  // General new wifi liquid data handler (all pending targets are applied at once)
+  LiquidCommand commands[COMMAND_QUEUE_SIZE];
+  bool isApplied[COMMAND_QUEUE_SIZE];
+  uint8_t commandCount = _liquidCommands.Drain(commands);
+  if (commandCount > 0)
   {
-    // Save values for drawing
-    uint32_t newLiquidClientID = _newLiquidClientID;
-    MixtureLiquid newLiquid = _newLiquid;
-    int16_t newLiquidIcrements_Degrees = _newLiquidIncrements_Degrees;
+    uint32_t newLiquidClientID = commands[0].ClientID;
+    for (uint8_t index = 0; index < commandCount; index++)
+    {
+      const LiquidCommand& command = commands[index];
 
-    // Reset wifi data
-    _newLiquidClientID = 0;
-    _newLiquid = eLiquidNone;
-    _newLiquidIncrements_Degrees = 0;
+      // A target based on an older version loses, if another client or the encoder changed the angle meanwhile
+      isApplied[index] = _angleVersions[command.Liquid] <= command.BaseVersion ||
+        _angleClientIDs[command.Liquid] == command.ClientID;
 
-    // Increment or decrement angle
-    switch (newLiquid)
-    {
-      case eLiquid1:
-        IncrementAngle(&_liquid1Angle_Degrees, _liquid2Angle_Degrees, _liquid3Angle_Degrees, newLiquidIcrements_Degrees);
-        break;
-      case eLiquid2:
-        IncrementAngle(&_liquid2Angle_Degrees, _liquid3Angle_Degrees, _liquid1Angle_Degrees, newLiquidIcrements_Degrees);
-        break;
-      case eLiquid3:
-        IncrementAngle(&_liquid3Angle_Degrees, _liquid1Angle_Degrees, _liquid2Angle_Degrees, newLiquidIcrements_Degrees);
-        break;
-      default:
-        break;
+      // Move angle on the shortest way to the target (clamped to the neighbouring angles)
+      if (isApplied[index])
+      {
+        int16_t distance_Degrees = GetDistanceDegrees(_liquidAngles_Degrees[command.Liquid], command.Target_Degrees);
+        IncrementSectorAngle(_liquidAngles_Degrees, LiquidCount, command.Liquid, distance_Degrees > 180 ? distance_Degrees - 360 : distance_Degrees);
+      }
+
+      // Several clients changed the mixture, every client has to take over the changes
+      if (command.ClientID != newLiquidClientID)
+      {
+        newLiquidClientID = 0;
+      }
     }
 
-    // Update display and pump values
+    // Update display and pump values (creates a new mixture version)
     UpdateValues(newLiquidClientID);
 
+    // Remember the writer of the changed angles and acknowledge the sequence numbers
+    for (uint8_t index = 0; index < commandCount; index++)
+    {
+      const LiquidCommand& command = commands[index];
+      if (isApplied[index] &&
+        _angleVersions[command.Liquid] == _mixtureVersion)
+      {
+        _angleClientIDs[command.Liquid] = command.ClientID;
+      }
+      Wifihandler.AcknowledgeLiquidAngle(command.ClientID, command.Sequence, isApplied[index], command.Received_ms);
+    }
+
     // Draw new values in dashboard mode and at main event
     if (_currentState == eDashboard &&
       event == eMain)
     {
       // Draw current value string and doughnut chart in partial updating mode
       Display.DrawCurrentValues();
-      Display.DrawDoughnutChart3(newLiquidIcrements_Degrees > 0);
+      Display.DrawDoughnutChart();
     }
   }
 
@@ -206,35 +262,291 @@ void StateMachine::HandleNewWifiData(MixerEvent event)
 }
 #endif
 
+//===============================================================
+// State table: Name, parent state, entry debounce time and
+// handler function (entry, main and exit hook) of every mixer
+// state
+//===============================================================
+const StateMachine::StateConfig StateMachine::StateTable[] =
+{
+  { eMenu,        "Menu",        eParentIdle,      500, &StateMachine::FctMenu },
+  { eDashboard,   "Dashboard",   eParentMenuChild, 500, ProductPolicy::HasBarStock ? &StateMachine::FctBarDashboard : &StateMachine::FctDashboard },
+  { eCleaning,    "Cleaning",    eParentMenuChild, 500, &StateMachine::FctCleaning },
+  { eReset,       "Reset",       eParentWifi,      0,   &StateMachine::FctReset },
+  { eSettings,    "Settings",    eParentMenuChild, 500, &StateMachine::FctSettings },
+  { eScreenSaver, "ScreenSaver", eParentRoot,      0,   &StateMachine::FctScreenSaver },
+  { eBar,         "Bar",         eParentMenuChild, 500, &StateMachine::FctBar },
+};
+
+//===============================================================
+// Parent table: Super state and handler function of every parent
+// state (root has no handler)
+//===============================================================
+const StateMachine::ParentConfig StateMachine::ParentTable[] =
+{
+  { eParentRoot,      eParentRoot, NULL },
+  { eParentWifi,      eParentRoot, &StateMachine::FctParentWifi },
+  { eParentIdle,      eParentWifi, &StateMachine::FctParentIdle },
+  { eParentMenuChild, eParentIdle, &StateMachine::FctParentMenuChild },
+};
+
+//===============================================================
+// Transition table: From state, event, guard, action and target
+// state of every transition (see TransitionConfig)
+//===============================================================
+constexpr StateMachine::TransitionConfig StateMachine::TransitionTable[] =
+{
+  // Menu: Enter the selected menu entry on button press
+  { eMenu,        eOnButton,     &StateMachine::IsMenuSelection<eDashboard>, &StateMachine::ActionSelectMenuEntry, eDashboard },
+  { eMenu,        eOnButton,     &StateMachine::IsMenuSelection<eCleaning>,  &StateMachine::ActionSelectMenuEntry, eCleaning },
+  { eMenu,        eOnButton,     &StateMachine::IsMenuSelection<eReset>,     &StateMachine::ActionSelectMenuEntry, eReset },
+  { eMenu,        eOnButton,     &StateMachine::IsMenuSelection<eBar>,       &StateMachine::ActionSelectMenuEntry, eBar },
+  { eMenu,        eOnButton,     &StateMachine::IsMenuSelection<eSettings>,  &StateMachine::ActionSelectMenuEntry, eSettings },
+
+  // Menu entries: Return to menu on long button press
+  { eDashboard,   eOnLongButton, NULL,                                       &StateMachine::ActionReturnToMenu,    eMenu },
+  { eCleaning,    eOnLongButton, NULL,                                       &StateMachine::ActionReturnToMenu,    eMenu },
+  { eBar,         eOnLongButton, NULL,                                       &StateMachine::ActionReturnToMenu,    eMenu },
+  { eSettings,    eOnLongButton, NULL,                                       &StateMachine::ActionReturnToMenu,    eMenu },
+
+  // Reset: Return to dashboard after the reset page display time
+  { eReset,       eOnTimeout,    &StateMachine::IsResetTimeout,              NULL,                                 eDashboard },
+
+  // Idle states: Enter screen saver after timeout
+  { eMenu,        eOnTimeout,    &StateMachine::IsIdleTimeout,               NULL,                                 eScreenSaver },
+  { eDashboard,   eOnTimeout,    &StateMachine::IsIdleTimeout,               NULL,                                 eScreenSaver },
+  { eCleaning,    eOnTimeout,    &StateMachine::IsIdleTimeout,               NULL,                                 eScreenSaver },
+  { eBar,         eOnTimeout,    &StateMachine::IsIdleTimeout,               NULL,                                 eScreenSaver },
+  { eSettings,    eOnTimeout,    &StateMachine::IsIdleTimeout,               NULL,                                 eScreenSaver },
+
+  // Screen saver: Return to the state before the screen saver on user input (dashboard as fallback)
+  { eScreenSaver, eOnUserInput,  &StateMachine::IsHistoryState<eMenu>,       NULL,                                 eMenu },
+  { eScreenSaver, eOnUserInput,  &StateMachine::IsHistoryState<eCleaning>,   NULL,                                 eCleaning },
+  { eScreenSaver, eOnUserInput,  &StateMachine::IsHistoryState<eBar>,        NULL,                                 eBar },
+  { eScreenSaver, eOnUserInput,  &StateMachine::IsHistoryState<eSettings>,   NULL,                                 eSettings },
+  { eScreenSaver, eOnUserInput,  NULL,                                       NULL,                                 eDashboard },
+};
+
+//===============================================================
+// Returns the table entry of a mixer state
+//===============================================================
+const StateMachine::StateConfig& StateMachine::GetStateConfig(MixerState state)
+{
+  for (uint8_t index = 0; index < sizeof(StateTable) / sizeof(StateTable[0]); index++)
+  {
+    if (StateTable[index].State == state)
+    {
+      return StateTable[index];
+    }
+  }
+
+  // In case something went wrong, default state is dashboard
+  return StateTable[eDashboard];
+}
+
 //===============================================================
 // General state machine execution function
 //===============================================================
 void StateMachine::Execute(MixerEvent event)
 {
-  switch (_currentState)
+  MixerState state = _currentState;
+  const StateConfig& config = GetStateConfig(state);
+
+  // Discard user input until the debounce time has elapsed
+  if (event == eMain &&
+    IsDebouncing())
   {
-    case eMenu:
-      FctMenu(event);
-      break;
-    case eCleaning:
-      FctCleaning(event);
-      break;
-    case eReset:
-      FctReset(event);
-      break;
-    case eSettings:
-      FctSettings(event);
-      break;
-    case eScreenSaver:
-      FctScreenSaver(event);
-      break;
-    default:  // In case something went wrong, default case is dashboard
-    case eDashboard:
-      FctDashboard(event);
-      break;
+    DiscardInput();
+  }
+
+  // Run state specific handler
+  (this->*config.Handler)(event);
+
+  // Run shared behaviour of the parent states, from the nearest
+  // parent to the root, as long as no transition was taken
+  if (event == eMain)
+  {
+    ParentState parent = config.Parent;
+    while (parent != eParentRoot && _currentState == state)
+    {
+      (this->*ParentTable[parent].Handler)();
+      parent = ParentTable[parent].Super;
+    }
   }
 }
 
+//===============================================================
+// Takes the transition of the transition table for an event
+//===============================================================
+bool StateMachine::Dispatch(TransitionEvent event)
+{
+  for (const TransitionConfig& transition : TransitionTable)
+  {
+    if (transition.From == _currentState &&
+      transition.Event == event &&
+      (transition.Guard == NULL || (this->*transition.Guard)()))
+    {
+      TransitionTo(transition.To, transition.Action);
+      return true;
+    }
+  }
+  return false;
+}
+
+//===============================================================
+// Changes the state with exit hook, transition action and entry
+// hook
+//===============================================================
+void StateMachine::TransitionTo(MixerState state, void (StateMachine::*action)())
+{
+  uint32_t start_us = micros();
+  MixerState lastState = _currentState;
+
+  // Exit old state and enter new state
+  Execute(eExit);
+  if (action != NULL)
+  {
+    (this->*action)();
+  }
+  _currentState = state;
+  Execute(eEntry);
+
+  // Save transition latency
+  _lastTransition_us = micros() - start_us;
+  _maxTransition_us = max(_maxTransition_us, _lastTransition_us);
+  _lastTransitionFrom = lastState;
+  _transitionCount++;
+
+  // Reset and ignore user input, debounce page change
+  DiscardInput();
+  Debounce(GetStateConfig(state).EntryDebounce_ms);
+}
+
+//===============================================================
+// Discards user input for the debounce time
+//===============================================================
+void StateMachine::Debounce(uint16_t debounce_ms)
+{
+  _debounceTimestamp_ms = millis();
+  _debounceTime_ms = debounce_ms;
+}
+
+//===============================================================
+// Returns true, if the debounce time has not elapsed
+//===============================================================
+bool StateMachine::IsDebouncing()
+{
+  return millis() - _debounceTimestamp_ms < _debounceTime_ms;
+}
+
+//===============================================================
+// Resets and ignores pending user input
+//===============================================================
+void StateMachine::DiscardInput()
+{
+  EncoderButton.GetEncoderIncrements();
+  EncoderButton.IsLongButtonPress();
+  EncoderButton.IsButtonPress();
+}
+
+//===============================================================
+// Function parent state with wifi
+//===============================================================
+void StateMachine::FctParentWifi()
+{
+#if defined(WIFI_MIXER)
+  // Draw wifi icons
+  Display.DrawWifiIcons();
+
+  // Check for new wifi data and handle it if required
+  HandleNewWifiData(eMain);
+#endif
+}
+
+//===============================================================
+// Function parent state with screen saver timeout
+//===============================================================
+void StateMachine::FctParentIdle()
+{
+  // Enter screen saver mode after timeout and return to the current state afterwards
+  Dispatch(eOnTimeout);
+}
+
+//===============================================================
+// Function parent state of the menu entries
+//===============================================================
+void StateMachine::FctParentMenuChild()
+{
+  // Check for long button press
+  if (EncoderButton.IsLongButtonPress())
+  {
+    // Return to menu mode with the current state selected
+    Dispatch(eOnLongButton);
+  }
+}
+
+//===============================================================
+// Transition guard: No user action and no running pumps for the
+// screen saver timeout
+//===============================================================
+bool StateMachine::IsIdleTimeout()
+{
+  return millis() - EncoderButton.GetLastUserAction() > SCREENSAVER_TIMEOUT_MS &&
+    millis() - Pumps.GetLastUserAction() > SCREENSAVER_TIMEOUT_MS;
+}
+
+//===============================================================
+// Transition guard: Reset page display time elapsed
+//===============================================================
+bool StateMachine::IsResetTimeout()
+{
+  return (millis() - _resetTimestamp) > ResetTime_ms;
+}
+
+//===============================================================
+// Transition action: Enter the selected menu entry
+//===============================================================
+void StateMachine::ActionSelectMenuEntry()
+{
+  // Short beep sound
+  tone(_pinBuzzer, 500, 40);
+}
+
+//===============================================================
+// Transition action: Return to menu with the current state
+// selected
+//===============================================================
+void StateMachine::ActionReturnToMenu()
+{
+  // Short beep sound
+  tone(_pinBuzzer, 800, 40);
+
+  // Exit hook already ran, current state is still the menu entry
+  _currentMenuState = _currentState;
+}
+
+//===============================================================
+// Returns the transition statistics as string
+//===============================================================
+String StateMachine::GetTransitionString()
+{
+  return String("Transitions: ") + String(_transitionCount) +
+    ", Last: " + GetStateConfig(_lastTransitionFrom).Name + " -> " + GetStateConfig(_currentState).Name + " " + String(_lastTransition_us) + "us" +
+    ", Max: " + String(_maxTransition_us) + "us"
+#if defined(WIFI_MIXER)
+    + ", Wifi increments: " + String(_liquidCommands.GetAcceptedCount()) + " accepted, " + String(_liquidCommands.GetRejectedCount()) + " rejected"
+#endif
+    ;
+}
+
+//===============================================================
+// Returns the count of state transitions since power on
+//===============================================================
+uint32_t StateMachine::GetTransitionCount()
+{
+  return _transitionCount;
+}
+
 //===============================================================
 // Function menu state
 //===============================================================
@@ -250,13 +562,6 @@ void StateMachine::FctMenu(MixerEvent event)
         // Show menu page
         Serial.println("[MAIN] Enter Menu Mode");
         Display.ShowMenuPage();
-
-        // Debounce page change
-        delay(500);
-
-        // Reset and ignore user input
-        EncoderButton.GetEncoderIncrements();
-        EncoderButton.IsButtonPress();
       }
       break;
     case eMain:
@@ -267,24 +572,17 @@ void StateMachine::FctMenu(MixerEvent event)
         // Check for changed encoder value
         if (currentEncoderIncrements != 0)
         {
-          // Increment or decrement current menu state
-          switch (_currentMenuState)
+          // Move current menu state up or down in the menu table (without overflow)
+          uint8_t menuIndex = GetMenuIndex(_currentMenuState);
+          if (currentEncoderIncrements > 0 && menuIndex > 0)
+          {
+            menuIndex--;
+          }
+          else if (currentEncoderIncrements < 0 && menuIndex < MenuCount - 1)
           {
-            case eDashboard:
-              _currentMenuState = currentEncoderIncrements > 0 ? eDashboard : eCleaning;
-              break;
-            case eCleaning:
-              _currentMenuState = currentEncoderIncrements > 0 ? eDashboard : eReset;
-              break;
-            case eReset:
-              _currentMenuState = currentEncoderIncrements > 0 ? eCleaning : eSettings;
-              break;
-            case eSettings:
-              _currentMenuState = currentEncoderIncrements > 0 ? eReset : eSettings;
-              break;
-            default:
-              break;
+            menuIndex++;
           }
+          _currentMenuState = MenuTable[menuIndex];
             
           // Update display and pump values
           UpdateValues();
@@ -293,36 +591,11 @@ void StateMachine::FctMenu(MixerEvent event)
           Display.DrawMenu();
         }
 
-#if defined(WIFI_MIXER)
-        // Draw wifi icons
-        Display.DrawWifiIcons();
-
-        // Check for new wifi data and handle it if required
-        HandleNewWifiData(event);
-#endif
-
         // Check for button press
         if (EncoderButton.IsButtonPress())
         {
-          // Short beep sound
-          tone(_pinBuzzer, 500, 40);
-
           // Exit menu and enter new selected mode
-          Execute(eExit);
-          _currentState = _currentMenuState;
-          Execute(eEntry);
-          return;
-        }
-
-        // Check for screen saver timeout
-        if (millis() - EncoderButton.GetLastUserAction() > SCREENSAVER_TIMEOUT_MS &&
-          millis() - Pumps.GetLastUserAction() > SCREENSAVER_TIMEOUT_MS)
-        {
-          // Exit menu mode and enter screen saver mode
-          Execute(eExit);
-          _lastState = eMenu;
-          _currentState = eScreenSaver;
-          Execute(eEntry);
+          Dispatch(eOnButton);
           return;
         }
       }
@@ -348,14 +621,6 @@ void StateMachine::FctDashboard(MixerEvent event)
         // Show dashboard page
         Serial.println("[MAIN] Enter Dashboard Mode");
         Display.ShowDashboardPage();
-
-        // Debounce page change
-        delay(500);
-
-        // Reset and ignore user input
-        EncoderButton.GetEncoderIncrements();
-        EncoderButton.IsLongButtonPress();
-        EncoderButton.IsButtonPress();
       }
       break;
     case eMain:
@@ -367,19 +632,9 @@ void StateMachine::FctDashboard(MixerEvent event)
         if (currentEncoderIncrements != 0)
         {
           // Increment or decrement angle
-          switch (_dashboardLiquid)
+          if (_dashboardLiquid < LiquidCount)
           {
-            case eLiquid1:
-              IncrementAngle(&_liquid1Angle_Degrees, _liquid2Angle_Degrees, _liquid3Angle_Degrees, currentEncoderIncrements * STEPANGLE_DEGREES);
-              break;
-            case eLiquid2:
-              IncrementAngle(&_liquid2Angle_Degrees, _liquid3Angle_Degrees, _liquid1Angle_Degrees, currentEncoderIncrements * STEPANGLE_DEGREES);
-              break;
-            case eLiquid3:
-              IncrementAngle(&_liquid3Angle_Degrees, _liquid1Angle_Degrees, _liquid2Angle_Degrees, currentEncoderIncrements * STEPANGLE_DEGREES);
-              break;
-            default:
-              break;
+            IncrementSectorAngle(_liquidAngles_Degrees, LiquidCount, _dashboardLiquid, currentEncoderIncrements * STEPANGLE_DEGREES);
           }
 
           // Update display and pump values
@@ -387,7 +642,7 @@ void StateMachine::FctDashboard(MixerEvent event)
           
           // Draw current value string and doughnut chart in partial updating mode
           Display.DrawCurrentValues();
-          Display.DrawDoughnutChart3(currentEncoderIncrements > 0);
+          Display.DrawDoughnutChart();
         }
 
         // Check for button press
@@ -404,45 +659,84 @@ void StateMachine::FctDashboard(MixerEvent event)
           
           // Draw legend and doughnut chart in partial updating mode
           Display.DrawLegend();
-          Display.DrawDoughnutChart3(false);
+          Display.DrawDoughnutChart();
           
           // Debounce settings change
-          delay(200);
+          Debounce(SETTINGS_DEBOUNCE_MS);
         }
 
-#if defined(WIFI_MIXER)
-        // Draw wifi icons
-        Display.DrawWifiIcons();
+        // Draw fill level warning in partial updating mode
+        Display.DrawLevelWarning();
+      }
+      break;
+    case eExit:
+    default:
+      break;
+  }
+}
 
-        // Check for new wifi data and handle it if required
-        HandleNewWifiData(event);
-#endif
+//===============================================================
+// Function dashboard state (products with bar stock)
+//===============================================================
+void StateMachine::FctBarDashboard(MixerEvent event)
+{
+  switch(event)
+  {
+    case eEntry:
+      {
+        // Skip empty bottle settings
+        SelectNextBarBottle(true);
 
-        // Check for long button press
-        if (EncoderButton.IsLongButtonPress())
-        {
-          // Short beep sound
-          tone(_pinBuzzer, 800, 40);
+        // Update display and pump values
+        UpdateValues();
 
-          // Exit dashboard and enter menu mode
-          Execute(eExit);
-          _currentState = eMenu;
-          _currentMenuState = eDashboard;
-          Execute(eEntry);
-          return;
+        // Show dashboard page
+        Serial.println("[MAIN] Enter Dashboard Mode");
+        Display.ShowDashboardPage();
+      }
+      break;
+    case eMain:
+      {
+        // Read encoder increments (resets the counter value)
+        int16_t currentEncoderIncrements = EncoderButton.GetEncoderIncrements();
+
+        // Will be true, if new encoder position is available
+        if (currentEncoderIncrements != 0)
+        {
+          // Increment or decrement spritzer percentage of the selected bottle
+          if (_dashboardLiquid < LiquidCount)
+          {
+            _spritzerPercentages[_dashboardLiquid] = max(min(_spritzerPercentages[_dashboardLiquid] + currentEncoderIncrements, MAX_SPRITZER_PERCENTAGE), 0);
+          }
+          
+          // Update display and pump values
+          UpdateValues();
+          
+          // Draw bar
+          Display.DrawBar(true);
         }
 
-        // Check for screen saver timeout
-        if (millis() - EncoderButton.GetLastUserAction() > SCREENSAVER_TIMEOUT_MS &&
-          millis() - Pumps.GetLastUserAction() > SCREENSAVER_TIMEOUT_MS)
+        // Check for button press
+        if (EncoderButton.IsButtonPress())
         {
-          // Exit dashboard mode and enter screen saver mode
-          Execute(eExit);
-          _lastState = eDashboard;
-          _currentState = eScreenSaver;
-          Execute(eEntry);
-          return;
+          // Short beep sound
+          tone(_pinBuzzer, 500, 40);
+
+          // Skip empty bottle settings
+          SelectNextBarBottle(false);
+          
+          // Update all values
+          UpdateValues();
+          
+          // Draw bar
+          Display.DrawBar(true);
+          
+          // Debounce settings change
+          Debounce(SETTINGS_DEBOUNCE_MS);
         }
+
+        // Draw fill level warning in partial updating mode
+        Display.DrawLevelWarning();
       }
       break;
     case eExit:
@@ -463,16 +757,12 @@ void StateMachine::FctCleaning(MixerEvent event)
         // Update display and pump values
         UpdateValues();
 
+        // Cleaning runs water through the pumps, ignore the fill levels
+        Pumps.SetLevelProtection(false);
+
         // Show cleaning page
         Serial.println("[MAIN] Enter Cleaning Mode");
         Display.ShowCleaningPage();
-
-        // Debounce page change
-        delay(500);
-
-        // Reset and ignore user input
-        EncoderButton.IsButtonPress();
-        EncoderButton.IsLongButtonPress();
       }
       break;
     case eMain:
@@ -490,48 +780,18 @@ void StateMachine::FctCleaning(MixerEvent event)
           UpdateValues();
 
           // Draw checkboxes
-          Display.DrawCheckBoxes();
+          Display.DrawCheckBoxes(_cleaningLiquid);
 
           // Debounce settings change
-          delay(200);
-        }
-
-#if defined(WIFI_MIXER)
-        // Draw wifi icons
-        Display.DrawWifiIcons();
-
-        // Check for new wifi data and handle it if required
-        HandleNewWifiData(event);
-#endif
-
-        // Check for long button press
-        if (EncoderButton.IsLongButtonPress())
-        {
-          // Short beep sound
-          tone(_pinBuzzer, 800, 40);
-
-          // Exit cleaning mode and return to menu mode
-          Execute(eExit);
-          _currentState = eMenu;
-          _currentMenuState = eCleaning;
-          Execute(eEntry);
-          return;
-        }
-        
-        // Check for screen saver timeout
-        if (millis() - EncoderButton.GetLastUserAction() > SCREENSAVER_TIMEOUT_MS &&
-          millis() - Pumps.GetLastUserAction() > SCREENSAVER_TIMEOUT_MS)
-        {
-          // Exit cleaning mode and enter screen saver mode
-          Execute(eExit);
-          _lastState = eCleaning;
-          _currentState = eScreenSaver;
-          Execute(eEntry);
-          return;
+          Debounce(SETTINGS_DEBOUNCE_MS);
         }
       }
       break;
     case eExit:
+      {
+        Pumps.SetLevelProtection(true);
+      }
+      break;
     default:
       break;
   }
@@ -565,24 +825,104 @@ void StateMachine::FctReset(MixerEvent event)
       break;
     case eMain:
       {
+        // Exit reset mode and return to dashboard mode after the reset page display time
+        Dispatch(eOnTimeout);
+      }
+      break;
+    case eExit:
+    default:
+      break;
+  }
+}
 
-#if defined(WIFI_MIXER)
-        // Check for new wifi data and handle it if required
-        HandleNewWifiData(event);
-#endif
+//===============================================================
+// Function bar state
+//===============================================================
+void StateMachine::FctBar(MixerEvent event)
+{
+  switch(event)
+  {
+    case eEntry:
+      {        
+        // Changed bottles are placed on confirm or when leaving the bar page
+        memcpy(_placedBarBottles, _barBottles, sizeof(_barBottles));
+
+        // Update all values
+        UpdateValues();
+        
+        // Show bar page
+        Serial.println("[MAIN] Enter Bar Mode");
+        Display.ShowBarPage();
+      }
+      break;
+    case eMain:
+      {
+        // Read encoder increments (resets the counter value)
+        int16_t currentEncoderIncrements = EncoderButton.GetEncoderIncrements();
 
-        // Wait for the reset page display time
-        if ((millis() - _resetTimestamp) > ResetTime_ms)
+        // Will be true, if new encoder position is available
+        if (currentEncoderIncrements != 0 &&
+          _dashboardLiquid < LiquidCount)
         {
-          // Exit reset mode and return to dashboard mode
-          Execute(eExit);
-          _currentState = eDashboard;
-          Execute(eEntry);
-          return;
+          // Only one bottle of sparkling water is allowed in the bar stock
+          BarBottle firstBarBottle = HasBarBottle(eSparklingWater, _dashboardLiquid) ? eEmpty : eSparklingWater;
+          BarBottle barBottle = _barBottles[_dashboardLiquid];
+
+          // Increment or decrement current bottle taking into account the overflow
+          if (currentEncoderIncrements > 0)
+          {
+            _barBottles[_dashboardLiquid] = barBottle + 1 >= BarBottleMax ? firstBarBottle : (BarBottle)(barBottle + 1);
+          }
+          else
+          {
+            _barBottles[_dashboardLiquid] = barBottle - 1 < firstBarBottle ? (BarBottle)(BarBottleMax - 1) : (BarBottle)(barBottle - 1);
+          }
+
+          // Short beep sound
+          tone(_pinBuzzer, 500, 40);
+
+          // Update display and pump values
+          UpdateValues();
+          
+          // Draw bar
+          Display.DrawBar(false);
+          
+          // Debounce settings change
+          Debounce(SETTINGS_DEBOUNCE_MS);
+        }
+
+        // Check for button press
+        if (EncoderButton.IsButtonPress())
+        {
+          // Short beep sound
+          tone(_pinBuzzer, 500, 40);
+
+          // Confirms the bottle of the current setting
+          PlaceBarBottle(_dashboardLiquid);
+
+          // Incrementing the setting value taking into account the overflow
+          _dashboardLiquid = _dashboardLiquid + 1 >= (MixtureLiquid)MixtureLiquidDashboardMax ? eLiquid1 : (MixtureLiquid)(_dashboardLiquid + 1);
+
+          // Update all values
+          UpdateValues();
+          
+          // Draw bar
+          Display.DrawBar(false);
+          
+          // Debounce settings change
+          Debounce(SETTINGS_DEBOUNCE_MS);
         }
       }
       break;
     case eExit:
+      {
+        // Place all changed bottles when leaving the bar page
+        for (uint8_t index = 0; index < LiquidCount; index++)
+        {
+          PlaceBarBottle(index);
+        }
+      }
+      break;
     default:
       break;
   }
@@ -603,14 +943,6 @@ void StateMachine::FctSettings(MixerEvent event)
         // Show settings page
         Serial.println("[MAIN] Enter Settings Mode");
         Display.ShowSettingsPage();
-        
-        // Debounce page change
-        delay(500);
-
-        // Reset and ignore user input
-        EncoderButton.GetEncoderIncrements();
-        EncoderButton.IsLongButtonPress(); 
-        EncoderButton.IsButtonPress();
       }
       break;
     case eMain:
@@ -621,8 +953,21 @@ void StateMachine::FctSettings(MixerEvent event)
         // Will be true, if new encoder position is available
         if (currentEncoderIncrements != 0)
         {
-          // Update cycle timespan
-          Pumps.SetCycleTimespan(Pumps.GetCycleTimespan() + currentEncoderIncrements * 20);
+          // Update cycle timespan (below the min value -> automatic mode)
+          int32_t cycleTimespan_ms = (int32_t)Pumps.GetCycleTimespan();
+          if (cycleTimespan_ms == (int32_t)AUTO_CYCLE_TIMESPAN_MS)
+          {
+            cycleTimespan_ms = (currentEncoderIncrements > 0) ? (int32_t)MIN_CYCLE_TIMESPAN_MS : (int32_t)AUTO_CYCLE_TIMESPAN_MS;
+          }
+          else
+          {
+            cycleTimespan_ms += currentEncoderIncrements * (int32_t)STEP_CYCLE_TIMESPAN_MS;
+            if (cycleTimespan_ms < (int32_t)MIN_CYCLE_TIMESPAN_MS)
+            {
+              cycleTimespan_ms = AUTO_CYCLE_TIMESPAN_MS;
+            }
+          }
+          Pumps.SetCycleTimespan((uint32_t)cycleTimespan_ms);
 
 #if defined(WIFI_MIXER)
           // Update wifi clients (client ID = 0 -> no client)
@@ -637,8 +982,8 @@ void StateMachine::FctSettings(MixerEvent event)
         // Check for short button press
         if (EncoderButton.IsButtonPress())
         {
-          // Update wifi mode
-          Wifihandler.SetWifiMode(Wifihandler.GetWifiMode() == WIFI_MODE_AP ? WIFI_MODE_NULL : WIFI_MODE_AP);
+          // Update wifi mode (station mode falls back to access point without credentials)
+          Wifihandler.SetWifiMode(Wifihandler.GetWifiMode() == WIFI_MODE_NULL ? WIFI_MODE_STA : WIFI_MODE_NULL);
 
           // Short beep sound
           tone(_pinBuzzer, 500, 40);
@@ -647,47 +992,15 @@ void StateMachine::FctSettings(MixerEvent event)
           Display.DrawWifiIcons(true);
           Display.DrawSettings();
         }
-
-        // Draw wifi icons
-        Display.DrawWifiIcons();
-
-        // Check for new wifi data and handle it if required
-        HandleNewWifiData(event);
 #endif
-
-        // Check for long button press
-        if (EncoderButton.IsLongButtonPress())
-        {
-          // Short beep sound
-          tone(_pinBuzzer, 800, 40);
-
-          // Exit cleaning mode and return to menu mode
-          Execute(eExit);
-          _currentState = eMenu;
-          _currentMenuState = eSettings;
-          Execute(eEntry);
-          return;
-        }
-
-        // Check for screen saver timeout
-        if (millis() - EncoderButton.GetLastUserAction() > SCREENSAVER_TIMEOUT_MS &&
-          millis() - Pumps.GetLastUserAction() > SCREENSAVER_TIMEOUT_MS)
-        {
-          // Exit settings mode and enter screen saver mode
-          Execute(eExit);
-          _lastState = eSettings;
-          _currentState = eScreenSaver;
-          Execute(eEntry);
-          return;
-        }
       }
       break;
     case eExit:
       {
-        Pumps.Save();
 #if defined(WIFI_MIXER)
         Wifihandler.Save();
 #endif
+        Settings.Commit();
       }
       break;
     default:
@@ -710,17 +1023,67 @@ void StateMachine::FctScreenSaver(MixerEvent event)
         // Show page
         Serial.println("[MAIN] Enter Screen Saver Mode");
         Display.ShowScreenSaverPage();
-        
-        // Reset and ignore user input
-        EncoderButton.GetEncoderIncrements();
-        EncoderButton.IsLongButtonPress(); 
-        EncoderButton.IsButtonPress();
+        Power.SetTier(eTierScreenSaver);
       }
       break;
     case eMain:
       {
-        // Draw screen saver
-        Display.DrawScreenSaver();
+        // Select idle tier by the time since the last user action
+        uint32_t idle_ms = min(millis() - EncoderButton.GetLastUserAction(), millis() - Pumps.GetLastUserAction());
+        IdleTier tier = eTierScreenSaver;
+        if (idle_ms > IDLE_SLEEP_TIMEOUT_MS && IsLightSleepAllowed())
+        {
+          tier = eTierSleep;
+        }
+        else if (idle_ms > IDLE_STATIC_TIMEOUT_MS)
+        {
+          tier = eTierStatic;
+        }
+
+        bool isTierChanged = Power.SetTier(tier);
+#if defined(DEBUG_MIXER)
+        if (isTierChanged)
+        {
+          Serial.println("[MAIN] Idle tier " + String(tier));
+        }
+#endif
+#if defined(WIFI_MIXER)
+        // Modem sleep while no client is connected (no effect in access point mode), clients connecting or leaving change it too
+        bool isModemSleep = tier >= eTierStatic && Wifihandler.GetConnectedClients() == 0;
+        if (isTierChanged || isModemSleep != _isModemSleep)
+        {
+          WiFi.setSleep(isModemSleep);
+          _isModemSleep = isModemSleep;
+        }
+#endif
+
+        // Draw screen saver animation (static and sleep tiers keep the last frame)
+        if (tier == eTierScreenSaver)
+        {
+          Display.DrawScreenSaver();
+        }
+
+#if defined(WIFI_MIXER)
+        // Clients keep changing the mixture (queued targets are applied and acknowledged)
+        HandleNewWifiData(event);
+#endif
+
+        // Sleep until user input
+        if (tier == eTierSleep)
+        {
+          Display.SetSleep(true);
+          Power.LightSleep();
+          Display.SetSleep(false);
+
+          // The wake up press is no short button press
+          EncoderButton.IgnoreCurrentButtonPress();
+          EncoderButton.SetUserAction();
+          
+          // Exit screen saver mode and return to last mode
+          Dispatch(eOnUserInput);
+          Power.WakeFinished();
+          return;
+        }
         
         // Check for user input
         if (EncoderButton.GetEncoderIncrements() != 0 ||
@@ -729,126 +1092,326 @@ void StateMachine::FctScreenSaver(MixerEvent event)
           Pumps.IsEnabled())
         {
           // Exit screen saver mode and return to last mode
-          Execute(eExit);
-          _currentState = _lastState;
-          Execute(eEntry);
+          Dispatch(eOnUserInput);
           return;
         }
       }
       break;
     case eExit:
+      {
+        Power.SetTier(eTierActive);
+#if defined(WIFI_MIXER)
+        WiFi.setSleep(false);
+        _isModemSleep = false;
+#endif
+      }
+      break;
     default:
       break;
   }
 }
 
+//===============================================================
+// Returns true, if no function requires the device to stay awake
+//===============================================================
+bool StateMachine::IsLightSleepAllowed()
+{
+#if defined(WIFI_MIXER)
+  // Light sleep would stop the access point
+  return Wifihandler.GetWifiMode() == WIFI_MODE_NULL;
+#else
+  return true;
+#endif
+}
+
 //===============================================================
 // Resets the mixture to default recipe
 //===============================================================
 void StateMachine::SetMixtureDefaults()
 { 
-  // Set mixture to:
-  // Aperol: 34%, Soda: 16%, Prosecco: 50% (Official Aperol recipe)
-  _liquid1Angle_Degrees = 0;                                                  // 33,33%
-  _liquid2Angle_Degrees = _liquid1Angle_Degrees + 120;                        // 15,83%
-  _liquid3Angle_Degrees = _liquid1Angle_Degrees + _liquid2Angle_Degrees + 57; // 50,84%
+  // Set mixture to the default angles of the liquid table
+  for (uint8_t index = 0; index < LiquidCount; index++)
+  {
+    _liquidAngles_Degrees[index] = LiquidTable[index].DefaultAngle_Degrees;
+  }
 }
 
 //===============================================================
-// Updates all values in display, pumps driver and wifi
+// Restores the saved mixture (incomplete mixtures or angles
+// IncrementSectorAngle could not have set, e.g. after a power
+// loss during a commit, keep the default recipe)
 //===============================================================
-void StateMachine::UpdateValues(uint32_t clientID)
+void StateMachine::LoadMixture()
 {
-  int16_t liquid1Distance_Degrees = GetDistanceDegrees(_liquid1Angle_Degrees, _liquid2Angle_Degrees);
-  int16_t liquid2Distance_Degrees = GetDistanceDegrees(_liquid2Angle_Degrees, _liquid3Angle_Degrees);
-  int16_t liquid3Distance_Degrees = GetDistanceDegrees(_liquid3Angle_Degrees, _liquid1Angle_Degrees);
+  int16_t liquidAngles_Degrees[LiquidCount];
+  for (uint8_t index = 0; index < LiquidCount; index++)
+  {
+    liquidAngles_Degrees[index] = Settings.GetMixtureAngle(index);
+    if (liquidAngles_Degrees[index] == SETTINGS_UNSET)
+    {
+      return;
+    }
+  }
 
-  // Avoid minimal setable value >0%. If an angle is at its min angle, mute
-  // it to zero and add the angle distance to the greater one of the two others
-  if (liquid1Distance_Degrees == MINANGLE_DEGREES)
+  if (!IsValidSectorAngles(liquidAngles_Degrees, LiquidCount))
+  {
+    return;
+  }
+
+  for (uint8_t index = 0; index < LiquidCount; index++)
   {
-    if (liquid2Distance_Degrees > liquid3Distance_Degrees)
+    _liquidAngles_Degrees[index] = liquidAngles_Degrees[index];
+  }
+}
+
+//===============================================================
+// Resets the bar stock to default bottles
+//===============================================================
+void StateMachine::SetBarStockDefaults()
+{
+  // Red, white and rose wine, each with the default spritzer percentage
+  for (uint8_t index = 0; index < LiquidCount; index++)
+  {
+    _barBottles[index] = (BarBottle)(eRedWine + index % (BarBottleMax - eRedWine));
+    _spritzerPercentages[index] = DEFAULT_SPRITZER_PERCENTAGE;
+  }
+  // The default bottles are placed, their fill levels are kept
+  memcpy(_placedBarBottles, _barBottles, sizeof(_barBottles));
+}
+
+//===============================================================
+// Returns true, if a bottle is in the bar stock (optionally
+// ignoring one liquid)
+//===============================================================
+bool StateMachine::HasBarBottle(BarBottle barBottle, uint8_t ignoredIndex)
+{
+  for (uint8_t index = 0; index < LiquidCount; index++)
+  {
+    if (index != ignoredIndex && _barBottles[index] == barBottle)
     {
-      liquid2Distance_Degrees += liquid1Distance_Degrees;
+      return true;
     }
-    else
+  }
+  return false;
+}
+
+//===============================================================
+// Restarts the fill level of a changed bottle of the bar stock
+//===============================================================
+void StateMachine::PlaceBarBottle(uint8_t liquidIndex)
+{
+  if (liquidIndex >= LiquidCount || _barBottles[liquidIndex] == _placedBarBottles[liquidIndex])
+  {
+    return;
+  }
+
+  // A new bottle is placed in the bar stock, restart its fill level
+  _placedBarBottles[liquidIndex] = _barBottles[liquidIndex];
+  FlowMeter.SetBottle(liquidIndex, _barBottles[liquidIndex] == eEmpty ? 0 : LiquidTable[liquidIndex].BottleCapacity_ml);
+}
+
+//===============================================================
+// Returns true, if all bottles of the bar stock are empty
+//===============================================================
+bool StateMachine::IsBarStockEmpty()
+{
+  for (uint8_t index = 0; index < LiquidCount; index++)
+  {
+    if (_barBottles[index] != eEmpty)
     {
-      liquid3Distance_Degrees += liquid1Distance_Degrees;
+      return false;
     }
-    liquid1Distance_Degrees = 0;
   }
+  return true;
+}
 
-  // Avoid minimal setable value >0%. If an angle is at its min angle, mute
-  // it to zero and add the angle distance to the greater one of the two others
-  if (liquid2Distance_Degrees == MINANGLE_DEGREES)
+//===============================================================
+// Selects the next not empty bottle of the bar stock. If all
+// bottles are empty thats okay, because in this case the
+// checkboxes will be displayed
+//===============================================================
+void StateMachine::SelectNextBarBottle(bool keepCurrent)
+{
+  bool isBarStockEmpty = IsBarStockEmpty();
+
+  for (uint8_t count = 0; count < LiquidCount; count++)
   {
-    if (liquid1Distance_Degrees > liquid3Distance_Degrees)
+    if (!keepCurrent || count > 0)
     {
-      liquid1Distance_Degrees += liquid2Distance_Degrees;
+      // Incrementing the setting value taking into account the overflow
+      _dashboardLiquid = _dashboardLiquid + 1 >= (MixtureLiquid)MixtureLiquidDashboardMax ? eLiquid1 : (MixtureLiquid)(_dashboardLiquid + 1);
     }
-    else
+
+    // Break only if current bottle is not empty
+    if (isBarStockEmpty ||
+      _dashboardLiquid >= LiquidCount ||
+      _barBottles[_dashboardLiquid] != eEmpty)
     {
-      liquid3Distance_Degrees += liquid2Distance_Degrees;
+      return;
     }
-    liquid2Distance_Degrees = 0;
   }
+}
 
-  // Avoid minimal setable value >0%. If an angle is at its min angle, mute
-  // it to zero and add the angle distance to the greater one of the two others
-  if (liquid3Distance_Degrees == MINANGLE_DEGREES)
+//===============================================================
+// Returns the pump shares for the selected bottle of the bar
+// stock. The bottle is mixed as spritzer with all sparkling water
+// bottles, if available
+//===============================================================
+void StateMachine::GetBarShares(MixtureShare shares[LiquidCount])
+{
+  bool hasSparklingWater = HasBarBottle(eSparklingWater);
+  uint32_t sparklingWater_Percentage = _dashboardLiquid < LiquidCount ? _spritzerPercentages[_dashboardLiquid] : 0;
+
+  for (uint8_t index = 0; index < LiquidCount; index++)
   {
-    if (liquid1Distance_Degrees > liquid2Distance_Degrees)
+    if (index == _dashboardLiquid)
     {
-      liquid1Distance_Degrees += liquid3Distance_Degrees;
+      shares[index] = hasSparklingWater ? (100 - sparklingWater_Percentage) * SHARE_PER_PERCENT : SHARE_FULLSCALE;
+    }
+    else if (hasSparklingWater && _barBottles[index] == eSparklingWater)
+    {
+      shares[index] = sparklingWater_Percentage * SHARE_PER_PERCENT;
     }
     else
     {
-      liquid2Distance_Degrees += liquid3Distance_Degrees;
+      shares[index] = 0;
     }
-    liquid3Distance_Degrees = 0;
   }
+}
+
+//===============================================================
+// Mutes liquids at their min angle and returns the distances of
+// all liquids
+//===============================================================
+void StateMachine::GetMutedDistances(int16_t distances_Degrees[LiquidCount])
+{
+  for (uint8_t index = 0; index < LiquidCount; index++)
+  {
+    distances_Degrees[index] = GetDistanceDegrees(_liquidAngles_Degrees[index], _liquidAngles_Degrees[(index + 1) % LiquidCount]);
+  }
+
+  // Avoid minimal setable value >0%. If an angle is at its min angle, mute
+  // it to zero and add the angle distance to the greater one of the two neighbours
+  for (uint8_t index = 0; index < LiquidCount; index++)
+  {
+    if (distances_Degrees[index] == MINANGLE_DEGREES)
+    {
+      uint8_t previousIndex = (index + LiquidCount - 1) % LiquidCount;
+      uint8_t nextIndex = (index + 1) % LiquidCount;
+      uint8_t lowerIndex = min(previousIndex, nextIndex);
+      uint8_t upperIndex = max(previousIndex, nextIndex);
+
+      // On equal distances the neighbour with the higher index wins
+      if (distances_Degrees[lowerIndex] > distances_Degrees[upperIndex])
+      {
+        distances_Degrees[lowerIndex] += distances_Degrees[index];
+      }
+      else
+      {
+        distances_Degrees[upperIndex] += distances_Degrees[index];
+      }
+      distances_Degrees[index] = 0;
+    }
+  }
+}
+
+//===============================================================
+// Updates all values in display, pumps driver and wifi
+//===============================================================
+void StateMachine::UpdateValues(uint32_t clientID)
+{
+  int16_t distances_Degrees[LiquidCount];
+  GetMutedDistances(distances_Degrees);
 
-  // Calculate percentage values
-  _liquid1_Percentage = (double)liquid1Distance_Degrees * 100.0 / 360.0;
-  _liquid2_Percentage = (double)liquid2Distance_Degrees * 100.0 / 360.0;
-  _liquid3_Percentage = (double)liquid3Distance_Degrees * 100.0 / 360.0;
+  // Calculate mixture shares (fixed point, exact for every degree)
+  for (uint8_t index = 0; index < LiquidCount; index++)
+  {
+    _liquidShares[index] = DegreesToShare(distances_Degrees[index]);
+  }
 
   // Update display driver
   Display.SetMenuState(_currentMenuState);
   Display.SetDashboardLiquid(_dashboardLiquid);
   Display.SetCleaningLiquid(_cleaningLiquid);
-  Display.SetAngles(_liquid1Angle_Degrees, _liquid2Angle_Degrees, _liquid3Angle_Degrees);
-  Display.SetPercentages(_liquid1_Percentage, _liquid2_Percentage, _liquid3_Percentage);
+  Display.SetAngles(_liquidAngles_Degrees);
+  Display.SetShares(_liquidShares);
+  Display.SetBarStock(_barBottles);
+  Display.SetSpritzerPercentages(_spritzerPercentages);
   
   // Update pump driver
   switch (_currentState)
   {
     case eDashboard:
       {
-        Pumps.SetPumps(_liquid1_Percentage, _liquid2_Percentage, _liquid3_Percentage);
+        if (ProductPolicy::HasBarStock)
+        {
+          MixtureShare barShares[LiquidCount];
+          GetBarShares(barShares);
+          Pumps.SetPumps(barShares);
+        }
+        else
+        {
+          Pumps.SetPumps(_liquidShares);
+        }
       }
       break;
     case eCleaning:
       {
-        double cleaningLiquid1_Percentage = (_cleaningLiquid == eLiquidAll || _cleaningLiquid == eLiquid1) ? 100.0 : 0.0;
-        double cleaningLiquid2_Percentage = (_cleaningLiquid == eLiquidAll || _cleaningLiquid == eLiquid2) ? 100.0 : 0.0;
-        double cleaningLiquid3_Percentage = (_cleaningLiquid == eLiquidAll || _cleaningLiquid == eLiquid3) ? 100.0 : 0.0;
-        Pumps.SetPumps(cleaningLiquid1_Percentage, cleaningLiquid2_Percentage, cleaningLiquid3_Percentage);
+        MixtureShare cleaningShares[LiquidCount];
+        for (uint8_t index = 0; index < LiquidCount; index++)
+        {
+          cleaningShares[index] = (_cleaningLiquid == eLiquidAll || _cleaningLiquid == index) ? SHARE_FULLSCALE : 0;
+        }
+        Pumps.SetPumps(cleaningShares);
       }
       break;
     default:
     case eMenu:
     case eReset:
+    case eBar:
     case eSettings:
       {
-        Pumps.SetPumps(0.0, 0.0, 0.0); // zero (0%)
+        Pumps.SetAllPumps(0); // zero (0%)
       }
       break;
   }
 
+  // Save the mixture (committed to flash after a quiet period)
+  if (!ProductPolicy::HasBarStock)
+  {
+    for (uint8_t index = 0; index < LiquidCount; index++)
+    {
+      Settings.SetMixtureAngle(index, _liquidAngles_Degrees[index]);
+    }
+  }
+
 #if defined(WIFI_MIXER)
-  // Update wifi clients
-  Wifihandler.UpdateLiquidAnglesToClients(clientID);
+  // Create a new mixture version, if any angle has changed
+  uint32_t changedLiquids = 0;
+  for (uint8_t index = 0; index < LiquidCount; index++)
+  {
+    if (_liquidAngles_Degrees[index] != _versionAngles_Degrees[index])
+    {
+      changedLiquids |= (1UL << index);
+    }
+  }
+
+  if (changedLiquids != 0)
+  {
+    _mixtureVersion++;
+    for (uint8_t index = 0; index < LiquidCount; index++)
+    {
+      if (changedLiquids & (1UL << index))
+      {
+        _angleVersions[index] = _mixtureVersion;
+        _angleClientIDs[index] = clientID;
+        _versionAngles_Degrees[index] = _liquidAngles_Degrees[index];
+      }
+    }
+
+    // Update wifi clients with the changed angles only
+    Wifihandler.UpdateMixtureToClients(clientID, changedLiquids);
+  }
 #endif
 }
 
@@ -857,18 +1420,19 @@ void StateMachine::UpdateValues(uint32_t clientID)
 //===============================================================
 String StateMachine::GetMixtureString()
 {
-  // Calculate sum
-  double sum_Percentage = _liquid1_Percentage + _liquid2_Percentage + _liquid3_Percentage;
+  uint32_t sum_Share = 0;
   
   // Build string output
   String returnString;
 
-  returnString += String(LIQUID1_NAME) + ": " + String(_liquid1_Percentage) + "% (" + String(_liquid1Angle_Degrees) + "°), ";
-  returnString += String(LIQUID2_NAME) + ": " + String(_liquid2_Percentage) + "% (" + String(_liquid2Angle_Degrees) + "°), ";
-  returnString += String(LIQUID3_NAME) + ": " + String(_liquid3_Percentage) + "% (" + String(_liquid3Angle_Degrees) + "°), ";
-  returnString += "Sum: " + String(sum_Percentage) + "%";
+  for (uint8_t index = 0; index < LiquidCount; index++)
+  {
+    returnString += String(LiquidTable[index].Name) + ": " + FormatFixedPoint(ShareToCentiPercent(_liquidShares[index]), 0, 2) + "% (" + String(_liquidAngles_Degrees[index]) + "°), ";
+    sum_Share += _liquidShares[index];
+  }
+  returnString += "Sum: " + FormatFixedPoint(RescaleRounded<SHARE_FULLSCALE, 10000>(sum_Share), 0, 2) + "%";
   
-  if ((sum_Percentage - 100.0) > 0.1 || (sum_Percentage - 100.0) < -0.1)
+  if (sum_Share != SHARE_FULLSCALE)
   {
     // Percentage error
     returnString += " Error: Sum of all percentages must be ~100%";
@@ -16,19 +16,50 @@
 #include <WiFi.h>
 #include "Config.h"
 #include "AngleHelper.h"
+#include "FixedPointHelper.h"
 #include "EncoderButtonDriver.h"
 #include "PumpDriver.h"
 #include "DisplayDriver.h"
 #include "FlowMeterDriver.h"
 #include "WifiHandler.h"
+#include "PowerManager.h"
+#include "CommandQueue.h"
+#include "SettingsStore.h"
 
 
 //===============================================================
 // Defines
 //===============================================================
-#define SCREENSAVER_TIMEOUT_MS      30000     // 30 seconds
+#define SCREENSAVER_TIMEOUT_MS      30000     // 30 seconds -> screen saver animation
+#define IDLE_STATIC_TIMEOUT_MS      300000    // 5 minutes -> static screen saver frame, LED light off
+#define IDLE_SLEEP_TIMEOUT_MS       900000    // 15 minutes -> light sleep (only with wifi off)
+#define MAX_SPRITZER_PERCENTAGE     95        // 0% to 95% sparkling water for wine spritzer
+#define DEFAULT_SPRITZER_PERCENTAGE 50
+#define SETTINGS_DEBOUNCE_MS        200       // User input is discarded after a settings change
 
 
+//===============================================================
+// Parent states (shared behaviour of the mixer states)
+//===============================================================
+enum ParentState : uint8_t
+{
+  eParentRoot = 0,        // No shared behaviour
+  eParentWifi = 1,        // Draws wifi icons and handles new wifi data
+  eParentIdle = 2,        // Enters screen saver after timeout (child of wifi)
+  eParentMenuChild = 3,   // Returns to menu on long button press (child of idle)
+};
+
+//===============================================================
+// Transition events (raised by the mixer and parent states)
+//===============================================================
+enum TransitionEvent : uint8_t
+{
+  eOnButton = 0,          // Short button press
+  eOnLongButton = 1,      // Long button press
+  eOnTimeout = 2,         // Checked every main event, the guard compares the time
+  eOnUserInput = 3,       // Any user input or running pumps (screen saver)
+};
+
 //===============================================================
 // Class for state machine handling
 //===============================================================
@@ -48,57 +79,166 @@ class StateMachine
     // Updates non volatile values from wifi
     bool UpdateValuesFromWifi(uint32_t clientID, bool save);
 
-    // Updates a liquid values from wifi
-    bool UpdateValuesFromWifi(uint32_t clientID, MixtureLiquid liquid, int16_t increments_Degrees);
+    // Queues an absolute liquid angle from wifi, applied and acknowledged with the sequence number in the next tick
+    bool UpdateValuesFromWifi(uint32_t clientID, MixtureLiquid liquid, int16_t angle_Degrees, uint32_t baseVersion, uint32_t sequence);
+
+    // Returns the mixture version (incremented with every angle change)
+    uint32_t GetMixtureVersion();
+
+    // Returns the mixture version of the last change of a liquid angle and its writer (client ID, 0 = encoder or several clients)
+    uint32_t GetAngleVersion(MixtureLiquid liquid, uint32_t& clientID);
 #endif
 
     // Returns the angle for a given liquid
     int16_t GetAngle(MixtureLiquid liquid);
 
+    // Returns the bar bottle of a given liquid (products with bar stock only)
+    BarBottle GetBarBottle(MixtureLiquid liquid);
+
     // Returns the current mixer state of the state machine
     MixerState GetCurrentState();
 
+    // Returns the name of the current mixer state
+    const char* GetCurrentStateName();
+
     // General state machine execution function
     void Execute(MixerEvent event);
 
     // Returns the current mixture a string
     String GetMixtureString();
 
+    // Returns the state transition statistics as string
+    String GetTransitionString();
+
+    // Returns the count of state transitions since power on
+    uint32_t GetTransitionCount();
+
   private:
+    // State table entry of a mixer state (the handler is the entry, main and exit hook)
+    struct StateConfig
+    {
+      MixerState State;
+      const char* Name;
+      ParentState Parent;
+      uint16_t EntryDebounce_ms;
+      void (StateMachine::*Handler)(MixerEvent event);
+    };
+
+    // Parent table entry of a parent state (the handler runs at every main event of its children)
+    struct ParentConfig
+    {
+      ParentState Parent;
+      ParentState Super;
+      void (StateMachine::*Handler)();
+    };
+
+    // Transition table entry: The first entry with the current state, the
+    // raised event and a passing guard (NULL -> always) is taken. The action
+    // (NULL -> none) runs between the exit and the entry hook
+    struct TransitionConfig
+    {
+      MixerState From;
+      TransitionEvent Event;
+      bool (StateMachine::*Guard)();
+      void (StateMachine::*Action)();
+      MixerState To;
+    };
+
+    // State, parent state and transition tables
+    static const StateConfig StateTable[];
+    static const ParentConfig ParentTable[];
+    static const TransitionConfig TransitionTable[];
+
     // Pin definitions
     uint8_t _pinBuzzer;
 
     // State machine variables
     MixerState _currentState = eDashboard;
-    MixerState _lastState = eDashboard;
     MixerState _currentMenuState = eDashboard;
 
+    // User input is discarded until the debounce time after a page or settings change has elapsed
+    uint32_t _debounceTimestamp_ms = 0;
+    uint16_t _debounceTime_ms = 0;
+
+    // Transition statistics
+    uint32_t _transitionCount = 0;
+    uint32_t _lastTransition_us = 0;
+    uint32_t _maxTransition_us = 0;
+    MixerState _lastTransitionFrom = eDashboard;
+
     // Dashboard mode settings
     MixtureLiquid _dashboardLiquid = eLiquid1;
-    int16_t _liquid1Angle_Degrees = 0;
-    int16_t _liquid2Angle_Degrees = 0;
-    int16_t _liquid3Angle_Degrees = 0;
-    double _liquid1_Percentage = 0;
-    double _liquid2_Percentage = 0;
-    double _liquid3_Percentage = 0;
+    int16_t _liquidAngles_Degrees[LiquidCount] = {};
+    MixtureShare _liquidShares[LiquidCount] = {};
 
     // Cleaning mode settings
     MixtureLiquid _cleaningLiquid = eLiquidAll;
 
+    // Bar settings (products with bar stock only)
+    BarBottle _barBottles[LiquidCount] = {};
+    BarBottle _placedBarBottles[LiquidCount] = {};    // Bottles with a started fill level (bar page changes are placed on confirm)
+    int16_t _spritzerPercentages[LiquidCount] = {};
+
     // Timer variables for reset counter
     uint32_t _resetTimestamp = 0;
     const uint32_t ResetTime_ms = 2000;
 
-    // Wifi new liquid data variables
-    uint32_t _newLiquidClientID = 0;
-    MixtureLiquid _newLiquid = eLiquidNone;
-    int16_t _newLiquidIncrements_Degrees = 0;
+#if defined(WIFI_MIXER)
+    // Wifi new liquid data queue (websocket task -> state machine)
+    LiquidCommandQueue _liquidCommands;
+
+    // Mixture versioning (version and writer of the last change per angle)
+    uint32_t _mixtureVersion = 0;
+    uint32_t _angleVersions[LiquidCount] = {};
+    uint32_t _angleClientIDs[LiquidCount] = {};
+    int16_t _versionAngles_Degrees[LiquidCount] = {};
+
+    // Modem sleep of the idle tiers (set while no client is connected)
+    bool _isModemSleep = false;
+#endif
 
     // Wifi new cycle timespan data variables
     uint32_t _newCycleTimespanClientID = 0;
     bool _newCycleTimespan = false;
     uint32_t _newCycleTimespan_ms = 0;
 
+    // Returns the state table entry of a mixer state
+    const StateConfig& GetStateConfig(MixerState state);
+
+    // Takes the transition of the transition table for an event, returns true if the state changed
+    bool Dispatch(TransitionEvent event);
+
+    // Changes the state with exit hook, transition action and entry hook
+    void TransitionTo(MixerState state, void (StateMachine::*action)() = NULL);
+
+    // Discards user input for the debounce time (non blocking)
+    void Debounce(uint16_t debounce_ms);
+
+    // Returns true, if the debounce time has not elapsed
+    bool IsDebouncing();
+
+    // Resets and ignores pending user input
+    void DiscardInput();
+
+    // Function parent state with wifi (draws wifi icons and handles new wifi data)
+    void FctParentWifi();
+
+    // Function parent state with screen saver timeout
+    void FctParentIdle();
+
+    // Function parent state of the menu entries (returns to menu on long button press)
+    void FctParentMenuChild();
+
+    // Transition guards
+    bool IsIdleTimeout();
+    bool IsResetTimeout();
+    template <MixerState state> bool IsMenuSelection() { return _currentMenuState == state; }
+    template <MixerState state> bool IsHistoryState() { return _lastTransitionFrom == state; }
+
+    // Transition actions
+    void ActionSelectMenuEntry();
+    void ActionReturnToMenu();
+
 #if defined(WIFI_MIXER)
     // Handles new wifi data, should be called in state machine
     void HandleNewWifiData(MixerEvent event);
@@ -110,23 +250,56 @@ class StateMachine
     // Function dashboard state
     void FctDashboard(MixerEvent event);
 
+    // Function dashboard state (products with bar stock)
+    void FctBarDashboard(MixerEvent event);
+
     // Function cleaning state
     void FctCleaning(MixerEvent event);
 
     // Function reset state
     void FctReset(MixerEvent event);
 
+    // Function bar state
+    void FctBar(MixerEvent event);
+
     // Function settings state
     void FctSettings(MixerEvent event);
 
     // Function screen saver state
     void FctScreenSaver(MixerEvent event);
     
+    // Returns true, if no function requires the device to stay awake
+    bool IsLightSleepAllowed();
+
     // Resets the mixture to default recipe
     void SetMixtureDefaults();
 
+    // Restores the saved mixture from the settings store (invalid mixtures keep the defaults)
+    void LoadMixture();
+
+    // Resets the bar stock to default bottles
+    void SetBarStockDefaults();
+
+    // Returns true, if a bottle is in the bar stock (optionally ignoring one liquid)
+    bool HasBarBottle(BarBottle barBottle, uint8_t ignoredIndex = LiquidCount);
+
+    // Returns true, if all bottles of the bar stock are empty
+    bool IsBarStockEmpty();
+
+    // Restarts the fill level of a changed bottle of the bar stock
+    void PlaceBarBottle(uint8_t liquidIndex);
+
+    // Selects the next not empty bottle of the bar stock
+    void SelectNextBarBottle(bool keepCurrent);
+
+    // Returns the pump shares for the selected bottle of the bar stock
+    void GetBarShares(MixtureShare shares[LiquidCount]);
+
     // Updates all values in display, pumps driver and wifi
     void UpdateValues(uint32_t clientID = 0);
+
+    // Mutes liquids at their min angle and returns the distances of all liquids
+    void GetMutedDistances(int16_t distances_Degrees[LiquidCount]);
 };
 
 
@@ -166,3 +166,12 @@ String GetResetReasonString(int cpu)
       return "NO_MEAN";
   }
 }
+
+//===============================================================
+// Prints the duration of a boot phase and the time since reset
+//===============================================================
+void LogBootPhase(const char* phase, uint32_t start_ms)
+{
+  uint32_t now_ms = millis();
+  Serial.println(String("[BOOT] ") + phase + ": " + String(now_ms - start_ms) + " ms (at " + String(now_ms) + " ms)");
+}
@@ -38,4 +38,9 @@ String WifiPowerToString(wifi_power_t power);
 //===============================================================
 String GetResetReasonString(int cpu);
 
+//===============================================================
+// Prints the duration of a boot phase and the time since reset
+//===============================================================
+void LogBootPhase(const char* phase, uint32_t start_ms);
+
 #endif
\ No newline at end of file
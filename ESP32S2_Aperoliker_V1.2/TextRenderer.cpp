@@ -0,0 +1,151 @@
+/**
+ * Includes all text renderer functions
+ *
+ * @author    Florian Staeblein
+ * @date      2024/01/28
+ * @copyright © 2024 Florian Staeblein
+ */
+
+#include "TextRenderer.h"
+
+//===============================================================
+// Constructor
+//===============================================================
+TextRenderer::TextRenderer()
+{
+}
+
+//===============================================================
+// Initializes the text renderer with the glyph atlas of a font
+//===============================================================
+void TextRenderer::Begin(Adafruit_SPITFT* tft, const GFXfont* font)
+{
+  _tft = tft;
+  _font = font;
+
+  // Calculate field metrics once from the glyph atlas
+  _ascent = 0;
+  _descent = 0;
+  for (uint16_t index = 0; index <= _font->last - _font->first; index++)
+  {
+    const GFXglyph* glyph = &_font->glyph[index];
+    _ascent = max(_ascent, (int16_t)-glyph->yOffset);
+    _descent = max(_descent, (int16_t)(glyph->yOffset + glyph->height));
+  }
+
+  // Allocate pixel buffer for the largest text field
+  if (_fieldBuffer == NULL)
+  {
+    _fieldBuffer = (uint16_t*)malloc(TEXTFIELD_MAX_WIDTH * GetFieldHeight() * sizeof(uint16_t));
+  }
+}
+
+//===============================================================
+// Returns the width and height of a text
+//===============================================================
+void TextRenderer::GetTextSize(const char* text, uint16_t* width, uint16_t* height)
+{
+  int16_t textWidth = 0;
+  int16_t top = 0;
+  int16_t bottom = 0;
+  
+  for (const char* character = text; *character != '\0'; character++)
+  {
+    const GFXglyph* glyph = GetGlyph(*character);
+    if (glyph != NULL)
+    {
+      textWidth += glyph->xAdvance;
+      top = min(top, (int16_t)glyph->yOffset);
+      bottom = max(bottom, (int16_t)(glyph->yOffset + glyph->height));
+    }
+  }
+
+  *width = textWidth;
+  *height = bottom - top;
+}
+
+//===============================================================
+// Draws a text into a fixed width field with opaque background
+//===============================================================
+void TextRenderer::DrawText(const char* text, int16_t x, int16_t y, int16_t width, uint16_t color, uint16_t backgroundColor, TextAlign align)
+{
+  int16_t height = GetFieldHeight();
+  width = min(width, (int16_t)TEXTFIELD_MAX_WIDTH);
+  if (_fieldBuffer == NULL || width <= 0)
+  {
+    return;
+  }
+
+  // Clear field with background color (replaces the erase pass of the old text)
+  for (int32_t index = 0; index < (int32_t)width * height; index++)
+  {
+    _fieldBuffer[index] = backgroundColor;
+  }
+
+  // Calculate text start position inside the field
+  uint16_t textWidth = 0;
+  uint16_t textHeight = 0;
+  GetTextSize(text, &textWidth, &textHeight);
+  int16_t cursor = 0;
+  if (align == eAlignCenter)
+  {
+    cursor = (width - (int16_t)textWidth) / 2;
+  }
+  else if (align == eAlignRight)
+  {
+    cursor = width - (int16_t)textWidth;
+  }
+
+  // Copy glyphs from the atlas into the field buffer (clipped to the field)
+  for (const char* character = text; *character != '\0'; character++)
+  {
+    const GFXglyph* glyph = GetGlyph(*character);
+    if (glyph == NULL)
+    {
+      continue;
+    }
+
+    const uint8_t* bitmap = &_font->bitmap[glyph->bitmapOffset];
+    int16_t x0 = cursor + glyph->xOffset;
+    int16_t y0 = _ascent + glyph->yOffset;
+    uint8_t bits = 0;
+    uint8_t bitCount = 0;
+
+    // Glyph bitmaps are packed row by row without padding
+    for (int16_t yGlyph = 0; yGlyph < glyph->height; yGlyph++)
+    {
+      for (int16_t xGlyph = 0; xGlyph < glyph->width; xGlyph++)
+      {
+        if ((bitCount++ & 7) == 0)
+        {
+          bits = pgm_read_byte(bitmap++);
+        }
+
+        int16_t xField = x0 + xGlyph;
+        if ((bits & 0x80) && xField >= 0 && xField < width)
+        {
+          _fieldBuffer[(y0 + yGlyph) * width + xField] = color;
+        }
+        bits <<= 1;
+      }
+    }
+
+    cursor += glyph->xAdvance;
+  }
+
+  // Write the whole field in one address window
+  _tft->drawRGBBitmap(x, y - _ascent, _fieldBuffer, width, height);
+}
+
+//===============================================================
+// Returns the glyph of a character or NULL if not in the font
+//===============================================================
+const GFXglyph* TextRenderer::GetGlyph(char character)
+{
+  uint8_t code = (uint8_t)character;
+  if (code < _font->first || code > _font->last)
+  {
+    return NULL;
+  }
+  return &_font->glyph[code - _font->first];
+}
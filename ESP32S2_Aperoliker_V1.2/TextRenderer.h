@@ -0,0 +1,80 @@
+/**
+ * Includes all text renderer functions
+ *
+ * @author    Florian Staeblein
+ * @date      2024/01/28
+ * @copyright © 2024 Florian Staeblein
+ */
+ 
+#ifndef TEXTRENDERER_H
+#define TEXTRENDERER_H
+
+//===============================================================
+// Includes
+//===============================================================
+#include <Arduino.h>
+#include <Adafruit_GFX.h>
+#include <Adafruit_SPITFT.h>
+
+
+//===============================================================
+// Defines
+//===============================================================
+#define TEXTFIELD_MAX_WIDTH         240   // Maximum width of a text field (display width)
+
+
+//===============================================================
+// Enums
+//===============================================================
+enum TextAlign : uint8_t
+{
+  eAlignLeft = 0,
+  eAlignCenter = 1,
+  eAlignRight = 2,
+};
+
+
+//===============================================================
+// Class for drawing text fields with opaque background
+//===============================================================
+class TextRenderer
+{
+  public:
+    // Constructor
+    TextRenderer();
+
+    // Initializes the text renderer with the glyph atlas of a font
+    void Begin(Adafruit_SPITFT* tft, const GFXfont* font);
+
+    // Returns the width and height of a text
+    void GetTextSize(const char* text, uint16_t* width, uint16_t* height);
+
+    // Returns the distance from the baseline to the top of the text field
+    int16_t GetAscent() { return _ascent; }
+
+    // Returns the height of a text field
+    int16_t GetFieldHeight() { return _ascent + _descent; }
+
+    // Draws a text into a fixed width field with opaque background (y is the baseline)
+    void DrawText(const char* text, int16_t x, int16_t y, int16_t width, uint16_t color, uint16_t backgroundColor, TextAlign align = eAlignLeft);
+
+  private:
+    // Display variable
+    Adafruit_SPITFT* _tft = NULL;
+
+    // Font glyph atlas (bitmaps and metrics in flash)
+    const GFXfont* _font = NULL;
+
+    // Text field metrics (max extent of all glyphs above and below the baseline)
+    int16_t _ascent = 0;
+    int16_t _descent = 0;
+
+    // Pixel buffer for one text field
+    uint16_t* _fieldBuffer = NULL;
+
+    // Returns the glyph of a character or NULL if not in the font
+    const GFXglyph* GetGlyph(char character);
+};
+
+
+#endif
@@ -15,6 +15,9 @@
 //===============================================================
 WifiHandler Wifihandler;
 
+// Network backend of the ESP32 wifi and mDNS libraries
+static NetworkBackendESP32 networkBackendESP32;
+
 //===============================================================
 // Will be called if an web socket event occours
 //===============================================================
@@ -28,6 +31,7 @@ void onWsEvent(AsyncWebSocket* server, AsyncWebSocketClient* client, AwsEventTyp
 //===============================================================
 WifiHandler::WifiHandler()
 {
+  _network = &networkBackendESP32;
 }
 
 //===============================================================
@@ -35,32 +39,42 @@ WifiHandler::WifiHandler()
 //===============================================================
 void WifiHandler::Begin()
 {
+  if (_mutex == NULL)
+  {
+    _mutex = xSemaphoreCreateMutex();
+  }
+
   Load();
   SetWifiMode(_initWifiMode);
 }
 
 //===============================================================
-// Load values from flash
+// Load values from the settings store
 //===============================================================
 void WifiHandler::Load()
 {
-  if (_preferences.begin(SETTINGS_NAME, true))
-  {
-    _initWifiMode = _preferences.getBool(KEY_WIFIMODE, false) ? WIFI_MODE_AP : WIFI_MODE_NULL;
-    _preferences.end();
-  }
+  // Station mode falls back to access point without credentials
+  _initWifiMode = Settings.GetWifiMode() ? WIFI_MODE_STA : WIFI_MODE_NULL;
+  Settings.GetStation(_staSsid, _staPassword, _staBssid, _staChannel);
 }
 
 //===============================================================
-// Save values to flash
+// Save values to the settings store
 //===============================================================
 void WifiHandler::Save()
 {
-  if (_preferences.begin(SETTINGS_NAME, false))
-  {
-    _preferences.putBool(KEY_WIFIMODE, _wifiMode == WIFI_AP);
-    _preferences.end();
-  }
+  Settings.SetWifiMode(_wifiMode != WIFI_MODE_NULL);
+}
+
+//===============================================================
+// Saves station credentials and cached network to the settings
+// store
+//===============================================================
+void WifiHandler::SaveStation()
+{
+  // Credentials must survive the following network restart
+  Settings.SetStation(_staSsid, _staPassword, _staBssid, _staChannel);
+  Settings.RequestCommit();
 }
 
 //===============================================================
@@ -71,20 +85,42 @@ wifi_mode_t WifiHandler::GetWifiMode()
   return _wifiMode;
 }
 
+//===============================================================
+// Returns the current wifi mode as short string
+//===============================================================
+String WifiHandler::GetWifiModeString()
+{
+  switch (_wifiMode)
+  {
+    case WIFI_MODE_AP:
+      return "AP";
+    case WIFI_MODE_STA:
+      return "STA";
+    default:
+      return "OFF";
+  }
+}
+
 //===============================================================
 // Sets the wifi mode
 //===============================================================
 void WifiHandler::SetWifiMode(wifi_mode_t mode)
 {
+  // Station mode needs provisioned credentials
+  if (mode == WIFI_MODE_STA && _staSsid.length() == 0)
+  {
+    mode = WIFI_MODE_AP;
+  }
+
   if (_wifiMode == mode)
   {
     return;
   }
 
-  if (mode == WIFI_MODE_AP)
+  if (mode == WIFI_MODE_AP || mode == WIFI_MODE_STA)
   {
     // Set internal wifi mode if success
-    _wifiMode = StartWebServer() ? WIFI_MODE_AP : WIFI_MODE_NULL;
+    _wifiMode = StartWebServer(mode) ? mode : WIFI_MODE_NULL;
   }
   else
   {
@@ -95,12 +131,56 @@ void WifiHandler::SetWifiMode(wifi_mode_t mode)
   }
 }
 
+//===============================================================
+// Replaces the network backend (e.g. by a local stand-in)
+//===============================================================
+void WifiHandler::SetNetworkBackend(NetworkBackend* network)
+{
+  _network = network;
+}
+
+//===============================================================
+// Requests new station credentials (empty SSID clears them)
+//===============================================================
+bool WifiHandler::RequestStationCredentials(const String& ssid, const String& password)
+{
+  // Check WPA2 limits (empty password -> open network)
+  if (ssid.length() > STA_SSID_MAX_LENGTH ||
+    (password.length() > 0 && password.length() < STA_PASSWORD_MIN_LENGTH) ||
+    password.length() > STA_PASSWORD_MAX_LENGTH ||
+    _provisionRequested)
+  {
+    return false;
+  }
+
+  // Applied in Update(), after the response was sent
+  _provisionSsid = ssid;
+  _provisionPassword = password;
+  _provisionRequest_ms = millis();
+  _provisionRequested = true;
+  return true;
+}
+
+//===============================================================
+// Returns the local IP address of the web server
+//===============================================================
+String WifiHandler::GetLocalIP()
+{
+  return _network->GetLocalIP();
+}
+
 //===============================================================
 // Returns the amount of connected clients
 //===============================================================
 uint16_t WifiHandler::GetConnectedClients()
 {
-  return WiFi.softAPgetStationNum();
+  if (_wifiMode == WIFI_MODE_AP)
+  {
+    return _network->GetAccessPointStations();
+  }
+
+  // Other devices share the network, count the web clients instead
+  return _websocket ? _websocket->count() : 0;
 }
 
 //===============================================================
@@ -108,31 +188,326 @@ uint16_t WifiHandler::GetConnectedClients()
 //===============================================================
 void WifiHandler::UpdateCycleTimespanToClients(uint32_t clientID)
 {
-  if (!_webevents)
+  // Format: "<client ID>:<cycle timespan>"
+  uint32_t cycleTimepan_ms = Pumps.GetCycleTimespan();
+  Publish(TOPIC_SETTINGS, "CYCLE_TIMESPAN", String(clientID) + ":" + String(cycleTimepan_ms));
+}
+
+//===============================================================
+// Updates the changed liquid angles of the new mixture version in
+// connected clients (websocket clients get the diff to the last
+// version handed over to them, a queued diff is replaced by one
+// covering all versions since then)
+//===============================================================
+void WifiHandler::UpdateMixtureToClients(uint32_t /*clientID*/, uint32_t changedLiquids)
+{
+  // Pushes before the web server is started (e.g. by the state machine during the boot) are skipped
+  if (!_isServerReady)
   {
     return;
   }
 
-  uint32_t cycleTimepan_ms = Pumps.GetCycleTimespan();
-  _webevents->send((String(clientID) + ":" + String(cycleTimepan_ms)).c_str(), "CYCLE_TIMESPAN");
+  uint32_t version = Statemachine.GetMixtureVersion();
+  xSemaphoreTake(_mutex, portMAX_DELAY);
+  if (_isServerReady && _websocket)
+  {
+    for (uint8_t index = 0; index < OUTBOUND_MAX_CLIENTS; index++)
+    {
+      uint32_t outboundClientID = _outbound.GetClientID(index);
+      if (outboundClientID != 0 &&
+        _outbound.IsSubscribed(outboundClientID, TOPIC_MIXTURE))
+      {
+        uint32_t baseVersion = _outbound.GetMixtureVersion(outboundClientID);
+        String diff = GetMixtureDiffString(baseVersion, version, 0);
+        if (diff.length() > 0)
+        {
+          SendText(_websocket->client(outboundClientID), "MIXTURE_DIFF:" + diff, version);
+        }
+      }
+    }
+  }
+
+  // Clients without websocket get the diff to the previous version
+  SendEvent(GetMixtureDiffString(version - 1, version, changedLiquids), "MIXTURE_DIFF");
+  xSemaphoreGive(_mutex);
 }
 
 //===============================================================
-// Updates all liquid angles in connected clients
+// Updates bottle fill levels and the refused liquid in connected clients
 //===============================================================
-void WifiHandler::UpdateLiquidAnglesToClients(uint32_t clientID)
+void WifiHandler::UpdateLevelsToClients()
 {
-  if (!_webevents)
+  // Format: "<refused liquid>:<remaining>,<capacity>,<minutes>,<status>;..."
+  String levels = String(Pumps.GetRefusedLiquid()) + ":";
+  for (uint8_t liquidIndex = 0; liquidIndex < LiquidCount; liquidIndex++)
+  {
+    uint32_t timeToEmpty_min = FlowMeter.GetTimeToEmpty(liquidIndex);
+    levels += String(FlowMeter.GetRemaining(liquidIndex)) + ",";
+    levels += String(FlowMeter.GetCapacity(liquidIndex)) + ",";
+    levels += (timeToEmpty_min == LEVEL_TIME_UNKNOWN ? String("-1") : String(timeToEmpty_min)) + ",";
+    levels += String((uint8_t)FlowMeter.GetLevelStatus(liquidIndex));
+    levels += (liquidIndex + 1 < LiquidCount) ? ";" : "";
+  }
+  Publish(TOPIC_LEVELS, "LEVELS", levels);
+}
+
+//===============================================================
+// Acknowledges an applied or conflicting liquid angle to the
+// sending client
+//===============================================================
+void WifiHandler::AcknowledgeLiquidAngle(uint32_t clientID, uint32_t sequence, bool isApplied, uint32_t received_ms)
+{
+  // Runs on the main task, the web server is only used while ready and under the mutex
+  if (!_isServerReady)
+  {
+    return;
+  }
+
+  // Record latency from receiving to acknowledging (bucket index is the bit length of the latency)
+  uint32_t latency_ms = millis() - received_ms;
+  uint8_t bucket = 0;
+  while (bucket < NETSTAT_LATENCY_BUCKETS - 1 && (1UL << bucket) < latency_ms)
   {
+    bucket++;
+  }
+  portENTER_CRITICAL(&_statMux);
+  _stats.Latencies[bucket]++;
+  _stats.LatencyMax_ms = max(_stats.LatencyMax_ms, latency_ms);
+  portEXIT_CRITICAL(&_statMux);
+
+  // Format: "<sequence>,<mixture version>"
+  String acknowledge = String(isApplied ? "LIQUID_ACK:" : "LIQUID_CONFLICT:") + String(sequence) + "," + String(Statemachine.GetMixtureVersion());
+  xSemaphoreTake(_mutex, portMAX_DELAY);
+  if (_isServerReady && _websocket)
+  {
+    SendText(_websocket->client(clientID), acknowledge);
+  }
+  xSemaphoreGive(_mutex);
+}
+
+//===============================================================
+// Returns the network statistics as string
+//===============================================================
+String WifiHandler::GetNetworkString()
+{
+  NetworkStatistics stats = GetNetworkStatistics();
+  uint32_t duration_s = (millis() - stats.Start_ms) / 1000;
+  return String("Network: ") + String(GetConnectedClients()) + " clients (peak " + String(stats.PeakClients) + ")" +
+    ", Received: " + String(stats.Received) + " (" + String(stats.Rejected) + " rejected)" +
+    ", Sent: " + String(stats.Sent) + " (" + String(stats.Dropped) + " dropped, " + String(stats.BytesSent) + " bytes)" +
+    ", Ack latency p50/p95/p99/max: " + String(GetLatencyPercentile(stats, 50)) + "/" + String(GetLatencyPercentile(stats, 95)) + "/" + String(GetLatencyPercentile(stats, 99)) + "/" + String(stats.LatencyMax_ms) + "ms" +
+    ", Queued: " + String(_outbound.GetQueuedMessages()) + " (" + String(_outbound.GetQueuedBytes()) + " bytes, max client " + String(_outbound.GetMaxClientBytes()) + " bytes)" +
+    ", Evicted: " + String(stats.Evicted) +
+    ", Min free heap: " + String(stats.MinFreeHeap == UINT32_MAX ? ESP.getFreeHeap() : stats.MinFreeHeap) + " bytes" +
+    ", Largest block: " + String(ESP.getMaxAllocHeap()) + " bytes" +
+    ", Duration: " + String(duration_s) + "s";
+}
+
+//===============================================================
+// Resets the network statistics
+//===============================================================
+void WifiHandler::ResetNetworkStatistics()
+{
+  NetworkStatistics stats = { millis(), 0, 0, 0, 0, 0, 0, GetConnectedClients(), UINT32_MAX, {}, 0 };
+  portENTER_CRITICAL(&_statMux);
+  _stats = stats;
+  portEXIT_CRITICAL(&_statMux);
+}
+
+//===============================================================
+// Returns a consistent copy of the network statistics
+//===============================================================
+NetworkStatistics WifiHandler::GetNetworkStatistics()
+{
+  portENTER_CRITICAL(&_statMux);
+  NetworkStatistics stats = _stats;
+  portEXIT_CRITICAL(&_statMux);
+  return stats;
+}
+
+//===============================================================
+// Returns the upper bound of the latency bucket containing the
+// percentile in ms
+//===============================================================
+uint32_t WifiHandler::GetLatencyPercentile(const NetworkStatistics& statistics, uint8_t percent)
+{
+  uint32_t count = 0;
+  for (uint8_t bucket = 0; bucket < NETSTAT_LATENCY_BUCKETS; bucket++)
+  {
+    count += statistics.Latencies[bucket];
+  }
+
+  uint32_t threshold = ScaleRatio<uint32_t>(count, percent, 100);
+  uint32_t cumulated = 0;
+  for (uint8_t bucket = 0; bucket < NETSTAT_LATENCY_BUCKETS; bucket++)
+  {
+    cumulated += statistics.Latencies[bucket];
+    if (cumulated > 0 && cumulated >= threshold)
+    {
+      return 1UL << bucket;
+    }
+  }
+  return 0;
+}
+
+//===============================================================
+// Publishes a state push to all websocket clients subscribed to
+// the topic and the event clients
+//===============================================================
+void WifiHandler::Publish(uint8_t topic, const char* event, const String& data)
+{
+  // Pushes before the web server is started (e.g. by the state machine during the boot) are skipped
+  if (!_isServerReady)
+  {
+    return;
+  }
+
+  xSemaphoreTake(_mutex, portMAX_DELAY);
+  if (_isServerReady && _websocket)
+  {
+    // Format: "<event>:<data>" (queued pushes of the same event are replaced by newer ones)
+    String text = String(event) + ":" + data;
+    for (uint8_t index = 0; index < OUTBOUND_MAX_CLIENTS; index++)
+    {
+      uint32_t clientID = _outbound.GetClientID(index);
+      if (clientID != 0 &&
+        _outbound.IsSubscribed(clientID, topic))
+      {
+        SendText(_websocket->client(clientID), text);
+      }
+    }
+  }
+
+  // Clients without websocket get the same data as event
+  SendEvent(data, event);
+  xSemaphoreGive(_mutex);
+}
+
+//===============================================================
+// Sends an event to all event clients
+//===============================================================
+void WifiHandler::SendEvent(const String& data, const char* event)
+{
+  if (!_isServerReady ||
+    !_webevents ||
+    _webevents->count() == 0)
+  {
+    return;
+  }
+
+  // Count one message and the payload per client
+  uint32_t clients = _webevents->count();
+
+  // Skip events while the clients don't take them (slow clients would fill the heap)
+  if (_webevents->avgPacketsWaiting() > WEBEVENTS_MAX_PACKETS_WAITING)
+  {
+    portENTER_CRITICAL(&_statMux);
+    _stats.Dropped += clients;
+    portEXIT_CRITICAL(&_statMux);
     return;
   }
 
-  int16_t angle1 = Statemachine.GetAngle(eLiquid1);
-  int16_t angle2 = Statemachine.GetAngle(eLiquid2);
-  int16_t angle3 = Statemachine.GetAngle(eLiquid3);
+  _webevents->send(data.c_str(), event);
+  portENTER_CRITICAL(&_statMux);
+  _stats.Sent += clients;
+  _stats.BytesSent += clients * (data.length() + strlen(event));
+  portEXIT_CRITICAL(&_statMux);
+}
+
+//===============================================================
+// Sends a text to a websocket client
+//===============================================================
+void WifiHandler::SendText(AsyncWebSocketClient* client, const String& text, uint32_t mixtureVersion)
+{
+  if (!client)
+  {
+    return;
+  }
 
-  // Send events from variables to all connected websockets
-  _webevents->send((String(clientID) + ":" + String(angle1) + "," + String(angle2)  + "," + String(angle3)).c_str(), "LIQUID_ANGLES");
+  // Send directly, if nothing is queued and the client can take the message
+  uint32_t clientID = client->id();
+  if (_outbound.IsEmpty(clientID) &&
+    !client->queueIsFull())
+  {
+    client->text(text);
+    _outbound.SetMixtureVersion(clientID, mixtureVersion);
+    portENTER_CRITICAL(&_statMux);
+    _stats.Sent++;
+    _stats.BytesSent += text.length();
+    portEXIT_CRITICAL(&_statMux);
+    return;
+  }
+
+  // Queue message (latest value wins per topic), drop it if the client is over its limit
+  if (!_outbound.Push(clientID, text, mixtureVersion))
+  {
+    portENTER_CRITICAL(&_statMux);
+    _stats.Dropped++;
+    portEXIT_CRITICAL(&_statMux);
+  }
+}
+
+//===============================================================
+// Sends queued messages and closes clients, which don't take
+// their messages
+//===============================================================
+void WifiHandler::UpdateOutboundQueues()
+{
+  // Pop and send under the publish lock (a mixture diff is built from the version taken over by the client)
+  uint32_t sent = 0;
+  uint32_t bytesSent = 0;
+  xSemaphoreTake(_mutex, portMAX_DELAY);
+  if (!_websocket)
+  {
+    xSemaphoreGive(_mutex);
+    return;
+  }
+
+  for (uint8_t index = 0; index < OUTBOUND_MAX_CLIENTS; index++)
+  {
+    uint32_t clientID = _outbound.GetClientID(index);
+    if (clientID == 0)
+    {
+      continue;
+    }
+
+    AsyncWebSocketClient* client = _websocket->client(clientID);
+    if (!client)
+    {
+      _outbound.RemoveClient(clientID);
+      continue;
+    }
+
+    // Send as many messages as the client can take
+    String text;
+    while (!client->queueIsFull() &&
+      _outbound.Pop(clientID, text))
+    {
+      client->text(text);
+      sent++;
+      bytesSent += text.length();
+    }
+  }
+
+  // Close a client, which stays over its limit or holds the most messages at low heap
+  uint32_t evictionID = _outbound.GetEvictionCandidate(ESP.getFreeHeap() < OUTBOUND_MIN_FREE_HEAP);
+  if (evictionID != 0)
+  {
+    AsyncWebSocketClient* client = _websocket->client(evictionID);
+    if (client)
+    {
+      client->close();
+    }
+    _outbound.RemoveClient(evictionID);
+    Serial.println("[WIFI] Closed slow websocket client " + String(evictionID));
+  }
+  xSemaphoreGive(_mutex);
+
+  portENTER_CRITICAL(&_statMux);
+  _stats.Sent += sent;
+  _stats.BytesSent += bytesSent;
+  _stats.Evicted += (evictionID != 0) ? 1 : 0;
+  portEXIT_CRITICAL(&_statMux);
 }
 
 //===============================================================
@@ -140,19 +515,60 @@ void WifiHandler::UpdateLiquidAnglesToClients(uint32_t clientID)
 //===============================================================
 void WifiHandler::Update()
 {
+  // Apply new station credentials
+  if (_provisionRequested && (millis() - _provisionRequest_ms) > STA_PROVISION_DELAY_MS)
+  {
+    _staSsid = _provisionSsid;
+    _staPassword = _provisionPassword;
+    _staChannel = 0;
+    memset(_staBssid, 0, NETWORK_BSSID_LENGTH);
+    SaveStation();
+    _provisionRequested = false;
+
+    // Restart the network (without credentials -> access point)
+    Serial.println("[WIFI] New station credentials for '" + _staSsid + "'");
+    StopWebServer();
+    _wifiMode = WIFI_MODE_NULL;
+    SetWifiMode(WIFI_MODE_STA);
+  }
+
+  if (_wifiMode == WIFI_MODE_STA)
+  {
+    UpdateStation();
+  }
+
+  if (_wifiMode != WIFI_MODE_NULL)
+  {
+    UpdateDiscovery(false);
+
+    // Update fleet protocol and orders
+    Fleet.Update();
+  }
+
   if (_websocket)
   {
     // Clean websocket clients
     _websocket->cleanupClients();
+
+    // Send queued messages to the clients
+    UpdateOutboundQueues();
+
+    // Update peak values of the network statistics
+    uint16_t clients = GetConnectedClients();
+    uint32_t freeHeap = ESP.getFreeHeap();
+    portENTER_CRITICAL(&_statMux);
+    _stats.PeakClients = max(_stats.PeakClients, clients);
+    _stats.MinFreeHeap = min(_stats.MinFreeHeap, freeHeap);
+    portEXIT_CRITICAL(&_statMux);
   }
 
-  if (_webevents)
+  if (_websocket)
   {
     // Send alive signal every second
     if (millis() - _lastAlive_ms > 1000)
     {
-      //_webevents->send("", "ALIVE");
-      UpdateLiquidAnglesToClients(0); // Use liquid angles instead (long time sync and alive in once)
+      Publish(TOPIC_MIXTURE, "MIXTURE_VERSION", String(Statemachine.GetMixtureVersion())); // Version instead of all angles (clients behind request a full update)
+      UpdateLevelsToClients();
       _lastAlive_ms = millis();
     }
   }
@@ -161,21 +577,29 @@ void WifiHandler::Update()
 //===============================================================
 // Will be called if an web socket event occours
 //===============================================================
-void WifiHandler::OnWebsocketEvent(AsyncWebSocket* server, AsyncWebSocketClient* client, AwsEventType type, void* arg, uint8_t* data, size_t len)
+void WifiHandler::OnWebsocketEvent(AsyncWebSocket* /*server*/, AsyncWebSocketClient* client, AwsEventType type, void* arg, uint8_t* data, size_t len)
 {
   // Client connected
   if (type == WS_EVT_CONNECT)
   {
     // Send all static settings to mixer on websocket connect
-    client->printf("Connected Client Number %u", (uint16_t)client->id());
+    _outbound.AddClient(client->id());
+    SendText(client, "Connected Client Number " + String(client->id()));
     UpdateSettingsToClient(client);
     client->ping();
   }
-  //else if (type == WS_EVT_DISCONNECT)
+  else if (type == WS_EVT_DISCONNECT)
+  {
+    // Free queued messages
+    _outbound.RemoveClient(client->id());
+  }
   //else if (type == WS_EVT_ERROR)
   //else if (type == WS_EVT_PONG)
   else if (type == WS_EVT_DATA)
   {
+    portENTER_CRITICAL(&_statMux);
+    _stats.Received++;
+    portEXIT_CRITICAL(&_statMux);
     AwsFrameInfo* info = (AwsFrameInfo*)arg;
     String msg = "";
     if (info->final &&
@@ -193,29 +617,36 @@ void WifiHandler::OnWebsocketEvent(AsyncWebSocket* server, AsyncWebSocketClient*
         if (msg.startsWith("FULLUPDATE"))
         {
           // Send all static settings to mixer on websocket connect
-          client->text("Valid Fullupdate received!");
+          SendText(client, "Valid Fullupdate received!");
           UpdateSettingsToClient(client);
           client->ping();
         }
-        else if (msg.startsWith("LIQUID_INCREMENT:"))
+        else if (msg.startsWith("LIQUID_ANGLE:"))
         {
-          // Split the message by a pre-defined delimiter
+          // Split the message by a pre-defined delimiter (format: "<liquid>,<angle>,<base version>,<sequence>")
           int delimiter = msg.indexOf(":");
           int delimiter_1 = msg.indexOf(",", delimiter + 1);
+          int delimiter_2 = msg.indexOf(",", delimiter_1 + 1);
+          int delimiter_3 = msg.indexOf(",", delimiter_2 + 1);
 
           String liquid_String = msg.substring(delimiter + 1, delimiter_1);
-          String liquidAngle_String = msg.substring(delimiter_1 + 1);
+          String liquidAngle_String = msg.substring(delimiter_1 + 1, delimiter_2);
+          String baseVersion_String = msg.substring(delimiter_2 + 1, delimiter_3);
+          String sequence_String = msg.substring(delimiter_3 + 1);
 
           MixtureLiquid liquid = (MixtureLiquid)liquid_String.toInt();
-          int16_t liquidIncrements_Degrees = (int16_t)liquidAngle_String.toInt();
+          int16_t liquidAngle_Degrees = (int16_t)liquidAngle_String.toInt();
+          uint32_t baseVersion = (uint32_t)baseVersion_String.toInt();
+          uint32_t sequence = (uint32_t)sequence_String.toInt();
 
-          if (Statemachine.UpdateValuesFromWifi((uint32_t)client->id(), liquid, liquidIncrements_Degrees))
-          {
-            client->text("Valid liquid increments received!");
-          }
-          else
+          // Valid angles are acknowledged by the state machine after they are applied
+          if (delimiter_1 < 0 || delimiter_2 < 0 || delimiter_3 < 0 ||
+            !Statemachine.UpdateValuesFromWifi((uint32_t)client->id(), liquid, liquidAngle_Degrees, baseVersion, sequence))
           {
-            client->text("Invalid liquid increments received!");
+            portENTER_CRITICAL(&_statMux);
+            _stats.Rejected++;
+            portEXIT_CRITICAL(&_statMux);
+            SendText(client, String("LIQUID_NACK:") + String(sequence));
           }
         }
         else if (msg.startsWith("CYCLE_TIMESPAN:"))
@@ -225,22 +656,47 @@ void WifiHandler::OnWebsocketEvent(AsyncWebSocket* server, AsyncWebSocketClient*
 
           if (Statemachine.UpdateValuesFromWifi((uint32_t)client->id(), cycleTimespan_ms))
           {
-            client->text("Valid cycle timespan received!");
+            SendText(client, "Valid cycle timespan received!");
           }
           else
           {
-            client->text("Invalid cycle timespan received!");
+            SendText(client, "Invalid cycle timespan received!");
           }
         }
+        else if (msg.startsWith("BOTTLE_REFILL:"))
+        {
+          // Refill is applied in the loop task
+          uint8_t liquidIndex = (uint8_t)msg.substring(msg.indexOf(":") + 1).toInt();
+          if (liquidIndex < LiquidCount)
+          {
+            FlowMeter.RequestRefill(liquidIndex);
+            SendText(client, "Valid bottle refill received!");
+          }
+          else
+          {
+            SendText(client, "Invalid bottle refill received!");
+          }
+        }
+        else if (msg.startsWith("SUBSCRIBE:"))
+        {
+          // Format: "<topic>,<topic>,..." (replaces the subscribed push topics)
+          String topics = "," + msg.substring(msg.indexOf(":") + 1) + ",";
+          uint8_t topicMask = (topics.indexOf(",MIXTURE,") >= 0 ? TOPIC_MIXTURE : 0) |
+            (topics.indexOf(",SETTINGS,") >= 0 ? TOPIC_SETTINGS : 0) |
+            (topics.indexOf(",LEVELS,") >= 0 ? TOPIC_LEVELS : 0);
+
+          _outbound.Subscribe(client->id(), topicMask);
+          SendText(client, "Valid subscribe received!");
+        }
         else if (msg.startsWith("SAVE"))
         {
           if (Statemachine.UpdateValuesFromWifi((uint32_t)client->id(), true))
           {
-            client->text("Valid save received!");
+            SendText(client, "Valid save received!");
           }
           else
           {
-            client->text("Invalid save received!");
+            SendText(client, "Invalid save received!");
           }
         }
       }
@@ -249,30 +705,130 @@ void WifiHandler::OnWebsocketEvent(AsyncWebSocket* server, AsyncWebSocketClient*
 }
 
 //===============================================================
-// Starts the web server
+// Returns the host name for mDNS and DHCP
 //===============================================================
-bool WifiHandler::StartWebServer()
+String WifiHandler::GetHostname()
 {
-  // Reset old webserver instances
-  StopWebServer();
+  String hostname = MIXER_NAME;
+  hostname.toLowerCase();
+  hostname.trim();
+  return hostname;
+}
 
-  IPAddress local_ip(192, 168, 1, 1);
-  IPAddress gateway(192, 168, 1, 1);
-  IPAddress subnet(255, 255, 255, 0);
+//===============================================================
+// Starts joining the provisioned network
+//===============================================================
+void WifiHandler::StartStation(bool fastConnect)
+{
+  // Cached BSSID and channel skip the scan of all channels
+  _staFastConnect = fastConnect && _staChannel > 0;
+  _network->StartStation(GetHostname().c_str(), _staSsid.c_str(), _staPassword.c_str(),
+    _staFastConnect ? _staBssid : NULL, _staFastConnect ? _staChannel : 0);
+}
 
-  // Set wifi TX power
-  WiFi.setTxPower(WIFI_POWER_19_5dBm);
+//===============================================================
+// Supervises the station connection
+//===============================================================
+void WifiHandler::UpdateStation()
+{
+  bool connected = _network->IsStationConnected();
 
-  // Start access point
-  WiFi.softAP(_ssid, _password);
-  WiFi.softAPConfig(local_ip, gateway, subnet);
-  delay(100);
+  if (connected && !_staConnected)
+  {
+    Serial.println("[WIFI] Joined '" + _staSsid + "' as " + _network->GetLocalIP() + " after " + String(millis() - _staConnectStart_ms) + " ms" + (_staFastConnect ? " (cached network)" : ""));
+    _staEverConnected = true;
+
+    // Cache BSSID and channel for the next fast reconnect
+    uint8_t bssid[NETWORK_BSSID_LENGTH];
+    int32_t channel = 0;
+    if (_network->GetStationNetwork(bssid, channel) &&
+      (channel != _staChannel || memcmp(bssid, _staBssid, NETWORK_BSSID_LENGTH) != 0))
+    {
+      memcpy(_staBssid, bssid, NETWORK_BSSID_LENGTH);
+      _staChannel = channel;
+      SaveStation();
+    }
+
+    // Join the fleet with the new address
+    Fleet.Begin(_network->GetLocalIP());
+  }
+  else if (!connected && !_staEverConnected)
+  {
+    uint32_t elapsed_ms = millis() - _staConnectStart_ms;
+
+    if (_staFastConnect && elapsed_ms > STA_FAST_CONNECT_TIMEOUT_MS)
+    {
+      // Cached access point not reachable (moved or channel changed), scan all channels
+      Serial.println("[WIFI] Cached network not reachable, scanning all channels");
+      StartStation(false);
+    }
+    else if (elapsed_ms > STA_CONNECT_TIMEOUT_MS)
+    {
+      // Network not reachable, open access point for new credentials
+      Serial.println("[WIFI] Joining '" + _staSsid + "' failed, starting access point");
+      SetWifiMode(WIFI_MODE_AP);
+      return;
+    }
+  }
+
+  // Later connection losses are handled by the auto reconnect of the network backend
+  _staConnected = connected;
+}
+
+//===============================================================
+// Updates the mDNS TXT records
+//===============================================================
+void WifiHandler::UpdateDiscovery(bool isfullUpdate)
+{
+  MixerState state = Statemachine.GetCurrentState();
+
+  if (isfullUpdate)
+  {
+    // Build comma separated liquid list (one entry per liquid)
+    String names;
+    for (uint8_t index = 0; index < LiquidCount; index++)
+    {
+      names += (index > 0 ? "," : "") + String(LiquidTable[index].Name);
+    }
+
+    _network->SetDiscoveryRecord("name", MIXER_NAME);
+    _network->SetDiscoveryRecord("version", APP_VERSION);
+    _network->SetDiscoveryRecord("liquids", names);
+  }
+
+  // Announce state changes only
+  if (_lastDiscoveryState != state || isfullUpdate)
+  {
+    _network->SetDiscoveryRecord("state", Statemachine.GetCurrentStateName());
+    _lastDiscoveryState = state;
+  }
+}
+
+//===============================================================
+// Starts the network in the given mode and the web server
+//===============================================================
+bool WifiHandler::StartWebServer(wifi_mode_t mode)
+{
+  // Reset old webserver instances
+  StopWebServer();
+
+  if (mode == WIFI_MODE_STA)
+  {
+    // Join the provisioned network (connection is supervised in Update())
+    _staConnectStart_ms = millis();
+    _staConnected = false;
+    _staEverConnected = false;
+    StartStation(true);
+  }
+  else
+  {
+    // Start access point
+    _network->StartAccessPoint(_ssid, _password);
+  }
 
   // Set up mDNS responder to mixer name, e.g. http://aperoliker.local
-  String mdnsName = MIXER_NAME;
-  mdnsName.toLowerCase();
-  mdnsName.trim();
-  MDNS.begin(mdnsName);
+  _network->StartDiscovery(GetHostname().c_str(), 80);
+  UpdateDiscovery(true);
 
   // Create web server
   _webserver.reset(new AsyncWebServer(80));
@@ -288,12 +844,14 @@ bool WifiHandler::StartWebServer()
     return false;
   }
 
-  // Create web events
+#if defined(WEBEVENTS_FALLBACK)
+  // Create web events (only used by clients without websocket)
   _webevents.reset(new AsyncEventSource("/events"));
   if (!_webevents)
   {
     return false;
   }
+#endif
   
   // Add root URL handler to web server
   _webserver->on("/", HTTP_GET, [](AsyncWebServerRequest * request)
@@ -307,30 +865,72 @@ bool WifiHandler::StartWebServer()
     request->send(200, "text/plain", GetSystemInfoString());
   });
 
+  // Add network statistics URL handler to web server (parameter 'reset' starts a new measurement)
+  _webserver->on("/netstats", HTTP_GET, [](AsyncWebServerRequest * request)
+  {
+    if (request->hasParam("reset"))
+    {
+      Wifihandler.ResetNetworkStatistics();
+    }
+    request->send(200, "text/plain", Wifihandler.GetNetworkString());
+  });
+
+  // Add station provisioning URL handler to web server (form parameters 'ssid' and 'password')
+  _webserver->on("/provision", HTTP_POST, [](AsyncWebServerRequest * request)
+  {
+    String ssid = request->hasParam("ssid", true) ? request->getParam("ssid", true)->value() : String("");
+    String password = request->hasParam("password", true) ? request->getParam("password", true)->value() : String("");
+
+    if (Wifihandler.RequestStationCredentials(ssid, password))
+    {
+      request->send(200, "text/plain", ssid.length() > 0 ? "Joining '" + ssid + "', reconnect via http://" + Wifihandler.GetHostname() + ".local" : String("Credentials cleared, starting access point"));
+    }
+    else
+    {
+      request->send(400, "text/plain", "Invalid credentials!");
+    }
+  });
+
+  // Add fleet status and order URL handlers to web server
+  Fleet.AddWebHandlers(_webserver.get());
+
+  // Add pour statistics URL handler to web server
+  Pours.AddWebHandlers(_webserver.get());
+
   // Add SPIFFS Handler to web server
   _webserver->addHandler(new SPIFFSEditor());
 
   // Add not found handler to web server
   _webserver->onNotFound([](AsyncWebServerRequest *request)
   {
-    request->send(404, "text/plain", "Sorry, page not found! Go to 'http://" + String(MIXER_NAME) + ".local' or 'http://192.168.1.1/'");
+    request->send(404, "text/plain", "Sorry, page not found! Go to 'http://" + Wifihandler.GetHostname() + ".local' or 'http://" + Wifihandler.GetLocalIP() + "/'");
   });
 
   // Add websocket handler to web server
   _websocket->onEvent(onWsEvent);
   _webserver->addHandler(_websocket.get());
 
+#if defined(WEBEVENTS_FALLBACK)
   // Add event handler to web server
   _webserver->addHandler(_webevents.get());
+#endif
 
-  // Add static files handler to web server
-  _webserver->serveStatic("/", SPIFFS, "/").setDefaultFile("index.html");
+  // Add static files handler to web server (cached by the browsers)
+  _webserver->serveStatic("/", SPIFFS, "/").setDefaultFile("index.html").setCacheControl(WEBUI_CACHE_CONTROL);
   
   // Start web server
   _webserver->begin();
 
-  // Add service to MDNS
-  MDNS.addService("http", "tcp", 80);
+  // Start fleet protocol (station mode starts it after joining the network)
+  if (mode == WIFI_MODE_AP)
+  {
+    Fleet.Begin(_network->GetLocalIP());
+  }
+
+  // Pushes of other tasks may use the web server from now on
+  xSemaphoreTake(_mutex, portMAX_DELAY);
+  _isServerReady = true;
+  xSemaphoreGive(_mutex);
 
   return true;
 }
@@ -340,6 +940,10 @@ bool WifiHandler::StartWebServer()
 //===============================================================
 void WifiHandler::StopWebServer()
 {
+  // Wait for running pushes of other tasks, then no more pushes until the restart
+  xSemaphoreTake(_mutex, portMAX_DELAY);
+  _isServerReady = false;
+
   // End old web event instances
   if (_webevents)
   {
@@ -360,9 +964,14 @@ void WifiHandler::StopWebServer()
     _webserver->end();
     _webserver.reset();
   }
+  xSemaphoreGive(_mutex);
+
+  // Stop fleet protocol
+  Fleet.End();
 
-  // Deactivate Accesspoint and Wifi
-  WiFi.softAPdisconnect(true);
+  // Deactivate mDNS, access point and station
+  _network->StopDiscovery();
+  _network->Stop();
 }
 
 //===============================================================
@@ -375,17 +984,69 @@ void WifiHandler::UpdateSettingsToClient(AsyncWebSocketClient* client)
     return;
   }
 
-  int16_t angle1 = Statemachine.GetAngle(eLiquid1);
-  int16_t angle2 = Statemachine.GetAngle(eLiquid2);
-  int16_t angle3 = Statemachine.GetAngle(eLiquid3);
   uint32_t cycleTimepan_ms = Pumps.GetCycleTimespan();
 
-  client->printf("CLIENT_ID:%s", String(client->id()).c_str());
-  client->printf("MIXER_NAME:%s", MIXER_NAME);
-  client->printf("LIQUID_NAMES:%s,%s,%s", LIQUID1_NAME, LIQUID2_NAME, LIQUID3_NAME);
-  client->printf("LIQUID_COLORS:%s,%s,%s", String(WIFI_COLOR_LIQUID_1).c_str(), String(WIFI_COLOR_LIQUID_2).c_str(), String(WIFI_COLOR_LIQUID_3).c_str());
-  client->printf("LIQUID_ANGLES:%s,%s,%s", String(angle1).c_str(), String(angle2).c_str(), String(angle3).c_str());
-  client->printf("CYCLE_TIMESPAN:%s", String(cycleTimepan_ms).c_str());
+  // Build comma separated liquid lists (one entry per liquid)
+  String names;
+  String colors;
+  for (uint8_t index = 0; index < LiquidCount; index++)
+  {
+    names += (index > 0 ? "," : "") + String(LiquidTable[index].Name);
+    colors += (index > 0 ? "," : "") + String(LiquidTable[index].WifiColor);
+  }
+
+  // Queued messages of the same topic are replaced (repeated full updates of a slow client)
+  SendText(client, "CLIENT_ID:" + String(client->id()));
+  SendText(client, String("MIXER_NAME:") + MIXER_NAME);
+  SendText(client, "LIQUID_NAMES:" + names);
+  SendText(client, "LIQUID_COLORS:" + colors);
+  uint32_t version = Statemachine.GetMixtureVersion();
+  SendText(client, "MIXTURE:" + String(version) + ":" + GetLiquidAnglesString(), version);
+  SendText(client, "CYCLE_TIMESPAN:0:" + String(cycleTimepan_ms));
+}
+
+//===============================================================
+// Returns all liquid angles as comma separated string
+//===============================================================
+String WifiHandler::GetLiquidAnglesString()
+{
+  String angles;
+  for (uint8_t index = 0; index < LiquidCount; index++)
+  {
+    angles += (index > 0 ? "," : "") + String(Statemachine.GetAngle((MixtureLiquid)index));
+  }
+  return angles;
+}
+
+//===============================================================
+// Returns the mixture diff from the base version to the version
+// (liquids changed since the base version or given by the mask),
+// empty if no liquid changed
+//===============================================================
+String WifiHandler::GetMixtureDiffString(uint32_t baseVersion, uint32_t version, uint32_t changedLiquids)
+{
+  // Format: "<client ID>:<base version>:<version>:<liquid>=<angle>,..." (client ID 0 -> several writers or the encoder)
+  String angles;
+  uint32_t writerID = 0;
+  bool isFirst = true;
+  for (uint8_t index = 0; index < LiquidCount; index++)
+  {
+    uint32_t angleClientID = 0;
+    uint32_t angleVersion = Statemachine.GetAngleVersion((MixtureLiquid)index, angleClientID);
+    if ((changedLiquids & (1UL << index)) ||
+      (changedLiquids == 0 && angleVersion > baseVersion))
+    {
+      angles += (isFirst ? "" : ",") + String(index) + "=" + String(Statemachine.GetAngle((MixtureLiquid)index));
+      writerID = (isFirst || writerID == angleClientID) ? angleClientID : 0;
+      isFirst = false;
+    }
+  }
+
+  if (isFirst)
+  {
+    return String();
+  }
+  return String(writerID) + ":" + String(baseVersion) + ":" + String(version) + ":" + angles;
 }
 
 #endif
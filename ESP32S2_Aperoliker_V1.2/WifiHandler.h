@@ -13,7 +13,6 @@
 // Includes
 //===============================================================
 #include <Arduino.h>
-#include <Preferences.h>
 #include <SPIFFS.h>
 #include <WiFi.h>
 #include <ESPmDNS.h>
@@ -22,15 +21,58 @@
 #include <SPIFFSEditor.h>
 #include "Config.h"
 #include "StateMachine.h"
+#include "NetworkBackend.h"
+#include "FleetController.h"
+#include "OutboundQueue.h"
+#include "SettingsStore.h"
+#include "PourLog.h"
 
 #if defined(WIFI_MIXER)
 
 //===============================================================
 // Defines
 //===============================================================
-#define KEY_WIFIMODE      "WifiMode"   // Key name: Maximum string length is 15 bytes, excluding a zero terminator.
+// Station mode defines
+#define STA_SSID_MAX_LENGTH             32      // Maximum SSID length of a network
+#define STA_PASSWORD_MIN_LENGTH         8       // Minimum WPA2 password length (empty password -> open network)
+#define STA_PASSWORD_MAX_LENGTH         63      // Maximum WPA2 password length
+#define STA_FAST_CONNECT_TIMEOUT_MS     3000    // Timeout for joining with cached BSSID and channel, then scan all channels
+#define STA_CONNECT_TIMEOUT_MS          15000   // Timeout for joining a network, then fall back to access point
+#define STA_PROVISION_DELAY_MS          1000    // Delay for the provisioning response before the network is changed
+
+// Web interface defines
+#define WEBUI_CACHE_CONTROL             "max-age=300"   // Browsers reuse static files for 5 minutes (reloads and reconnects without requests)
+#define WEBEVENTS_FALLBACK                      // Server-sent events at "/events" for clients without websocket (comment out to save the handler)
+#define WEBEVENTS_MAX_PACKETS_WAITING   4       // Events are skipped while the clients have more packets waiting (clients resync by version)
+
+// Push topics of the websocket clients (subscribed with "SUBSCRIBE:MIXTURE,SETTINGS,LEVELS")
+#define TOPIC_MIXTURE                   0x01    // "MIXTURE_DIFF" and "MIXTURE_VERSION"
+#define TOPIC_SETTINGS                  0x02    // "CYCLE_TIMESPAN"
+#define TOPIC_LEVELS                    0x04    // "LEVELS"
+
+// Network statistics defines
+#define NETSTAT_LATENCY_BUCKETS         12      // Acknowledge latency histogram (upper bounds 1, 2, 4 ... 2048 ms)
 
 
+//===============================================================
+// Network statistics (counted in the web server, state machine
+// and loop task)
+//===============================================================
+struct NetworkStatistics
+{
+  uint32_t Start_ms;                                // Start of the measurement
+  uint32_t Received;                                // Received websocket messages
+  uint32_t Rejected;                                // Rejected liquid angles
+  uint32_t Dropped;                                 // Dropped messages (client over its limit, skipped events)
+  uint32_t Evicted;                                 // Closed slow websocket clients
+  uint32_t Sent;                                    // Sent messages (events counted per client)
+  uint32_t BytesSent;                               // Sent payload bytes
+  uint16_t PeakClients;                             // Peak of the connected clients
+  uint32_t MinFreeHeap;                             // Minimum free heap (UINT32_MAX -> not measured yet)
+  uint32_t Latencies[NETSTAT_LATENCY_BUCKETS];      // Acknowledge latency histogram
+  uint32_t LatencyMax_ms;                           // Maximum acknowledge latency
+};
+
 //===============================================================
 // Class for wifi handling
 //===============================================================
@@ -43,26 +85,59 @@ class WifiHandler
     // Initializes the wifi handler
     void Begin();
 
-    // Load values from flash
+    // Load values from the settings store
     void Load();
 
-    // Save values to flash
+    // Save values to the settings store
     void Save();
 
     // Returns the current wifi mode
     wifi_mode_t GetWifiMode();
 
-    // Sets the wifi mode
+    // Returns the current wifi mode as short string ("AP", "STA" or "OFF")
+    String GetWifiModeString();
+
+    // Sets the wifi mode (station mode falls back to access point without credentials)
     void SetWifiMode(wifi_mode_t mode);
 
+    // Replaces the network backend (e.g. by a local stand-in), call before Begin()
+    void SetNetworkBackend(NetworkBackend* network);
+
+    // Requests new station credentials (empty SSID clears them), applied in Update()
+    bool RequestStationCredentials(const String& ssid, const String& password);
+
+    // Returns the host name for mDNS and DHCP, e.g. "aperoliker"
+    String GetHostname();
+
+    // Returns the local IP address of the web server
+    String GetLocalIP();
+
     // Returns the amount of connected clients
     uint16_t GetConnectedClients();
 
     // Updates cycle timespan in connected clients
     void UpdateCycleTimespanToClients(uint32_t clientID);
 
-    // Updates all liquid angles in connected clients
-    void UpdateLiquidAnglesToClients(uint32_t clientID);
+    // Updates the changed liquid angles of the new mixture version in connected clients
+    void UpdateMixtureToClients(uint32_t clientID, uint32_t changedLiquids);
+
+    // Updates bottle fill levels and the refused liquid in connected clients
+    void UpdateLevelsToClients();
+
+    // Acknowledges an applied or conflicting liquid angle to the sending client
+    void AcknowledgeLiquidAngle(uint32_t clientID, uint32_t sequence, bool isApplied, uint32_t received_ms);
+
+    // Returns the network statistics (latency percentiles, messages, bytes, clients, heap) as string
+    String GetNetworkString();
+
+    // Resets the network statistics (e.g. at the start of a load test)
+    void ResetNetworkStatistics();
+
+    // Returns a consistent copy of the network statistics
+    NetworkStatistics GetNetworkStatistics();
+
+    // Returns the upper bound of the latency bucket containing the percentile in ms
+    static uint32_t GetLatencyPercentile(const NetworkStatistics& statistics, uint8_t percent);
 
     // Updates the web server and clients
     void Update();
@@ -71,33 +146,93 @@ class WifiHandler
     void OnWebsocketEvent(AsyncWebSocket* server, AsyncWebSocketClient* client, AwsEventType type, void* arg, uint8_t* data, size_t len);
 
   private:
-    // Preferences variable
-    Preferences _preferences;
-    
     // Wifi settings
     wifi_mode_t _initWifiMode = WIFI_MODE_AP;
     wifi_mode_t _wifiMode = WIFI_MODE_NULL;
 
-    // SSID and Password
+    // SSID and Password of the access point
     const char* _ssid = MIXER_NAME;
     const char* _password = "mixer1234";
+
+    // Network backend (radio and mDNS)
+    NetworkBackend* _network;
+
+    // Station credentials and cached network of the last connection
+    String _staSsid;
+    String _staPassword;
+    uint8_t _staBssid[NETWORK_BSSID_LENGTH] = {};
+    int32_t _staChannel = 0;
+
+    // Station connection variables
+    uint32_t _staConnectStart_ms = 0;
+    bool _staFastConnect = false;
+    bool _staConnected = false;
+    bool _staEverConnected = false;
+
+    // Provisioning variables (written by the web server task)
+    String _provisionSsid;
+    String _provisionPassword;
+    uint32_t _provisionRequest_ms = 0;
+    volatile bool _provisionRequested = false;
+
+    // Discovery variables
+    MixerState _lastDiscoveryState = eDashboard;
     
-    // Web server variables
+    // Web server variables (pushes of other tasks use them only while ready, under the mutex)
     std::unique_ptr<AsyncWebServer> _webserver;
     std::unique_ptr<AsyncWebSocket> _websocket;
     std::unique_ptr<AsyncEventSource> _webevents;
+    SemaphoreHandle_t _mutex = NULL;
+    volatile bool _isServerReady = false;
 
     // Alive counter variable
     uint32_t _lastAlive_ms = 0;
 
-    // Starts the web server
-    bool StartWebServer();
+    // Outbound message queues of the websocket clients
+    OutboundQueue _outbound;
+
+    // Network statistics (counted in the web server, state machine and loop task, only changed in the critical section)
+    NetworkStatistics _stats = { 0, 0, 0, 0, 0, 0, 0, 0, UINT32_MAX, {}, 0 };
+    portMUX_TYPE _statMux = portMUX_INITIALIZER_UNLOCKED;
+
+    // Saves station credentials and cached network to the settings store (committed immediately)
+    void SaveStation();
+
+    // Starts joining the provisioned network
+    void StartStation(bool fastConnect);
+
+    // Supervises the station connection (network cache and fallback)
+    void UpdateStation();
+
+    // Updates the mDNS TXT records (name, liquids, state)
+    void UpdateDiscovery(bool isfullUpdate);
+
+    // Starts the network in the given mode and the web server
+    bool StartWebServer(wifi_mode_t mode);
 
     // Stops the web server
     void StopWebServer();
 
     // Updates all settings in given client
     void UpdateSettingsToClient(AsyncWebSocketClient* client);
+
+    // Publishes a state push to all websocket clients subscribed to the topic and the event clients
+    void Publish(uint8_t topic, const char* event, const String& data);
+
+    // Sends an event to all event clients (counted in the network statistics)
+    void SendEvent(const String& data, const char* event);
+
+    // Sends a text to a websocket client (queued, if the client can't take it now), a mixture version is taken over by the client on sending
+    void SendText(AsyncWebSocketClient* client, const String& text, uint32_t mixtureVersion = 0);
+
+    // Sends queued messages and closes clients, which don't take their messages
+    void UpdateOutboundQueues();
+
+    // Returns all liquid angles as comma separated string
+    String GetLiquidAnglesString();
+
+    // Returns the mixture diff from the base version (changed liquids given by the mask or taken from the angle versions)
+    String GetMixtureDiffString(uint32_t baseVersion, uint32_t version, uint32_t changedLiquids);
 };
 
 
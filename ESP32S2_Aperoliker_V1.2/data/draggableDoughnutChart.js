@@ -67,6 +67,14 @@
     this.onchange = setupValues.onchange;
     this.onshift = setupValues.onshift;
 
+    // Render variables (drawing is done once per animation frame)
+    this.isFrameRequested = false;
+    this.pendingShifts = {};
+    this.layerCanvas = document.createElement('canvas');
+    this.layerContext = this.layerCanvas.getContext("2d");
+    this.layerKey = null;
+    this.overlayKey = null;
+
     // Bind appropriate events
     this.canvas.addEventListener('touchstart', function (e)
     {
@@ -198,10 +206,14 @@
   // Set the names of the doughnut chart parts
   DraggableDoughnutchart.prototype.Setnames = function (names)
   {
-    // Check for correct length
+    // Rebuild the parts if the mixer has a different count of liquids
     if (this.data.length !== names.length)
     {
-      return;
+      this.data = [];
+      for (var index = 0; index < names.length; index++)
+      {
+        this.data.push({ label: '', color: "#969696", angle: Math.round(index * 360 / names.length) });
+      }
     }
     
     // Set new names
@@ -273,6 +285,12 @@
     this.Draw();
   };
 
+  // Returns true, if shifted angles are not reported by onshift yet
+  DraggableDoughnutchart.prototype.IsShiftPending = function ()
+  {
+    return Object.keys(this.pendingShifts).length > 0;
+  };
+
   // Gets percentage for slice with current index
   DraggableDoughnutchart.prototype.GetSliceSizePercentage = function (index)
   {
@@ -386,27 +404,73 @@
     return arcSize;
   };
 
-  // Draws the doughnutchart
+  // Requests drawing the doughnutchart in the next animation frame (several requests are drawn once)
   DraggableDoughnutchart.prototype.Draw = function ()
+  {
+    var doughnutchart = this;
+    if (doughnutchart.isFrameRequested)
+    {
+      return;
+    }
+    
+    doughnutchart.isFrameRequested = true;
+    requestFrame(function ()
+    {
+      doughnutchart.isFrameRequested = false;
+      doughnutchart.Render();
+    });
+  };
+
+  // *INTERNAL USE ONLY*
+  // Draws the doughnutchart (segments and labels are cached in a layer canvas until they change)
+  DraggableDoughnutchart.prototype.Render = function ()
   {
     var doughnutchart = this;
     var context = doughnutchart.context;
     var canvas = doughnutchart.canvas;
-    context.clearRect(0, 0, canvas.width, canvas.height);
-
+    var layerContext = doughnutchart.layerContext;
     var geometry = this.GetGeometry();
-
-    // Draw each segment
-    for (index = 0; index < doughnutchart.data.length; index++)
+    
+    // Report shifted angles once per frame
+    doughnutchart.ReportShifts();
+    
+    // Redraw segments and labels only if angles, colors, names or the size have changed
+    var layerKey = canvas.width + "x" + canvas.height + doughnutchart.data.map(function (segment)
     {
-      doughnutchart.DrawSegment(context, doughnutchart, geometry, index);
+      return ";" + segment.angle + "," + segment.color + "," + segment.label;
+    }).join("");
+    var isLayerChanged = layerKey !== doughnutchart.layerKey;
+    if (isLayerChanged)
+    {
+      doughnutchart.layerKey = layerKey;
+      doughnutchart.layerCanvas.width = canvas.width;
+      doughnutchart.layerCanvas.height = canvas.height;
+      layerContext.clearRect(0, 0, canvas.width, canvas.height);
+      
+      // Draw each segment
+      for (var index = 0; index < doughnutchart.data.length; index++)
+      {
+        doughnutchart.DrawSegment(layerContext, doughnutchart, geometry, index);
+      }
+      
+      // Draw each label
+      for (var index = 0; index < doughnutchart.data.length; index++)
+      {
+        doughnutchart.DrawLabel(layerContext, doughnutchart, geometry, index);
+      }
     }
     
-    // Draw each label
-    for (index = 0; index < doughnutchart.data.length; index++)
+    // Nothing to draw if the hovered segment and the online state are unchanged too
+    var overlayKey = doughnutchart.hoveredIndex + "," + doughnutchart.online;
+    if (!isLayerChanged && overlayKey === doughnutchart.overlayKey)
     {
-      doughnutchart.DrawLabel(context, doughnutchart, geometry, index);
+      return;
     }
+    doughnutchart.overlayKey = overlayKey;
+    
+    // Copy cached segments and labels
+    context.clearRect(0, 0, canvas.width, canvas.height);
+    context.drawImage(doughnutchart.layerCanvas, 0, 0);
     
     // Draw node if hovered segment
     if (doughnutchart.hoveredIndex !== -1)
@@ -423,7 +487,27 @@
     context.fillText(doughnutchart.online ? "Online" : "Offline", 0, fontsize / 2);
     context.restore();
     
-    doughnutchart.onchange();
+    // Shares only change with the segments
+    if (isLayerChanged)
+    {
+      doughnutchart.onchange();
+    }
+  };
+
+  // *INTERNAL USE ONLY*
+  // Reports the accumulated shifts of every moved angle by onshift
+  DraggableDoughnutchart.prototype.ReportShifts = function ()
+  {
+    var pendingShifts = this.pendingShifts;
+    this.pendingShifts = {};
+    
+    for (var index in pendingShifts)
+    {
+      if (pendingShifts.hasOwnProperty(index) && pendingShifts[index] != 0)
+      {
+        this.onshift(parseInt(index), pendingShifts[index]);
+      }
+    }
   };
 
   // *INTERNAL USE ONLY*
@@ -484,10 +568,11 @@
     
     //console.log("Next=" + nextIndex + ", Angle=" + distanceDragToNext + " | Previous=" + previousIndex + ", Angle=" + distanceDragToPrevious);
     
-    // Check for angle changes
+    // Check for angle changes (reported once per animation frame)
     if (realShiftedDistance != 0)
     {
-      doughnutchart.onshift(draggedSegment.index, realShiftedDistance);
+      var index = draggedSegment.index;
+      doughnutchart.pendingShifts[index] = (doughnutchart.pendingShifts[index] || 0) + realShiftedDistance;
     }
   };
   
@@ -599,6 +684,19 @@
   //-------------------------------------------------
   // Utilities + Constants
   //-------------------------------------------------
+  // Calls the function in the next animation frame (fallback for old browsers: 60 frames per second)
+  function requestFrame(callback)
+  {
+    if (window.requestAnimationFrame)
+    {
+      window.requestAnimationFrame(callback);
+    }
+    else
+    {
+      setTimeout(callback, 16);
+    }
+  };
+
   // Calculates 0-360° to 0-2Pi   
   function degreesToRadians(degrees)
   {
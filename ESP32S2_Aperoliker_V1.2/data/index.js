@@ -9,9 +9,20 @@
 // Global variables
 var doughnutchart = null;
 var websocket = null;
+var events = null;
+var socketFailures = 0;
 var clientID = 0;
 var websocketConnected = false;
 var lastAliveTimestamp = new Date(0);
+var mixtureVersion = 0;
+var liquidSequence = 0;
+var liquidAckedSequence = 0;
+var isResyncRequired = false;
+var isFullUpdateRequested = false;
+var isDebug = false;
+var reconnectDelay_ms = 500;
+var offlineLiquids = {};
+var offlineCycleTimespan = null;
 
 (function()
 {
@@ -48,10 +59,20 @@ var lastAliveTimestamp = new Date(0);
     var sliderCycleTimespan = document.getElementById('sliderCycleTimespan');
     sliderCycleTimespan.oninput = OnInputCycleTimespan;
     sliderCycleTimespan.onchange = OnChangeCycleTimespan;
-    sliderCycleTimespan.min = 200;
+    sliderCycleTimespan.min = 180; // One step below 200ms -> automatic mode
     sliderCycleTimespan.max = 1000;
     sliderCycleTimespan.step = 20;
     sliderCycleTimespan.value = 500;
+
+    // Initialize bottle refill buttons
+    [].forEach.call(document.getElementsByClassName('refill-button'), function (refillButton)
+    {
+      refillButton.onclick = OnClickRefill;
+    });
+
+    // Initialize button for wifi provisioning
+    var buttonWifiProvision = document.getElementById('buttonWifiProvision');
+    buttonWifiProvision.onclick = OnClickWifiProvision;
         
     // Set default data (angles in 0-360°), size and event handlers in doughnut chart
     var setup = 
@@ -75,9 +96,28 @@ var lastAliveTimestamp = new Date(0);
     // Start alive timer
     setInterval(CheckAlive, 500);
     
-    // Start web socket and web events
-    StartSocket();
-    StartEvents();
+    // Start web socket (web events only as fallback)
+    if (window.WebSocket)
+    {
+      StartSocket();
+    }
+    else
+    {
+      StartEvents();
+    }
+    
+    // Cache the page for fast reloads (service workers are only available in secure contexts)
+    if ('serviceWorker' in navigator && window.isSecureContext)
+    {
+      navigator.serviceWorker.register('sw.js');
+    }
+  }
+  
+  // Restarts the websocket with exponential backoff (0.5s, 1s, 2s ... 8s)
+  function ReconnectSocket()
+  {
+    setTimeout(StartSocket, reconnectDelay_ms);
+    reconnectDelay_ms = Math.min(reconnectDelay_ms * 2, 8000);
   }
 
   // Starts the websocket
@@ -85,20 +125,41 @@ var lastAliveTimestamp = new Date(0);
   {
     websocket = new WebSocket('ws://' + document.location.host + '/websocket', ['arduino']);
     websocket.binaryType = "arraybuffer";
+    var isOpened = false;
     
     // Connected handler
     websocket.onopen = function(e)
     {
-      console.log("Websocket connected");
+      Log("Websocket connected");
       websocketConnected = true;
       lastAliveTimestamp = Date.now();
+      reconnectDelay_ms = 500;
+      socketFailures = 0;
+      isOpened = true;
+
+      // Pushes are sent over the websocket, the fallback events aren't needed anymore
+      websocket.send("SUBSCRIBE:MIXTURE,SETTINGS,LEVELS");
+      StopEvents();
+
+      // A new connection gets a new client ID and a full update, old sequence numbers are never acknowledged
+      liquidAckedSequence = liquidSequence;
+      isResyncRequired = false;
+      isFullUpdateRequested = true;
     };
     
-    // Disconnected handler
+    // Disconnected handler (edits are queued until the websocket is reconnected)
     websocket.onclose = function(e)
     {
-      console.log("Websocket disconnected");
+      Log("Websocket disconnected");
       websocketConnected = false;
+      
+      // Websocket doesn't get through (e.g. a proxy), receive the pushes by events meanwhile
+      socketFailures = isOpened ? 0 : socketFailures + 1;
+      if (socketFailures >= 3 && !events)
+      {
+        StartEvents();
+      }
+      ReconnectSocket();
     };
     
     // Error handler
@@ -111,7 +172,7 @@ var lastAliveTimestamp = new Date(0);
     // Message handler
     websocket.onmessage = function(e)
     {
-      console.log("Websocket new message:" + e.data);
+      Log("Websocket new message:" + e.data);
       lastAliveTimestamp = Date.now();
       
       if (e.data.startsWith("CLIENT_ID:"))
@@ -124,19 +185,79 @@ var lastAliveTimestamp = new Date(0);
         
         if (value_int == NaN)
         {
-          console.log("Data for client ID not matching (NaN is not allowed)");
+          Log("Data for client ID not matching (NaN is not allowed)");
           return;
         }
         
         if (value_int == 0)
         {
-          console.log("Data for client ID not matching (0 is not allowed)");
+          Log("Data for client ID not matching (0 is not allowed)");
           return;
         }
         
         clientID = value_int;
         
-        console.log("Set [CLIENT_ID] = " + value_int);
+        Log("Set [CLIENT_ID] = " + value_int);
+      }
+      else if (e.data.startsWith("LIQUID_ACK:") ||
+        e.data.startsWith("LIQUID_CONFLICT:") ||
+        e.data.startsWith("LIQUID_NACK:"))
+      {
+        // All angles up to this sequence number are handled by the mixer (format: "<sequence>,<version>")
+        var values = e.data.substring(e.data.indexOf(":") + 1).split(",");
+        var sequence = parseInt(values[0]);
+        if (!isNaN(sequence) && sequence > liquidAckedSequence)
+        {
+          liquidAckedSequence = sequence;
+        }
+
+        // Conflicting (another client was faster) or rejected angles require the mixture of the mixer
+        if (!e.data.startsWith("LIQUID_ACK:"))
+        {
+          isResyncRequired = true;
+        }
+
+        if (!IsLiquidPending() && isResyncRequired)
+        {
+          RequestFullUpdate();
+        }
+      }
+      else if (e.data.startsWith("MIXTURE:"))
+      {
+        // Full mixture snapshot (format: "<version>:<angle>,<angle>,...")
+        var values = e.data.split(":");
+        var version = parseInt(values[1]);
+        var angles = ParseAngles(values[2].split(","));
+        isFullUpdateRequested = false;
+
+        if (isNaN(version) || angles === null || !doughnutchart)
+        {
+          return;
+        }
+
+        // Own angles are still pending, take over the mixture after the acknowledges
+        if (IsLiquidPending())
+        {
+          isResyncRequired = true;
+          return;
+        }
+
+        // Angles edited while offline win over the mixer angles
+        var offlineIndexes = Object.keys(offlineLiquids).map(function(index) { return parseInt(index); });
+        offlineIndexes.forEach(function(index)
+        {
+          angles[index] = Math.round(doughnutchart.data[index].angle) % 360;
+        });
+        offlineLiquids = {};
+
+        mixtureVersion = version;
+        isResyncRequired = false;
+        doughnutchart.Setangles(angles);
+
+        Log("Set [MIXTURE] = " + version + ":" + angles);
+
+        // Replay offline edits as one update based on the received version
+        ReplayOfflineEdits(offlineIndexes);
       }
       else if (e.data.startsWith("MIXER_NAME:"))
       {
@@ -150,250 +271,380 @@ var lastAliveTimestamp = new Date(0);
         nameVar.innerHTML = name_String;
         titleVar.innerHTML = name_String;
         
-        console.log("Set [MIXER_NAME] = " + name_String);
+        Log("Set [MIXER_NAME] = " + name_String);
         
         // Set image if available
         var imageVar = document.getElementById('mixerNameImage');
         imageVar.data = "logo_" + name_String.toLowerCase() + ".svg";
       }
       else if (e.data.startsWith("LIQUID_NAMES:") ||
-        e.data.startsWith("LIQUID_COLORS:") ||
-        e.data.startsWith("LIQUID_ANGLES:"))
+        e.data.startsWith("LIQUID_COLORS:"))
       {
-        // Split the message by a pre-defined delimiter
-        var delimiter_0 = e.data.indexOf(":");
-        var delimiter_1 = e.data.indexOf(",", delimiter_0 + 1);
-        var delimiter_2 = e.data.indexOf(",", delimiter_1 + 1);
-
-        var value1_String = e.data.substring(delimiter_0 + 1, delimiter_1);
-        var value2_String = e.data.substring(delimiter_1 + 1, delimiter_2);
-        var value3_String = e.data.substring(delimiter_2 + 1, e.data.length);
+        // Split the message by a pre-defined delimiter (one value per liquid)
+        var delimiter = e.data.indexOf(":");
+        var values = e.data.substring(delimiter + 1, e.data.length).split(",");
         
         if (!doughnutchart)
         {
-          console.log("Doughnutchart is null");
+          Log("Doughnutchart is null");
           return;
         }
         
         if (e.data.startsWith("LIQUID_NAMES:"))
         {
+          // Rebuild the proportions table for the count of liquids
+          BuildProportionsTable(values.length);
+          
           // Set new names
-          var names = [ value1_String, value2_String, value3_String ];
-          doughnutchart.Setnames(names);
+          doughnutchart.Setnames(values);
       
-          console.log("Set [LIQUID_NAMES] = " + names);
+          Log("Set [LIQUID_NAMES] = " + values);
         }
         else if (e.data.startsWith("LIQUID_COLORS:"))
         {
-          var value1_int = parseInt(value1_String);
-          var value2_int = parseInt(value2_String);
-          var value3_int = parseInt(value3_String);
-          
-          if (value1_int == NaN || value2_int == NaN || value3_int == NaN)
+          var colors = [];
+          for (var index = 0; index < values.length; index++)
           {
-            console.log("Data for liquid colors not matching (NaN is not allowed)");
-            return;
+            var value_int = parseInt(values[index]);
+            
+            if (isNaN(value_int))
+            {
+              Log("Data for liquid colors not matching (NaN is not allowed)");
+              return;
+            }
+            
+            colors.push("#" + value_int.toString(16).padStart(6, "0"));
           }
           
-          var color1_string = "#" + value1_int.toString(16).padStart(6, "0");
-          var color2_string = "#" + value2_int.toString(16).padStart(6, "0");
-          var color3_string = "#" + value3_int.toString(16).padStart(6, "0");
-          
           // Set new colors
-          var colors = [ color1_string, color2_string, color3_string ];
           doughnutchart.Setcolors(colors);
         
-          console.log("Set [LIQUID_COLORS] = " + colors);
-        }
-        else if (e.data.startsWith("LIQUID_ANGLES:"))
-        {
-          var angle1 = parseInt(value1_String);
-          var angle2 = parseInt(value2_String);
-          var angle3 = parseInt(value3_String);
-          
-          if (angle1 == NaN || angle2 == NaN || angle3 == NaN)
-          {
-            console.log("Data for liquid angles not matching (NaN is not allowed)");
-            return;
-          }
-          
-          if (angle1 < 0 || angle1 > 360 || angle2 < 0 || angle2 > 360 || angle3 < 0 || angle3 > 360)
-          {
-            console.log("Data for liquid angles not matching (must be within 0° and 360°)");
-            return;
-          }
-          
-          // Set new angles
-          var angles = [ angle1, angle2, angle3 ];
-          doughnutchart.Setangles(angles);
-        
-          console.log("Set [LIQUID_ANGLES] = " + angles);
+          Log("Set [LIQUID_COLORS] = " + colors);
         }
       }
+      else if (e.data.startsWith("MIXTURE_DIFF:"))
+      {
+        HandleMixtureDiff(e.data.substring(e.data.indexOf(":") + 1));
+      }
+      else if (e.data.startsWith("MIXTURE_VERSION:"))
+      {
+        HandleMixtureVersion(e.data.substring(e.data.indexOf(":") + 1));
+      }
       else if (e.data.startsWith("CYCLE_TIMESPAN:"))
       {
-        // Split the message by a pre-defined delimiter
-        var delimiter = e.data.indexOf(":");
-        var cycletimespan_String = e.data.substring(delimiter + 1, e.data.length);
-        
-        var value_int = parseInt(cycletimespan_String);
-        
-        if (value_int == NaN)
-        {
-          console.log("Data for cycle timespan not matching (NaN is not allowed)");
-          return;
-        }
-        
-        if (value_int < 200 || value_int > 1000)
-        {
-          console.log("Data for cycle timespan not matching (must be within 200ms and 1000ms)");
-          return;
-        }
-        
-        // Set new cycle timespan value
-        var output = document.getElementById('valueCycleTimespan');
-        var slider = document.getElementById("sliderCycleTimespan");
-        
-        slider.value = value_int;
-        output.innerHTML = value_int + "ms";
-    
-        console.log("Set [CYCLE_TIMESPAN] = " + value_int + "ms");
+        HandleCycleTimespan(e.data.substring(e.data.indexOf(":") + 1));
+      }
+      else if (e.data.startsWith("LEVELS:"))
+      {
+        HandleLevels(e.data.substring(e.data.indexOf(":") + 1));
       }
     };
   }
   
-  // Starts the events
+  // Starts the events (fallback for browsers without a working websocket, receives pushes only)
   function StartEvents()
   {
-    var events = new EventSource('/events');
+    events = new EventSource('/events');
     events.onopen = function(e)
     {
-      console.log("Events Opened");
+      Log("Events Opened");
       lastAliveTimestamp = Date.now();
     };
     
     events.onerror = function(e)
     {
-      if (e.target.readyState !== EventSource.OPEN)
+      // The browser reconnects by itself, only closed event sources are restarted with backoff
+      if (e.target.readyState === EventSource.CLOSED && e.target === events)
       {
-        console.log("Events Closed");
+        Log("Events Closed");
+        events = null;
+        setTimeout(StartEvents, reconnectDelay_ms);
       }
     };
     
     events.onmessage = function(e)
     {
-      console.log("Event: " + e.data);
+      Log("Event: " + e.data);
       lastAliveTimestamp = Date.now();
     };
     
-    events.addEventListener('ALIVE', function(e)
+    // Same data as the websocket pushes
+    [['MIXTURE_DIFF', HandleMixtureDiff],
+     ['MIXTURE_VERSION', HandleMixtureVersion],
+     ['CYCLE_TIMESPAN', HandleCycleTimespan],
+     ['LEVELS', HandleLevels]].forEach(function(listener)
     {
-      lastAliveTimestamp = Date.now();
-      console.log("Set [ALIVE] = true");
-      
-    }, false);
+      events.addEventListener(listener[0], function(e)
+      {
+        Log("Event[" + listener[0] + "]:" + e.data);
+        lastAliveTimestamp = Date.now();
+        listener[1](e.data);
+        
+      }, false);
+    });
+  }
+  
+  // Stops the events (the websocket carries the pushes again)
+  function StopEvents()
+  {
+    if (events)
+    {
+      Log("Events Stopped");
+      events.close();
+      events = null;
+    }
+  }
+  
+  // Applies the changed angles of a new mixture version (format: "<client ID>:<base version>:<version>:<liquid>=<angle>,...")
+  function HandleMixtureDiff(data)
+  {
+    // Split the message by a pre-defined delimiter
+    var values = data.split(":");
+    var clientID_int = parseInt(values[0]);
+    var baseVersion = parseInt(values[1]);
+    var version = parseInt(values[2]);
     
-    events.addEventListener('LIQUID_ANGLES', function(e)
+    if (isNaN(clientID_int) || isNaN(baseVersion) || isNaN(version) || values.length !== 4 || !doughnutchart)
     {
-      console.log("Event[LIQUID_ANGLES]:" + e.data);
-      lastAliveTimestamp = Date.now();
-      
-      // Split the message by a pre-defined delimiter
-      var delimiter = e.data.indexOf(":");
-      var clientID_String = e.data.substring(0, delimiter);
-      var angles_String = e.data.substring(delimiter + 1, e.data.length);
-      
-      var clientID_int = parseInt(clientID_String);
-      
-      if (clientID_int == NaN)
-      {
-        console.log("Data for client ID not matching (NaN is not allowed)");
-        return;
-      }
-      
-      // Split angle data
-      const angles = angles_String.split(",", 3);
-      
-      // Check for correct length
-      if (angles.length !== 3)
+      Log("Data for mixture not matching");
+      return;
+    }
+    
+    // Old or already known version
+    if (version <= mixtureVersion)
+    {
+      return;
+    }
+    
+    // Own angles are still pending (the chart is ahead of the mixer), changes of other clients are taken over later
+    if (IsLiquidPending())
+    {
+      isResyncRequired = isResyncRequired || clientID_int != clientID || baseVersion > mixtureVersion;
+      mixtureVersion = version;
+      return;
+    }
+    
+    // Missed a version (the diff starts after the known version), the diff can't be applied
+    if (baseVersion > mixtureVersion)
+    {
+      RequestFullUpdate();
+      return;
+    }
+    
+    // Apply changed angles
+    var angles = doughnutchart.data.map(function(segment) { return segment.angle; });
+    values[3].split(",").forEach(function(change)
+    {
+      var pair = change.split("=");
+      var index = parseInt(pair[0]);
+      var angle = parseInt(pair[1]);
+      if (index >= 0 && index < angles.length && angle >= 0 && angle < 360)
       {
-        console.log("Data length for liquid angles not matching (must be 3)");
-        return;
+        angles[index] = angle;
       }
-      
-      // Get liquid angle values
-      var angle1_int = parseInt(angles[0]);
-      var angle2_int = parseInt(angles[1]);
-      var angle3_int = parseInt(angles[2]);
-      
-      if (angle1_int < 0 || angle1_int > 360 || angle2_int < 0 || angle2_int > 360 || angle3_int < 0 || angle3_int > 360)
+    });
+    
+    mixtureVersion = version;
+    doughnutchart.Setangles(angles);
+    
+    Log("Set [MIXTURE] = " + version + ":" + angles);
+  }
+  
+  // Requests the mixture, if a version was missed (format: "<version>", sent every second)
+  function HandleMixtureVersion(data)
+  {
+    var version = parseInt(data);
+    if (!isNaN(version) && version != mixtureVersion && !IsLiquidPending())
+    {
+      RequestFullUpdate();
+    }
+  }
+  
+  // Sets the cycle timespan of the mixer (format: "<client ID>:<cycle timespan>", client ID 0 = snapshot)
+  function HandleCycleTimespan(data)
+  {
+    // Split the message by a pre-defined delimiter
+    var delimiter = data.indexOf(":");
+    var clientID_int = parseInt(data.substring(0, delimiter));
+    var cycletimespan_int = parseInt(data.substring(delimiter + 1, data.length));
+    
+    if (isNaN(cycletimespan_int) || isNaN(clientID_int))
+    {
+      Log("Data for cycle timespan or client ID not matching (NaN is not allowed)");
+      return;
+    }
+    
+    // Check for correct data range (0 = automatic mode)
+    if (cycletimespan_int != 0 && (cycletimespan_int < 200 || cycletimespan_int > 1000))
+    {
+      Log("Data for cycle timespan not matching (must be 0 or within 200ms and 1000ms)");
+      return;
+    }
+    
+    // Check for own client ID
+    if (clientID_int == clientID)
+    {
+      Log("NOT Set [CYCLE_TIMESPAN] = " + cycletimespan_int + "ms (Own Client ID)");
+      return;
+    }
+    
+    // Replay cycle timespan edited while offline instead of the snapshot
+    if (clientID_int == 0 && offlineCycleTimespan !== null && websocketConnected)
+    {
+      websocket.send("CYCLE_TIMESPAN:" + offlineCycleTimespan);
+      websocket.send("SAVE");
+      offlineCycleTimespan = null;
+      return;
+    }
+    
+    // Set new cycle timespan value
+    var output = document.getElementById('valueCycleTimespan');
+    var slider = document.getElementById("sliderCycleTimespan");
+    
+    slider.value = (cycletimespan_int == 0) ? slider.min : cycletimespan_int;
+    output.innerHTML = FormatCycleTimespan(cycletimespan_int);
+    
+    Log("Set [CYCLE_TIMESPAN] = " + cycletimespan_int + "ms");
+  }
+  
+  // Shows the bottle fill levels and the refused liquid
+  function HandleLevels(data)
+  {
+    // Format: "<refused liquid>:<remaining>,<capacity>,<minutes>,<status>;..."
+    var delimiter = data.indexOf(":");
+    var refusedLiquid = parseInt(data.substring(0, delimiter));
+    var levels = data.substring(delimiter + 1).split(";");
+    var warning = "";
+
+    for (var i = 0; i < levels.length; i++)
+    {
+      var level = levels[i].split(",").map(function(value) { return parseInt(value); });
+      var output = document.getElementById('varLevel' + i);
+      if (!output || level.length !== 4)
       {
-        console.log("Data for liquid angles not matching (must be within 0° and 360°)");
-        return;
+        continue;
       }
-      
-      // Check for own client ID
-      if (clientID_int == clientID)
+
+      // Status: 0 = untracked, 1 = ok, 2 = low, 3 = empty
+      if (level[3] == 0)
       {
-        console.log("NOT Set [LIQUID_ANGLES] = " + angle1_int + "," + angle2_int + "," + angle3_int + " (Own Client ID)");
-        return;
+        output.innerHTML = "-";
+        continue;
       }
-      
-      if (!doughnutchart)
+
+      output.innerHTML = level[0] + "/" + level[1] + "ml" + (level[2] >= 0 ? " (" + level[2] + "min)" : "");
+      if (level[3] >= 2 && warning.length == 0)
       {
-        console.log("Doughnutchart is null");
-        return;
+        warning = document.getElementById('labelLiquid' + i).innerHTML + (level[3] == 3 ? " empty!" : " low!");
       }
-      
-      doughnutchart.Setangles([angle1_int, angle2_int, angle3_int]);
-      
-      console.log("Set [LIQUID_ANGLES] = " + angle1_int + "," + angle2_int + "," + angle3_int);
-      
-    }, false);
+    }
+
+    if (refusedLiquid < levels.length)
+    {
+      warning = "Refill " + document.getElementById('labelLiquid' + refusedLiquid).innerHTML + "!";
+    }
+    document.getElementById('levelWarning').innerHTML = warning;
+  }
+  
+  // Returns true, if own liquid angles are not sent or not acknowledged by the mixer yet
+  function IsLiquidPending()
+  {
+    return liquidAckedSequence < liquidSequence ||
+      (doughnutchart !== null && doughnutchart.IsShiftPending());
+  }
+  
+  // Writes a debug message to the console (logging every message slows down dragging on mobile phones)
+  function Log(message)
+  {
+    if (isDebug)
+    {
+      console.log(message);
+    }
+  }
+  
+  // Requests all settings and the mixture snapshot (once until the snapshot is received)
+  function RequestFullUpdate()
+  {
+    if (websocketConnected && !isFullUpdateRequested)
+    {
+      isFullUpdateRequested = true;
+      websocket.send("FULLUPDATE");
+    }
+  }
+  
+  // Parses and checks liquid angles, returns null if the data is invalid
+  function ParseAngles(values)
+  {
+    // Check for correct length
+    if (doughnutchart && values.length !== doughnutchart.data.length)
+    {
+      Log("Data length for liquid angles not matching (must be " + doughnutchart.data.length + ")");
+      return null;
+    }
     
-    events.addEventListener('CYCLE_TIMESPAN', function(e)
+    var angles = [];
+    for (var index = 0; index < values.length; index++)
     {
-      console.log("Event[CYCLE_TIMESPAN]:" + e.data);
-      lastAliveTimestamp = Date.now();
-      
-      // Split the message by a pre-defined delimiter
-      var delimiter = e.data.indexOf(":");
-      var clientID_String = e.data.substring(0, delimiter);
-      var cycletimespan_String = e.data.substring(delimiter + 1, e.data.length);
+      var angle_int = parseInt(values[index]);
       
-      var clientID_int = parseInt(clientID_String);
-      var cycletimespan_int = parseInt(cycletimespan_String);
-      
-      if (cycletimespan_int == NaN || clientID_int == NaN)
+      if (isNaN(angle_int) || angle_int < 0 || angle_int > 360)
       {
-        console.log("Data for cycle timespan or client ID not matching (NaN is not allowed)");
-        return;
+        Log("Data for liquid angles not matching (must be within 0° and 360°)");
+        return null;
       }
       
-      // Check for correct data range
-      if (cycletimespan_int < 200 || cycletimespan_int > 1000)
-      {
-        console.log("Data for cycle timespan not matching (must be within 200ms and 1000ms)");
-        return;
-      }
-      
-      // Check for own client ID
-      if (clientID_int == clientID)
-      {
-        console.log("NOT Set [CYCLE_TIMESPAN] = " + cycletimespan_int + "ms (Own Client ID)");
-        return;
-      }
-      
-      // Set new cycle timespan value
-      var output = document.getElementById('valueCycleTimespan');
-      var slider = document.getElementById("sliderCycleTimespan");
-      
-      slider.value = cycletimespan_int;
-      output.innerHTML = cycletimespan_int + "ms";
+      angles.push(angle_int);
+    }
+    
+    return angles;
+  }
+  
+  // Builds the proportions table with one column per liquid
+  function BuildProportionsTable(count)
+  {
+    var table = document.getElementById('proportions-table');
+    var headerRow = table.insertRow(-1);
+    var valueRow = table.insertRow(-1);
+    var levelRow = table.insertRow(-1);
+    
+    // Remove old rows
+    while (table.rows.length > 3)
+    {
+      table.deleteRow(0);
+    }
+    
+    for (var index = 0; index < count; index++)
+    {
+      var headerCell = document.createElement('th');
+      headerCell.id = "labelLiquid" + index;
+      headerCell.className = "bordered-cell";
+      headerRow.appendChild(headerCell);
       
-      console.log("Set [CYCLE_TIMESPAN] = " + cycletimespan_int + "ms");
+      var valueCell = valueRow.insertCell(-1);
+      valueCell.className = "bordered-cell";
+      valueCell.innerHTML =
+        '<div class="adjust-button" data-i="' + index + '" data-d="1">&#8722;</div>' +
+        '<var id="varLiquid' + index + '">0%</var>' +
+        '<div class="adjust-button" data-i="' + index + '" data-d="-1">&#43;</div>';
+
+      var levelCell = levelRow.insertCell(-1);
+      levelCell.className = "bordered-cell";
+      levelCell.innerHTML =
+        '<var id="varLevel' + index + '">-</var>' +
+        '<button class="refill-button" data-i="' + index + '">Refill</button>';
+    }
     
-    }, false);
+    // Initialize buttons with event handler
+    [].forEach.call(table.getElementsByClassName('adjust-button'), function (adjustButton)
+    {
+      adjustButton.onclick = AdjustClick;
+    });
+
+    // Initialize bottle refill buttons
+    [].forEach.call(table.getElementsByClassName('refill-button'), function (refillButton)
+    {
+      refillButton.onclick = OnClickRefill;
+    });
   }
   
   // Function checks every 500ms if the communication is online. Timeout is 1.5s
@@ -403,6 +654,13 @@ var lastAliveTimestamp = new Date(0);
     {
       doughnutchart.Setonline(Date.now() - lastAliveTimestamp < 1500);
     }
+    
+    // Close a silent websocket (e.g. the access point was lost), the close handler reconnects
+    if (websocketConnected && Date.now() - lastAliveTimestamp > 5000)
+    {
+      websocketConnected = false;
+      websocket.close();
+    }
   }
   
   // Will be called if a value of the doughnutchart has changed
@@ -430,24 +688,37 @@ var lastAliveTimestamp = new Date(0);
   // Will be called if an angle of the doughnutchart has shifted. increments is signed and in degrees
   function OnDoughnutChartShift(index, increments)
   {
-    // Build websocket message
-    var websocketMessage = "LIQUID_INCREMENT:" + index + "," + increments.toFixed(0);
-  
     // Send websocket
     if (websocketConnected)
     {
+      // Build websocket message with the absolute angle and the mixture version it is based on
+      liquidSequence++;
+      var angle = Math.round(doughnutchart.data[index].angle) % 360;
+      var websocketMessage = "LIQUID_ANGLE:" + index + "," + angle + "," + mixtureVersion + "," + liquidSequence;
+
       websocket.send(websocketMessage);
-      console.log("Websocket send:" + websocketMessage + " -> success");
+      Log("Websocket send:" + websocketMessage + " -> success");
     }
     else
     {
-      console.log("Websocket send:" + websocketMessage + " -> no websocket..");
-      if (confirm("The control is not connected. Reload page?"))
-      {
-        window.location.reload();
-      }
+      // Queue edit, replayed after the reconnect
+      Log("Websocket send:LIQUID_ANGLE -> queued");
+      offlineLiquids[index] = true;
     }
   }
+  
+  // Sends all angles edited while offline
+  function ReplayOfflineEdits(offlineIndexes)
+  {
+    offlineIndexes.forEach(function(index)
+    {
+      liquidSequence++;
+      var angle = Math.round(doughnutchart.data[index].angle) % 360;
+      websocket.send("LIQUID_ANGLE:" + index + "," + angle + "," + mixtureVersion + "," + liquidSequence);
+    });
+    
+    Log("Replayed offline edits: " + offlineIndexes.length);
+  }
 
   // Toggle visibillity on checked changed
   function OnToggleExpertSettings()
@@ -473,30 +744,35 @@ var lastAliveTimestamp = new Date(0);
     }
   }
 
+  // Returns the text of a cycle timespan (0 = automatic mode, selected by the mixer per mixture)
+  function FormatCycleTimespan(cycletimespan_int)
+  {
+    return (cycletimespan_int == 0) ? "Auto" : cycletimespan_int + "ms";
+  }
+
   // Will be called if new slider value is present
   function OnInputCycleTimespan()
   {
     var output = document.getElementById('valueCycleTimespan');
     var slider = document.getElementById("sliderCycleTimespan");
+    var cycletimespan_int = (parseInt(slider.value) < 200) ? 0 : parseInt(slider.value);
     
-    output.innerHTML = slider.value + "ms";
+    output.innerHTML = FormatCycleTimespan(cycletimespan_int);
     
     // Build websocket message
-    var websocketMessage = "CYCLE_TIMESPAN:" + slider.value;
+    var websocketMessage = "CYCLE_TIMESPAN:" + cycletimespan_int;
     
     // Send websocket
     if (websocketConnected)
     {
       websocket.send(websocketMessage);
-      console.log("Websocket send:" + websocketMessage + "ms -> success");
+      Log("Websocket send:" + websocketMessage + "ms -> success");
     }
     else
     {
-      console.log("Websocket send:" + websocketMessage + "ms -> no websocket..");
-      if (confirm("The control is not connected. Reload page?"))
-      {
-        window.location.reload();
-      }
+      // Queue edit, replayed after the reconnect
+      Log("Websocket send:" + websocketMessage + "ms -> queued");
+      offlineCycleTimespan = cycletimespan_int;
     }
   }
 
@@ -506,17 +782,56 @@ var lastAliveTimestamp = new Date(0);
     if (websocketConnected)
     {
       websocket.send("SAVE");
-      console.log("Websocket send:SAVE");
+      Log("Websocket send:SAVE");
     }
     else
     {
-      console.log("SAVE: no websocket..");
-      if (confirm("The control is not connected. Reload page?"))
-      {
-        window.location.reload();
-      }
+      // Saved with the queued cycle timespan after the reconnect
+      Log("SAVE: queued");
     }
   }
 
+  // Will be called if a bottle refill button is clicked
+  function OnClickRefill()
+  {
+    var index = this.getAttribute('data-i');
+    var label = document.getElementById('labelLiquid' + index).innerHTML;
+
+    if (!websocketConnected)
+    {
+      alert("The control is not connected.");
+      return;
+    }
+
+    if (confirm("Refilled bottle of " + label + "?"))
+    {
+      websocket.send("BOTTLE_REFILL:" + index);
+      Log("Websocket send:BOTTLE_REFILL:" + index);
+    }
+  }
+
+  // Will be called if the join network button is clicked
+  function OnClickWifiProvision()
+  {
+    var ssid = document.getElementById('inputWifiSsid').value;
+    var password = document.getElementById('inputWifiPassword').value;
+
+    // An empty SSID clears the credentials and the mixer starts its own access point
+    if (!confirm(ssid.length > 0 ? "Join network '" + ssid + "'? The mixer leaves its current network." : "Clear network and start access point?"))
+    {
+      return;
+    }
+
+    // Send credentials as form parameters
+    var request = new XMLHttpRequest();
+    request.open("POST", "/provision", true);
+    request.setRequestHeader("Content-Type", "application/x-www-form-urlencoded");
+    request.onload = function()
+    {
+      alert(request.responseText);
+    };
+    request.send("ssid=" + encodeURIComponent(ssid) + "&password=" + encodeURIComponent(password));
+  }
+
 })();
 
@@ -0,0 +1,77 @@
+/**
+ * Includes the service worker for index.html (secure contexts only)
+ *
+ * @author    Florian Staeblein
+ * @date      2024/01/28
+ * @copyright © 2024 Florian Staeblein
+ */
+
+// Cache name, increment the version with every changed web interface file
+var CACHE_NAME = "mixer-ui-v3";
+
+// Static files of the web interface
+var CACHE_FILES = [
+  "/",
+  "/index.html",
+  "/index.js",
+  "/index.css",
+  "/draggableDoughnutChart.js",
+  "/favicon.ico"];
+
+// Stores all static files on install
+self.addEventListener('install', function(e)
+{
+  e.waitUntil(caches.open(CACHE_NAME).then(function(cache)
+  {
+    return cache.addAll(CACHE_FILES);
+  }));
+  self.skipWaiting();
+});
+
+// Deletes the caches of old versions
+self.addEventListener('activate', function(e)
+{
+  e.waitUntil(caches.keys().then(function(names)
+  {
+    return Promise.all(names.filter(function(name)
+    {
+      return name !== CACHE_NAME;
+    }).map(function(name)
+    {
+      return caches.delete(name);
+    }));
+  }));
+});
+
+// Answers static files from the cache and updates the cache in background
+self.addEventListener('fetch', function(e)
+{
+  var path = new URL(e.request.url).pathname;
+
+  // Events, websocket, status and POST requests always go to the mixer
+  if (e.request.method !== 'GET' ||
+    (CACHE_FILES.indexOf(path) < 0 && !path.endsWith(".svg")))
+  {
+    return;
+  }
+
+  e.respondWith(caches.open(CACHE_NAME).then(function(cache)
+  {
+    return cache.match(e.request).then(function(cached)
+    {
+      var fetched = fetch(e.request).then(function(response)
+      {
+        if (response.ok)
+        {
+          cache.put(e.request, response.clone());
+        }
+        return response;
+      }).catch(function()
+      {
+        return cached;
+      });
+
+      return cached || fetched;
+    });
+  }));
+});
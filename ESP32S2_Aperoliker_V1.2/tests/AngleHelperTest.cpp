@@ -0,0 +1,229 @@
+/**
+ * Host test of the constant time angle functions: Equivalence
+ * with the former per-degree loops
+ *
+ * @author    Florian Staeblein
+ * @date      2024/01/28
+ * @copyright © 2024 Florian Staeblein
+ */
+
+#include "TestHelper.h"
+#include "AngleHelper.h"
+
+//===============================================================
+// Former loop of GetDistanceDegrees (one step per degree)
+//===============================================================
+static int16_t LoopGetDistanceDegrees(int16_t startAngle, int16_t stopAngle)
+{
+  int16_t distance = 0;
+  int16_t runAngle = startAngle;
+  while (runAngle != stopAngle)
+  {
+    runAngle = Move360(runAngle, 1);
+    distance++;
+  }
+  return distance;
+}
+
+//===============================================================
+// Former loop of IncrementAngle (one step per degree)
+//===============================================================
+static void LoopIncrementAngle(int16_t* value, int16_t nextBorder, int16_t previousBorder, int16_t angleDistance_Degrees)
+{
+  bool clockwise = angleDistance_Degrees > 0;
+  for (uint16_t index = 0; index < abs(angleDistance_Degrees); index++)
+  {
+    int16_t newValue = Move360(*value, clockwise ? 1 : -1);
+    int16_t distanceToNextBorder_Degrees = GetDistanceDegrees(newValue, clockwise ? nextBorder : previousBorder);
+    distanceToNextBorder_Degrees = clockwise ? distanceToNextBorder_Degrees : 360 - distanceToNextBorder_Degrees;
+    if (distanceToNextBorder_Degrees >= MINANGLE_DEGREES)
+    {
+      *value = newValue;
+    }
+    else
+    {
+      break;
+    }
+  }
+}
+
+//===============================================================
+// Distance and move of every angle pair, both are shift
+// invariant (rotating all angles rotates the result)
+//===============================================================
+static void TestDistanceAndMove()
+{
+  for (int16_t startAngle = 0; startAngle < 360; startAngle++)
+  {
+    for (int16_t stopAngle = 0; stopAngle < 360; stopAngle++)
+    {
+      CHECK_EQUAL(LoopGetDistanceDegrees(startAngle, stopAngle), GetDistanceDegrees(startAngle, stopAngle));
+      CHECK_EQUAL(GetDistanceDegrees(0, Move360(stopAngle, -startAngle)), GetDistanceDegrees(startAngle, stopAngle));
+    }
+    for (int16_t distance = -359; distance <= 359; distance++)
+    {
+      CHECK_EQUAL((startAngle + distance + 720) % 360, Move360(startAngle, distance));
+    }
+  }
+}
+
+//===============================================================
+// Every border pair and every increment (-360° to 360°) from a
+// start angle. The loop result of an increment k is the loop
+// result of k - 1 moved by one more step, so the former loop is
+// walked once per direction instead of once per increment.
+//===============================================================
+static void TestIncrementFromStart(int16_t startAngle)
+{
+  for (int16_t nextBorder = 0; nextBorder < 360; nextBorder++)
+  {
+    for (int16_t previousBorder = 0; previousBorder < 360; previousBorder++)
+    {
+      int16_t clockwiseValue = startAngle;
+      int16_t counterClockwiseValue = startAngle;
+      for (int16_t increment = 1; increment <= 360; increment++)
+      {
+        LoopIncrementAngle(&clockwiseValue, nextBorder, previousBorder, 1);
+        LoopIncrementAngle(&counterClockwiseValue, nextBorder, previousBorder, -1);
+
+        int16_t value = startAngle;
+        IncrementAngle(&value, nextBorder, previousBorder, increment);
+        CHECK_EQUAL(clockwiseValue, value);
+
+        value = startAngle;
+        IncrementAngle(&value, nextBorder, previousBorder, -increment);
+        CHECK_EQUAL(counterClockwiseValue, value);
+      }
+
+      int16_t value = startAngle;
+      IncrementAngle(&value, nextBorder, previousBorder, 0);
+      CHECK_EQUAL(startAngle, value);
+    }
+  }
+}
+
+//===============================================================
+// The stepwise walk equals one loop call with the full increment
+//===============================================================
+static void TestLoopWalk()
+{
+  for (int16_t nextBorder = 0; nextBorder < 360; nextBorder += 7)
+  {
+    for (int16_t previousBorder = 0; previousBorder < 360; previousBorder += 11)
+    {
+      int16_t walkValue = 0;
+      for (int16_t increment = 1; increment <= 360; increment++)
+      {
+        LoopIncrementAngle(&walkValue, nextBorder, previousBorder, 1);
+        int16_t value = 0;
+        LoopIncrementAngle(&value, nextBorder, previousBorder, increment);
+        CHECK_EQUAL(walkValue, value);
+      }
+    }
+  }
+}
+
+//===============================================================
+// Every start angle with every border pair is a rotated start
+// angle 0 case. The rotation is checked for every start angle and
+// border pair with the increments around the clamping points.
+//===============================================================
+static void TestIncrementRotation()
+{
+  const int16_t increments[] = { 1, MINANGLE_DEGREES - 1, MINANGLE_DEGREES, 179, 180, 360 };
+  for (int16_t startAngle = 1; startAngle < 360; startAngle++)
+  {
+    for (int16_t nextBorder = 0; nextBorder < 360; nextBorder++)
+    {
+      for (int16_t previousBorder = 0; previousBorder < 360; previousBorder++)
+      {
+        for (int16_t increment : increments)
+        {
+          for (int16_t sign = -1; sign <= 1; sign += 2)
+          {
+            int16_t rotatedValue = 0;
+            IncrementAngle(&rotatedValue, Move360(nextBorder, -startAngle), Move360(previousBorder, -startAngle), sign * increment);
+
+            int16_t value = startAngle;
+            IncrementAngle(&value, nextBorder, previousBorder, sign * increment);
+            CHECK_EQUAL(Move360(rotatedValue, startAngle), value);
+          }
+        }
+      }
+    }
+  }
+}
+
+//===============================================================
+// Sector angles use the neighbouring angles as borders
+//===============================================================
+static void TestSectorAngles()
+{
+  for (uint8_t angleCount = 2; angleCount <= 6; angleCount++)
+  {
+    int16_t angles_Degrees[6];
+    for (uint8_t index = 0; index < angleCount; index++)
+    {
+      angles_Degrees[index] = index * (360 / angleCount);
+    }
+
+    for (uint8_t angleIndex = 0; angleIndex < angleCount; angleIndex++)
+    {
+      for (int16_t increment = -360; increment <= 360; increment += 3)
+      {
+        int16_t sectorAngles_Degrees[6];
+        memcpy(sectorAngles_Degrees, angles_Degrees, sizeof(angles_Degrees));
+        IncrementSectorAngle(sectorAngles_Degrees, angleCount, angleIndex, increment);
+
+        int16_t value = angles_Degrees[angleIndex];
+        LoopIncrementAngle(&value, angles_Degrees[(angleIndex + 1) % angleCount], angles_Degrees[(angleIndex + angleCount - 1) % angleCount], increment);
+        CHECK_EQUAL(value, sectorAngles_Degrees[angleIndex]);
+        CHECK(IsValidSectorAngles(sectorAngles_Degrees, angleCount));
+      }
+    }
+  }
+}
+
+//===============================================================
+// Only clockwise ordered angles with minimum distance are valid
+//===============================================================
+static void TestValidSectorAngles()
+{
+  const int16_t single[] = { 359 };
+  const int16_t ordered[] = { 0, 90, 180, 270 };
+  const int16_t wrapped[] = { 300, 0, 120, 200 };
+  const int16_t minimum[] = { 354, 0, MINANGLE_DEGREES };
+  CHECK(IsValidSectorAngles(single, 1));
+  CHECK(IsValidSectorAngles(ordered, 4));
+  CHECK(IsValidSectorAngles(wrapped, 4));
+  CHECK(IsValidSectorAngles(minimum, 3));
+
+  const int16_t outOfRange[] = { 0, 90, 360 };
+  const int16_t negative[] = { -6, 90, 180 };
+  const int16_t tooClose[] = { 0, MINANGLE_DEGREES - 1, 180 };
+  const int16_t equal[] = { 90, 90, 180 };
+  const int16_t unordered[] = { 0, 180, 90, 270 };
+  const int16_t wrappedTooClose[] = { 2, 120, 240, 358 };
+  CHECK(!IsValidSectorAngles(outOfRange, 3));
+  CHECK(!IsValidSectorAngles(negative, 3));
+  CHECK(!IsValidSectorAngles(tooClose, 3));
+  CHECK(!IsValidSectorAngles(equal, 3));
+  CHECK(!IsValidSectorAngles(unordered, 4));
+  CHECK(!IsValidSectorAngles(wrappedTooClose, 4));
+}
+
+//===============================================================
+// Main
+//===============================================================
+int main()
+{
+  TestDistanceAndMove();
+  TestLoopWalk();
+  TestIncrementFromStart(0);
+  TestIncrementFromStart(MINANGLE_DEGREES - 1);
+  TestIncrementFromStart(359);
+  TestIncrementRotation();
+  TestSectorAngles();
+  TestValidSectorAngles();
+  return TEST_RESULT();
+}
@@ -0,0 +1,470 @@
+/**
+ * Host test of the liquid command queue: Coalescing of targets,
+ * the full queue, conflicts of several websocket clients, the
+ * mixture diff of a slow client, concurrent clients (threads)
+ * pushing while the state machine drains the queue and targets in
+ * the screen saver
+ *
+ * @author    Florian Staeblein
+ * @date      2024/01/28
+ * @copyright © 2024 Florian Staeblein
+ */
+
+#include "TestHelper.h"
+#include "CommandQueue.h"
+#include "WifiHandler.h"
+#include "fakes/FakeDisplayDriver.h"
+#include "fakes/LocalNetworkBackend.h"
+#include <atomic>
+#include <thread>
+#include <vector>
+
+//===============================================================
+// Defines
+//===============================================================
+#define PIN_ENCODER_OUTA        8
+#define PIN_ENCODER_OUTB        11
+#define PIN_ENCODER_BUTTON      10
+#define PIN_BUZZER              17
+
+#define STRESS_CLIENTS          6       // Concurrent clients (two per liquid)
+#define STRESS_TARGETS          20000   // Targets per client
+
+
+//===============================================================
+// Global variables
+//===============================================================
+static LocalNetworkBackend network;
+
+//===============================================================
+// Returns the next pseudo random target angle of a client
+//===============================================================
+static int16_t GetRandomAngle(uint32_t& seed)
+{
+  seed = seed * 1103515245 + 12345;
+  return (int16_t)((seed >> 16) % 360);
+}
+
+//===============================================================
+// Returns true, if the liquid angles are ordered and keep the
+// minimum distance
+//===============================================================
+static bool IsValidMixture()
+{
+  int32_t sum_Degrees = 0;
+  for (uint8_t index = 0; index < LiquidCount; index++)
+  {
+    int16_t distance_Degrees = GetDistanceDegrees(Statemachine.GetAngle((MixtureLiquid)index), Statemachine.GetAngle((MixtureLiquid)((index + 1) % LiquidCount)));
+    if (distance_Degrees < MINANGLE_DEGREES)
+    {
+      return false;
+    }
+    sum_Degrees += distance_Degrees;
+  }
+  return sum_Degrees == 360;
+}
+
+//===============================================================
+// Delivers the messages of a client and returns the last liquid
+// acknowledge ("" -> none)
+//===============================================================
+static String GetLastAcknowledge(AsyncWebSocketClient* client)
+{
+  client->HostDeliver();
+  String acknowledge;
+  for (const String& message : client->HostReceived)
+  {
+    if (message.startsWith("LIQUID_"))
+    {
+      acknowledge = message;
+    }
+  }
+  client->HostReceived.clear();
+  return acknowledge;
+}
+
+//===============================================================
+// Targets of the same client and liquid replace each other
+//===============================================================
+static void TestCoalescing()
+{
+  LiquidCommandQueue queue;
+  uint32_t received_ms = millis();
+  CHECK(queue.Push(1, 0, 10, 5, 1));
+  HostAdvance_ms(20);
+  CHECK(queue.Push(1, 0, 20, 3, 2));
+  CHECK(queue.Push(2, 0, 30, 4, 1));
+  CHECK(queue.Push(1, 1, 40, 4, 3));
+  CHECK(queue.Push(1, 0, 25, 6, 4));
+
+  LiquidCommand commands[COMMAND_QUEUE_SIZE];
+  CHECK_EQUAL(3, queue.Drain(commands));
+
+  // Latest target, highest base version and sequence, oldest timestamp
+  CHECK_EQUAL(1, commands[0].ClientID);
+  CHECK_EQUAL(0, commands[0].Liquid);
+  CHECK_EQUAL(25, commands[0].Target_Degrees);
+  CHECK_EQUAL(6, commands[0].BaseVersion);
+  CHECK_EQUAL(4, commands[0].Sequence);
+  CHECK_EQUAL(received_ms, commands[0].Received_ms);
+
+  // Other client and other liquid are separate commands
+  CHECK_EQUAL(2, commands[1].ClientID);
+  CHECK_EQUAL(30, commands[1].Target_Degrees);
+  CHECK_EQUAL(1, commands[2].Liquid);
+  CHECK_EQUAL(40, commands[2].Target_Degrees);
+
+  CHECK_EQUAL(0, queue.Drain(commands));
+  CHECK_EQUAL(5, queue.GetAcceptedCount());
+  CHECK_EQUAL(0, queue.GetRejectedCount());
+}
+
+//===============================================================
+// A full queue only rejects new client/liquid pairs
+//===============================================================
+static void TestQueueFull()
+{
+  LiquidCommandQueue queue;
+  for (uint32_t clientID = 1; clientID <= COMMAND_QUEUE_SIZE; clientID++)
+  {
+    CHECK(queue.Push(clientID, 0, 10, 0, 1));
+  }
+  CHECK(!queue.Push(COMMAND_QUEUE_SIZE + 1, 0, 10, 0, 1));
+  CHECK(queue.Push(1, 0, 20, 0, 2));
+  CHECK_EQUAL(COMMAND_QUEUE_SIZE + 1, queue.GetAcceptedCount());
+  CHECK_EQUAL(1, queue.GetRejectedCount());
+
+  // Space again after the drain
+  LiquidCommand commands[COMMAND_QUEUE_SIZE];
+  CHECK_EQUAL(COMMAND_QUEUE_SIZE, queue.Drain(commands));
+  CHECK_EQUAL(20, commands[0].Target_Degrees);
+  CHECK(queue.Push(COMMAND_QUEUE_SIZE + 1, 0, 10, 0, 1));
+}
+
+//===============================================================
+// A target based on an older mixture version loses against the
+// change of another client, but not against an own change
+//===============================================================
+static void TestConflict()
+{
+  AsyncWebServer* server = AsyncWebServer::HostInstance;
+  CHECK(server != NULL);
+  AsyncWebSocket* websocket = server ? server->HostFindHandler<AsyncWebSocket>() : NULL;
+  CHECK(websocket != NULL);
+  if (websocket == NULL)
+  {
+    return;
+  }
+
+  AsyncWebSocketClient* clientA = websocket->HostConnect();
+  AsyncWebSocketClient* clientB = websocket->HostConnect();
+  int16_t angle_Degrees = Statemachine.GetAngle((MixtureLiquid)1);
+  uint32_t baseVersion = Statemachine.GetMixtureVersion();
+
+  // Several targets of client A before a tick -> one acknowledge of the last sequence
+  websocket->HostReceive(clientA, "LIQUID_ANGLE:1," + String(angle_Degrees + 4) + "," + String(baseVersion) + ",1");
+  websocket->HostReceive(clientA, "LIQUID_ANGLE:1," + String(angle_Degrees + 8) + "," + String(baseVersion) + ",2");
+  websocket->HostReceive(clientA, "LIQUID_ANGLE:1," + String(angle_Degrees + 10) + "," + String(baseVersion) + ",3");
+  Statemachine.Execute(eMain);
+  uint32_t versionA = Statemachine.GetMixtureVersion();
+  CHECK(versionA > baseVersion);
+  CHECK(GetLastAcknowledge(clientA) == "LIQUID_ACK:3," + String(versionA));
+  CHECK_EQUAL(angle_Degrees + 10, Statemachine.GetAngle((MixtureLiquid)1));
+
+  // Client B has not seen the change of client A
+  GetLastAcknowledge(clientB);
+  websocket->HostReceive(clientB, "LIQUID_ANGLE:1," + String(angle_Degrees - 10) + "," + String(baseVersion) + ",1");
+  Statemachine.Execute(eMain);
+  CHECK(GetLastAcknowledge(clientB) == "LIQUID_CONFLICT:1," + String(Statemachine.GetMixtureVersion()));
+  CHECK_EQUAL(angle_Degrees + 10, Statemachine.GetAngle((MixtureLiquid)1));
+
+  // Client A changes its own angle again with the old version
+  websocket->HostReceive(clientA, "LIQUID_ANGLE:1," + String(angle_Degrees + 6) + "," + String(baseVersion) + ",4");
+  Statemachine.Execute(eMain);
+  CHECK(GetLastAcknowledge(clientA).startsWith("LIQUID_ACK:4,"));
+  CHECK_EQUAL(angle_Degrees + 6, Statemachine.GetAngle((MixtureLiquid)1));
+
+  // Client B after taking over the changes
+  websocket->HostReceive(clientB, "LIQUID_ANGLE:1," + String(angle_Degrees) + "," + String(Statemachine.GetMixtureVersion()) + ",2");
+  Statemachine.Execute(eMain);
+  CHECK(GetLastAcknowledge(clientB).startsWith("LIQUID_ACK:2,"));
+  CHECK_EQUAL(angle_Degrees, Statemachine.GetAngle((MixtureLiquid)1));
+
+  websocket->HostDisconnect(clientA);
+  websocket->HostDisconnect(clientB);
+  websocket->cleanupClients();
+}
+
+//===============================================================
+// A slow client gets one diff from its last taken over mixture
+// version, covering all versions it missed
+//===============================================================
+static void TestSlowClientDiff()
+{
+  AsyncWebServer* server = AsyncWebServer::HostInstance;
+  AsyncWebSocket* websocket = server ? server->HostFindHandler<AsyncWebSocket>() : NULL;
+  CHECK(websocket != NULL);
+  if (websocket == NULL)
+  {
+    return;
+  }
+
+  AsyncWebSocketClient* slowClient = websocket->HostConnect();
+  AsyncWebSocketClient* writer = websocket->HostConnect();
+  websocket->HostReceive(slowClient, "SUBSCRIBE:MIXTURE");
+  websocket->HostReceive(slowClient, "FULLUPDATE");
+  slowClient->HostDeliver();
+  slowClient->HostReceived.clear();
+  uint32_t baseVersion = Statemachine.GetMixtureVersion();
+
+  // The slow client doesn't take its messages (full websocket queue)
+  while (!slowClient->queueIsFull())
+  {
+    websocket->HostReceive(slowClient, "FULLUPDATE");
+  }
+
+  // Two mixture versions while the client is slow
+  int16_t angle0_Degrees = Statemachine.GetAngle((MixtureLiquid)0);
+  int16_t angle1_Degrees = Statemachine.GetAngle((MixtureLiquid)1);
+  websocket->HostReceive(writer, "LIQUID_ANGLE:1," + String(angle1_Degrees + 4) + "," + String(baseVersion) + ",1");
+  Statemachine.Execute(eMain);
+  websocket->HostReceive(writer, "LIQUID_ANGLE:0," + String(angle0_Degrees + 4) + "," + String(Statemachine.GetMixtureVersion()) + ",2");
+  Statemachine.Execute(eMain);
+  uint32_t version = Statemachine.GetMixtureVersion();
+  CHECK_EQUAL(baseVersion + 2, version);
+
+  // The client takes its messages again -> one diff from the version of the last full update
+  slowClient->HostDeliver();
+  slowClient->HostReceived.clear();
+  Wifihandler.Update();
+  slowClient->HostDeliver();
+  String expected = "MIXTURE_DIFF:" + String(writer->id()) + ":" + String(baseVersion) + ":" + String(version) +
+    ":0=" + String(Statemachine.GetAngle((MixtureLiquid)0)) + ",1=" + String(Statemachine.GetAngle((MixtureLiquid)1));
+  uint32_t diffs = 0;
+  for (const String& message : slowClient->HostReceived)
+  {
+    if (message.startsWith("MIXTURE_DIFF:"))
+    {
+      CHECK(message == expected);
+      diffs++;
+    }
+  }
+  CHECK_EQUAL(1, diffs);
+
+  // Up to date, the next diff only contains the next version
+  slowClient->HostReceived.clear();
+  websocket->HostReceive(writer, "LIQUID_ANGLE:1," + String(angle1_Degrees) + "," + String(version) + ",3");
+  Statemachine.Execute(eMain);
+  slowClient->HostDeliver();
+  CHECK(!slowClient->HostReceived.empty() &&
+    slowClient->HostReceived.back() == "MIXTURE_DIFF:" + String(writer->id()) + ":" + String(version) + ":" + String(version + 1) + ":1=" + String(angle1_Degrees));
+
+  websocket->HostDisconnect(slowClient);
+  websocket->HostDisconnect(writer);
+  websocket->cleanupClients();
+}
+
+//===============================================================
+// Concurrent clients push while the state machine task drains:
+// Nothing is lost, every pair ends with its last target
+//===============================================================
+static void TestConcurrentQueue()
+{
+  LiquidCommandQueue queue;
+  std::atomic<bool> isStarted(false);
+  std::atomic<uint32_t> runningClients(STRESS_CLIENTS);
+  int16_t lastTargets_Degrees[STRESS_CLIENTS] = {};
+
+  std::vector<std::thread> clients;
+  for (uint32_t clientIndex = 0; clientIndex < STRESS_CLIENTS; clientIndex++)
+  {
+    clients.emplace_back([&queue, &isStarted, &runningClients, &lastTargets_Degrees, clientIndex]()
+    {
+      while (!isStarted)
+      {
+        std::this_thread::yield();
+      }
+
+      uint32_t seed = clientIndex + 1;
+      for (uint32_t sequence = 1; sequence <= STRESS_TARGETS; sequence++)
+      {
+        lastTargets_Degrees[clientIndex] = GetRandomAngle(seed);
+        queue.Push(clientIndex + 1, clientIndex % LiquidCount, lastTargets_Degrees[clientIndex], 0, sequence);
+        std::this_thread::yield();
+      }
+      runningClients--;
+    });
+  }
+  isStarted = true;
+
+  // State machine task: Sequences of a pair must increase from drain to drain
+  uint32_t lastSequences[STRESS_CLIENTS] = {};
+  int16_t drainedTargets_Degrees[STRESS_CLIENTS] = {};
+  uint32_t drainedCommands = 0;
+  bool isOrdered = true;
+  bool isRunning = true;
+  while (isRunning)
+  {
+    isRunning = runningClients > 0;
+    LiquidCommand commands[COMMAND_QUEUE_SIZE];
+    uint8_t commandCount = queue.Drain(commands);
+    for (uint8_t index = 0; index < commandCount; index++)
+    {
+      uint32_t clientIndex = commands[index].ClientID - 1;
+      isOrdered &= clientIndex < STRESS_CLIENTS &&
+        commands[index].Liquid == clientIndex % LiquidCount &&
+        commands[index].Sequence > lastSequences[clientIndex];
+      if (clientIndex < STRESS_CLIENTS)
+      {
+        lastSequences[clientIndex] = commands[index].Sequence;
+        drainedTargets_Degrees[clientIndex] = commands[index].Target_Degrees;
+      }
+    }
+    drainedCommands += commandCount;
+
+    // The state machine ticks slower than the clients send
+    for (uint8_t index = 0; index < STRESS_CLIENTS; index++)
+    {
+      std::this_thread::yield();
+    }
+  }
+
+  for (std::thread& client : clients)
+  {
+    client.join();
+  }
+
+  CHECK(isOrdered);
+  CHECK_EQUAL(STRESS_CLIENTS * STRESS_TARGETS, queue.GetAcceptedCount());
+  CHECK_EQUAL(0, queue.GetRejectedCount());
+  for (uint32_t clientIndex = 0; clientIndex < STRESS_CLIENTS; clientIndex++)
+  {
+    CHECK_EQUAL(STRESS_TARGETS, lastSequences[clientIndex]);
+    CHECK_EQUAL(lastTargets_Degrees[clientIndex], drainedTargets_Degrees[clientIndex]);
+  }
+  printf("Concurrent queue: %u targets coalesced to %u commands\n", (unsigned)(STRESS_CLIENTS * STRESS_TARGETS), (unsigned)drainedCommands);
+}
+
+//===============================================================
+// Concurrent clients with outdated versions fight for the same
+// liquids while the state machine runs: The mixture stays valid
+//===============================================================
+static void TestConcurrentClients()
+{
+  uint32_t startVersion = Statemachine.GetMixtureVersion();
+  std::atomic<bool> isStarted(false);
+  std::atomic<uint32_t> runningClients(STRESS_CLIENTS);
+  std::atomic<uint32_t> rejectedTargets(0);
+
+  // Mixture version of the last broadcast (clients send targets based on it)
+  std::atomic<uint32_t> broadcastVersion(startVersion);
+
+  std::vector<std::thread> clients;
+  for (uint32_t clientIndex = 0; clientIndex < STRESS_CLIENTS; clientIndex++)
+  {
+    clients.emplace_back([&isStarted, &runningClients, &rejectedTargets, &broadcastVersion, clientIndex]()
+    {
+      while (!isStarted)
+      {
+        std::this_thread::yield();
+      }
+
+      uint32_t seed = 100 + clientIndex;
+      for (uint32_t sequence = 1; sequence <= STRESS_TARGETS; sequence++)
+      {
+        if (!Statemachine.UpdateValuesFromWifi(1000 + clientIndex, (MixtureLiquid)(clientIndex % LiquidCount), GetRandomAngle(seed), broadcastVersion, sequence))
+        {
+          rejectedTargets++;
+        }
+        std::this_thread::yield();
+      }
+      runningClients--;
+    });
+  }
+  isStarted = true;
+
+  // State machine task
+  bool isValid = true;
+  uint32_t ticks = 0;
+  while (runningClients > 0)
+  {
+    Statemachine.Execute(eMain);
+    broadcastVersion = Statemachine.GetMixtureVersion();
+    isValid &= IsValidMixture();
+    ticks++;
+    for (uint8_t index = 0; index < STRESS_CLIENTS; index++)
+    {
+      std::this_thread::yield();
+    }
+  }
+
+  for (std::thread& client : clients)
+  {
+    client.join();
+  }
+  Statemachine.Execute(eMain);
+
+  CHECK(isValid);
+  CHECK(IsValidMixture());
+  CHECK_EQUAL(0, rejectedTargets.load());
+  CHECK(Statemachine.GetMixtureVersion() > startVersion);
+  printf("Concurrent clients: %u ticks, %u mixture versions\n", (unsigned)ticks, (unsigned)(Statemachine.GetMixtureVersion() - startVersion));
+}
+
+//===============================================================
+// Targets are applied and acknowledged in the screen saver (no
+// user action at the mixer)
+//===============================================================
+static void TestScreenSaver()
+{
+  AsyncWebServer* server = AsyncWebServer::HostInstance;
+  AsyncWebSocket* websocket = server ? server->HostFindHandler<AsyncWebSocket>() : NULL;
+  CHECK(websocket != NULL);
+  if (websocket == NULL)
+  {
+    return;
+  }
+
+  HostAdvance_ms(SCREENSAVER_TIMEOUT_MS + 100);
+  Statemachine.Execute(eMain);
+  CHECK_EQUAL(eScreenSaver, Statemachine.GetCurrentState());
+
+  AsyncWebSocketClient* client = websocket->HostConnect();
+  GetLastAcknowledge(client);
+  int16_t angle_Degrees = Statemachine.GetAngle((MixtureLiquid)1);
+  websocket->HostReceive(client, "LIQUID_ANGLE:1," + String(angle_Degrees + 4) + "," + String(Statemachine.GetMixtureVersion()) + ",1");
+  Statemachine.Execute(eMain);
+  CHECK(GetLastAcknowledge(client) == "LIQUID_ACK:1," + String(Statemachine.GetMixtureVersion()));
+  CHECK_EQUAL(angle_Degrees + 4, Statemachine.GetAngle((MixtureLiquid)1));
+  CHECK_EQUAL(eScreenSaver, Statemachine.GetCurrentState());
+
+  websocket->HostDisconnect(client);
+  websocket->cleanupClients();
+}
+
+//===============================================================
+// Main
+//===============================================================
+int main()
+{
+  // Boot like the setup function (wifi enabled without credentials -> access point)
+  HostPinReads[PIN_ENCODER_BUTTON] = HIGH;
+  Settings.Begin();
+  Settings.SetWifiMode(true);
+  EncoderButton.Begin(PIN_ENCODER_OUTA, PIN_ENCODER_OUTB, PIN_ENCODER_BUTTON);
+  FlowMeter.Load();
+  Pumps.Begin();
+  Statemachine.Begin(PIN_BUZZER);
+  Statemachine.Execute(eEntry);
+  Wifihandler.SetNetworkBackend(&network);
+  Wifihandler.Begin();
+
+  TestCoalescing();
+  TestQueueFull();
+  TestConflict();
+  TestSlowClientDiff();
+  TestConcurrentQueue();
+  TestConcurrentClients();
+  TestScreenSaver();
+  return TEST_RESULT();
+}
@@ -0,0 +1,322 @@
+/**
+ * Host test of the encoder: Replays edge traces of the encoder pins
+ * (slow and fast detents, contact bounce, direction changes and
+ * half step jitter) through the encoder backend and checks the
+ * increments of GetEncoderIncrements (quadrature decoding, step
+ * remainder and acceleration). The traces are synthetic.
+ *
+ * Built twice with the same traces: EncoderTest uses the pulse
+ * counter backend (PCNT stand-in with glitch filter), EncoderISRTest
+ * (HOST_ENCODER_ISR) uses the interrupt backend with the table decoder.
+ *
+ * @author    Florian Staeblein
+ * @date      2024/01/28
+ * @copyright © 2024 Florian Staeblein
+ */
+
+#include "TestHelper.h"
+#include <vector>
+#include "Config.h"
+#if defined(HOST_ENCODER_ISR)
+#undef ENCODER_PCNT
+#endif
+#include "EncoderBackend.cpp"
+#include "EncoderButtonDriver.cpp"
+
+//===============================================================
+// Defines
+//===============================================================
+#define PIN_ENCODER_OUTA        8
+#define PIN_ENCODER_OUTB        11
+#define PIN_ENCODER_BUTTON      10
+#define MAIN_PERIOD_US          5000  // Main task period (one encoder read per period)
+#define TRACE_OFFSET_US         1234  // Edges are not aligned with the reads
+#define BOUNCE_PULSE_US         2     // Bounce pulses are shorter than the PCNT glitch filter (12.8 us)
+#define PAUSE_US                200000
+
+
+//===============================================================
+// Trace edge: Time relative to the trace start, pin and level
+//===============================================================
+struct TraceEdge
+{
+  uint32_t Time_us;
+  uint8_t Pin;
+  uint8_t Level;
+};
+
+// Forward sequence of the quadrature state (A << 1 | B)
+static const uint8_t ForwardSequence[4] = { 0b00, 0b01, 0b11, 0b10 };
+
+// Position of the pins in the forward sequence at the end of the traces built so far
+static uint8_t tracePosition = 0;
+
+//===============================================================
+// Adds quarter steps (signed) to a trace. Every edge can be
+// preceded by bounce pulses of the changing pin.
+//===============================================================
+static uint32_t AddQuarterSteps(std::vector<TraceEdge>& trace, uint32_t start_us, int16_t quarterSteps, uint32_t quarterInterval_us, uint8_t bounces = 0)
+{
+  uint32_t time_us = start_us;
+  for (int16_t index = 0; index < abs(quarterSteps); index++)
+  {
+    uint8_t lastState = ForwardSequence[tracePosition];
+    tracePosition = (tracePosition + (quarterSteps > 0 ? 1 : 3)) % 4;
+    uint8_t state = ForwardSequence[tracePosition];
+
+    // Only one pin changes per quarter step
+    uint8_t pin = ((lastState ^ state) & 0b10) ? PIN_ENCODER_OUTA : PIN_ENCODER_OUTB;
+    uint8_t level = (pin == PIN_ENCODER_OUTA) ? (state >> 1) : (state & 1);
+    for (uint8_t bounce = 0; bounce < bounces; bounce++)
+    {
+      trace.push_back({ time_us, pin, level });
+      trace.push_back({ time_us + BOUNCE_PULSE_US, pin, (uint8_t)!level });
+      time_us += 2 * BOUNCE_PULSE_US;
+    }
+    trace.push_back({ time_us, pin, level });
+    time_us += quarterInterval_us;
+  }
+  return time_us;
+}
+
+//===============================================================
+// Replays a trace from now on and reads the encoder every main
+// task period. Returns the increments of all reads.
+//===============================================================
+static std::vector<int16_t> Replay(const std::vector<TraceEdge>& trace)
+{
+  uint64_t start_us = HostTime_us;
+  uint32_t duration_us = trace.empty() ? 0 : trace.back().Time_us + 2 * MAIN_PERIOD_US;
+
+  std::vector<int16_t> increments;
+  size_t edge = 0;
+  for (uint32_t read_us = MAIN_PERIOD_US; read_us <= duration_us; read_us += MAIN_PERIOD_US)
+  {
+    while (edge < trace.size() && trace[edge].Time_us <= read_us)
+    {
+      HostTime_us = start_us + trace[edge].Time_us;
+      HostSetPin(trace[edge].Pin, trace[edge].Level);
+      edge++;
+    }
+    HostTime_us = start_us + read_us;
+    increments.push_back(EncoderButton.GetEncoderIncrements());
+  }
+  return increments;
+}
+
+//===============================================================
+// Returns the sum of increments (with a sign filter)
+//===============================================================
+static int32_t Sum(const std::vector<int16_t>& increments, int8_t sign = 0)
+{
+  int32_t sum = 0;
+  for (int16_t increment : increments)
+  {
+    if (sign == 0 || (increment > 0 && sign > 0) || (increment < 0 && sign < 0))
+    {
+      sum += increment;
+    }
+  }
+  return sum;
+}
+
+//===============================================================
+// Returns the non zero increments
+//===============================================================
+static std::vector<int16_t> NonZero(const std::vector<int16_t>& increments)
+{
+  std::vector<int16_t> nonZero;
+  for (int16_t increment : increments)
+  {
+    if (increment != 0)
+    {
+      nonZero.push_back(increment);
+    }
+  }
+  return nonZero;
+}
+
+//===============================================================
+// Slow detents (100 ms per detent) count one increment each
+//===============================================================
+static void TestSlowDetents()
+{
+  std::vector<TraceEdge> trace;
+  AddQuarterSteps(trace, PAUSE_US, 10 * ENCODER_QUARTERSTEPS, 25000);
+  std::vector<int16_t> increments = NonZero(Replay(trace));
+  CHECK_EQUAL(10, increments.size());
+  CHECK_EQUAL(10, Sum(increments));
+  CHECK_EQUAL(10, Sum(increments, 1));
+
+  trace.clear();
+  AddQuarterSteps(trace, PAUSE_US, -10 * ENCODER_QUARTERSTEPS, 25000);
+  increments = NonZero(Replay(trace));
+  CHECK_EQUAL(10, increments.size());
+  CHECK_EQUAL(-10, Sum(increments, -1));
+}
+
+//===============================================================
+// Contact bounce shorter than the filter time gives the same
+// increments as the clean trace (both directions)
+//===============================================================
+static void TestContactBounce()
+{
+  for (int8_t direction : { 1, -1 })
+  {
+    std::vector<TraceEdge> clean;
+    AddQuarterSteps(clean, PAUSE_US + TRACE_OFFSET_US, direction * 8 * ENCODER_QUARTERSTEPS, 5000);
+    std::vector<int16_t> cleanIncrements = Replay(clean);
+
+    std::vector<TraceEdge> bouncy;
+    AddQuarterSteps(bouncy, PAUSE_US + TRACE_OFFSET_US, direction * 8 * ENCODER_QUARTERSTEPS, 5000, 3);
+    std::vector<int16_t> bouncyIncrements = Replay(bouncy);
+
+    CHECK_EQUAL(cleanIncrements.size(), bouncyIncrements.size());
+    for (size_t index = 0; index < cleanIncrements.size() && index < bouncyIncrements.size(); index++)
+    {
+      CHECK_EQUAL(cleanIncrements[index], bouncyIncrements[index]);
+    }
+    CHECK_EQUAL(direction * (1 + 3 * 7), Sum(bouncyIncrements));
+  }
+}
+
+//===============================================================
+// Fast detents are accelerated: 4 ms per detent gives the maximum
+// factor, 20 ms per detent factor 3 (the first detent after a
+// pause always counts once)
+//===============================================================
+static void TestAcceleration()
+{
+  std::vector<TraceEdge> trace;
+  AddQuarterSteps(trace, PAUSE_US + TRACE_OFFSET_US, 20 * ENCODER_QUARTERSTEPS, 1000);
+  std::vector<int16_t> increments = NonZero(Replay(trace));
+  CHECK(!increments.empty());
+  CHECK_EQUAL(1, increments.front());
+  for (size_t index = 1; index < increments.size(); index++)
+  {
+    CHECK_EQUAL(0, increments[index] % ENCODER_ACCEL_MAXFACTOR);
+  }
+  CHECK_EQUAL(1 + ENCODER_ACCEL_MAXFACTOR * 19, Sum(increments));
+
+  trace.clear();
+  AddQuarterSteps(trace, PAUSE_US + TRACE_OFFSET_US, 10 * ENCODER_QUARTERSTEPS, 5000);
+  increments = NonZero(Replay(trace));
+  CHECK_EQUAL(10, increments.size());
+  CHECK_EQUAL(1 + 3 * 9, Sum(increments));
+  CHECK_EQUAL(3, EncoderButtonDriver::GetAccelerationFactor(20000));
+}
+
+//===============================================================
+// A direction change starts slow again
+//===============================================================
+static void TestDirectionChange()
+{
+  std::vector<TraceEdge> trace;
+  uint32_t time_us = AddQuarterSteps(trace, PAUSE_US + TRACE_OFFSET_US, 5 * ENCODER_QUARTERSTEPS, 1000);
+  AddQuarterSteps(trace, time_us + 10000, -5 * ENCODER_QUARTERSTEPS, 1000);
+  std::vector<int16_t> increments = NonZero(Replay(trace));
+  CHECK_EQUAL(1 + ENCODER_ACCEL_MAXFACTOR * 4, Sum(increments, 1));
+  CHECK_EQUAL(-(1 + ENCODER_ACCEL_MAXFACTOR * 4), Sum(increments, -1));
+
+  // First increment after the direction change
+  for (size_t index = 1; index < increments.size(); index++)
+  {
+    if (increments[index] < 0)
+    {
+      CHECK(increments[index - 1] > 0);
+      CHECK_EQUAL(-1, increments[index]);
+      break;
+    }
+  }
+}
+
+//===============================================================
+// Jitter within a detent (half and three quarter steps back and
+// forth) never counts
+//===============================================================
+static void TestHalfStepJitter()
+{
+  std::vector<TraceEdge> trace;
+  uint32_t time_us = PAUSE_US + TRACE_OFFSET_US;
+  for (uint8_t jitter = 0; jitter < 20; jitter++)
+  {
+    time_us = AddQuarterSteps(trace, time_us, 1, 300);
+    time_us = AddQuarterSteps(trace, time_us, -1, 300);
+  }
+  for (uint8_t jitter = 0; jitter < 10; jitter++)
+  {
+    time_us = AddQuarterSteps(trace, time_us, 3, 2000);
+    time_us = AddQuarterSteps(trace, time_us, -3, 2000);
+  }
+  std::vector<int16_t> increments = Replay(trace);
+  CHECK_EQUAL(0, NonZero(increments).size());
+}
+
+//===============================================================
+// Quarter steps below a detent are kept for the next read
+//===============================================================
+static void TestRemainder()
+{
+  std::vector<TraceEdge> trace;
+  AddQuarterSteps(trace, PAUSE_US + TRACE_OFFSET_US, 2, 100);
+  CHECK_EQUAL(0, Sum(Replay(trace)));
+
+  trace.clear();
+  AddQuarterSteps(trace, TRACE_OFFSET_US, 2, 100);
+  CHECK_EQUAL(1, Sum(Replay(trace)));
+
+  trace.clear();
+  AddQuarterSteps(trace, PAUSE_US + TRACE_OFFSET_US, -3, 100);
+  CHECK_EQUAL(0, Sum(Replay(trace)));
+
+  trace.clear();
+  AddQuarterSteps(trace, TRACE_OFFSET_US, -1, 100);
+  CHECK_EQUAL(-1, Sum(Replay(trace)));
+}
+
+#if defined(HOST_ENCODER_ISR)
+//===============================================================
+// The table decoder counts an invalid transition (both pins
+// changed before the interrupt ran) as zero and continues from
+// the new state
+//===============================================================
+static void TestInvalidTransition()
+{
+  HostTime_us += PAUSE_US;
+  uint8_t state = ForwardSequence[tracePosition];
+  uint8_t skippedPosition = (tracePosition + 2) % 4;
+  uint8_t skippedState = ForwardSequence[skippedPosition];
+  CHECK_EQUAL(0b11, state ^ skippedState);
+
+  // Pin A changes without its interrupt, the interrupt of B sees both changes
+  HostPinReads[PIN_ENCODER_OUTA] = skippedState >> 1;
+  HostSetPin(PIN_ENCODER_OUTB, skippedState & 1);
+  CHECK_EQUAL(0, encoderBackend.ReadAndClear());
+  tracePosition = skippedPosition;
+
+  // A full detent from the new state counts
+  std::vector<TraceEdge> trace;
+  AddQuarterSteps(trace, TRACE_OFFSET_US, ENCODER_QUARTERSTEPS, 25000);
+  CHECK_EQUAL(1, Sum(Replay(trace)));
+}
+#endif
+
+//===============================================================
+// Main
+//===============================================================
+int main()
+{
+  EncoderButton.Begin(PIN_ENCODER_OUTA, PIN_ENCODER_OUTB, PIN_ENCODER_BUTTON);
+
+  TestSlowDetents();
+  TestContactBounce();
+  TestAcceleration();
+  TestDirectionChange();
+  TestHalfStepJitter();
+  TestRemainder();
+#if defined(HOST_ENCODER_ISR)
+  TestInvalidTransition();
+#endif
+
+  return TEST_RESULT();
+}
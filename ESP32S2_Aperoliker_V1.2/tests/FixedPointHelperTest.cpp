@@ -0,0 +1,143 @@
+/**
+ * Host test of the fixed point mixture math: Displayed percentages
+ * must be identical to the former double math, pump pwm times may
+ * be 1 ms longer (rounded instead of truncated) for every valid
+ * mixture
+ *
+ * @author    Florian Staeblein
+ * @date      2024/01/28
+ * @copyright © 2024 Florian Staeblein
+ */
+
+#include "TestHelper.h"
+#include "FixedPointHelper.h"
+#include "AngleHelper.h"
+
+//===============================================================
+// Former double math of PumpDriver::SetPumps (one pump)
+//===============================================================
+static uint32_t GetDoublePwm(int16_t distance_Degrees, int16_t maxDistance_Degrees, uint32_t cycleTimespan_ms)
+{
+  double value_Percentage = (double)distance_Degrees * 100.0 / 360.0;
+  double maxValue_Percentage = max(1.0, (double)maxDistance_Degrees * 100.0 / 360.0);
+  return (uint32_t)(value_Percentage / maxValue_Percentage * cycleTimespan_ms);
+}
+
+//===============================================================
+// Returns true, if a pwm time is the former double pwm time or
+// rounded up by 1 ms
+//===============================================================
+static bool IsPwmCompatible(uint32_t doublePwm_ms, uint32_t pwm_ms)
+{
+  return pwm_ms == doublePwm_ms || pwm_ms == doublePwm_ms + 1;
+}
+
+//===============================================================
+// Former double output of dtostrf(value, mainPlaces, decimalPlaces)
+//===============================================================
+static String FormatDouble(double value, int mainPlaces, int decimalPlaces)
+{
+  char output[32];
+  snprintf(output, sizeof(output), "%*.*f", mainPlaces, decimalPlaces, value);
+  return String(output);
+}
+
+//===============================================================
+// Pwm time of every share pair and every cycle timespan
+//===============================================================
+static void TestPwmPairs()
+{
+  for (int16_t maxDistance_Degrees = 0; maxDistance_Degrees <= 360; maxDistance_Degrees++)
+  {
+    uint32_t maxValue_Share = max((uint32_t)SHARE_PER_PERCENT, (uint32_t)DegreesToShare(maxDistance_Degrees));
+    for (int16_t distance_Degrees = 0; distance_Degrees <= maxDistance_Degrees; distance_Degrees++)
+    {
+      for (uint32_t cycleTimespan_ms = 200; cycleTimespan_ms <= 1000; cycleTimespan_ms++)
+      {
+        CHECK(IsPwmCompatible(GetDoublePwm(distance_Degrees, maxDistance_Degrees, cycleTimespan_ms),
+          ScaleShareRatio(cycleTimespan_ms, DegreesToShare(distance_Degrees), maxValue_Share)));
+      }
+    }
+  }
+}
+
+//===============================================================
+// Complete mixture of every valid distance triple (distances of
+// MINANGLE_DEGREES and more or muted to zero, sum 360°)
+//===============================================================
+static void TestMixtureTriples()
+{
+  uint32_t tripleCount = 0;
+  for (int16_t distance1_Degrees = 0; distance1_Degrees <= 360; distance1_Degrees++)
+  {
+    for (int16_t distance2_Degrees = 0; distance1_Degrees + distance2_Degrees <= 360; distance2_Degrees++)
+    {
+      int16_t distances_Degrees[3] = { distance1_Degrees, distance2_Degrees, (int16_t)(360 - distance1_Degrees - distance2_Degrees) };
+      bool isValid = true;
+      int16_t maxDistance_Degrees = 0;
+      uint32_t maxValue_Share = SHARE_PER_PERCENT;
+      for (uint8_t index = 0; index < 3; index++)
+      {
+        isValid = isValid && (distances_Degrees[index] == 0 || distances_Degrees[index] >= MINANGLE_DEGREES);
+        maxDistance_Degrees = max(maxDistance_Degrees, distances_Degrees[index]);
+        maxValue_Share = max(maxValue_Share, (uint32_t)DegreesToShare(distances_Degrees[index]));
+      }
+      if (!isValid)
+      {
+        continue;
+      }
+      tripleCount++;
+
+      for (uint8_t index = 0; index < 3; index++)
+      {
+        double value_Percentage = (double)distances_Degrees[index] * 100.0 / 360.0;
+        MixtureShare share = DegreesToShare(distances_Degrees[index]);
+
+        // Dashboard percentages and mixture string
+        CHECK(FormatDouble(value_Percentage, 2, 0) == FormatFixedPoint(ShareToPercent(share), 2, 0));
+        CHECK(FormatDouble(value_Percentage, 0, 2) == FormatFixedPoint(ShareToCentiPercent(share), 0, 2));
+
+        // Pump pwm times of all cycle timespans of the settings page
+        for (uint32_t cycleTimespan_ms = 200; cycleTimespan_ms <= 1000; cycleTimespan_ms += 20)
+        {
+          CHECK(IsPwmCompatible(GetDoublePwm(distances_Degrees[index], maxDistance_Degrees, cycleTimespan_ms),
+            ScaleShareRatio(cycleTimespan_ms, share, maxValue_Share)));
+        }
+      }
+    }
+  }
+  printf("%u valid distance triples\n", (unsigned)tripleCount);
+}
+
+//===============================================================
+// Rounding of the conversion templates
+//===============================================================
+static void TestRounding()
+{
+  // Exact halves are rounded to even like dtostrf (9° = 2.5%, 27° = 7.5%)
+  CHECK_EQUAL(2, ShareToPercent(DegreesToShare(9)));
+  CHECK_EQUAL(8, ShareToPercent(DegreesToShare(27)));
+  CHECK_EQUAL(100, ShareToPercent(SHARE_FULLSCALE));
+  CHECK_EQUAL(3, (RescaleRounded<SHARE_FULLSCALE, 100>(DegreesToShare(9))));
+
+  // Exact integer result, the former double math truncated it (5/6 * 204 = 170 -> 169)
+  CHECK_EQUAL(170, ScaleShareRatio(204, DegreesToShare(5), DegreesToShare(6)));
+  CHECK_EQUAL(169, GetDoublePwm(5, 6, 204));
+
+  // Halves are rounded up (1/8 * 204 = 25.5)
+  CHECK_EQUAL(26, ScaleShareRatio(204, DegreesToShare(45), DegreesToShare(360)));
+  CHECK_EQUAL(0, ScaleShareRatio(1000, SHARE_PER_PERCENT, 0));
+  CHECK_EQUAL(1000, ScaleShareRatio(1000, SHARE_FULLSCALE, SHARE_FULLSCALE));
+  CHECK_EQUAL(0, ScaleShareRatio(1000, 0, SHARE_PER_PERCENT));
+}
+
+//===============================================================
+// Main
+//===============================================================
+int main()
+{
+  TestRounding();
+  TestMixtureTriples();
+  TestPwmPairs();
+  return TEST_RESULT();
+}
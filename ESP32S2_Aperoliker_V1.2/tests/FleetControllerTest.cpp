@@ -0,0 +1,378 @@
+/**
+ * Host simulation of a mixer fleet: Several fleet controllers with
+ * simulated mixers on a loopback transport. Measures the order
+ * latencies and the load balance and checks, that orders are not
+ * routed to empty or low bottles.
+ *
+ * @author    Florian Staeblein
+ * @date      2024/01/28
+ * @copyright © 2024 Florian Staeblein
+ */
+
+#include "TestHelper.h"
+#include "FleetController.h"
+#include "FlowMeterDriver.h"
+#include "PumpDriver.h"
+#include <deque>
+#include <vector>
+
+//===============================================================
+// Defines
+//===============================================================
+#define SIM_DEVICES             3       // Mixers of the simulated fleet
+#define SIM_TICK_MS             10      // Loop task period of every mixer
+#define SIM_NETWORK_DELAY_MS    5       // Delivery time of a multicast message
+#define SIM_POUR_MS             3000    // Time to pour a glass
+#define SIM_ORDER_INTERVAL_MS   1500    // Time between two orders of the load test
+#define SIM_LOAD_ORDERS         24      // Orders of the load test
+
+
+//===============================================================
+// Multicast group of the loopback transports
+//===============================================================
+struct LoopbackMessage
+{
+  String Text;
+  uint32_t Due_ms;
+};
+
+class LoopbackTransport;
+static std::vector<LoopbackTransport*> loopbackGroup;
+
+//===============================================================
+// Loopback transport: Sent messages are received by every started
+// transport after the network delay
+//===============================================================
+class LoopbackTransport : public FleetTransport
+{
+  public:
+    bool Begin() override
+    {
+      loopbackGroup.push_back(this);
+      return true;
+    }
+
+    void End() override
+    {
+      loopbackGroup.erase(std::find(loopbackGroup.begin(), loopbackGroup.end(), this));
+      _inbox.clear();
+    }
+
+    void Send(const String& message) override
+    {
+      for (LoopbackTransport* transport : loopbackGroup)
+      {
+        transport->_inbox.push_back({ message, millis() + SIM_NETWORK_DELAY_MS });
+      }
+    }
+
+    bool Receive(String& message) override
+    {
+      if (_inbox.empty() || (int32_t)(millis() - _inbox.front().Due_ms) < 0)
+      {
+        return false;
+      }
+      message = _inbox.front().Text;
+      _inbox.pop_front();
+      return true;
+    }
+
+  private:
+    std::deque<LoopbackMessage> _inbox;
+};
+
+//===============================================================
+// Simulated mixer: Pours a glass for every order assigned to it,
+// like a guest at the mixer
+//===============================================================
+class SimulatedMixer : public FleetMixer
+{
+  public:
+    String GetStateName() override { return "Dashboard"; }
+    bool IsAvailable() override { return true; }
+    bool IsDispensing() override { return _isPouring; }
+    void GetLiquids(String& liquids, String& lowLiquids) override { liquids = Liquids; lowLiquids = LowLiquids; }
+    String GetDispensed() override { return String(Pours); }
+
+    // Starts and stops pouring
+    void Update(FleetController& fleet)
+    {
+      if (_isPouring && (millis() - _pourStart_ms) >= SIM_POUR_MS)
+      {
+        _isPouring = false;
+        Pours++;
+      }
+      else if (!_isPouring && fleet.GetLocalOrderCount() > 0)
+      {
+        _isPouring = true;
+        _pourStart_ms = millis();
+      }
+    }
+
+    String Liquids = "APEROLiker,Aperol,Soda,Prosecco";
+    String LowLiquids;
+    uint32_t Pours = 0;
+
+  private:
+    bool _isPouring = false;
+    uint32_t _pourStart_ms = 0;
+};
+
+//===============================================================
+// Simulated device of the fleet
+//===============================================================
+struct SimulatedDevice
+{
+  FleetController Fleet;
+  LoopbackTransport Transport;
+  SimulatedMixer Mixer;
+};
+
+static SimulatedDevice devices[SIM_DEVICES];
+
+//===============================================================
+// Order statistics of the fleet string
+//===============================================================
+struct FleetStatistics
+{
+  uint32_t Completed;
+  uint32_t Rejected;
+  uint32_t Open;
+  uint32_t RouteAvg_ms;
+  uint32_t RouteMax_ms;
+  uint32_t CompleteAvg_ms;
+  uint32_t CompleteMax_ms;
+};
+
+//===============================================================
+// Returns the order statistics of an origin device
+//===============================================================
+static FleetStatistics GetStatistics(FleetController& fleet)
+{
+  FleetStatistics statistics = {};
+  String fleetString = fleet.GetFleetString();
+  int start = fleetString.indexOf("Orders: ");
+  CHECK(start >= 0);
+  if (start >= 0)
+  {
+    CHECK_EQUAL(7, sscanf(fleetString.c_str() + start, "Orders: %u done, %u rejected, %u open, Route: %ums avg, %ums max, Complete: %ums avg, %ums max",
+      &statistics.Completed, &statistics.Rejected, &statistics.Open,
+      &statistics.RouteAvg_ms, &statistics.RouteMax_ms, &statistics.CompleteAvg_ms, &statistics.CompleteMax_ms));
+  }
+  return statistics;
+}
+
+//===============================================================
+// Runs the loop tasks of all devices for a time
+//===============================================================
+static void RunFleet(uint32_t time_ms)
+{
+  uint32_t start_ms = millis();
+  while (millis() - start_ms < time_ms)
+  {
+    for (SimulatedDevice& device : devices)
+    {
+      device.Mixer.Update(device.Fleet);
+      device.Fleet.Update();
+    }
+    HostAdvance_ms(SIM_TICK_MS);
+  }
+}
+
+//===============================================================
+// Returns the pours of all devices
+//===============================================================
+static std::vector<uint32_t> GetPours()
+{
+  std::vector<uint32_t> pours;
+  for (SimulatedDevice& device : devices)
+  {
+    pours.push_back(device.Mixer.Pours);
+  }
+  return pours;
+}
+
+//===============================================================
+// Every device knows the fleet and the same coordinator
+//===============================================================
+static void TestJoin()
+{
+  RunFleet(2000);
+  for (SimulatedDevice& device : devices)
+  {
+    CHECK(device.Fleet.GetFleetString().startsWith("Fleet: " + String(SIM_DEVICES) + " devices"));
+    CHECK_EQUAL(devices[0].Fleet.GetCoordinatorId(), device.Fleet.GetCoordinatorId());
+  }
+}
+
+//===============================================================
+// Orders of all devices are balanced over the fleet
+//===============================================================
+static void TestLoadBalance()
+{
+  std::vector<uint32_t> poursBefore = GetPours();
+  for (uint32_t order = 0; order < SIM_LOAD_ORDERS; order++)
+  {
+    CHECK(devices[order % SIM_DEVICES].Fleet.RequestOrder(order % 2 ? "APEROLiker" : "Prosecco"));
+    RunFleet(SIM_ORDER_INTERVAL_MS);
+  }
+  RunFleet(4 * SIM_POUR_MS);
+
+  uint32_t completed = 0;
+  uint32_t routeMax_ms = 0;
+  uint32_t completeMax_ms = 0;
+  for (uint8_t index = 0; index < SIM_DEVICES; index++)
+  {
+    FleetStatistics statistics = GetStatistics(devices[index].Fleet);
+    CHECK_EQUAL(0, statistics.Rejected);
+    CHECK_EQUAL(0, statistics.Open);
+    completed += statistics.Completed;
+    routeMax_ms = max(routeMax_ms, statistics.RouteMax_ms);
+    completeMax_ms = max(completeMax_ms, statistics.CompleteMax_ms);
+    printf("Device %u: %s\n", index, devices[index].Fleet.GetFleetString().c_str());
+  }
+  CHECK_EQUAL(SIM_LOAD_ORDERS, completed);
+
+  // Routing takes one round trip to the coordinator, an order waits at most for the running pour
+  CHECK(routeMax_ms <= 2 * (SIM_NETWORK_DELAY_MS + SIM_TICK_MS));
+  CHECK(completeMax_ms <= 2 * SIM_POUR_MS + SIM_TICK_MS * 4);
+
+  // Every device pours its share
+  std::vector<uint32_t> pours = GetPours();
+  uint32_t minPours = UINT32_MAX;
+  uint32_t maxPours = 0;
+  for (uint8_t index = 0; index < SIM_DEVICES; index++)
+  {
+    uint32_t devicePours = pours[index] - poursBefore[index];
+    minPours = min(minPours, devicePours);
+    maxPours = max(maxPours, devicePours);
+  }
+  printf("Pours per device: %u - %u\n", minPours, maxPours);
+  CHECK(minPours >= SIM_LOAD_ORDERS / SIM_DEVICES - 2);
+  CHECK(maxPours <= SIM_LOAD_ORDERS / SIM_DEVICES + 2);
+}
+
+//===============================================================
+// A burst of orders at one device is spread over the fleet
+//===============================================================
+static void TestOrderBurst()
+{
+  std::vector<uint32_t> poursBefore = GetPours();
+  FleetStatistics before = GetStatistics(devices[1].Fleet);
+  for (uint8_t order = 0; order < 2 * SIM_DEVICES; order++)
+  {
+    CHECK(devices[1].Fleet.RequestOrder("Prosecco"));
+  }
+  RunFleet(3 * SIM_POUR_MS);
+
+  FleetStatistics statistics = GetStatistics(devices[1].Fleet);
+  printf("Burst: %s\n", devices[1].Fleet.GetFleetString().c_str());
+  CHECK_EQUAL(before.Completed + 2 * SIM_DEVICES, statistics.Completed);
+  CHECK_EQUAL(0, statistics.Open);
+  CHECK(statistics.CompleteMax_ms <= 2 * SIM_POUR_MS + SIM_TICK_MS * 10);
+
+  std::vector<uint32_t> pours = GetPours();
+  for (uint8_t index = 0; index < SIM_DEVICES; index++)
+  {
+    CHECK_EQUAL(poursBefore[index] + 2, pours[index]);
+  }
+}
+
+//===============================================================
+// Empty bottles are not offered, low bottles only if no other
+// device offers the liquid
+//===============================================================
+static void TestLevelAwareRouting()
+{
+  devices[1].Mixer.Liquids = "Soda,Prosecco";
+  devices[2].Mixer.LowLiquids = "APEROLiker,Aperol";
+  RunFleet(2000);
+
+  // Busy device with full bottles before idle devices with low or empty bottles
+  std::vector<uint32_t> poursBefore = GetPours();
+  for (uint8_t order = 0; order < 4; order++)
+  {
+    CHECK(devices[order % SIM_DEVICES].Fleet.RequestOrder("Aperol"));
+    RunFleet(100);
+  }
+  RunFleet(5 * SIM_POUR_MS);
+  std::vector<uint32_t> pours = GetPours();
+  CHECK_EQUAL(poursBefore[0] + 4, pours[0]);
+  CHECK_EQUAL(poursBefore[1], pours[1]);
+  CHECK_EQUAL(poursBefore[2], pours[2]);
+
+  // Last bottles with a low level
+  devices[0].Mixer.Liquids = "Soda,Prosecco";
+  RunFleet(2000);
+  CHECK(devices[1].Fleet.RequestOrder("APEROLiker"));
+  RunFleet(SIM_POUR_MS + 1000);
+  CHECK_EQUAL(pours[2] + 1, devices[2].Mixer.Pours);
+
+  // No device offers the liquid
+  uint32_t rejected = GetStatistics(devices[1].Fleet).Rejected;
+  devices[2].Mixer.Liquids = "Soda,Prosecco";
+  devices[2].Mixer.LowLiquids = "";
+  RunFleet(2000);
+  CHECK(devices[1].Fleet.RequestOrder("Aperol"));
+  RunFleet(100);
+  FleetStatistics statistics = GetStatistics(devices[1].Fleet);
+  CHECK_EQUAL(rejected + 1, statistics.Rejected);
+  CHECK_EQUAL(0, statistics.Open);
+}
+
+//===============================================================
+// The mixer itself offers no empty bottles and the mixture only,
+// if every bottle covers its share of a glass
+//===============================================================
+static void TestLocalMixer()
+{
+  FleetMixerLocal mixer;
+  String liquids;
+  String lowLiquids;
+  String mixture = String(MIXER_NAME) + "," + LiquidTable[0].Name + "," + LiquidTable[1].Name + "," + LiquidTable[2].Name;
+
+  // Untracked bottles
+  mixer.GetLiquids(liquids, lowLiquids);
+  CHECK(liquids == mixture);
+  CHECK(lowLiquids == "");
+
+  // Low bottle
+  MixtureShare shares[LiquidCount] = { SHARE_FULLSCALE / 3, SHARE_FULLSCALE / 3, SHARE_FULLSCALE / 3 };
+  Pumps.SetPumps(shares);
+  FlowMeter.SetBottle(0, LEVEL_LOW_ML - 50);
+  Pumps.UpdatePourCheck();
+  mixer.GetLiquids(liquids, lowLiquids);
+  CHECK(liquids == mixture);
+  CHECK(lowLiquids == String(MIXER_NAME) + "," + LiquidTable[0].Name);
+
+  // Empty bottle
+  FlowMeter.AddFlowTime(0, (LEVEL_LOW_ML - 50) * 60000 / FLOWRATE_ML_PER_MIN);
+  Pumps.UpdatePourCheck();
+  mixer.GetLiquids(liquids, lowLiquids);
+  CHECK(liquids == String(LiquidTable[1].Name) + "," + LiquidTable[2].Name);
+  CHECK(lowLiquids == "");
+  FlowMeter.SetBottle(0, 0);
+  Pumps.UpdatePourCheck();
+}
+
+//===============================================================
+// Main
+//===============================================================
+int main()
+{
+  // Device IDs are the lower 32 bits of the MAC
+  for (uint8_t index = 0; index < SIM_DEVICES; index++)
+  {
+    ESP.HostEfuseMac = 0x5634120AC430 + index;
+    devices[index].Fleet.SetTransport(&devices[index].Transport);
+    devices[index].Fleet.SetMixer(&devices[index].Mixer);
+    devices[index].Fleet.Begin("10.0.0." + String(30 + index));
+  }
+
+  TestJoin();
+  TestLoadBalance();
+  TestOrderBurst();
+  TestLevelAwareRouting();
+  TestLocalMixer();
+  return TEST_RESULT();
+}
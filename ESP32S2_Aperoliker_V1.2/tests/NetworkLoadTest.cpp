@@ -0,0 +1,560 @@
+/**
+ * Load test of the web server of the mixer (benchmark of the
+ * network statistics at "/netstats"): Simulated phones load the
+ * page and drag liquids over the websocket or listen to the
+ * server-sent events. The messages wait in the stand-in clients
+ * like unacknowledged TCP data until the link of a phone takes
+ * them. Reports acknowledge latency percentiles, dropped messages,
+ * bytes and the peak heap of the web server.
+ *
+ * NetworkLoadTest [clients] [duration in s]
+ *
+ * @author    Florian Staeblein
+ * @date      2024/01/28
+ * @copyright © 2024 Florian Staeblein
+ */
+
+#include "TestHelper.h"
+#include "WifiHandler.h"
+#include "fakes/FakeDisplayDriver.h"
+#include "fakes/LocalNetworkBackend.h"
+#include <algorithm>
+#include <deque>
+#include <fstream>
+#include <new>
+#include <sstream>
+#include <vector>
+
+//===============================================================
+// Defines
+//===============================================================
+#define PIN_ENCODER_OUTA        8
+#define PIN_ENCODER_OUTB        11
+#define PIN_ENCODER_BUTTON      10
+#define PIN_BUZZER              17
+
+#define LOAD_CLIENTS            12      // Default amount of phones (every third listens to the events, 8 websockets like the library limit)
+#define LOAD_DURATION_S         60      // Default simulated duration
+#define LOAD_SETTLE_MS          3000    // Phones stop dragging this time before the end (outstanding acknowledges)
+#define LOAD_FREE_HEAP          150000  // Assumed free heap of the mixer with started web server
+#define MAIN_PERIOD_MS          5       // Main task period (state machine)
+#define LOOP_PERIOD_MS          10      // Loop task period (wifi update)
+
+#define LINK_FAST_BYTES         2000    // Link of a phone near the mixer (bytes per main period)
+#define LINK_FAST_DELAY_MS      5       // Delay of the messages of a phone near the mixer
+#define LINK_SLOW_BYTES         40      // Link of a phone at the edge of the access point (every fourth phone)
+#define LINK_SLOW_DELAY_MS      40      // Delay of the messages of a phone at the edge of the access point
+#define DRAG_STEPS              25      // Liquid angles per drag (one drag of a second)
+#define DRAG_STEP_MS            40      // Time between the angles of a drag
+#define DRAG_PAUSE_MIN_MS       2000    // Pause between two drags
+#define DRAG_PAUSE_MAX_MS       8000
+#define RECONNECT_MIN_MS        500     // Reconnect backoff of the page (0.5s, 1s, 2s ... 8s)
+#define RECONNECT_MAX_MS        8000
+
+
+//===============================================================
+// Heap of the web server: Allocations while the firmware or the
+// stand-in of the network library runs are counted until they are
+// freed (host allocation sizes approximate the mixer). Responses of
+// page loads are left out, the library streams them in chunks.
+//===============================================================
+struct HeapBlock
+{
+  size_t Size;
+  size_t IsTracked;
+};
+
+static bool isHeapTracked = false;
+static int64_t heapUsed = 0;
+static int64_t heapPeak = 0;
+
+static void* AllocateBlock(size_t size)
+{
+  HeapBlock* block = (HeapBlock*)malloc(sizeof(HeapBlock) + size);
+  if (block == NULL)
+  {
+    return NULL;
+  }
+  block->Size = size;
+  block->IsTracked = isHeapTracked;
+  if (isHeapTracked)
+  {
+    heapUsed += size;
+    heapPeak = std::max(heapPeak, heapUsed);
+  }
+  return block + 1;
+}
+
+static void FreeBlock(void* pointer)
+{
+  if (pointer == NULL)
+  {
+    return;
+  }
+  HeapBlock* block = (HeapBlock*)pointer - 1;
+  if (block->IsTracked)
+  {
+    heapUsed -= block->Size;
+  }
+  free(block);
+}
+
+void* operator new(size_t size)
+{
+  void* pointer = AllocateBlock(size);
+  if (pointer == NULL)
+  {
+    throw std::bad_alloc();
+  }
+  return pointer;
+}
+void* operator new[](size_t size) { return operator new(size); }
+void* operator new(size_t size, const std::nothrow_t&) noexcept { return AllocateBlock(size); }
+void* operator new[](size_t size, const std::nothrow_t&) noexcept { return AllocateBlock(size); }
+void operator delete(void* pointer) noexcept { FreeBlock(pointer); }
+void operator delete[](void* pointer) noexcept { FreeBlock(pointer); }
+void operator delete(void* pointer, size_t) noexcept { FreeBlock(pointer); }
+void operator delete[](void* pointer, size_t) noexcept { FreeBlock(pointer); }
+void operator delete(void* pointer, const std::nothrow_t&) noexcept { FreeBlock(pointer); }
+void operator delete[](void* pointer, const std::nothrow_t&) noexcept { FreeBlock(pointer); }
+
+// Free heap reported to the firmware
+static uint32_t GetFreeHeap()
+{
+  return (uint32_t)(LOAD_FREE_HEAP - heapUsed);
+}
+
+
+//===============================================================
+// Simulated phone
+//===============================================================
+struct Phone
+{
+  bool IsListener;                  // Listens to the events instead of the websocket
+  int32_t Link_Bytes;               // Bytes per main period
+  int32_t Credit_Bytes;             // Bytes the link can take now (negative after a large message)
+  uint32_t LinkDelay_ms;            // Delay of the messages to the mixer
+  std::deque<std::pair<uint32_t, String>> Outgoing;   // Messages on the way to the mixer (arrival time)
+  uint32_t Seed;                    // Pseudo random script
+  uint32_t Next_ms;                 // Next action (page load, reconnect, drag angle)
+  uint32_t ReconnectDelay_ms;
+  bool IsPageLoaded;
+  AsyncWebSocketClient* Websocket;
+  AsyncEventSourceClient* Events;
+
+  // Mixture known by the page
+  uint32_t MixtureVersion;
+  int16_t Angles_Degrees[LiquidCount];
+  bool IsFullUpdateRequested;
+
+  // Drag and outstanding liquid angles (sequence and send time)
+  uint8_t DragLiquid;
+  int8_t DragDirection;
+  uint8_t DragSteps;
+  uint32_t Sequence;
+  std::vector<std::pair<uint32_t, uint32_t>> Pending;
+};
+
+//===============================================================
+// Results of the load test (measured by the phones)
+//===============================================================
+struct LoadResults
+{
+  std::vector<uint32_t> Latencies_ms;   // Acknowledge latencies
+  uint32_t Sent;                        // Messages sent by the phones on open websockets
+  uint32_t Conflicts;                   // Liquid angles acknowledged as conflict
+  uint32_t Rejected;                    // Liquid angles rejected by the mixer (command queue full)
+  uint32_t LostOnClose;                 // Outstanding liquid angles of closed websockets
+  uint32_t Closed;                      // Websockets closed by the mixer
+  uint32_t Connects;                    // Websocket connects (including reconnects)
+  uint64_t ReceivedMessages;            // Messages received by the phones
+  uint64_t ReceivedBytes;               // Bytes received by the phones
+  uint64_t PageBytes;                   // Bytes of the page loads
+};
+
+
+//===============================================================
+// Global variables
+//===============================================================
+static LocalNetworkBackend network;
+static LoadResults results = {};
+
+//===============================================================
+// Returns the next pseudo random value of a phone
+//===============================================================
+static uint32_t GetRandom(Phone& phone, uint32_t minimum, uint32_t maximum)
+{
+  phone.Seed = phone.Seed * 1103515245 + 12345;
+  return minimum + (phone.Seed >> 16) % (maximum - minimum + 1);
+}
+
+//===============================================================
+// Copies a file of the web interface to the file system
+//===============================================================
+static void LoadDataFile(const char* name)
+{
+  std::ifstream input(std::string(HOST_DATA_DIR) + name, std::ios::binary);
+  std::stringstream content;
+  content << input.rdbuf();
+  std::string data = content.str();
+  SPIFFS.open(name, FILE_WRITE).write((const uint8_t*)data.data(), data.size());
+}
+
+//===============================================================
+// Runs firmware code with counted allocations
+//===============================================================
+template <typename Function> static void RunTracked(Function function)
+{
+  isHeapTracked = true;
+  function();
+  isHeapTracked = false;
+}
+
+//===============================================================
+// Sends a text over the websocket of a phone (arrives after the
+// delay of the link)
+//===============================================================
+static void SendText(Phone& phone, const String& text)
+{
+  phone.Outgoing.push_back(std::make_pair(millis() + phone.LinkDelay_ms, text));
+}
+
+//===============================================================
+// Hands the arrived messages of a phone to the mixer
+//===============================================================
+static void TransmitPhone(Phone& phone)
+{
+  AsyncWebSocket* websocket = AsyncWebServer::HostInstance->HostFindHandler<AsyncWebSocket>();
+  while (phone.Websocket &&
+    !phone.Outgoing.empty() &&
+    phone.Outgoing.front().first <= millis())
+  {
+    RunTracked([&]() { websocket->HostReceive(phone.Websocket, phone.Outgoing.front().second); });
+    phone.Outgoing.pop_front();
+    results.Sent++;
+  }
+}
+
+//===============================================================
+// Loads the page and connects the websocket or the events
+//===============================================================
+static void ConnectPhone(Phone& phone)
+{
+  AsyncWebServer* server = AsyncWebServer::HostInstance;
+
+  // Page load (static files are cached by the browser for reconnects)
+  if (!phone.IsPageLoaded)
+  {
+    const char* urls[] = { "/", "/index.css", "/draggableDoughnutChart.js", "/index.js" };
+    for (const char* url : urls)
+    {
+      AsyncWebServerRequest request = server->HostRequest(HTTP_GET, url);
+      CHECK_EQUAL(200, request.HostCode);
+      results.PageBytes += request.HostBody.length();
+    }
+    phone.IsPageLoaded = true;
+  }
+
+  if (phone.IsListener)
+  {
+    AsyncEventSource* events = server->HostFindHandler<AsyncEventSource>();
+    RunTracked([&]() { phone.Events = events->HostConnect(); });
+    phone.Next_ms = UINT32_MAX;
+    return;
+  }
+
+  // Websocket with subscribed pushes and a full update
+  AsyncWebSocket* websocket = server->HostFindHandler<AsyncWebSocket>();
+  RunTracked([&]() { phone.Websocket = websocket->HostConnect(); });
+  results.Connects++;
+  phone.ReconnectDelay_ms = RECONNECT_MIN_MS;
+  phone.Pending.clear();
+  phone.Outgoing.clear();
+  phone.DragSteps = 0;
+  SendText(phone, "SUBSCRIBE:MIXTURE,SETTINGS,LEVELS");
+  SendText(phone, "FULLUPDATE");
+  phone.IsFullUpdateRequested = true;
+  phone.Next_ms = millis() + GetRandom(phone, DRAG_PAUSE_MIN_MS, DRAG_PAUSE_MAX_MS);
+}
+
+//===============================================================
+// Runs the script of a phone: Connect, reconnect and drag
+//===============================================================
+static void RunPhone(Phone& phone, uint32_t end_ms)
+{
+  if (millis() < phone.Next_ms)
+  {
+    return;
+  }
+
+  if (!phone.Websocket && !phone.Events)
+  {
+    ConnectPhone(phone);
+    return;
+  }
+
+  // No drags while waiting for the mixture and at the end of the test
+  if (phone.IsListener || phone.IsFullUpdateRequested || millis() + LOAD_SETTLE_MS > end_ms)
+  {
+    return;
+  }
+
+  // Start a drag of a liquid
+  if (phone.DragSteps == 0)
+  {
+    phone.DragLiquid = (uint8_t)GetRandom(phone, 0, LiquidCount - 1);
+    phone.DragDirection = GetRandom(phone, 0, 1) ? 1 : -1;
+    phone.DragSteps = DRAG_STEPS;
+  }
+
+  // Next angle of the drag
+  int16_t& angle_Degrees = phone.Angles_Degrees[phone.DragLiquid];
+  angle_Degrees = (angle_Degrees + phone.DragDirection * 2 + 360) % 360;
+  phone.Sequence++;
+  phone.Pending.push_back(std::make_pair(phone.Sequence, millis()));
+  SendText(phone, "LIQUID_ANGLE:" + String(phone.DragLiquid) + "," + String(angle_Degrees) + "," + String(phone.MixtureVersion) + "," + String(phone.Sequence));
+
+  phone.DragSteps--;
+  phone.Next_ms = millis() + (phone.DragSteps > 0 ? DRAG_STEP_MS : GetRandom(phone, DRAG_PAUSE_MIN_MS, DRAG_PAUSE_MAX_MS));
+}
+
+//===============================================================
+// Takes over the acknowledge of a sequence (acknowledges all
+// older sequences of the phone)
+//===============================================================
+static void Acknowledge(Phone& phone, uint32_t sequence)
+{
+  while (!phone.Pending.empty() && phone.Pending.front().first <= sequence)
+  {
+    results.Latencies_ms.push_back(millis() - phone.Pending.front().second);
+    phone.Pending.erase(phone.Pending.begin());
+  }
+}
+
+//===============================================================
+// Handles a message of the mixer like the page
+//===============================================================
+static void HandleMessage(Phone& phone, const String& message)
+{
+  results.ReceivedMessages++;
+  results.ReceivedBytes += message.length();
+  String data = message.substring(message.indexOf(":") + 1);
+
+  if (message.startsWith("LIQUID_ACK:") || message.startsWith("LIQUID_CONFLICT:"))
+  {
+    results.Conflicts += message.startsWith("LIQUID_CONFLICT:") ? 1 : 0;
+    Acknowledge(phone, (uint32_t)data.substring(0, data.indexOf(",")).toInt());
+  }
+  else if (message.startsWith("LIQUID_NACK:"))
+  {
+    results.Rejected++;
+    Acknowledge(phone, (uint32_t)data.toInt());
+  }
+  else if (message.startsWith("MIXTURE:"))
+  {
+    // Snapshot "<version>:<angle>,<angle>,..."
+    phone.MixtureVersion = (uint32_t)data.toInt();
+    String angles = data.substring(data.indexOf(":") + 1) + ",";
+    for (uint8_t index = 0; index < LiquidCount; index++)
+    {
+      phone.Angles_Degrees[index] = (int16_t)angles.toInt();
+      angles = angles.substring(angles.indexOf(",") + 1);
+    }
+    phone.IsFullUpdateRequested = false;
+  }
+  else if (message.startsWith("MIXTURE_DIFF:"))
+  {
+    // Diff "<client ID>:<base version>:<version>:<liquid>=<angle>,..." (the own drag wins on the page)
+    int delimiter = data.indexOf(":", data.indexOf(":") + 1);
+    uint32_t baseVersion = (uint32_t)data.substring(data.indexOf(":") + 1, delimiter).toInt();
+    uint32_t version = (uint32_t)data.substring(delimiter + 1).toInt();
+    if (baseVersion > phone.MixtureVersion && !phone.IsFullUpdateRequested && phone.Pending.empty())
+    {
+      SendText(phone, "FULLUPDATE");
+      phone.IsFullUpdateRequested = true;
+    }
+    phone.MixtureVersion = std::max(phone.MixtureVersion, version);
+  }
+  else if (message.startsWith("MIXTURE_VERSION:"))
+  {
+    if ((uint32_t)data.toInt() != phone.MixtureVersion && !phone.IsFullUpdateRequested && phone.Pending.empty())
+    {
+      SendText(phone, "FULLUPDATE");
+      phone.IsFullUpdateRequested = true;
+    }
+  }
+}
+
+//===============================================================
+// Delivers the messages of a phone as far as its link takes them
+//===============================================================
+static void ReceivePhone(Phone& phone)
+{
+  phone.Credit_Bytes = std::min(phone.Credit_Bytes + phone.Link_Bytes, phone.Link_Bytes);
+  if (phone.Events)
+  {
+    while (phone.Credit_Bytes > 0 && phone.Events->packetsWaiting() > 0)
+    {
+      phone.Credit_Bytes -= (int32_t)phone.Events->HostDeliver(1);
+    }
+    for (const String& message : phone.Events->HostReceived)
+    {
+      results.ReceivedMessages++;
+      results.ReceivedBytes += message.length();
+    }
+    phone.Events->HostReceived.clear();
+  }
+
+  if (!phone.Websocket)
+  {
+    return;
+  }
+
+  // Closed by the mixer (slow client or too many clients), the page reconnects with backoff
+  if (phone.Websocket->status() != WS_CONNECTED)
+  {
+    results.Closed++;
+    results.LostOnClose += phone.Pending.size();
+    phone.Pending.clear();
+    phone.Outgoing.clear();
+    phone.Websocket = NULL;
+    phone.Next_ms = millis() + phone.ReconnectDelay_ms;
+    phone.ReconnectDelay_ms = std::min(phone.ReconnectDelay_ms * 2, (uint32_t)RECONNECT_MAX_MS);
+    return;
+  }
+
+  while (phone.Credit_Bytes > 0 && phone.Websocket->queueLen() > 0)
+  {
+    phone.Credit_Bytes -= (int32_t)phone.Websocket->HostDeliver(1);
+  }
+  std::deque<String> messages;
+  messages.swap(phone.Websocket->HostReceived);
+  for (const String& message : messages)
+  {
+    HandleMessage(phone, message);
+  }
+}
+
+//===============================================================
+// Returns a percentile of the measured latencies
+//===============================================================
+static uint32_t GetPercentile(const std::vector<uint32_t>& sorted, uint8_t percent)
+{
+  if (sorted.empty())
+  {
+    return 0;
+  }
+  size_t index = (sorted.size() * percent + 99) / 100;
+  return sorted[std::max(index, (size_t)1) - 1];
+}
+
+//===============================================================
+// Runs the phones against the mixer and reports the results
+//===============================================================
+static void RunLoadTest(uint32_t clients, uint32_t duration_s)
+{
+  std::vector<Phone> phones(clients);
+  for (uint32_t index = 0; index < clients; index++)
+  {
+    Phone& phone = phones[index];
+    phone = Phone();
+    phone.IsListener = (index % 3) == 2;
+    phone.Link_Bytes = ((index % 4) == 3) ? LINK_SLOW_BYTES : LINK_FAST_BYTES;
+    phone.LinkDelay_ms = ((index % 4) == 3) ? LINK_SLOW_DELAY_MS : LINK_FAST_DELAY_MS;
+    phone.Seed = index + 1;
+    phone.Next_ms = millis() + index * 250;    // Guests join one after another
+    phone.ReconnectDelay_ms = RECONNECT_MIN_MS;
+  }
+  results.Latencies_ms.reserve(200000);
+
+  // Measurement from an idle web server
+  AsyncWebServer* server = AsyncWebServer::HostInstance;
+  server->HostRequest(HTTP_GET, "/netstats", { { "reset", "", false } });
+  heapUsed = 0;
+  heapPeak = 0;
+  ESP.HostFreeHeap = GetFreeHeap;
+  network.AccessPointStations = (uint16_t)clients;
+
+  uint32_t start_ms = millis();
+  uint32_t end_ms = start_ms + duration_s * 1000;
+  while (millis() < end_ms)
+  {
+    for (Phone& phone : phones)
+    {
+      RunPhone(phone, end_ms);
+      TransmitPhone(phone);
+    }
+    RunTracked([]() { Statemachine.Execute(eMain); });
+    if ((millis() - start_ms) % LOOP_PERIOD_MS == 0)
+    {
+      RunTracked([]() { Wifihandler.Update(); });
+    }
+    for (Phone& phone : phones)
+    {
+      ReceivePhone(phone);
+    }
+    HostAdvance_ms(MAIN_PERIOD_MS);
+  }
+
+  // Statistics of the mixer and the phones
+  NetworkStatistics stats = Wifihandler.GetNetworkStatistics();
+  AsyncWebServerRequest netstats = server->HostRequest(HTTP_GET, "/netstats");
+  uint32_t lostOnOpen = 0;
+  for (Phone& phone : phones)
+  {
+    lostOnOpen += phone.Pending.size();
+  }
+  std::vector<uint32_t> sorted = results.Latencies_ms;
+  std::sort(sorted.begin(), sorted.end());
+
+  printf("Load: %u phones (%u on events), %u s, %u websocket connects, %u closed by the mixer\n",
+    (unsigned)clients, (unsigned)(clients / 3), (unsigned)duration_s, (unsigned)results.Connects, (unsigned)results.Closed);
+  printf("Ack latency p50/p95/p99/max: %u/%u/%u/%u ms (%u acknowledged, %u conflicts, %u rejected, %u lost on close, %u outstanding)\n",
+    (unsigned)GetPercentile(sorted, 50), (unsigned)GetPercentile(sorted, 95), (unsigned)GetPercentile(sorted, 99), (unsigned)(sorted.empty() ? 0 : sorted.back()),
+    (unsigned)sorted.size(), (unsigned)results.Conflicts, (unsigned)results.Rejected, (unsigned)results.LostOnClose, (unsigned)lostOnOpen);
+  printf("Phones: %u messages sent, %llu received (%llu bytes), page loads %llu bytes\n",
+    (unsigned)results.Sent, (unsigned long long)results.ReceivedMessages, (unsigned long long)results.ReceivedBytes, (unsigned long long)results.PageBytes);
+  printf("Mixer: %u sent (%u bytes), %u dropped, %u evicted\n",
+    (unsigned)stats.Sent, (unsigned)stats.BytesSent, (unsigned)stats.Dropped, (unsigned)stats.Evicted);
+  printf("Peak heap: %lld bytes (min free heap %lld bytes)\n", (long long)heapPeak, (long long)(LOAD_FREE_HEAP - heapPeak));
+  printf("/netstats: %s\n", netstats.HostBody.c_str());
+
+  // The mixer counts every message of the phones and answers every liquid angle of an open websocket
+  CHECK_EQUAL(200, netstats.HostCode);
+  CHECK(netstats.HostBody.startsWith("Network: "));
+  CHECK_EQUAL(results.Sent, stats.Received);
+  CHECK_EQUAL(0, lostOnOpen);
+  CHECK(!sorted.empty());
+  CHECK(stats.MinFreeHeap >= LOAD_FREE_HEAP - heapPeak);
+  CHECK(stats.LatencyMax_ms <= (sorted.empty() ? 0 : sorted.back()));
+
+  ESP.HostFreeHeap = NULL;
+}
+
+//===============================================================
+// Main
+//===============================================================
+int main(int argc, char** argv)
+{
+  uint32_t clients = (argc > 1) ? (uint32_t)atoi(argv[1]) : LOAD_CLIENTS;
+  uint32_t duration_s = (argc > 2) ? (uint32_t)atoi(argv[2]) : LOAD_DURATION_S;
+
+  // Boot like the setup function (wifi enabled without credentials -> access point)
+  HostPinReads[PIN_ENCODER_BUTTON] = HIGH;
+  LoadDataFile("/index.html");
+  LoadDataFile("/index.css");
+  LoadDataFile("/index.js");
+  LoadDataFile("/draggableDoughnutChart.js");
+  Settings.Begin();
+  Settings.SetWifiMode(true);
+  EncoderButton.Begin(PIN_ENCODER_OUTA, PIN_ENCODER_OUTB, PIN_ENCODER_BUTTON);
+  FlowMeter.Load();
+  Pumps.Begin();
+  Statemachine.Begin(PIN_BUZZER);
+  Statemachine.Execute(eEntry);
+  Wifihandler.SetNetworkBackend(&network);
+  Wifihandler.Begin();
+
+  RunLoadTest(clients, duration_s);
+  return TEST_RESULT();
+}
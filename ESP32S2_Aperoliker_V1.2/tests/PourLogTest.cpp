@@ -0,0 +1,329 @@
+/**
+ * Host test of the pour log: Ring buffer wraparound, statistics
+ * of overwritten records and the streamed JSON and CSV export of
+ * the statistics URL
+ *
+ * @author    Florian Staeblein
+ * @date      2024/01/28
+ * @copyright © 2024 Florian Staeblein
+ */
+
+#include "TestHelper.h"
+#include "PourLog.h"
+#include <string>
+
+//===============================================================
+// Defines
+//===============================================================
+#define WRAPPED_RECORDS         10    // Records overwritten by the wraparound
+#define POUR_PERIOD_S           60    // Uptime between two test pours
+
+
+//===============================================================
+// Global variables
+//===============================================================
+static AsyncWebServer server(80);
+static uint32_t addedVolume_ml = 0;
+
+//===============================================================
+// Returns the test record with an absolute number
+//===============================================================
+static PourRecord GetTestRecord(uint32_t number)
+{
+  PourRecord record = {};
+  uint32_t volume_ml = 0;
+  for (uint8_t index = 0; index < LiquidCount; index++)
+  {
+    record.Volumes_ml[index] = 10 * (index + 1) + number % 7;
+    volume_ml += record.Volumes_ml[index];
+  }
+  for (uint8_t index = 0; index < LiquidCount; index++)
+  {
+    record.Mixture_Percent[index] = (uint8_t)((record.Volumes_ml[index] * 100 + volume_ml / 2) / volume_ml);
+  }
+  record.Timestamp_s = number * POUR_PERIOD_S;
+  record.Duration_ms = 1000 + number;
+  record.RecipeId = PourLog::GetRecipeId(record.Mixture_Percent);
+  return record;
+}
+
+//===============================================================
+// Adds test records up to the given record count
+//===============================================================
+static void AddTestRecords(uint32_t recordCount)
+{
+  for (uint32_t number = Pours.GetRecordCount(); number < recordCount; number++)
+  {
+    PourRecord record = GetTestRecord(number);
+    Pours.Add(record);
+    for (uint8_t index = 0; index < LiquidCount; index++)
+    {
+      addedVolume_ml += record.Volumes_ml[index];
+    }
+  }
+}
+
+//===============================================================
+// Returns true, if two records are equal
+//===============================================================
+static bool IsRecordEqual(const PourRecord& expected, const PourRecord& actual)
+{
+  return expected.Timestamp_s == actual.Timestamp_s &&
+    expected.Duration_ms == actual.Duration_ms &&
+    memcmp(expected.Volumes_ml, actual.Volumes_ml, sizeof(expected.Volumes_ml)) == 0 &&
+    memcmp(expected.Mixture_Percent, actual.Mixture_Percent, sizeof(expected.Mixture_Percent)) == 0 &&
+    expected.RecipeId == actual.RecipeId;
+}
+
+//===============================================================
+// Returns the CSV line of a test record
+//===============================================================
+static std::string GetCsvLine(uint32_t number)
+{
+  PourRecord record = GetTestRecord(number);
+  std::string line = std::to_string(record.Timestamp_s) + "," + std::to_string(record.Duration_ms);
+  for (uint8_t index = 0; index < LiquidCount; index++)
+  {
+    line += "," + std::to_string(record.Volumes_ml[index]);
+  }
+  for (uint8_t index = 0; index < LiquidCount; index++)
+  {
+    line += "," + std::to_string(record.Mixture_Percent[index]);
+  }
+  return line + "," + std::to_string(record.RecipeId) + "\n";
+}
+
+//===============================================================
+// Returns the JSON object of a test record
+//===============================================================
+static std::string GetJsonRecord(uint32_t number)
+{
+  PourRecord record = GetTestRecord(number);
+  std::string volumes;
+  std::string mixture;
+  for (uint8_t index = 0; index < LiquidCount; index++)
+  {
+    volumes += (index > 0 ? "," : "") + std::to_string(record.Volumes_ml[index]);
+    mixture += (index > 0 ? "," : "") + std::to_string(record.Mixture_Percent[index]);
+  }
+  return "{\"t\":" + std::to_string(record.Timestamp_s) + ",\"d\":" + std::to_string(record.Duration_ms) +
+    ",\"v\":[" + volumes + "],\"m\":[" + mixture + "],\"r\":" + std::to_string(record.RecipeId) + "}";
+}
+
+//===============================================================
+// Returns the expected JSON records array of a record range
+//===============================================================
+static std::string GetJsonRecords(uint32_t firstRecord, uint32_t endRecord)
+{
+  std::string records = "\"records\":[";
+  for (uint32_t number = firstRecord; number < endRecord; number++)
+  {
+    records += (number > firstRecord ? "," : "") + GetJsonRecord(number);
+  }
+  return records + "]}";
+}
+
+//===============================================================
+// Returns the expected CSV export of a record range
+//===============================================================
+static std::string GetCsv(uint32_t firstRecord, uint32_t endRecord)
+{
+  std::string csv = "timestamp_s,duration_ms";
+  for (uint8_t index = 0; index < LiquidCount; index++)
+  {
+    csv += std::string(",") + LiquidTable[index].Name + "_ml";
+  }
+  for (uint8_t index = 0; index < LiquidCount; index++)
+  {
+    csv += std::string(",") + LiquidTable[index].Name + "_percent";
+  }
+  csv += ",recipe\n";
+  for (uint32_t number = firstRecord; number < endRecord; number++)
+  {
+    csv += GetCsvLine(number);
+  }
+  return csv;
+}
+
+//===============================================================
+// Requests the statistics URL (JSON or CSV)
+//===============================================================
+static AsyncWebServerRequest RequestStats(bool isCsv)
+{
+  std::vector<AsyncWebParameter> parameters;
+  if (isCsv)
+  {
+    parameters.push_back({ "format", "csv", false });
+  }
+  return server.HostRequest(HTTP_GET, "/stats", parameters);
+}
+
+//===============================================================
+// Returns true, if the text ends with the suffix
+//===============================================================
+static bool EndsWith(const std::string& text, const std::string& suffix)
+{
+  return text.size() >= suffix.size() && text.compare(text.size() - suffix.size(), suffix.size(), suffix) == 0;
+}
+
+//===============================================================
+// Without pours the export has no records
+//===============================================================
+static void TestEmptyExport()
+{
+  AsyncWebServerRequest json = RequestStats(false);
+  CHECK_EQUAL(200, json.HostCode);
+  CHECK(json.HostContentType == "application/json");
+  CHECK(json.HostBody.startsWith("{\"uptime_s\":"));
+  CHECK(json.HostBody.indexOf(",\"pours\":0,\"volume_ml\":0,\"average_ml\":0,") > 0);
+  CHECK(json.HostBody.indexOf(",\"recipes\":[],") > 0);
+  CHECK(EndsWith(json.HostBody.c_str(), GetJsonRecords(0, 0)));
+
+  AsyncWebServerRequest csv = RequestStats(true);
+  CHECK_EQUAL(200, csv.HostCode);
+  CHECK(csv.HostContentType == "text/csv");
+  CHECK(csv.HostBody == GetCsv(0, 0).c_str());
+}
+
+//===============================================================
+// The ring buffer keeps the last POURLOG_SIZE records, the
+// statistics count all records since boot
+//===============================================================
+static void TestRingWraparound()
+{
+  // Full ring buffer without wraparound
+  AddTestRecords(POURLOG_SIZE);
+  PourRecord record;
+  CHECK(Pours.GetRecord(0, record));
+  CHECK(IsRecordEqual(GetTestRecord(0), record));
+  CHECK(!Pours.GetRecord(POURLOG_SIZE, record));
+
+  // The oldest records are overwritten
+  const uint32_t recordCount = POURLOG_SIZE + WRAPPED_RECORDS;
+  AddTestRecords(recordCount);
+  CHECK_EQUAL(recordCount, Pours.GetRecordCount());
+  for (uint32_t number = 0; number < recordCount + 2; number++)
+  {
+    bool isAvailable = number >= WRAPPED_RECORDS && number < recordCount;
+    CHECK_EQUAL(isAvailable, Pours.GetRecord(number, record));
+    if (isAvailable)
+    {
+      CHECK(IsRecordEqual(GetTestRecord(number), record));
+    }
+  }
+
+  // Statistics include the overwritten records
+  String summary = String(",\"pours\":") + String(recordCount) +
+    ",\"volume_ml\":" + String(addedVolume_ml) +
+    ",\"average_ml\":" + String(addedVolume_ml / recordCount) + ",";
+  CHECK(Pours.GetPourString().startsWith(String("Pours: ") + String(recordCount) + " (" + String(addedVolume_ml) + "ml"));
+  CHECK(RequestStats(false).HostBody.indexOf(summary) > 0);
+}
+
+//===============================================================
+// JSON and CSV export the available records oldest first, the
+// result does not depend on the chunk size
+//===============================================================
+static void TestExport()
+{
+  const uint32_t recordCount = Pours.GetRecordCount();
+  const size_t chunkSizes[] = { 1, 7, 64, 1436 };
+  String jsonBody;
+  for (size_t chunkSize : chunkSizes)
+  {
+    AsyncWebServerRequest::HostChunkSize = chunkSize;
+    AsyncWebServerRequest json = RequestStats(false);
+    CHECK_EQUAL(200, json.HostCode);
+    CHECK(EndsWith(json.HostBody.c_str(), GetJsonRecords(recordCount - POURLOG_SIZE, recordCount)));
+    CHECK(jsonBody.length() == 0 || json.HostBody == jsonBody);
+    CHECK_EQUAL((json.HostBody.length() + chunkSize - 1) / chunkSize, json.HostChunks);
+    jsonBody = json.HostBody;
+
+    AsyncWebServerRequest csv = RequestStats(true);
+    CHECK_EQUAL(200, csv.HostCode);
+    CHECK(csv.HostBody == GetCsv(recordCount - POURLOG_SIZE, recordCount).c_str());
+  }
+  AsyncWebServerRequest::HostChunkSize = 1436;
+
+  // JSON brackets are balanced
+  int32_t depth = 0;
+  int32_t minDepth = 1;
+  for (unsigned int index = 0; index < jsonBody.length(); index++)
+  {
+    char value = jsonBody[index];
+    depth += (value == '{' || value == '[') ? 1 : ((value == '}' || value == ']') ? -1 : 0);
+    minDepth = (index + 1 < jsonBody.length()) ? min(minDepth, depth) : minDepth;
+  }
+  CHECK_EQUAL(0, depth);
+  CHECK_EQUAL(1, minDepth);
+}
+
+//===============================================================
+// Pours during an export: Records added after the start are not
+// exported, records overwritten meanwhile are skipped
+//===============================================================
+static void TestExportDuringPours()
+{
+  const uint32_t startCount = Pours.GetRecordCount();
+  const uint32_t addedRecords = POURLOG_SIZE / 2;
+  uint8_t buffer[64];
+
+  for (uint8_t isCsv = 0; isCsv <= 1; isCsv++)
+  {
+    PourExport state;
+    uint32_t recordCount = Pours.GetRecordCount();
+    Pours.StartExport(state, isCsv);
+
+    // Summary or header and the first record (byte by byte, the next line is not created yet)
+    std::string body;
+    while (!EndsWith(body, isCsv ? GetCsvLine(recordCount - POURLOG_SIZE) : GetJsonRecord(recordCount - POURLOG_SIZE)))
+    {
+      size_t length = Pours.FillExport(state, buffer, 1);
+      CHECK(length > 0);
+      if (length == 0)
+      {
+        break;
+      }
+      body.append((const char*)buffer, length);
+    }
+
+    // Overwrites the oldest half of the exported records
+    AddTestRecords(recordCount + addedRecords);
+    size_t length;
+    while ((length = Pours.FillExport(state, buffer, sizeof(buffer))) > 0)
+    {
+      body.append((const char*)buffer, length);
+    }
+
+    // First record, then the records, which were not overwritten, up to the start of the export
+    uint32_t firstRecord = recordCount - POURLOG_SIZE + addedRecords;
+    std::string records;
+    if (isCsv)
+    {
+      records = GetCsvLine(recordCount - POURLOG_SIZE) + GetCsv(firstRecord, recordCount).substr(GetCsv(0, 0).size());
+    }
+    else
+    {
+      records = GetJsonRecord(recordCount - POURLOG_SIZE) + "," + GetJsonRecords(firstRecord, recordCount).substr(strlen("\"records\":["));
+    }
+    CHECK(EndsWith(body, records));
+    CHECK(body.find(isCsv ? GetCsvLine(recordCount) : GetJsonRecord(recordCount)) == std::string::npos);
+  }
+  CHECK_EQUAL(startCount + 2 * addedRecords, Pours.GetRecordCount());
+}
+
+//===============================================================
+// Main
+//===============================================================
+int main()
+{
+  Pours.Begin(false);
+  Pours.AddWebHandlers(&server);
+  server.begin();
+
+  TestEmptyExport();
+  TestRingWraparound();
+  TestExport();
+  TestExportDuringPours();
+  return TEST_RESULT();
+}
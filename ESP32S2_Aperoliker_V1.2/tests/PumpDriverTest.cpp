@@ -0,0 +1,264 @@
+/**
+ * Host test of the cycle timespan selection of the automatic mode:
+ * Representative mixtures meet the ratio error target (the ratio
+ * error of every candidate cycle timespan is reported), the
+ * selected cycle is the shortest one on target and every mixture
+ * meeting the target with the former fixed cycle meets it too
+ *
+ * @author    Florian Staeblein
+ * @date      2024/01/28
+ * @copyright © 2024 Florian Staeblein
+ */
+
+#include "TestHelper.h"
+#include "PumpDriver.h"
+
+//===============================================================
+// Defines
+//===============================================================
+#define FIXED_CYCLE_TIMESPAN_MS DEFAULT_CYCLE_TIMESPAN_MS   // Cycle timespan before the automatic mode
+#define MIXTURE_STEP_PERCENT    5                           // Share step of the mixtures of all liquids
+#define SWEEP_STEP_MS           200                         // Step of the reported candidate cycle timespans
+
+
+//===============================================================
+// Comparison of the automatic mode and the fixed cycle timespan
+//===============================================================
+struct CycleComparison
+{
+  uint32_t Mixtures;
+  uint32_t AutoOnTarget;          // Mixtures within the ratio error target
+  uint32_t FixedOnTarget;
+  uint64_t AutoCycles_ms;         // Sum of the cycle timespans
+  uint64_t AutoErrors_Permille;   // Sum of the ratio errors
+  uint64_t FixedErrors_Permille;
+};
+
+//===============================================================
+// Representative mixture (liquids 1-3, the others are off)
+//===============================================================
+struct MixtureCase
+{
+  const char* Name;
+  uint8_t Percentages[3];
+  bool IsOnTarget;                // False -> target out of reach, the longest cycle is selected
+};
+
+//===============================================================
+// Global variables
+//===============================================================
+static CycleComparison comparison = {};
+
+static const MixtureCase mixtureCases[] =
+{
+  { "100",      { 100, 0,  0  }, true  },   // One pump runs the whole cycle
+  { "50/50",    { 50,  50, 0  }, true  },
+  { "70/30",    { 70,  30, 0  }, true  },
+  { "90/10",    { 90,  10, 0  }, true  },
+  { "40/40/20", { 40,  40, 20 }, true  },
+  { "50/45/5",  { 50,  45, 5  }, true  },   // 5% share with a pulse of exactly MIN_PULSE_MS
+  { "60/35/5",  { 60,  35, 5  }, false },
+  { "95/5",     { 95,  5,  0  }, false },
+};
+
+//===============================================================
+// Returns the ratio error and the shortest pulse of a mixture
+// with the pwm timings of the pump driver
+//===============================================================
+static uint32_t GetMixtureError(const uint32_t clip_Share[LiquidCount], uint32_t maxValue_Share, uint32_t cycleTimespan_ms, uint32_t* minPulse_ms = NULL)
+{
+  uint32_t pwmPumps_ms[LiquidCount];
+  uint32_t minPulseTime_ms = cycleTimespan_ms;
+  for (uint8_t index = 0; index < LiquidCount; index++)
+  {
+    pwmPumps_ms[index] = ScaleShareRatio(cycleTimespan_ms, clip_Share[index], maxValue_Share);
+    if (pwmPumps_ms[index] > 0)
+    {
+      minPulseTime_ms = min(minPulseTime_ms, pwmPumps_ms[index]);
+    }
+  }
+
+  if (minPulse_ms != NULL)
+  {
+    *minPulse_ms = minPulseTime_ms;
+  }
+  return PumpDriver::GetRatioError(pwmPumps_ms, cycleTimespan_ms);
+}
+
+//===============================================================
+// Checks the selected cycle timespan of one mixture against the
+// fixed cycle timespan
+//===============================================================
+static void CheckMixture(const uint32_t clip_Share[LiquidCount])
+{
+  uint32_t maxValue_Share = 0;
+  for (uint8_t index = 0; index < LiquidCount; index++)
+  {
+    maxValue_Share = max(maxValue_Share, clip_Share[index]);
+  }
+
+  uint32_t cycleTimespan_ms = PumpDriver::SelectCycleTimespan(clip_Share, maxValue_Share);
+  uint32_t minPulse_ms;
+  uint32_t autoError_Permille = GetMixtureError(clip_Share, maxValue_Share, cycleTimespan_ms, &minPulse_ms);
+  uint32_t fixedError_Permille = GetMixtureError(clip_Share, maxValue_Share, FIXED_CYCLE_TIMESPAN_MS);
+
+  // Setting range in steps
+  CHECK(cycleTimespan_ms >= MIN_CYCLE_TIMESPAN_MS && cycleTimespan_ms <= MAX_CYCLE_TIMESPAN_MS);
+  CHECK_EQUAL(0, cycleTimespan_ms % STEP_CYCLE_TIMESPAN_MS);
+
+  bool isAutoOnTarget = autoError_Permille <= RATIO_ERROR_TARGET_PERMILLE && (autoError_Permille == 0 || minPulse_ms >= MIN_PULSE_MS);
+  if (fixedError_Permille <= RATIO_ERROR_TARGET_PERMILLE)
+  {
+    // Never worse than the target, never longer than the fixed cycle
+    CHECK(isAutoOnTarget);
+    CHECK(cycleTimespan_ms <= FIXED_CYCLE_TIMESPAN_MS);
+  }
+  else
+  {
+    // Target out of reach: The longest cycle comes closest
+    CHECK_EQUAL(MAX_CYCLE_TIMESPAN_MS, cycleTimespan_ms);
+    CHECK(autoError_Permille <= fixedError_Permille);
+  }
+
+  // The next shorter cycle misses the target or the minimum pulse
+  if (isAutoOnTarget &&
+    cycleTimespan_ms > MIN_CYCLE_TIMESPAN_MS)
+  {
+    uint32_t shorterPulse_ms;
+    uint32_t shorterError_Permille = GetMixtureError(clip_Share, maxValue_Share, cycleTimespan_ms - STEP_CYCLE_TIMESPAN_MS, &shorterPulse_ms);
+    CHECK(shorterError_Permille > RATIO_ERROR_TARGET_PERMILLE || shorterPulse_ms < MIN_PULSE_MS);
+  }
+
+  comparison.Mixtures++;
+  comparison.AutoOnTarget += isAutoOnTarget ? 1 : 0;
+  comparison.FixedOnTarget += (fixedError_Permille <= RATIO_ERROR_TARGET_PERMILLE) ? 1 : 0;
+  comparison.AutoCycles_ms += cycleTimespan_ms;
+  comparison.AutoErrors_Permille += autoError_Permille;
+  comparison.FixedErrors_Permille += fixedError_Permille;
+}
+
+//===============================================================
+// Representative mixtures set by the pump driver in automatic
+// mode: Ratio error and shortest pulse of the selected cycle, the
+// ratio error of every candidate cycle is reported
+//===============================================================
+static void TestMixtureCases()
+{
+  CHECK(Pumps.SetCycleTimespan(AUTO_CYCLE_TIMESPAN_MS));
+  for (const MixtureCase& mixtureCase : mixtureCases)
+  {
+    // Mixtures of more liquids than the mixer has are skipped
+    MixtureShare values_Share[LiquidCount] = {};
+    uint32_t clip_Share[LiquidCount] = {};
+    uint32_t maxValue_Share = 0;
+    bool isAvailable = true;
+    for (uint8_t index = 0; index < 3; index++)
+    {
+      if (index >= LiquidCount)
+      {
+        isAvailable = isAvailable && mixtureCase.Percentages[index] == 0;
+        continue;
+      }
+      values_Share[index] = mixtureCase.Percentages[index] * SHARE_PER_PERCENT;
+      clip_Share[index] = values_Share[index];
+      maxValue_Share = max(maxValue_Share, clip_Share[index]);
+    }
+    if (!isAvailable)
+    {
+      continue;
+    }
+
+    Pumps.SetPumps(values_Share);
+    uint32_t cycleTimespan_ms = Pumps.GetActiveCycleTimespan();
+    uint32_t ratioError_Permille = Pumps.GetActiveRatioError();
+    uint32_t minPulse_ms;
+    CHECK_EQUAL(GetMixtureError(clip_Share, maxValue_Share, cycleTimespan_ms, &minPulse_ms), ratioError_Permille);
+
+    printf("%-9s cycle %4u ms, pulse %4u ms, ratio error %s%%, candidates:", mixtureCase.Name, (unsigned)cycleTimespan_ms,
+      (unsigned)minPulse_ms, FormatFixedPoint(ratioError_Permille, 3, 1).c_str());
+    for (uint32_t candidate_ms = MIN_CYCLE_TIMESPAN_MS; candidate_ms <= MAX_CYCLE_TIMESPAN_MS; candidate_ms += SWEEP_STEP_MS)
+    {
+      uint32_t candidateError_Permille = GetMixtureError(clip_Share, maxValue_Share, candidate_ms);
+      printf(" %u ms=%s%%", (unsigned)candidate_ms, FormatFixedPoint(candidateError_Permille, 3, 1).c_str());
+
+      // Shorter candidates miss the target (the selection is the shortest cycle on target)
+      if (mixtureCase.IsOnTarget && candidate_ms < cycleTimespan_ms)
+      {
+        CHECK(candidateError_Permille > RATIO_ERROR_TARGET_PERMILLE);
+      }
+    }
+    printf("\n");
+
+    if (mixtureCase.IsOnTarget)
+    {
+      // Pulsed pumps run at least the shortest pulse (a pump running the whole cycle doesn't restart)
+      CHECK(ratioError_Permille <= RATIO_ERROR_TARGET_PERMILLE);
+      CHECK(minPulse_ms >= MIN_PULSE_MS);
+    }
+    else
+    {
+      CHECK_EQUAL(MAX_CYCLE_TIMESPAN_MS, cycleTimespan_ms);
+      CHECK(ratioError_Permille > RATIO_ERROR_TARGET_PERMILLE);
+    }
+  }
+}
+
+//===============================================================
+// Two liquids in steps of one degree (the other liquids are off)
+//===============================================================
+static void TestTwoLiquids()
+{
+  for (uint32_t angle_Degrees = 0; angle_Degrees <= 360; angle_Degrees++)
+  {
+    uint32_t clip_Share[LiquidCount] = {};
+    clip_Share[0] = angle_Degrees * SHARE_PER_DEGREE;
+    clip_Share[1] = SHARE_FULLSCALE - clip_Share[0];
+    CheckMixture(clip_Share);
+  }
+}
+
+//===============================================================
+// All mixtures of all liquids in MIXTURE_STEP_PERCENT steps
+//===============================================================
+static void TestAllLiquids(uint32_t* clip_Share, uint8_t liquidIndex, uint32_t remaining_Percent)
+{
+  if (liquidIndex == LiquidCount - 1)
+  {
+    clip_Share[liquidIndex] = remaining_Percent * SHARE_PER_PERCENT;
+    CheckMixture(clip_Share);
+    return;
+  }
+
+  for (uint32_t share_Percent = 0; share_Percent <= remaining_Percent; share_Percent += MIXTURE_STEP_PERCENT)
+  {
+    clip_Share[liquidIndex] = share_Percent * SHARE_PER_PERCENT;
+    TestAllLiquids(clip_Share, liquidIndex + 1, remaining_Percent - share_Percent);
+  }
+}
+
+//===============================================================
+// The automatic mode meets the target for the same mixtures as
+// the fixed cycle timespan, with shorter cycles on average
+//===============================================================
+static void TestComparison()
+{
+  printf("Mixtures: %u, on target auto/fixed: %u/%u, average cycle auto/fixed: %llu/%u ms, average ratio error auto/fixed: %.1f/%.1f%%\n",
+    comparison.Mixtures, comparison.AutoOnTarget, comparison.FixedOnTarget,
+    (unsigned long long)(comparison.AutoCycles_ms / comparison.Mixtures), FIXED_CYCLE_TIMESPAN_MS,
+    comparison.AutoErrors_Permille / 10.0 / comparison.Mixtures, comparison.FixedErrors_Permille / 10.0 / comparison.Mixtures);
+  CHECK(comparison.AutoOnTarget >= comparison.FixedOnTarget);
+  CHECK(comparison.AutoCycles_ms < (uint64_t)FIXED_CYCLE_TIMESPAN_MS * comparison.Mixtures);
+}
+
+//===============================================================
+// Main
+//===============================================================
+int main()
+{
+  TestMixtureCases();
+  TestTwoLiquids();
+  uint32_t clip_Share[LiquidCount] = {};
+  TestAllLiquids(clip_Share, 0, 100);
+  TestComparison();
+  return TEST_RESULT();
+}
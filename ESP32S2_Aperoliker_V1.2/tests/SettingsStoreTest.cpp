@@ -0,0 +1,235 @@
+/**
+ * Host test of the settings store: Saved mixtures, which are no
+ * valid sector angles, keep the default recipe and commits stop
+ * as soon as the pumps start (remaining values stay dirty)
+ *
+ * @author    Florian Staeblein
+ * @date      2024/01/28
+ * @copyright © 2024 Florian Staeblein
+ */
+
+#include "TestHelper.h"
+#include "StateMachine.h"
+#include "fakes/FakeDisplayDriver.h"
+
+//===============================================================
+// Defines
+//===============================================================
+#define PIN_ENCODER_OUTA        8
+#define PIN_ENCODER_OUTB        11
+#define PIN_ENCODER_BUTTON      10
+#define PIN_BUZZER              17
+
+
+//===============================================================
+// Global variables
+//===============================================================
+static uint32_t startPumpsAfterWrites = 0;    // Pumps start after this amount of flash writes (0 -> never)
+
+//===============================================================
+// Starts the pumps during a commit after the given amount of
+// flash writes
+//===============================================================
+static void StartPumpsHook(const char* key)
+{
+  if (startPumpsAfterWrites > 0 &&
+    Preferences::HostWriteCount >= startPumpsAfterWrites)
+  {
+    Pumps.Enable();
+  }
+}
+
+//===============================================================
+// Saves mixture angles to flash, restores the settings and the
+// mixture like after a power cycle
+//===============================================================
+static void RestoreMixture(const int16_t* angles_Degrees)
+{
+  Preferences preferences;
+  preferences.begin(SETTINGS_NAME, false);
+  char key[16];
+  for (uint8_t index = 0; index < LiquidCount; index++)
+  {
+    snprintf(key, sizeof(key), KEY_MIXTURE_ANGLE, index + 1);
+    preferences.putShort(key, angles_Degrees[index]);
+  }
+  preferences.end();
+
+  Settings.Begin();
+  Statemachine.Begin(PIN_BUZZER);
+}
+
+//===============================================================
+// Returns true, if the state machine has the given mixture
+//===============================================================
+static bool IsMixture(const int16_t* angles_Degrees)
+{
+  for (uint8_t index = 0; index < LiquidCount; index++)
+  {
+    if (Statemachine.GetAngle((MixtureLiquid)index) != angles_Degrees[index])
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+//===============================================================
+// Valid saved mixtures are restored, all others (unordered or
+// angles closer than MINANGLE_DEGREES) keep the default recipe
+//===============================================================
+static void TestLoadMixture()
+{
+  int16_t defaults_Degrees[LiquidCount];
+  int16_t angles_Degrees[LiquidCount];
+  for (uint8_t index = 0; index < LiquidCount; index++)
+  {
+    defaults_Degrees[index] = LiquidTable[index].DefaultAngle_Degrees;
+  }
+
+  // Valid: Evenly spread, starting behind zero
+  for (uint8_t index = 0; index < LiquidCount; index++)
+  {
+    angles_Degrees[index] = 3 + index * (360 / LiquidCount);
+  }
+  RestoreMixture(angles_Degrees);
+  CHECK(IsMixture(angles_Degrees));
+
+  // Unordered: First two angles swapped
+  int16_t angle_Degrees = angles_Degrees[0];
+  angles_Degrees[0] = angles_Degrees[1];
+  angles_Degrees[1] = angle_Degrees;
+  RestoreMixture(angles_Degrees);
+  CHECK(IsMixture(defaults_Degrees));
+
+  // Too close: Second angle right behind the first one
+  angles_Degrees[0] = 3;
+  angles_Degrees[1] = 3 + MINANGLE_DEGREES - 1;
+  RestoreMixture(angles_Degrees);
+  CHECK(IsMixture(defaults_Degrees));
+
+  // Same angle for all liquids
+  for (uint8_t index = 0; index < LiquidCount; index++)
+  {
+    angles_Degrees[index] = 90;
+  }
+  RestoreMixture(angles_Degrees);
+  CHECK(IsMixture(defaults_Degrees));
+}
+
+//===============================================================
+// Changes all values of the settings store (new values on every
+// call, so stale keys in flash are found)
+//===============================================================
+static void ChangeAllValues(uint32_t run)
+{
+  for (uint8_t index = 0; index < LiquidCount; index++)
+  {
+    Settings.SetMixtureAngle(index, (run + index * (360 / LiquidCount)) % 360);
+    Settings.SetFlowMeter(index, 1000 * run + index, 500 + run + index, 2000 * run + index);
+  }
+  Settings.SetCycleTimespan(MIN_CYCLE_TIMESPAN_MS + run);
+}
+
+//===============================================================
+// Returns true, if all values in flash equal the values of the
+// settings store
+//===============================================================
+static bool IsFlashEqual()
+{
+  Preferences preferences;
+  preferences.begin(SETTINGS_NAME, true);
+  bool isEqual = (uint32_t)preferences.getLong(KEY_CYCLETIMESPAN_MS, SETTINGS_UNSET) == Settings.GetCycleTimespan();
+  char key[16];
+  for (uint8_t index = 0; index < LiquidCount; index++)
+  {
+    snprintf(key, sizeof(key), KEY_MIXTURE_ANGLE, index + 1);
+    isEqual = isEqual && preferences.getShort(key, SETTINGS_UNSET) == Settings.GetMixtureAngle(index);
+    snprintf(key, sizeof(key), KEY_FLOWTIME_LIQUID, index + 1);
+    isEqual = isEqual && preferences.getULong64(key, 0) == Settings.GetFlowTime(index);
+    snprintf(key, sizeof(key), KEY_CAPACITY_LIQUID, index + 1);
+    isEqual = isEqual && preferences.getULong(key, 0) == Settings.GetCapacity(index);
+    snprintf(key, sizeof(key), KEY_EMPTYTIME_LIQUID, index + 1);
+    isEqual = isEqual && preferences.getULong64(key, 0) == Settings.GetEmptyFlowTime(index);
+  }
+  preferences.end();
+  return isEqual;
+}
+
+//===============================================================
+// Returns true, if the settings store has dirty values
+//===============================================================
+static bool IsDirty()
+{
+  return Settings.GetSettingsString().indexOf("Dirty: true") >= 0;
+}
+
+//===============================================================
+// The pumps start after every possible key of a commit: No
+// further key is written, the commit is counted as stopped and
+// the remaining values (also the rest of a flow meter triple)
+// are written by the next commit
+//===============================================================
+static void TestCommitStoppedByPumps()
+{
+  // Mixture angle, flow meter triple per liquid and cycle timespan
+  const uint32_t keyCount = LiquidCount * 4 + 1;
+  Preferences::HostWriteHook = StartPumpsHook;
+
+  for (uint32_t stopKey = 1; stopKey < keyCount; stopKey++)
+  {
+    ChangeAllValues(stopKey);
+    CHECK(IsDirty());
+
+    // Pumps start while the commit writes key number stopKey
+    uint32_t writeCount = Preferences::HostWriteCount;
+    startPumpsAfterWrites = writeCount + stopKey;
+    Settings.Commit();
+    startPumpsAfterWrites = 0;
+    CHECK(Pumps.IsEnabled());
+    CHECK_EQUAL(stopKey, Preferences::HostWriteCount - writeCount);
+    CHECK(IsDirty());
+    CHECK(!IsFlashEqual());
+
+    // No commit while the pumps run
+    writeCount = Preferences::HostWriteCount;
+    HostAdvance_ms(SETTINGS_QUIET_MS + 100);
+    Settings.Update(Pumps.IsEnabled());
+    Settings.Commit();
+    CHECK_EQUAL(writeCount, Preferences::HostWriteCount);
+
+    // Remaining values are written after the pumps stopped
+    Pumps.Disable();
+    Settings.Update(Pumps.IsEnabled());
+    CHECK(!IsDirty());
+    CHECK(IsFlashEqual());
+  }
+
+  // Commit without pumps
+  ChangeAllValues(keyCount);
+  uint32_t writeCount = Preferences::HostWriteCount;
+  Settings.Commit();
+  CHECK_EQUAL(keyCount, Preferences::HostWriteCount - writeCount);
+  CHECK(!IsDirty());
+  CHECK(IsFlashEqual());
+  CHECK(Settings.GetSettingsString().indexOf(String("Stopped: ") + String(keyCount - 1) + ",") >= 0);
+  Preferences::HostWriteHook = NULL;
+}
+
+//===============================================================
+// Main
+//===============================================================
+int main()
+{
+  // Boot like the setup function
+  HostPinReads[PIN_ENCODER_BUTTON] = HIGH;
+  Settings.Begin();
+  EncoderButton.Begin(PIN_ENCODER_OUTA, PIN_ENCODER_OUTB, PIN_ENCODER_BUTTON);
+  FlowMeter.Load();
+  Pumps.Begin();
+  Statemachine.Begin(PIN_BUZZER);
+
+  TestLoadMixture();
+  TestCommitStoppedByPumps();
+  return TEST_RESULT();
+}
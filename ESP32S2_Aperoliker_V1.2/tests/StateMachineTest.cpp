@@ -0,0 +1,333 @@
+/**
+ * Host test of the state machine: Replays input sequences (button,
+ * long button press, encoder, dispensing lever and waiting) and
+ * checks the state after every input
+ *
+ * @author    Florian Staeblein
+ * @date      2024/01/28
+ * @copyright © 2024 Florian Staeblein
+ */
+
+#include "TestHelper.h"
+#include "StateMachine.h"
+#include "fakes/FakeDisplayDriver.h"
+
+//===============================================================
+// Defines
+//===============================================================
+#define PIN_ENCODER_OUTA        8
+#define PIN_ENCODER_OUTB        11
+#define PIN_ENCODER_BUTTON      10
+#define PIN_BUZZER              17
+#define MAIN_PERIOD_MS          5     // Main task period
+
+
+//===============================================================
+// Replay step: Input, its value and the expected state afterwards
+//===============================================================
+enum ReplayInput : uint8_t
+{
+  eButton,        // Short button press
+  eLongButton,    // Long button press (pressed for value ms)
+  eEncoder,       // Encoder detents (signed, one detent per 20 ms)
+  eLever,         // Dispensing lever (1 -> pressed, 0 -> released)
+  eWait,          // Main task runs for value ms without input
+};
+
+struct ReplayStep
+{
+  ReplayInput Input;
+  int32_t Value;
+  MixerState ExpectedState;
+};
+
+//===============================================================
+// Runs the main task for a time
+//===============================================================
+static void RunMainTask(uint32_t time_ms)
+{
+  uint32_t start_ms = millis();
+  while (millis() - start_ms < time_ms)
+  {
+    Statemachine.Execute(eMain);
+    HostAdvance_ms(MAIN_PERIOD_MS);
+  }
+}
+
+//===============================================================
+// Changes the button level (like the button interrupt)
+//===============================================================
+static void SetButton(bool isPressed)
+{
+  HostPinReads[PIN_ENCODER_BUTTON] = isPressed ? LOW : HIGH;
+  EncoderButton.ButtonEvent();
+}
+
+//===============================================================
+// Replays the input of one step and checks the state
+//===============================================================
+static void Replay(const ReplayStep& step, uint32_t line)
+{
+  switch (step.Input)
+  {
+    case eButton:
+      {
+        SetButton(true);
+        RunMainTask(50);
+        SetButton(false);
+        RunMainTask(20);
+      }
+      break;
+    case eLongButton:
+      {
+        SetButton(true);
+        RunMainTask(step.Value);
+        SetButton(false);
+        RunMainTask(20);
+      }
+      break;
+    case eEncoder:
+      {
+        for (int32_t detent = 0; detent < abs(step.Value); detent++)
+        {
+          HostPcntCounter += step.Value > 0 ? ENCODER_QUARTERSTEPS : -ENCODER_QUARTERSTEPS;
+          RunMainTask(20);
+        }
+      }
+      break;
+    case eLever:
+      {
+        step.Value ? Pumps.Enable() : Pumps.Disable();
+        RunMainTask(20);
+      }
+      break;
+    case eWait:
+    default:
+      {
+        RunMainTask(step.Value);
+      }
+      break;
+  }
+
+  if (Statemachine.GetCurrentState() != step.ExpectedState)
+  {
+    printf("Replay step %u: ", (unsigned)line);
+  }
+  CHECK_EQUAL(step.ExpectedState, Statemachine.GetCurrentState());
+}
+
+//===============================================================
+// Replays a sequence of steps
+//===============================================================
+template <size_t count> static void Replay(const ReplayStep (&steps)[count])
+{
+  for (size_t index = 0; index < count; index++)
+  {
+    Replay(steps[index], index);
+  }
+}
+
+//===============================================================
+// Menu navigation: Long press returns to menu, the menu selects
+// the state, inputs of the page change debounce are discarded
+//===============================================================
+static void TestMenuNavigation()
+{
+  const ReplayStep steps[] =
+  {
+    { eLongButton, 600,   eMenu },        // Dashboard -> menu, dashboard selected
+    { eEncoder,    -1,    eMenu },        // Discarded (page change debounce)
+    { eButton,     0,     eMenu },        // Discarded (page change debounce)
+    { eWait,       500,   eMenu },
+    { eEncoder,    -1,    eMenu },        // Cleaning selected
+    { eButton,     0,     eCleaning },
+    { eLongButton, 600,   eMenu },        // Cleaning -> menu, cleaning selected
+    { eWait,       500,   eMenu },
+    { eEncoder,    -2,    eMenu },        // Settings selected
+    { eEncoder,    1,     eMenu },        // Reset selected (one entry per detent)
+    { eButton,     0,     eReset },
+    { eLongButton, 600,   eReset },       // Reset has no menu return
+    { eWait,       2000,  eDashboard },   // Reset page display time
+    { eLongButton, 600,   eMenu },
+    { eWait,       500,   eMenu },
+    { eEncoder,    -3,    eMenu },        // Settings selected
+    { eButton,     0,     eSettings },
+    { eLongButton, 600,   eMenu },
+    { eWait,       500,   eMenu },
+    { eEncoder,    10,    eMenu },        // Dashboard selected (no overflow)
+    { eButton,     0,     eDashboard },
+  };
+  Replay(steps);
+  CHECK(FakeDisplayPage == "Dashboard");
+}
+
+//===============================================================
+// Menu selection after a long press is the state it came from
+//===============================================================
+static void TestMenuSelection()
+{
+  const ReplayStep steps[] =
+  {
+    { eLongButton, 600,   eMenu },
+    { eWait,       500,   eMenu },
+    { eEncoder,    -1,    eMenu },
+    { eButton,     0,     eCleaning },
+    { eLongButton, 600,   eMenu },
+  };
+  Replay(steps);
+  CHECK_EQUAL(eCleaning, FakeDisplayMenuState);
+
+  const ReplayStep back[] =
+  {
+    { eWait,       500,   eMenu },
+    { eEncoder,    1,     eMenu },
+    { eButton,     0,     eDashboard },
+  };
+  Replay(back);
+}
+
+//===============================================================
+// Dashboard: Selecting the liquids by button never restarts a
+// fill level (bottles are only placed on the bar page)
+//===============================================================
+static void TestDashboardKeepsLevels()
+{
+  uint32_t remaining_ml[LiquidCount];
+  for (uint8_t index = 0; index < LiquidCount; index++)
+  {
+    FlowMeter.SetBottle(index, LiquidTable[index].BottleCapacity_ml);
+    FlowMeter.AddFlowTime(index, 5000);
+    remaining_ml[index] = FlowMeter.GetRemaining(index);
+    CHECK(remaining_ml[index] < LiquidTable[index].BottleCapacity_ml);
+  }
+
+  for (uint8_t press = 0; press <= LiquidCount; press++)
+  {
+    Replay({ eButton, 0, eDashboard }, press);
+    Replay({ eWait, SETTINGS_DEBOUNCE_MS, eDashboard }, press);
+  }
+
+  for (uint8_t index = 0; index < LiquidCount; index++)
+  {
+    CHECK_EQUAL(remaining_ml[index], FlowMeter.GetRemaining(index));
+  }
+}
+
+//===============================================================
+// Settings debounce: A second button press within the debounce
+// time is discarded, the main task is not blocked
+//===============================================================
+static void TestSettingsDebounce()
+{
+  const ReplayStep steps[] =
+  {
+    { eLongButton, 600,   eMenu },
+    { eWait,       500,   eMenu },
+    { eEncoder,    -1,    eMenu },
+    { eButton,     0,     eCleaning },
+    { eWait,       500,   eCleaning },
+  };
+  Replay(steps);
+
+  uint32_t drawCount = FakeDisplayDraws["DrawCheckBoxes"];
+  Replay({ eButton, 0, eCleaning }, 0);
+  CHECK_EQUAL(drawCount + 1, FakeDisplayDraws["DrawCheckBoxes"]);
+  Replay({ eButton, 0, eCleaning }, 1);
+  CHECK_EQUAL(drawCount + 1, FakeDisplayDraws["DrawCheckBoxes"]);
+  Replay({ eWait, SETTINGS_DEBOUNCE_MS, eCleaning }, 2);
+  Replay({ eButton, 0, eCleaning }, 3);
+  CHECK_EQUAL(drawCount + 2, FakeDisplayDraws["DrawCheckBoxes"]);
+
+  // A main event with a debounced settings change and a transition returns in time
+  SetButton(true);
+  HostAdvance_ms(10);
+  SetButton(false);
+  uint64_t start_us = HostTime_us;
+  Statemachine.Execute(eMain);
+  CHECK(HostTime_us - start_us < (uint64_t)SETTINGS_DEBOUNCE_MS * 1000);
+
+  SetButton(true);
+  start_us = HostTime_us;
+  RunMainTask(600);
+  SetButton(false);
+  CHECK_EQUAL(eMenu, Statemachine.GetCurrentState());
+  CHECK(HostTime_us - start_us < 700 * 1000);
+
+  const ReplayStep back[] =
+  {
+    { eWait,       500,   eMenu },
+    { eEncoder,    1,     eMenu },
+    { eButton,     0,     eDashboard },
+  };
+  Replay(back);
+}
+
+//===============================================================
+// Screen saver: Entered after the idle timeout, returns to the
+// state before on encoder, button or dispensing lever
+//===============================================================
+static void TestScreenSaver()
+{
+  const ReplayStep steps[] =
+  {
+    { eWait,       SCREENSAVER_TIMEOUT_MS - 1000, eDashboard },
+    { eWait,       1100,  eScreenSaver },
+    { eEncoder,    1,     eDashboard },
+    { eLongButton, 600,   eMenu },
+    { eWait,       SCREENSAVER_TIMEOUT_MS + 100, eScreenSaver },
+    { eButton,     0,     eMenu },
+    { eWait,       500,   eMenu },
+    { eEncoder,    -3,    eMenu },
+    { eButton,     0,     eSettings },
+    { eWait,       SCREENSAVER_TIMEOUT_MS + 100, eScreenSaver },
+    { eLever,      1,     eSettings },
+    { eLever,      0,     eSettings },
+    { eLongButton, 600,   eMenu },
+    { eWait,       500,   eMenu },
+    { eEncoder,    10,    eMenu },
+    { eButton,     0,     eDashboard },
+  };
+  Replay(steps);
+  CHECK(FakeDisplayPage == "Dashboard");
+}
+
+//===============================================================
+// Light sleep: Entered after the sleep timeout, the wake up
+// returns to the state before the screen saver
+//===============================================================
+static void TestLightSleep()
+{
+  uint32_t sleepCount = HostLightSleepCount;
+  const ReplayStep steps[] =
+  {
+    { eWait,       SCREENSAVER_TIMEOUT_MS + 100, eScreenSaver },
+    { eWait,       IDLE_SLEEP_TIMEOUT_MS - SCREENSAVER_TIMEOUT_MS, eDashboard },
+  };
+  Replay(steps);
+  CHECK_EQUAL(sleepCount + 1, HostLightSleepCount);
+  CHECK_EQUAL(eTierActive, Power.GetTier());
+}
+
+//===============================================================
+// Main
+//===============================================================
+int main()
+{
+  // Boot like the setup function
+  HostPinReads[PIN_ENCODER_BUTTON] = HIGH;
+  Settings.Begin();
+  EncoderButton.Begin(PIN_ENCODER_OUTA, PIN_ENCODER_OUTB, PIN_ENCODER_BUTTON);
+  FlowMeter.Load();
+  Pumps.Begin();
+  Statemachine.Begin(PIN_BUZZER);
+  Statemachine.Execute(eEntry);
+  CHECK_EQUAL(eDashboard, Statemachine.GetCurrentState());
+
+  TestMenuNavigation();
+  TestMenuSelection();
+  TestDashboardKeepsLevels();
+  TestSettingsDebounce();
+  TestScreenSaver();
+  TestLightSleep();
+  return TEST_RESULT();
+}
@@ -0,0 +1,64 @@
+/**
+ * Includes the check macros of the host tests
+ *
+ * @author    Florian Staeblein
+ * @date      2024/01/28
+ * @copyright © 2024 Florian Staeblein
+ */
+
+#ifndef TESTHELPER_H
+#define TESTHELPER_H
+
+//===============================================================
+// Includes
+//===============================================================
+#include <stdio.h>
+#include <stdint.h>
+
+
+//===============================================================
+// Global variables
+//===============================================================
+static uint32_t TestFailures = 0;
+static uint32_t TestChecks = 0;
+
+
+//===============================================================
+// Check macros (failures are printed, the test continues)
+//===============================================================
+#define CHECK(condition) \
+  do \
+  { \
+    TestChecks++; \
+    if (!(condition)) \
+    { \
+      if (TestFailures++ < 20) \
+      { \
+        printf("%s:%d: CHECK failed: %s\n", __FILE__, __LINE__, #condition); \
+      } \
+    } \
+  } \
+  while (0)
+
+#define CHECK_EQUAL(expected, actual) \
+  do \
+  { \
+    TestChecks++; \
+    long long expectedValue = (long long)(expected); \
+    long long actualValue = (long long)(actual); \
+    if (expectedValue != actualValue) \
+    { \
+      if (TestFailures++ < 20) \
+      { \
+        printf("%s:%d: CHECK_EQUAL failed: %s = %lld, %s = %lld\n", __FILE__, __LINE__, #expected, expectedValue, #actual, actualValue); \
+      } \
+    } \
+  } \
+  while (0)
+
+// Prints the result and returns the exit code of the test
+#define TEST_RESULT() \
+  (printf("%u checks, %u failures\n", (unsigned)TestChecks, (unsigned)TestFailures), TestFailures == 0 ? 0 : 1)
+
+
+#endif
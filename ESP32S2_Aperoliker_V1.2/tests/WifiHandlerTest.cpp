@@ -0,0 +1,253 @@
+/**
+ * Host test of the wifi handler against the local network backend:
+ * Access point without credentials, provisioning, joining with scan
+ * and with the cached network, moved and missing networks and the
+ * mDNS TXT records
+ *
+ * @author    Florian Staeblein
+ * @date      2024/01/28
+ * @copyright © 2024 Florian Staeblein
+ */
+
+#include "TestHelper.h"
+#include "WifiHandler.h"
+#include "fakes/FakeDisplayDriver.h"
+#include "fakes/LocalNetworkBackend.h"
+
+//===============================================================
+// Defines
+//===============================================================
+#define PIN_ENCODER_OUTA        8
+#define PIN_ENCODER_OUTB        11
+#define PIN_ENCODER_BUTTON      10
+#define PIN_BUZZER              17
+#define LOOP_PERIOD_MS          10    // Loop task period
+
+#define VENUE_SSID              "Venue"
+#define VENUE_PASSWORD          "venue-password"
+#define VENUE_CHANNEL           6
+
+
+//===============================================================
+// Global variables
+//===============================================================
+static LocalNetworkBackend network;
+
+//===============================================================
+// Runs the wifi update of the loop task for a time
+//===============================================================
+static void RunLoopTask(uint32_t time_ms)
+{
+  uint32_t start_ms = millis();
+  while (millis() - start_ms < time_ms)
+  {
+    Wifihandler.Update();
+    HostAdvance_ms(LOOP_PERIOD_MS);
+  }
+}
+
+//===============================================================
+// Returns the station network of the settings store
+//===============================================================
+static int32_t GetSavedChannel(String* ssid = NULL)
+{
+  String savedSsid;
+  String savedPassword;
+  uint8_t bssid[NETWORK_BSSID_LENGTH];
+  int32_t channel = 0;
+  Settings.GetStation(savedSsid, savedPassword, bssid, channel);
+  if (ssid != NULL)
+  {
+    *ssid = savedSsid;
+  }
+  return channel;
+}
+
+//===============================================================
+// Restarts the network in station mode (e.g. after a power cycle)
+//===============================================================
+static void RestartStation()
+{
+  Wifihandler.SetWifiMode(WIFI_MODE_NULL);
+  Wifihandler.SetWifiMode(WIFI_MODE_STA);
+}
+
+//===============================================================
+// Without credentials the mixer opens its access point and
+// announces itself by mDNS
+//===============================================================
+static void TestAccessPointWithoutCredentials()
+{
+  CHECK_EQUAL(WIFI_MODE_AP, Wifihandler.GetWifiMode());
+  CHECK(network.AccessPointSsid == MIXER_NAME);
+  CHECK(Wifihandler.GetLocalIP() == "192.168.1.1");
+
+  // TXT records of the http service
+  String names;
+  for (uint8_t index = 0; index < LiquidCount; index++)
+  {
+    names += (index > 0 ? "," : "") + String(LiquidTable[index].Name);
+  }
+  CHECK(network.DiscoveryHostname == Wifihandler.GetHostname().c_str());
+  CHECK(network.DiscoveryRecords["name"] == MIXER_NAME);
+  CHECK(network.DiscoveryRecords["version"] == APP_VERSION);
+  CHECK(network.DiscoveryRecords["liquids"] == names.c_str());
+  CHECK(network.DiscoveryRecords["state"] == Statemachine.GetCurrentStateName());
+
+  // Web server of the access point
+  AsyncWebServer* server = AsyncWebServer::HostInstance;
+  CHECK(server != NULL);
+  if (server != NULL)
+  {
+    AsyncWebServerRequest page = server->HostRequest(HTTP_GET, "/");
+    CHECK_EQUAL(200, page.HostCode);
+    CHECK(page.HostBody == "<html>Mixer</html>");
+    CHECK_EQUAL(404, server->HostRequest(HTTP_GET, "/missing").HostCode);
+  }
+
+  // Connected clients are the stations of the access point
+  network.AccessPointStations = 3;
+  CHECK_EQUAL(3, Wifihandler.GetConnectedClients());
+  network.AccessPointStations = 0;
+}
+
+//===============================================================
+// Provisioned credentials are applied after the response, the
+// first join scans all channels and caches the network
+//===============================================================
+static void TestProvisioning()
+{
+  AsyncWebServer* server = AsyncWebServer::HostInstance;
+  CHECK(server != NULL);
+  if (server == NULL)
+  {
+    return;
+  }
+
+  // WPA2 limits
+  AsyncWebServerRequest invalid = server->HostRequest(HTTP_POST, "/provision", { { "ssid", VENUE_SSID, true }, { "password", "short", true } });
+  CHECK_EQUAL(400, invalid.HostCode);
+  AsyncWebServerRequest valid = server->HostRequest(HTTP_POST, "/provision", { { "ssid", VENUE_SSID, true }, { "password", VENUE_PASSWORD, true } });
+  CHECK_EQUAL(200, valid.HostCode);
+
+  // The response is sent before the network changes
+  RunLoopTask(STA_PROVISION_DELAY_MS / 2);
+  CHECK_EQUAL(WIFI_MODE_AP, Wifihandler.GetWifiMode());
+  RunLoopTask(STA_PROVISION_DELAY_MS);
+  CHECK_EQUAL(WIFI_MODE_STA, Wifihandler.GetWifiMode());
+  CHECK(network.AccessPointSsid.empty());
+  CHECK_EQUAL(1, network.ScanJoins);
+  CHECK_EQUAL(0, network.CachedJoins);
+
+  // Joined after the scan, the network is cached
+  String ssid;
+  CHECK_EQUAL(0, GetSavedChannel(&ssid));
+  CHECK(ssid == VENUE_SSID);
+  RunLoopTask(LOCAL_JOIN_SCAN_MS + 100);
+  CHECK(network.IsStationConnected());
+  CHECK(Wifihandler.GetLocalIP() == "10.0.0.23");
+  CHECK_EQUAL(VENUE_CHANNEL, GetSavedChannel());
+  CHECK(network.DiscoveryRecords["name"] == MIXER_NAME);
+  CHECK(AsyncWebServer::HostInstance != NULL);
+}
+
+//===============================================================
+// Later joins use the cached network without a scan
+//===============================================================
+static void TestFastReconnect()
+{
+  RestartStation();
+  CHECK_EQUAL(1, network.CachedJoins);
+  CHECK_EQUAL(1, network.ScanJoins);
+  RunLoopTask(LOCAL_JOIN_CACHED_MS + 100);
+  CHECK(network.IsStationConnected());
+  CHECK_EQUAL(WIFI_MODE_STA, Wifihandler.GetWifiMode());
+}
+
+//===============================================================
+// A moved access point (other channel) is found by a scan after
+// the fast connect timeout and cached again
+//===============================================================
+static void TestCachedNetworkMoved()
+{
+  network.AccessPoints[0].Channel = 11;
+  RestartStation();
+  CHECK_EQUAL(2, network.CachedJoins);
+  RunLoopTask(STA_FAST_CONNECT_TIMEOUT_MS - 100);
+  CHECK(!network.IsStationConnected());
+  CHECK_EQUAL(1, network.ScanJoins);
+
+  RunLoopTask(200 + LOCAL_JOIN_SCAN_MS + 100);
+  CHECK_EQUAL(2, network.ScanJoins);
+  CHECK(network.IsStationConnected());
+  CHECK_EQUAL(11, GetSavedChannel());
+  CHECK_EQUAL(WIFI_MODE_STA, Wifihandler.GetWifiMode());
+}
+
+//===============================================================
+// A missing network opens the access point for new credentials
+//===============================================================
+static void TestFallbackToAccessPoint()
+{
+  network.AccessPoints.clear();
+  RestartStation();
+  RunLoopTask(STA_CONNECT_TIMEOUT_MS - 100);
+  CHECK_EQUAL(WIFI_MODE_STA, Wifihandler.GetWifiMode());
+
+  RunLoopTask(200);
+  CHECK_EQUAL(WIFI_MODE_AP, Wifihandler.GetWifiMode());
+  CHECK(network.AccessPointSsid == MIXER_NAME);
+  CHECK(AsyncWebServer::HostInstance != NULL);
+}
+
+//===============================================================
+// State changes update the state record, nothing else is
+// announced again
+//===============================================================
+static void TestDiscoveryState()
+{
+  RunLoopTask(100);
+  uint32_t updates = network.DiscoveryRecordUpdates;
+  RunLoopTask(1000);
+  CHECK_EQUAL(updates, network.DiscoveryRecordUpdates);
+
+  // Long button press opens the menu
+  HostPinReads[PIN_ENCODER_BUTTON] = LOW;
+  EncoderButton.ButtonEvent();
+  HostAdvance_ms(MINIMUMLONGTIMEPRESS_MS + 100);
+  Statemachine.Execute(eMain);
+  CHECK_EQUAL(eMenu, Statemachine.GetCurrentState());
+
+  RunLoopTask(100);
+  CHECK_EQUAL(updates + 1, network.DiscoveryRecordUpdates);
+  CHECK(network.DiscoveryRecords["state"] == Statemachine.GetCurrentStateName());
+}
+
+//===============================================================
+// Main
+//===============================================================
+int main()
+{
+  // Boot like the setup function (wifi enabled without credentials)
+  HostPinReads[PIN_ENCODER_BUTTON] = HIGH;
+  SPIFFS.open("/index.html", FILE_WRITE).write((const uint8_t*)"<html>Mixer</html>", 18);
+  Settings.Begin();
+  Settings.SetWifiMode(true);
+  EncoderButton.Begin(PIN_ENCODER_OUTA, PIN_ENCODER_OUTB, PIN_ENCODER_BUTTON);
+  FlowMeter.Load();
+  Pumps.Begin();
+  Statemachine.Begin(PIN_BUZZER);
+  Statemachine.Execute(eEntry);
+
+  network.AccessPoints.push_back({ VENUE_SSID, VENUE_PASSWORD, { 0x24, 0x0A, 0xC4, 0x12, 0x34, 0x56 }, VENUE_CHANNEL });
+  Wifihandler.SetNetworkBackend(&network);
+  Wifihandler.Begin();
+
+  TestAccessPointWithoutCredentials();
+  TestProvisioning();
+  TestFastReconnect();
+  TestCachedNetworkMoved();
+  TestFallbackToAccessPoint();
+  TestDiscoveryState();
+  return TEST_RESULT();
+}
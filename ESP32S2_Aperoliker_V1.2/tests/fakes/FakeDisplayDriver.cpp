@@ -0,0 +1,197 @@
+/**
+ * Includes the fake display driver of the host tests: Records
+ * the shown pages and draw calls instead of drawing
+ *
+ * @author    Florian Staeblein
+ * @date      2024/01/28
+ * @copyright © 2024 Florian Staeblein
+ */
+
+#include "FakeDisplayDriver.h"
+
+//===============================================================
+// Global variables
+//===============================================================
+DisplayDriver Display;
+std::string FakeDisplayPage;
+std::map<std::string, uint32_t> FakeDisplayDraws;
+MixerState FakeDisplayMenuState = eDashboard;
+MixtureLiquid FakeDisplayDashboardLiquid = eLiquid1;
+
+//===============================================================
+// Members of the display driver (image reader and text renderer
+// are not used)
+//===============================================================
+SPIFFSImageReader::SPIFFSImageReader()
+{
+}
+
+SPIFFSImageReader::~SPIFFSImageReader()
+{
+}
+
+TextRenderer::TextRenderer()
+{
+}
+
+DisplayDriver::DisplayDriver()
+{
+}
+
+//===============================================================
+// Initialization
+//===============================================================
+void DisplayDriver::Begin(Adafruit_ST7789* tft, bool spiffsAvailable)
+{
+}
+
+void DisplayDriver::LoadImages(bool spiffsAvailable)
+{
+}
+
+void DisplayDriver::ReleaseIntroImages()
+{
+}
+
+void DisplayDriver::SetSleep(bool enable)
+{
+}
+
+//===============================================================
+// Values set by the state machine
+//===============================================================
+void DisplayDriver::SetMenuState(MixerState state)
+{
+  FakeDisplayMenuState = state;
+}
+
+void DisplayDriver::SetDashboardLiquid(MixtureLiquid liquid)
+{
+  FakeDisplayDashboardLiquid = liquid;
+}
+
+void DisplayDriver::SetCleaningLiquid(MixtureLiquid liquid)
+{
+}
+
+void DisplayDriver::SetAngles(const int16_t liquidAngles_Degrees[LiquidCount])
+{
+}
+
+void DisplayDriver::SetShares(const MixtureShare liquidShares[LiquidCount])
+{
+}
+
+void DisplayDriver::SetBarStock(const BarBottle barBottles[LiquidCount])
+{
+}
+
+void DisplayDriver::SetSpritzerPercentages(const int16_t spritzerPercentages[LiquidCount])
+{
+}
+
+//===============================================================
+// Pages (the name of the last shown page is recorded)
+//===============================================================
+void DisplayDriver::ShowIntroPage()
+{
+  FakeDisplayPage = "Intro";
+}
+
+void DisplayDriver::ShowHelpPage()
+{
+  FakeDisplayPage = "Help";
+}
+
+void DisplayDriver::ShowMenuPage()
+{
+  FakeDisplayPage = "Menu";
+}
+
+void DisplayDriver::ShowDashboardPage()
+{
+  FakeDisplayPage = "Dashboard";
+}
+
+void DisplayDriver::ShowCleaningPage()
+{
+  FakeDisplayPage = "Cleaning";
+}
+
+void DisplayDriver::ShowBarPage()
+{
+  FakeDisplayPage = "Bar";
+}
+
+void DisplayDriver::ShowSettingsPage()
+{
+  FakeDisplayPage = "Settings";
+}
+
+void DisplayDriver::ShowScreenSaverPage()
+{
+  FakeDisplayPage = "ScreenSaver";
+}
+
+//===============================================================
+// Partial updates (the calls are counted)
+//===============================================================
+void DisplayDriver::DrawWifiIcons(bool isfullUpdate)
+{
+  FakeDisplayDraws["DrawWifiIcons"]++;
+}
+
+void DisplayDriver::DrawInfoBox(const String &line1, const String &line2)
+{
+  FakeDisplayDraws["DrawInfoBox"]++;
+}
+
+void DisplayDriver::DrawLevelWarning(bool isfullUpdate)
+{
+  FakeDisplayDraws["DrawLevelWarning"]++;
+}
+
+void DisplayDriver::DrawMenu(bool isfullUpdate)
+{
+  FakeDisplayDraws["DrawMenu"]++;
+}
+
+void DisplayDriver::DrawCheckBoxes(MixtureLiquid liquid)
+{
+  FakeDisplayDraws["DrawCheckBoxes"]++;
+}
+
+void DisplayDriver::DrawBar(bool isDashboard, bool isfullUpdate)
+{
+  FakeDisplayDraws["DrawBar"]++;
+}
+
+void DisplayDriver::DrawLegend()
+{
+  FakeDisplayDraws["DrawLegend"]++;
+}
+
+void DisplayDriver::DrawCurrentValues(bool isfullUpdate)
+{
+  FakeDisplayDraws["DrawCurrentValues"]++;
+}
+
+void DisplayDriver::DrawDoughnutChart(bool isfullUpdate)
+{
+  FakeDisplayDraws["DrawDoughnutChart"]++;
+}
+
+void DisplayDriver::DrawSettings(bool isfullUpdate)
+{
+  FakeDisplayDraws["DrawSettings"]++;
+}
+
+void DisplayDriver::DrawScreenSaver()
+{
+  FakeDisplayDraws["DrawScreenSaver"]++;
+}
+
+String DisplayDriver::GetScreenSaverString()
+{
+  return String();
+}
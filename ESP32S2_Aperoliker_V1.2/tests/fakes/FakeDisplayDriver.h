@@ -0,0 +1,35 @@
+/**
+ * Includes the fake display driver of the host tests: Records
+ * the shown pages and draw calls instead of drawing
+ *
+ * @author    Florian Staeblein
+ * @date      2024/01/28
+ * @copyright © 2024 Florian Staeblein
+ */
+
+#ifndef FAKEDISPLAYDRIVER_H
+#define FAKEDISPLAYDRIVER_H
+
+//===============================================================
+// Includes
+//===============================================================
+#include <map>
+#include <string>
+#include "DisplayDriver.h"
+
+
+//===============================================================
+// Global variables
+//===============================================================
+// Name of the last shown page (e.g. "Menu")
+extern std::string FakeDisplayPage;
+
+// Count of calls per draw function (e.g. "DrawBar")
+extern std::map<std::string, uint32_t> FakeDisplayDraws;
+
+// Last values set by the state machine
+extern MixerState FakeDisplayMenuState;
+extern MixtureLiquid FakeDisplayDashboardLiquid;
+
+
+#endif
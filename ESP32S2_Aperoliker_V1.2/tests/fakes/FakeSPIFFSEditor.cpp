@@ -0,0 +1,31 @@
+/**
+ * Includes the fake SPIFFS editor of the host tests: Handles no
+ * request (the editor page is not part of the tests)
+ *
+ * @author    Florian Staeblein
+ * @date      2024/01/28
+ * @copyright © 2024 Florian Staeblein
+ */
+
+#include "SPIFFSEditor.h"
+
+//===============================================================
+// Members of the SPIFFS editor
+//===============================================================
+SPIFFSEditor::SPIFFSEditor() :
+  _startTime(0)
+{
+}
+
+bool SPIFFSEditor::canHandle(AsyncWebServerRequest *request)
+{
+  return false;
+}
+
+void SPIFFSEditor::handleRequest(AsyncWebServerRequest *request)
+{
+}
+
+void SPIFFSEditor::handleUpload(AsyncWebServerRequest *request, const String& filename, size_t index, uint8_t *data, size_t len, bool final)
+{
+}
@@ -0,0 +1,37 @@
+/**
+ * Includes the fake system helper of the host tests: Fixed system
+ * information instead of the chip registers
+ *
+ * @author    Florian Staeblein
+ * @date      2024/01/28
+ * @copyright © 2024 Florian Staeblein
+ */
+
+#include "SystemHelper.h"
+
+//===============================================================
+// System information of the host
+//===============================================================
+String GetSystemInfoString()
+{
+  return "Host test";
+}
+
+String GetMemoryInfoString(bool allOrDynamic)
+{
+  return "Heap: " + String(ESP.getFreeHeap()) + " bytes free";
+}
+
+String WifiPowerToString(wifi_power_t power)
+{
+  return String((int)power);
+}
+
+String GetResetReasonString(int cpu)
+{
+  return "POWERON_RESET";
+}
+
+void LogBootPhase(const char* phase, uint32_t start_ms)
+{
+}
@@ -0,0 +1,128 @@
+/**
+ * Includes the local network backend of the host tests
+ *
+ * @author    Florian Staeblein
+ * @date      2024/01/28
+ * @copyright © 2024 Florian Staeblein
+ */
+
+#include "LocalNetworkBackend.h"
+
+//===============================================================
+// Starts an access point
+//===============================================================
+bool LocalNetworkBackend::StartAccessPoint(const char* ssid, const char* password)
+{
+  _joinIndex = -1;
+  AccessPointSsid = ssid;
+  return true;
+}
+
+//===============================================================
+// Starts joining a network: With cached BSSID and channel only
+// the cached access point is tried, otherwise all channels are
+// scanned for the SSID
+//===============================================================
+bool LocalNetworkBackend::StartStation(const char* hostname, const char* ssid, const char* password, const uint8_t* bssid, int32_t channel)
+{
+  AccessPointSsid.clear();
+  _joinIndex = -1;
+  _joinStart_ms = millis();
+  _joinTime_ms = (bssid != NULL) ? LOCAL_JOIN_CACHED_MS : LOCAL_JOIN_SCAN_MS;
+  (bssid != NULL) ? CachedJoins++ : ScanJoins++;
+
+  for (size_t index = 0; index < AccessPoints.size(); index++)
+  {
+    const LocalAccessPoint& accessPoint = AccessPoints[index];
+    if (accessPoint.Ssid == ssid &&
+      accessPoint.Password == password &&
+      (bssid == NULL || (accessPoint.Channel == channel && memcmp(accessPoint.Bssid, bssid, NETWORK_BSSID_LENGTH) == 0)))
+    {
+      _joinIndex = (int16_t)index;
+      break;
+    }
+  }
+  return true;
+}
+
+//===============================================================
+// Stops access point and station
+//===============================================================
+void LocalNetworkBackend::Stop()
+{
+  AccessPointSsid.clear();
+  _joinIndex = -1;
+}
+
+//===============================================================
+// Returns true, if the join time has passed and the access point
+// is still in range
+//===============================================================
+bool LocalNetworkBackend::IsStationConnected()
+{
+  return _joinIndex >= 0 &&
+    (size_t)_joinIndex < AccessPoints.size() &&
+    (millis() - _joinStart_ms) >= _joinTime_ms;
+}
+
+//===============================================================
+// Returns BSSID and channel of the joined network
+//===============================================================
+bool LocalNetworkBackend::GetStationNetwork(uint8_t bssid[NETWORK_BSSID_LENGTH], int32_t& channel)
+{
+  if (!IsStationConnected())
+  {
+    return false;
+  }
+  memcpy(bssid, AccessPoints[_joinIndex].Bssid, NETWORK_BSSID_LENGTH);
+  channel = AccessPoints[_joinIndex].Channel;
+  return true;
+}
+
+//===============================================================
+// Returns the local IP address
+//===============================================================
+String LocalNetworkBackend::GetLocalIP()
+{
+  if (!AccessPointSsid.empty())
+  {
+    return "192.168.1.1";
+  }
+  return IsStationConnected() ? "10.0.0.23" : "0.0.0.0";
+}
+
+//===============================================================
+// Returns the amount of stations connected to the access point
+//===============================================================
+uint16_t LocalNetworkBackend::GetAccessPointStations()
+{
+  return AccessPointSsid.empty() ? 0 : AccessPointStations;
+}
+
+//===============================================================
+// Starts the mDNS responder
+//===============================================================
+bool LocalNetworkBackend::StartDiscovery(const char* hostname, uint16_t port)
+{
+  DiscoveryHostname = hostname;
+  DiscoveryRecords.clear();
+  return true;
+}
+
+//===============================================================
+// Adds or replaces a TXT record
+//===============================================================
+void LocalNetworkBackend::SetDiscoveryRecord(const char* key, const String& value)
+{
+  DiscoveryRecords[key] = value.c_str();
+  DiscoveryRecordUpdates++;
+}
+
+//===============================================================
+// Stops the mDNS responder
+//===============================================================
+void LocalNetworkBackend::StopDiscovery()
+{
+  DiscoveryHostname.clear();
+  DiscoveryRecords.clear();
+}
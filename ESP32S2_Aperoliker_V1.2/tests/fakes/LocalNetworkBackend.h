@@ -0,0 +1,84 @@
+/**
+ * Includes the local network backend of the host tests: Access
+ * points in range, joining with and without cached network, and
+ * the mDNS TXT records, without a radio
+ *
+ * @author    Florian Staeblein
+ * @date      2024/01/28
+ * @copyright © 2024 Florian Staeblein
+ */
+
+#ifndef LOCALNETWORKBACKEND_H
+#define LOCALNETWORKBACKEND_H
+
+//===============================================================
+// Includes
+//===============================================================
+#include <map>
+#include <string>
+#include <vector>
+#include "NetworkBackend.h"
+
+
+//===============================================================
+// Defines
+//===============================================================
+#define LOCAL_JOIN_CACHED_MS      300     // Join time with cached BSSID and channel
+#define LOCAL_JOIN_SCAN_MS        2500    // Join time with a scan of all channels
+
+
+//===============================================================
+// Access point in range of the local network
+//===============================================================
+struct LocalAccessPoint
+{
+  std::string Ssid;
+  std::string Password;
+  uint8_t Bssid[NETWORK_BSSID_LENGTH];
+  int32_t Channel;
+};
+
+//===============================================================
+// Local network backend
+//===============================================================
+class LocalNetworkBackend : public NetworkBackend
+{
+  public:
+    bool StartAccessPoint(const char* ssid, const char* password) override;
+    bool StartStation(const char* hostname, const char* ssid, const char* password, const uint8_t* bssid, int32_t channel) override;
+    void Stop() override;
+    bool IsStationConnected() override;
+    bool GetStationNetwork(uint8_t bssid[NETWORK_BSSID_LENGTH], int32_t& channel) override;
+    String GetLocalIP() override;
+    uint16_t GetAccessPointStations() override;
+    bool StartDiscovery(const char* hostname, uint16_t port) override;
+    void SetDiscoveryRecord(const char* key, const String& value) override;
+    void StopDiscovery() override;
+
+    // Access points in range (changed by the tests, e.g. moved to another channel)
+    std::vector<LocalAccessPoint> AccessPoints;
+
+    // Stations connected to the own access point
+    uint16_t AccessPointStations = 0;
+
+    // Started access point (empty if not started)
+    std::string AccessPointSsid;
+
+    // Station join attempts (with cached network and with scan)
+    uint32_t CachedJoins = 0;
+    uint32_t ScanJoins = 0;
+
+    // Discovery host name and TXT records (empty if not started)
+    std::string DiscoveryHostname;
+    std::map<std::string, std::string> DiscoveryRecords;
+    uint32_t DiscoveryRecordUpdates = 0;
+
+  private:
+    // Joined access point (-1 -> none) and end of the join
+    int16_t _joinIndex = -1;
+    uint32_t _joinStart_ms = 0;
+    uint32_t _joinTime_ms = 0;
+};
+
+
+#endif
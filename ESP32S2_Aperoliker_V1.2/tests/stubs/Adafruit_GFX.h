@@ -0,0 +1,53 @@
+/**
+ * Includes the host stand-in of the Adafruit graphics library (tests only)
+ *
+ * @author    Florian Staeblein
+ * @date      2024/01/28
+ * @copyright © 2024 Florian Staeblein
+ */
+
+#ifndef HOST_ADAFRUIT_GFX_H
+#define HOST_ADAFRUIT_GFX_H
+
+#include <Arduino.h>
+
+// Sizes only, the display is replaced by a fake in the host tests
+typedef struct
+{
+  uint16_t bitmapOffset;
+  uint8_t width;
+  uint8_t height;
+  uint8_t xAdvance;
+  int8_t xOffset;
+  int8_t yOffset;
+} GFXglyph;
+
+typedef struct
+{
+  uint8_t* bitmap;
+  GFXglyph* glyph;
+  uint16_t first;
+  uint16_t last;
+  uint8_t yAdvance;
+} GFXfont;
+
+class Adafruit_GFX
+{
+  public:
+    Adafruit_GFX(int16_t width, int16_t height) : _width(width), _height(height) {}
+    virtual ~Adafruit_GFX() {}
+    int16_t width() const { return _width; }
+    int16_t height() const { return _height; }
+
+  protected:
+    int16_t _width;
+    int16_t _height;
+};
+
+class GFXcanvas16 : public Adafruit_GFX
+{
+  public:
+    GFXcanvas16(uint16_t width, uint16_t height) : Adafruit_GFX(width, height) {}
+};
+
+#endif
@@ -0,0 +1,18 @@
+/**
+ * Includes the host stand-in of the Adafruit SPI display base class (tests only)
+ *
+ * @author    Florian Staeblein
+ * @date      2024/01/28
+ * @copyright © 2024 Florian Staeblein
+ */
+
+#ifndef HOST_ADAFRUIT_SPITFT_H
+#define HOST_ADAFRUIT_SPITFT_H
+
+#include <Adafruit_GFX.h>
+#include <SPI.h>
+
+// Types only, the display is replaced by a fake in the host tests
+class Adafruit_SPITFT;
+
+#endif
@@ -0,0 +1,18 @@
+/**
+ * Includes the host stand-in of the ST7789 display (tests only)
+ *
+ * @author    Florian Staeblein
+ * @date      2024/01/28
+ * @copyright © 2024 Florian Staeblein
+ */
+
+#ifndef HOST_ADAFRUIT_ST7789_H
+#define HOST_ADAFRUIT_ST7789_H
+
+#include <Adafruit_ST77xx.h>
+#include <Adafruit_SPITFT.h>
+
+// Types only, the display is replaced by a fake in the host tests
+class Adafruit_ST7789;
+
+#endif
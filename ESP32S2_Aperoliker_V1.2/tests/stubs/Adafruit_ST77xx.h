@@ -0,0 +1,22 @@
+/**
+ * Includes the host stand-in of the display colors (tests only)
+ *
+ * @author    Florian Staeblein
+ * @date      2024/01/28
+ * @copyright © 2024 Florian Staeblein
+ */
+
+#ifndef HOST_ADAFRUIT_ST77XX_H
+#define HOST_ADAFRUIT_ST77XX_H
+
+#define ST77XX_BLACK      0x0000
+#define ST77XX_WHITE      0xFFFF
+#define ST77XX_RED        0xF800
+#define ST77XX_GREEN      0x07E0
+#define ST77XX_BLUE       0x001F
+#define ST77XX_CYAN       0x07FF
+#define ST77XX_MAGENTA    0xF81F
+#define ST77XX_YELLOW     0xFFE0
+#define ST77XX_ORANGE     0xFC00
+
+#endif
@@ -0,0 +1,281 @@
+/**
+ * Includes the host stand-in of the Arduino core (tests only)
+ *
+ * @author    Florian Staeblein
+ * @date      2024/01/28
+ * @copyright © 2024 Florian Staeblein
+ */
+
+#include <Arduino.h>
+#include <stdarg.h>
+
+//===============================================================
+// Global variables
+//===============================================================
+HardwareSerial Serial;
+EspClass ESP;
+uint64_t HostTime_us = 1000000;
+uint8_t HostPinModes[64] = {};
+uint8_t HostPinWrites[64] = {};
+uint8_t HostPinReads[64] = {};
+
+// Attached interrupts and pin listeners
+struct HostInterrupt
+{
+  void (*Handler)(void);
+  void (*HandlerArg)(void*);
+  void* Argument;
+  int Mode;
+};
+static HostInterrupt hostInterrupts[64] = {};
+static void (*hostPinListeners[8])(uint8_t pin, uint8_t level) = {};
+
+//===============================================================
+// String conversions
+//===============================================================
+std::string String::FromInteger(long long value, unsigned char base)
+{
+  if (value < 0 && base == DEC)
+  {
+    return "-" + FromUnsigned((unsigned long long)(-value), base);
+  }
+  return FromUnsigned((unsigned long long)value, base);
+}
+
+std::string String::FromUnsigned(unsigned long long value, unsigned char base)
+{
+  const char* digits = "0123456789ABCDEF";
+  std::string text;
+  do
+  {
+    text.insert(text.begin(), digits[value % base]);
+    value /= base;
+  }
+  while (value > 0);
+  return text;
+}
+
+std::string String::FromDouble(double value, unsigned int decimalPlaces)
+{
+  char output[64];
+  snprintf(output, sizeof(output), "%.*f", (int)decimalPlaces, value);
+  return output;
+}
+
+void String::replace(const String& from, const String& to)
+{
+  if (from._text.empty())
+  {
+    return;
+  }
+  size_t position = 0;
+  while ((position = _text.find(from._text, position)) != std::string::npos)
+  {
+    _text.replace(position, from._text.size(), to._text);
+    position += to._text.size();
+  }
+}
+
+//===============================================================
+// Serial output
+//===============================================================
+size_t Print::write(const uint8_t* buffer, size_t size)
+{
+  for (size_t index = 0; index < size; index++)
+  {
+    write(buffer[index]);
+  }
+  return size;
+}
+
+size_t Print::printf(const char* format, ...)
+{
+  char output[256];
+  va_list arguments;
+  va_start(arguments, format);
+  int length = vsnprintf(output, sizeof(output), format, arguments);
+  va_end(arguments);
+  return print(output) * (length >= 0);
+}
+
+size_t HardwareSerial::write(uint8_t value)
+{
+  if (IsEnabled)
+  {
+    fputc(value, stdout);
+  }
+  return 1;
+}
+
+//===============================================================
+// Host time
+//===============================================================
+void HostAdvance_ms(uint32_t time_ms)
+{
+  HostTime_us += (uint64_t)time_ms * 1000;
+}
+
+uint32_t millis()
+{
+  return (uint32_t)(HostTime_us / 1000);
+}
+
+uint32_t micros()
+{
+  return (uint32_t)HostTime_us;
+}
+
+int64_t esp_timer_get_time()
+{
+  return (int64_t)HostTime_us;
+}
+
+void delay(uint32_t time_ms)
+{
+  HostAdvance_ms(time_ms);
+}
+
+void delayMicroseconds(uint32_t time_us)
+{
+  HostTime_us += time_us;
+}
+
+void yield()
+{
+}
+
+//===============================================================
+// Host pins
+//===============================================================
+void pinMode(uint8_t pin, uint8_t mode)
+{
+  HostPinModes[pin & 63] = mode;
+}
+
+void digitalWrite(uint8_t pin, uint8_t value)
+{
+  HostPinWrites[pin & 63] = value;
+}
+
+int digitalRead(uint8_t pin)
+{
+  return HostPinReads[pin & 63];
+}
+
+int digitalPinToInterrupt(int pin)
+{
+  return pin;
+}
+
+void attachInterrupt(uint8_t pin, void (*handler)(void), int mode)
+{
+  hostInterrupts[pin & 63] = { handler, NULL, NULL, mode };
+}
+
+void attachInterruptArg(uint8_t pin, void (*handler)(void*), void* argument, int mode)
+{
+  hostInterrupts[pin & 63] = { NULL, handler, argument, mode };
+}
+
+void detachInterrupt(uint8_t pin)
+{
+  hostInterrupts[pin & 63] = {};
+}
+
+void HostSetPin(uint8_t pin, uint8_t level)
+{
+  pin &= 63;
+  if (HostPinReads[pin] == level)
+  {
+    return;
+  }
+  HostPinReads[pin] = level;
+
+  // Interrupt of the edge
+  const HostInterrupt& interrupt = hostInterrupts[pin];
+  if (interrupt.Mode == CHANGE ||
+    (interrupt.Mode == RISING && level) ||
+    (interrupt.Mode == FALLING && !level))
+  {
+    if (interrupt.Handler != NULL)
+    {
+      interrupt.Handler();
+    }
+    if (interrupt.HandlerArg != NULL)
+    {
+      interrupt.HandlerArg(interrupt.Argument);
+    }
+  }
+
+  // Peripheral stand-ins
+  for (auto listener : hostPinListeners)
+  {
+    if (listener != NULL)
+    {
+      listener(pin, level);
+    }
+  }
+}
+
+void HostAddPinListener(void (*listener)(uint8_t pin, uint8_t level))
+{
+  for (auto& entry : hostPinListeners)
+  {
+    if (entry == NULL || entry == listener)
+    {
+      entry = listener;
+      return;
+    }
+  }
+}
+
+void tone(uint8_t, unsigned int, unsigned long)
+{
+}
+
+void noTone(uint8_t)
+{
+}
+
+long random(long maximum)
+{
+  return maximum > 0 ? rand() % maximum : 0;
+}
+
+long random(long minimum, long maximum)
+{
+  return minimum + random(maximum - minimum);
+}
+
+void randomSeed(unsigned long seed)
+{
+  srand((unsigned int)seed);
+}
+
+bool psramFound()
+{
+  return false;
+}
+
+void* ps_malloc(size_t size)
+{
+  return malloc(size);
+}
+
+//===============================================================
+// Host heap
+//===============================================================
+uint32_t EspClass::getFreeHeap()
+{
+  return HostFreeHeap ? HostFreeHeap() : 200000;
+}
+
+uint32_t EspClass::getMinFreeHeap()
+{
+  return 200000;
+}
+
+uint32_t EspClass::getMaxAllocHeap()
+{
+  return 100000;
+}
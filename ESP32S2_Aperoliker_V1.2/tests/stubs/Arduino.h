@@ -0,0 +1,216 @@
+/**
+ * Includes the host stand-in of the Arduino core (tests only)
+ *
+ * @author    Florian Staeblein
+ * @date      2024/01/28
+ * @copyright © 2024 Florian Staeblein
+ */
+
+#ifndef HOST_ARDUINO_H
+#define HOST_ARDUINO_H
+
+//===============================================================
+// Includes
+//===============================================================
+#include <stdint.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <math.h>
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <string>
+#include "esp_attr.h"
+#include "freertos/FreeRTOS.h"
+
+
+//===============================================================
+// Defines
+//===============================================================
+#define PROGMEM
+#define HIGH              1
+#define LOW               0
+#define INPUT             1
+#define OUTPUT            3
+#define INPUT_PULLUP      5
+#define CHANGE            3
+#define FALLING           2
+#define RISING            1
+#define DEC               10
+#define HEX               16
+#define F(x)              (x)
+
+#define constrain(amt, low, high) ((amt) < (low) ? (low) : ((amt) > (high) ? (high) : (amt)))
+#define pgm_read_byte(addr) (*(const unsigned char*)(addr))
+
+using std::min;
+using std::max;
+typedef bool boolean;
+typedef uint8_t byte;
+
+
+//===============================================================
+// String with the Arduino interface (backed by std::string)
+//===============================================================
+class String
+{
+  public:
+    String(const char* text = "") : _text(text ? text : "") {}
+    String(const std::string& text) : _text(text) {}
+    String(char value) : _text(1, value) {}
+    String(unsigned char value, unsigned char base = DEC) : _text(FromUnsigned(value, base)) {}
+    String(int value, unsigned char base = DEC) : _text(FromInteger((long long)value, base)) {}
+    String(unsigned int value, unsigned char base = DEC) : _text(FromUnsigned(value, base)) {}
+    String(long value, unsigned char base = DEC) : _text(FromInteger(value, base)) {}
+    String(unsigned long value, unsigned char base = DEC) : _text(FromUnsigned(value, base)) {}
+    String(long long value, unsigned char base = DEC) : _text(FromInteger(value, base)) {}
+    String(unsigned long long value, unsigned char base = DEC) : _text(FromUnsigned(value, base)) {}
+    String(float value, unsigned int decimalPlaces = 2) : _text(FromDouble(value, decimalPlaces)) {}
+    String(double value, unsigned int decimalPlaces = 2) : _text(FromDouble(value, decimalPlaces)) {}
+
+    String& operator+=(const String& text) { _text += text._text; return *this; }
+    String& operator+=(const char* text) { _text += text; return *this; }
+    String& operator+=(char value) { _text += value; return *this; }
+    template <typename T> String& operator+=(T value) { _text += String(value)._text; return *this; }
+
+    friend String operator+(const String& left, const String& right) { return String(left._text + right._text); }
+    friend String operator+(const String& left, const char* right) { return String(left._text + right); }
+    friend String operator+(const char* left, const String& right) { return String(std::string(left) + right._text); }
+    friend String operator+(const String& left, char right) { return String(left._text + right); }
+    template <typename T> friend String operator+(const String& left, T right) { return left + String(right); }
+
+    bool operator==(const String& text) const { return _text == text._text; }
+    bool operator!=(const String& text) const { return _text != text._text; }
+    bool operator==(const char* text) const { return _text == text; }
+    bool operator!=(const char* text) const { return _text != text; }
+    bool operator<(const String& text) const { return _text < text._text; }
+    char operator[](unsigned int index) const { return index < _text.size() ? _text[index] : 0; }
+    char& operator[](unsigned int index) { return _text[index]; }
+
+    const char* c_str() const { return _text.c_str(); }
+    unsigned int length() const { return (unsigned int)_text.size(); }
+    bool isEmpty() const { return _text.empty(); }
+    bool reserve(unsigned int size) { _text.reserve(size); return true; }
+    bool concat(const String& text) { _text += text._text; return true; }
+    bool concat(const char* text, unsigned int length) { _text.append(text, length); return true; }
+    bool equals(const String& text) const { return _text == text._text; }
+    bool startsWith(const String& text) const { return _text.compare(0, text._text.size(), text._text) == 0; }
+    bool endsWith(const String& text) const { return _text.size() >= text._text.size() && _text.compare(_text.size() - text._text.size(), text._text.size(), text._text) == 0; }
+    int indexOf(char value, unsigned int start = 0) const { return ToIndex(_text.find(value, start)); }
+    int indexOf(const String& text, unsigned int start = 0) const { return ToIndex(_text.find(text._text, start)); }
+    int lastIndexOf(char value) const { return ToIndex(_text.rfind(value)); }
+    String substring(unsigned int start) const { return start < _text.size() ? String(_text.substr(start)) : String(); }
+    String substring(unsigned int start, unsigned int end) const { return (start < end && start < _text.size()) ? String(_text.substr(start, end - start)) : String(); }
+    long toInt() const { return strtol(_text.c_str(), NULL, 10); }
+    float toFloat() const { return strtof(_text.c_str(), NULL); }
+    void toLowerCase() { for (char& value : _text) value = (char)tolower(value); }
+    void toUpperCase() { for (char& value : _text) value = (char)toupper(value); }
+    void trim() { _text.erase(0, _text.find_first_not_of(" \t\r\n")); _text.erase(_text.find_last_not_of(" \t\r\n") + 1); }
+    void replace(const String& from, const String& to);
+    explicit operator bool() const { return true; }
+
+  private:
+    std::string _text;
+
+    static int ToIndex(size_t position) { return position == std::string::npos ? -1 : (int)position; }
+    static std::string FromInteger(long long value, unsigned char base);
+    static std::string FromUnsigned(unsigned long long value, unsigned char base);
+    static std::string FromDouble(double value, unsigned int decimalPlaces);
+};
+
+
+//===============================================================
+// Serial output (written to stdout only if enabled by a test)
+//===============================================================
+class Print
+{
+  public:
+    virtual ~Print() {}
+    virtual size_t write(uint8_t value) = 0;
+    virtual size_t write(const uint8_t* buffer, size_t size);
+    size_t print(const String& text) { return write((const uint8_t*)text.c_str(), text.length()); }
+    size_t print(const char* text) { return print(String(text)); }
+    template <typename T> size_t print(T value) { return print(String(value)); }
+    size_t println() { return print("\n"); }
+    template <typename T> size_t println(T value) { return print(value) + println(); }
+    size_t printf(const char* format, ...);
+};
+
+class HardwareSerial : public Print
+{
+  public:
+    bool IsEnabled = false;
+    void begin(unsigned long) {}
+    void flush() {}
+    int available() { return 0; }
+    int read() { return -1; }
+    size_t write(uint8_t value) override;
+    operator bool() const { return true; }
+};
+
+extern HardwareSerial Serial;
+
+
+//===============================================================
+// Host time and pins
+//===============================================================
+// Simulated time in microseconds (advanced by tests and delay())
+extern uint64_t HostTime_us;
+
+// Advances the simulated time
+void HostAdvance_ms(uint32_t time_ms);
+
+// Last written and read values of the pins
+extern uint8_t HostPinModes[64];
+extern uint8_t HostPinWrites[64];
+extern uint8_t HostPinReads[64];
+
+// Changes the level of an input pin like an external signal (runs the
+// attached interrupt and the pin listeners of the peripheral stand-ins)
+void HostSetPin(uint8_t pin, uint8_t level);
+
+// Adds a pin listener (called on every level change of HostSetPin)
+void HostAddPinListener(void (*listener)(uint8_t pin, uint8_t level));
+
+uint32_t millis();
+uint32_t micros();
+int64_t esp_timer_get_time();
+void delay(uint32_t time_ms);
+void delayMicroseconds(uint32_t time_us);
+void yield();
+void pinMode(uint8_t pin, uint8_t mode);
+void digitalWrite(uint8_t pin, uint8_t value);
+int digitalRead(uint8_t pin);
+int digitalPinToInterrupt(int pin);
+void attachInterrupt(uint8_t pin, void (*handler)(void), int mode);
+void attachInterruptArg(uint8_t pin, void (*handler)(void*), void* argument, int mode);
+void detachInterrupt(uint8_t pin);
+void tone(uint8_t pin, unsigned int frequency, unsigned long duration_ms = 0);
+void noTone(uint8_t pin);
+long random(long maximum);
+long random(long minimum, long maximum);
+void randomSeed(unsigned long seed);
+bool psramFound();
+void* ps_malloc(size_t size);
+
+// Free heap of the host build (tracked by tests with own allocators)
+class EspClass
+{
+  public:
+    uint32_t getFreeHeap();
+    uint32_t getMinFreeHeap();
+    uint32_t getMaxAllocHeap();
+    uint64_t getEfuseMac() { return HostEfuseMac; }
+
+    // Factory MAC address of the host device
+    uint64_t HostEfuseMac = 0x5634120AC424ULL;
+
+    // Free heap of a test tracking its allocations (NULL -> fixed host heap)
+    uint32_t (*HostFreeHeap)() = NULL;
+};
+extern EspClass ESP;
+
+
+#endif
@@ -0,0 +1,16 @@
+/**
+ * Includes the host stand-in of the asynchronous TCP library (tests only)
+ *
+ * @author    Florian Staeblein
+ * @date      2024/01/28
+ * @copyright © 2024 Florian Staeblein
+ */
+
+#ifndef HOST_ASYNCTCP_H
+#define HOST_ASYNCTCP_H
+
+#include <Arduino.h>
+
+class AsyncClient;
+
+#endif
@@ -0,0 +1,14 @@
+/**
+ * Includes the host stand-in of the ESP system functions (tests only)
+ *
+ * @author    Florian Staeblein
+ * @date      2024/01/28
+ * @copyright © 2024 Florian Staeblein
+ */
+
+#ifndef HOST_ESP_H
+#define HOST_ESP_H
+
+#include <Arduino.h>
+
+#endif
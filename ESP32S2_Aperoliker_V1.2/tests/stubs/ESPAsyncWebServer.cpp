@@ -0,0 +1,433 @@
+/**
+ * Includes the host stand-in of the asynchronous web server (tests
+ * only)
+ *
+ * @author    Florian Staeblein
+ * @date      2024/01/28
+ * @copyright © 2024 Florian Staeblein
+ */
+
+#include <ESPAsyncWebServer.h>
+
+//===============================================================
+// Global variables
+//===============================================================
+AsyncWebServer* AsyncWebServer::HostInstance = NULL;
+size_t AsyncWebServerRequest::HostChunkSize = 1436;
+
+//===============================================================
+// Request
+//===============================================================
+AsyncWebServerRequest::AsyncWebServerRequest(WebRequestMethodComposite method, const String& url, const std::vector<AsyncWebParameter>& parameters) :
+  _method(method),
+  _url(url),
+  _parameters(parameters)
+{
+}
+
+AsyncWebParameter* AsyncWebServerRequest::getParam(const String& name, bool isPost, bool) const
+{
+  for (const AsyncWebParameter& parameter : _parameters)
+  {
+    if (parameter.name() == name && parameter.isPost() == isPost)
+    {
+      return (AsyncWebParameter*)&parameter;
+    }
+  }
+  return NULL;
+}
+
+const String& AsyncWebServerRequest::arg(const String& name) const
+{
+  AsyncWebParameter* parameter = getParam(name);
+  parameter = parameter ? parameter : getParam(name, true);
+  return parameter ? parameter->value() : _empty;
+}
+
+void AsyncWebServerRequest::send(int code, const String& contentType, const String& content)
+{
+  send(beginResponse(code, contentType, content));
+}
+
+void AsyncWebServerRequest::send(fs::FS& fs, const String& path, const String& contentType, bool)
+{
+  fs::File file = fs.open(path, FILE_READ);
+  if (!file)
+  {
+    send(404);
+    return;
+  }
+
+  String content;
+  uint8_t buffer[256];
+  size_t length;
+  while ((length = file.read(buffer, sizeof(buffer))) > 0)
+  {
+    content.concat((const char*)buffer, length);
+  }
+  send(200, contentType, content);
+}
+
+void AsyncWebServerRequest::send(AsyncWebServerResponse* response)
+{
+  HostCode = response->_code;
+  HostContentType = response->_contentType;
+  HostHeaders = response->_headers;
+  HostBody = response->_content;
+  HostChunks = 0;
+
+  // Chunks are requested until the filler returns zero
+  if (response->_filler)
+  {
+    std::vector<uint8_t> buffer(HostChunkSize);
+    size_t length;
+    while ((length = response->_filler(buffer.data(), buffer.size(), HostBody.length())) > 0)
+    {
+      HostBody.concat((const char*)buffer.data(), (unsigned int)length);
+      HostChunks++;
+    }
+  }
+  delete response;
+}
+
+AsyncWebServerResponse* AsyncWebServerRequest::beginResponse(int code, const String& contentType, const String& content)
+{
+  return new AsyncWebServerResponse(code, contentType, content);
+}
+
+AsyncWebServerResponse* AsyncWebServerRequest::beginChunkedResponse(const String& contentType, AwsResponseFiller filler)
+{
+  return new AsyncWebServerResponse(contentType, filler);
+}
+
+//===============================================================
+// Static files handler
+//===============================================================
+String AsyncStaticWebHandler::GetFilePath(const String& url)
+{
+  String path = _path + url.substring(_url.length());
+  path.replace("//", "/");
+  if (path.endsWith("/"))
+  {
+    path += _defaultFile;
+  }
+  return path;
+}
+
+bool AsyncStaticWebHandler::canHandle(AsyncWebServerRequest* request)
+{
+  return request->method() == HTTP_GET &&
+    request->url().startsWith(_url) &&
+    _fs.exists(GetFilePath(request->url()));
+}
+
+void AsyncStaticWebHandler::handleRequest(AsyncWebServerRequest* request)
+{
+  fs::File file = _fs.open(GetFilePath(request->url()), FILE_READ);
+  String content;
+  uint8_t buffer[256];
+  size_t length;
+  while ((length = file.read(buffer, sizeof(buffer))) > 0)
+  {
+    content.concat((const char*)buffer, length);
+  }
+  AsyncWebServerResponse* response = request->beginResponse(200, "", content);
+  if (_cacheControl.length() > 0)
+  {
+    response->addHeader("Cache-Control", _cacheControl);
+  }
+  request->send(response);
+}
+
+//===============================================================
+// Websocket client
+//===============================================================
+void AsyncWebSocketClient::text(const String& message)
+{
+  // Messages to a full queue are lost (like the library)
+  if (!queueIsFull())
+  {
+    _queue.push_back(message);
+  }
+}
+
+void AsyncWebSocketClient::close()
+{
+  if (_status != WS_CONNECTED)
+  {
+    return;
+  }
+  _status = WS_DISCONNECTING;
+  _queue.clear();
+  if (_server->_handler)
+  {
+    _server->_handler(_server, this, WS_EVT_DISCONNECT, NULL, NULL, 0);
+  }
+}
+
+size_t AsyncWebSocketClient::HostDeliver(size_t count)
+{
+  size_t bytes = 0;
+  while (count-- > 0 && !_queue.empty())
+  {
+    bytes += _queue.front().length();
+    HostReceived.push_back(_queue.front());
+    _queue.pop_front();
+  }
+  return bytes;
+}
+
+//===============================================================
+// Websocket
+//===============================================================
+AsyncWebSocket::~AsyncWebSocket()
+{
+  for (AsyncWebSocketClient* client : _clients)
+  {
+    delete client;
+  }
+}
+
+size_t AsyncWebSocket::count() const
+{
+  size_t connected = 0;
+  for (AsyncWebSocketClient* client : _clients)
+  {
+    connected += client->status() == WS_CONNECTED ? 1 : 0;
+  }
+  return connected;
+}
+
+AsyncWebSocketClient* AsyncWebSocket::client(uint32_t id)
+{
+  for (AsyncWebSocketClient* client : _clients)
+  {
+    if (client->id() == id && client->status() == WS_CONNECTED)
+    {
+      return client;
+    }
+  }
+  return NULL;
+}
+
+void AsyncWebSocket::cleanupClients(uint16_t maxClients)
+{
+  // Free closed clients, close the oldest clients over the limit
+  for (auto iterator = _clients.begin(); iterator != _clients.end();)
+  {
+    if ((*iterator)->status() != WS_CONNECTED)
+    {
+      delete *iterator;
+      iterator = _clients.erase(iterator);
+    }
+    else
+    {
+      iterator++;
+    }
+  }
+  if (count() > maxClients)
+  {
+    _clients.front()->close();
+  }
+}
+
+void AsyncWebSocket::closeAll()
+{
+  for (AsyncWebSocketClient* client : _clients)
+  {
+    client->close();
+  }
+}
+
+void AsyncWebSocket::textAll(const String& message)
+{
+  for (AsyncWebSocketClient* client : _clients)
+  {
+    client->text(message);
+  }
+}
+
+AsyncWebSocketClient* AsyncWebSocket::HostConnect()
+{
+  AsyncWebSocketClient* client = new AsyncWebSocketClient(this, _nextID++);
+  _clients.push_back(client);
+  if (_handler)
+  {
+    _handler(this, client, WS_EVT_CONNECT, NULL, NULL, 0);
+  }
+  return client;
+}
+
+void AsyncWebSocket::HostReceive(AsyncWebSocketClient* client, const String& message)
+{
+  if (client->status() != WS_CONNECTED || !_handler)
+  {
+    return;
+  }
+
+  // Whole message in a single final text frame
+  AwsFrameInfo info = {};
+  info.final = 1;
+  info.opcode = WS_TEXT;
+  info.message_opcode = WS_TEXT;
+  info.len = message.length();
+  _handler(this, client, WS_EVT_DATA, &info, (uint8_t*)message.c_str(), message.length());
+}
+
+void AsyncWebSocket::HostDisconnect(AsyncWebSocketClient* client)
+{
+  client->close();
+}
+
+//===============================================================
+// Server-sent events
+//===============================================================
+void AsyncEventSourceClient::send(const char* message, const char* event)
+{
+  if (_isConnected)
+  {
+    _queue.push_back(String(event ? event : "") + ":" + message);
+  }
+}
+
+size_t AsyncEventSourceClient::HostDeliver(size_t count)
+{
+  size_t bytes = 0;
+  while (count-- > 0 && !_queue.empty())
+  {
+    bytes += _queue.front().length();
+    HostReceived.push_back(_queue.front());
+    _queue.pop_front();
+  }
+  return bytes;
+}
+
+AsyncEventSource::~AsyncEventSource()
+{
+  for (AsyncEventSourceClient* client : _clients)
+  {
+    delete client;
+  }
+}
+
+void AsyncEventSource::close()
+{
+  for (AsyncEventSourceClient* client : _clients)
+  {
+    client->close();
+  }
+}
+
+void AsyncEventSource::send(const char* message, const char* event)
+{
+  for (AsyncEventSourceClient* client : _clients)
+  {
+    client->send(message, event);
+  }
+}
+
+size_t AsyncEventSource::count() const
+{
+  size_t connected = 0;
+  for (AsyncEventSourceClient* client : _clients)
+  {
+    connected += client->connected() ? 1 : 0;
+  }
+  return connected;
+}
+
+size_t AsyncEventSource::avgPacketsWaiting() const
+{
+  size_t packets = 0;
+  size_t connected = count();
+  for (AsyncEventSourceClient* client : _clients)
+  {
+    packets += client->connected() ? client->packetsWaiting() : 0;
+  }
+  return connected > 0 ? (packets + connected - 1) / connected : 0;
+}
+
+AsyncEventSourceClient* AsyncEventSource::HostConnect()
+{
+  AsyncEventSourceClient* client = new AsyncEventSourceClient();
+  _clients.push_back(client);
+  return client;
+}
+
+void AsyncEventSource::HostDisconnect(AsyncEventSourceClient* client)
+{
+  client->close();
+}
+
+//===============================================================
+// Web server
+//===============================================================
+AsyncWebServer::~AsyncWebServer()
+{
+  end();
+}
+
+void AsyncWebServer::begin()
+{
+  HostInstance = this;
+}
+
+void AsyncWebServer::end()
+{
+  if (HostInstance == this)
+  {
+    HostInstance = NULL;
+  }
+}
+
+AsyncWebHandler& AsyncWebServer::addHandler(AsyncWebHandler* handler)
+{
+  _handlers.push_back(handler);
+  return *handler;
+}
+
+bool AsyncWebServer::removeHandler(AsyncWebHandler* handler)
+{
+  auto iterator = std::find(_handlers.begin(), _handlers.end(), handler);
+  if (iterator == _handlers.end())
+  {
+    return false;
+  }
+  _handlers.erase(iterator);
+  return true;
+}
+
+AsyncCallbackWebHandler& AsyncWebServer::on(const char* url, WebRequestMethodComposite method, ArRequestHandlerFunction onRequest)
+{
+  AsyncCallbackWebHandler* handler = new AsyncCallbackWebHandler(url, method, onRequest);
+  _ownHandlers.emplace_back(handler);
+  addHandler(handler);
+  return *handler;
+}
+
+AsyncStaticWebHandler& AsyncWebServer::serveStatic(const char* url, fs::FS& fs, const char* path)
+{
+  AsyncStaticWebHandler* handler = new AsyncStaticWebHandler(url, fs, path);
+  _ownHandlers.emplace_back(handler);
+  addHandler(handler);
+  return *handler;
+}
+
+AsyncWebServerRequest AsyncWebServer::HostRequest(WebRequestMethodComposite method, const String& url, const std::vector<AsyncWebParameter>& parameters)
+{
+  AsyncWebServerRequest request(method, url, parameters);
+  for (AsyncWebHandler* handler : _handlers)
+  {
+    if (handler->canHandle(&request))
+    {
+      handler->handleRequest(&request);
+      return request;
+    }
+  }
+
+  if (_onNotFound)
+  {
+    _onNotFound(&request);
+  }
+  return request;
+}
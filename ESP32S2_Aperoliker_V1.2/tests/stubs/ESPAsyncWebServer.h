@@ -0,0 +1,364 @@
+/**
+ * Includes the host stand-in of the asynchronous web server (tests
+ * only). Requests, websocket and event clients are driven by the
+ * tests (Host* functions) instead of the network. Messages to the
+ * clients wait in the client queues until the test delivers them,
+ * like unacknowledged TCP data.
+ *
+ * @author    Florian Staeblein
+ * @date      2024/01/28
+ * @copyright © 2024 Florian Staeblein
+ */
+
+#ifndef HOST_ESPASYNCWEBSERVER_H
+#define HOST_ESPASYNCWEBSERVER_H
+
+//===============================================================
+// Includes
+//===============================================================
+#include <Arduino.h>
+#include <FS.h>
+#include <AsyncTCP.h>
+#include <deque>
+#include <list>
+#include <map>
+#include <vector>
+
+
+//===============================================================
+// Defines
+//===============================================================
+#define WS_MAX_QUEUED_MESSAGES    32      // Messages per websocket client until the queue is full (like the library)
+
+typedef enum
+{
+  HTTP_GET = 0b00000001,
+  HTTP_POST = 0b00000010,
+  HTTP_DELETE = 0b00000100,
+  HTTP_PUT = 0b00001000,
+  HTTP_PATCH = 0b00010000,
+  HTTP_HEAD = 0b00100000,
+  HTTP_OPTIONS = 0b01000000,
+  HTTP_ANY = 0b01111111,
+} WebRequestMethod;
+
+typedef uint8_t WebRequestMethodComposite;
+
+class AsyncWebServer;
+class AsyncWebServerRequest;
+class AsyncWebSocket;
+class AsyncEventSource;
+
+typedef std::function<void(AsyncWebServerRequest* request)> ArRequestHandlerFunction;
+typedef std::function<size_t(uint8_t* buffer, size_t maxLength, size_t index)> AwsResponseFiller;
+
+
+//===============================================================
+// Request parameter (query or form parameter)
+//===============================================================
+class AsyncWebParameter
+{
+  public:
+    AsyncWebParameter(const String& name, const String& value, bool isPost) : _name(name), _value(value), _isPost(isPost) {}
+    const String& name() const { return _name; }
+    const String& value() const { return _value; }
+    bool isPost() const { return _isPost; }
+    bool isFile() const { return false; }
+
+  private:
+    String _name;
+    String _value;
+    bool _isPost;
+};
+
+//===============================================================
+// Response (content or chunks of a filler)
+//===============================================================
+class AsyncWebServerResponse
+{
+  public:
+    AsyncWebServerResponse(int code, const String& contentType, const String& content) : _code(code), _contentType(contentType), _content(content) {}
+    AsyncWebServerResponse(const String& contentType, AwsResponseFiller filler) : _code(200), _contentType(contentType), _filler(filler) {}
+    void setCode(int code) { _code = code; }
+    void setContentType(const String& contentType) { _contentType = contentType; }
+    void addHeader(const String& name, const String& value) { _headers[name.c_str()] = value; }
+
+  private:
+    friend class AsyncWebServerRequest;
+    int _code;
+    String _contentType;
+    String _content;
+    AwsResponseFiller _filler;
+    std::map<std::string, String> _headers;
+};
+
+//===============================================================
+// Request of a test client. The response is kept in the request.
+//===============================================================
+class AsyncWebServerRequest
+{
+  public:
+    AsyncWebServerRequest(WebRequestMethodComposite method, const String& url, const std::vector<AsyncWebParameter>& parameters);
+
+    WebRequestMethodComposite method() const { return _method; }
+    const String& url() const { return _url; }
+    size_t params() const { return _parameters.size(); }
+    bool hasParam(const String& name, bool isPost = false, bool isFile = false) const { return getParam(name, isPost, isFile) != NULL; }
+    AsyncWebParameter* getParam(const String& name, bool isPost = false, bool isFile = false) const;
+    AsyncWebParameter* getParam(size_t index) const { return index < _parameters.size() ? (AsyncWebParameter*)&_parameters[index] : NULL; }
+    bool hasArg(const char* name) const { return hasParam(name) || hasParam(name, true); }
+    const String& arg(const String& name) const;
+    const String& header(const char*) const { return _empty; }
+    void addInterestingHeader(const String&) {}
+
+    void send(int code, const String& contentType = String(), const String& content = String());
+    void send(fs::FS& fs, const String& path, const String& contentType = String(), bool download = false);
+    void send(AsyncWebServerResponse* response);
+    AsyncWebServerResponse* beginResponse(int code, const String& contentType = String(), const String& content = String());
+    AsyncWebServerResponse* beginChunkedResponse(const String& contentType, AwsResponseFiller filler);
+
+    // Response of the request (chunked responses are filled completely in chunks of HostChunkSize)
+    static size_t HostChunkSize;
+    int HostCode = 0;
+    String HostContentType;
+    String HostBody;
+    uint32_t HostChunks = 0;
+    std::map<std::string, String> HostHeaders;
+
+  private:
+    WebRequestMethodComposite _method;
+    String _url;
+    std::vector<AsyncWebParameter> _parameters;
+    String _empty;
+};
+
+//===============================================================
+// Base class of the request handlers
+//===============================================================
+class AsyncWebHandler
+{
+  public:
+    virtual ~AsyncWebHandler() {}
+    virtual bool canHandle(AsyncWebServerRequest* request) { return false; }
+    virtual void handleRequest(AsyncWebServerRequest* request) {}
+    virtual void handleUpload(AsyncWebServerRequest* request, const String& filename, size_t index, uint8_t* data, size_t len, bool final) {}
+    virtual bool isRequestHandlerTrivial() { return true; }
+};
+
+// Handler of an URL and method
+class AsyncCallbackWebHandler : public AsyncWebHandler
+{
+  public:
+    AsyncCallbackWebHandler(const String& url, WebRequestMethodComposite method, ArRequestHandlerFunction onRequest) : _url(url), _method(method), _onRequest(onRequest) {}
+    bool canHandle(AsyncWebServerRequest* request) override { return (request->method() & _method) && request->url() == _url; }
+    void handleRequest(AsyncWebServerRequest* request) override { _onRequest(request); }
+
+  private:
+    String _url;
+    WebRequestMethodComposite _method;
+    ArRequestHandlerFunction _onRequest;
+};
+
+// Handler of static files
+class AsyncStaticWebHandler : public AsyncWebHandler
+{
+  public:
+    AsyncStaticWebHandler(const String& url, fs::FS& fs, const String& path) : _url(url), _fs(fs), _path(path) {}
+    AsyncStaticWebHandler& setDefaultFile(const char* defaultFile) { _defaultFile = defaultFile; return *this; }
+    AsyncStaticWebHandler& setCacheControl(const char* cacheControl) { _cacheControl = cacheControl; return *this; }
+    bool canHandle(AsyncWebServerRequest* request) override;
+    void handleRequest(AsyncWebServerRequest* request) override;
+
+  private:
+    String _url;
+    fs::FS& _fs;
+    String _path;
+    String _defaultFile;
+    String _cacheControl;
+
+    String GetFilePath(const String& url);
+};
+
+
+//===============================================================
+// Websocket
+//===============================================================
+typedef enum
+{
+  WS_EVT_CONNECT,
+  WS_EVT_DISCONNECT,
+  WS_EVT_PONG,
+  WS_EVT_ERROR,
+  WS_EVT_DATA,
+} AwsEventType;
+
+typedef enum
+{
+  WS_CONTINUATION,
+  WS_TEXT,
+  WS_BINARY,
+  WS_DISCONNECT = 0x08,
+  WS_PING,
+  WS_PONG,
+} AwsFrameType;
+
+typedef enum
+{
+  WS_DISCONNECTED,
+  WS_CONNECTED,
+  WS_DISCONNECTING,
+} AwsClientStatus;
+
+typedef struct
+{
+  uint8_t message_opcode;
+  uint32_t num;
+  uint8_t final;
+  uint8_t masked;
+  uint8_t opcode;
+  uint64_t len;
+  uint8_t mask[4];
+  uint64_t index;
+} AwsFrameInfo;
+
+typedef std::function<void(AsyncWebSocket* server, class AsyncWebSocketClient* client, AwsEventType type, void* arg, uint8_t* data, size_t len)> AwsEventHandler;
+
+// Websocket client (sent messages wait in the queue until the test delivers them)
+class AsyncWebSocketClient
+{
+  public:
+    AsyncWebSocketClient(AsyncWebSocket* server, uint32_t id) : _server(server), _id(id) {}
+    uint32_t id() { return _id; }
+    AsyncWebSocket* server() { return _server; }
+    AwsClientStatus status() { return _status; }
+    void text(const String& message);
+    void text(const char* message) { text(String(message)); }
+    void ping() {}
+    void close();
+    bool queueIsFull() { return _status != WS_CONNECTED || _queue.size() >= WS_MAX_QUEUED_MESSAGES; }
+    size_t queueLen() { return _queue.size(); }
+
+    // Delivers up to count queued messages to the received messages of the test client, returns the delivered bytes
+    size_t HostDeliver(size_t count = SIZE_MAX);
+    std::deque<String> HostReceived;
+
+  private:
+    friend class AsyncWebSocket;
+    AsyncWebSocket* _server;
+    uint32_t _id;
+    AwsClientStatus _status = WS_CONNECTED;
+    std::deque<String> _queue;
+};
+
+class AsyncWebSocket : public AsyncWebHandler
+{
+  public:
+    AsyncWebSocket(const String& url) : _url(url) {}
+    ~AsyncWebSocket();
+    void onEvent(AwsEventHandler handler) { _handler = handler; }
+    bool canHandle(AsyncWebServerRequest* request) override { return request->url() == _url; }
+    size_t count() const;
+    AsyncWebSocketClient* client(uint32_t id);
+    void cleanupClients(uint16_t maxClients = 8);
+    void closeAll();
+    void textAll(const String& message);
+
+    // Test clients: Connect (upgrade request), receive a text message from a client and disconnect
+    AsyncWebSocketClient* HostConnect();
+    void HostReceive(AsyncWebSocketClient* client, const String& message);
+    void HostDisconnect(AsyncWebSocketClient* client);
+
+  private:
+    friend class AsyncWebSocketClient;
+    String _url;
+    AwsEventHandler _handler;
+    uint32_t _nextID = 1;
+    std::list<AsyncWebSocketClient*> _clients;
+};
+
+
+//===============================================================
+// Server-sent events
+//===============================================================
+class AsyncEventSourceClient
+{
+  public:
+    void send(const char* message, const char* event = NULL);
+    size_t packetsWaiting() const { return _queue.size(); }
+    void close() { _isConnected = false; }
+    bool connected() const { return _isConnected; }
+
+    // Delivers up to count waiting packets to the test client, returns the delivered bytes
+    size_t HostDeliver(size_t count = SIZE_MAX);
+    std::deque<String> HostReceived;
+
+  private:
+    bool _isConnected = true;
+    std::deque<String> _queue;
+};
+
+class AsyncEventSource : public AsyncWebHandler
+{
+  public:
+    AsyncEventSource(const String& url) : _url(url) {}
+    ~AsyncEventSource();
+    bool canHandle(AsyncWebServerRequest* request) override { return request->url() == _url; }
+    void close();
+    void send(const char* message, const char* event = NULL);
+    size_t count() const;
+    size_t avgPacketsWaiting() const;
+
+    // Test clients: Connect (event stream request) and disconnect
+    AsyncEventSourceClient* HostConnect();
+    void HostDisconnect(AsyncEventSourceClient* client);
+
+  private:
+    String _url;
+    std::list<AsyncEventSourceClient*> _clients;
+};
+
+
+//===============================================================
+// Web server
+//===============================================================
+class AsyncWebServer
+{
+  public:
+    AsyncWebServer(uint16_t port) : _port(port) {}
+    ~AsyncWebServer();
+    void begin();
+    void end();
+    AsyncWebHandler& addHandler(AsyncWebHandler* handler);
+    bool removeHandler(AsyncWebHandler* handler);
+    AsyncCallbackWebHandler& on(const char* url, WebRequestMethodComposite method, ArRequestHandlerFunction onRequest);
+    AsyncStaticWebHandler& serveStatic(const char* url, fs::FS& fs, const char* path);
+    void onNotFound(ArRequestHandlerFunction onNotFound) { _onNotFound = onNotFound; }
+
+    // Last started web server (NULL after end())
+    static AsyncWebServer* HostInstance;
+
+    // Handles a request of a test client like the network task (form parameters need method HTTP_POST)
+    AsyncWebServerRequest HostRequest(WebRequestMethodComposite method, const String& url, const std::vector<AsyncWebParameter>& parameters = {});
+
+    // Returns the first handler of a type (e.g. the websocket)
+    template <typename T> T* HostFindHandler()
+    {
+      for (AsyncWebHandler* handler : _handlers)
+      {
+        if (T* found = dynamic_cast<T*>(handler))
+        {
+          return found;
+        }
+      }
+      return NULL;
+    }
+
+  private:
+    uint16_t _port;
+    std::vector<AsyncWebHandler*> _handlers;
+    std::vector<std::unique_ptr<AsyncWebHandler>> _ownHandlers;
+    ArRequestHandlerFunction _onNotFound;
+};
+
+
+#endif
@@ -0,0 +1,26 @@
+/**
+ * Includes the host stand-in of the mDNS responder (tests only)
+ *
+ * @author    Florian Staeblein
+ * @date      2024/01/28
+ * @copyright © 2024 Florian Staeblein
+ */
+
+#ifndef HOST_ESPMDNS_H
+#define HOST_ESPMDNS_H
+
+#include <Arduino.h>
+
+// mDNS responder without network (the network tests replace it by a local network backend)
+class MDNSResponder
+{
+  public:
+    bool begin(const char*) { return true; }
+    void end() {}
+    bool addService(const char*, const char*, uint16_t) { return true; }
+    bool addServiceTxt(const char*, const char*, const char*, const char*) { return true; }
+};
+
+inline MDNSResponder MDNS;
+
+#endif
@@ -0,0 +1,101 @@
+/**
+ * Includes the host stand-in of the file system (files are kept in memory) (tests only)
+ *
+ * @author    Florian Staeblein
+ * @date      2024/01/28
+ * @copyright © 2024 Florian Staeblein
+ */
+
+#include <SPIFFS.h>
+
+//===============================================================
+// Global variables
+//===============================================================
+SPIFFSFS SPIFFS;
+
+//===============================================================
+// File in memory
+//===============================================================
+fs::File::File(const std::string& name, std::shared_ptr<std::string> data, bool isWritable, size_t position) :
+  _name(name), _data(data), _isWritable(isWritable), _position(position)
+{
+}
+
+size_t fs::File::write(const uint8_t* buffer, size_t size)
+{
+  if (!_data || !_isWritable)
+  {
+    return 0;
+  }
+  _data->replace(_position, min(size, _data->size() - _position), (const char*)buffer, size);
+  _position += size;
+  return size;
+}
+
+int fs::File::read()
+{
+  uint8_t value;
+  return read(&value, 1) == 1 ? value : -1;
+}
+
+size_t fs::File::read(uint8_t* buffer, size_t size)
+{
+  size_t count = min(size, (size_t)available());
+  if (count > 0)
+  {
+    memcpy(buffer, _data->data() + _position, count);
+    _position += count;
+  }
+  return count;
+}
+
+bool fs::File::seek(uint32_t position)
+{
+  if (!_data || position > _data->size())
+  {
+    return false;
+  }
+  _position = position;
+  return true;
+}
+
+//===============================================================
+// File system in memory
+//===============================================================
+fs::File fs::FS::open(const char* path, const char* mode, bool create)
+{
+  std::shared_ptr<std::string>& data = _files[path];
+  bool isRead = mode[0] == 'r';
+  if (isRead && !data)
+  {
+    _files.erase(path);
+    return File();
+  }
+  if (!data || mode[0] == 'w')
+  {
+    data = std::make_shared<std::string>();
+  }
+  return File(path, data, !isRead || mode[1] == '+', mode[0] == 'a' ? data->size() : 0);
+}
+
+bool fs::FS::rename(const char* pathFrom, const char* pathTo)
+{
+  auto iterator = _files.find(pathFrom);
+  if (iterator == _files.end())
+  {
+    return false;
+  }
+  _files[pathTo] = iterator->second;
+  _files.erase(iterator);
+  return true;
+}
+
+size_t SPIFFSFS::usedBytes()
+{
+  size_t bytes = 0;
+  for (auto& file : _files)
+  {
+    bytes += file.second->size();
+  }
+  return bytes;
+}
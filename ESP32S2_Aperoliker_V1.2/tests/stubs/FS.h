@@ -0,0 +1,84 @@
+/**
+ * Includes the host stand-in of the file system (files are kept in memory) (tests only)
+ *
+ * @author    Florian Staeblein
+ * @date      2024/01/28
+ * @copyright © 2024 Florian Staeblein
+ */
+
+#ifndef HOST_FS_H
+#define HOST_FS_H
+
+//===============================================================
+// Includes
+//===============================================================
+#include <Arduino.h>
+#include <map>
+
+
+//===============================================================
+// Defines
+//===============================================================
+#define FILE_READ         "r"
+#define FILE_WRITE        "w"
+#define FILE_APPEND       "a"
+
+
+namespace fs
+{
+//===============================================================
+// File in memory (copies share the contents)
+//===============================================================
+class File
+{
+  public:
+    File() {}
+    File(const std::string& name, std::shared_ptr<std::string> data, bool isWritable, size_t position);
+
+    size_t write(uint8_t value) { return write(&value, 1); }
+    size_t write(const uint8_t* buffer, size_t size);
+    int read();
+    size_t read(uint8_t* buffer, size_t size);
+    int available() { return _data ? (int)(_data->size() - _position) : 0; }
+    bool seek(uint32_t position);
+    size_t position() const { return _position; }
+    size_t size() const { return _data ? _data->size() : 0; }
+    void flush() {}
+    void close() { _data.reset(); }
+    const char* name() const { return _name.c_str(); }
+    operator bool() const { return (bool)_data; }
+
+  private:
+    std::string _name;
+    std::shared_ptr<std::string> _data;
+    bool _isWritable = false;
+    size_t _position = 0;
+};
+
+//===============================================================
+// File system in memory
+//===============================================================
+class FS
+{
+  public:
+    File open(const char* path, const char* mode = FILE_READ, bool create = false);
+    File open(const String& path, const char* mode = FILE_READ, bool create = false) { return open(path.c_str(), mode, create); }
+    bool exists(const char* path) { return _files.count(path) > 0; }
+    bool exists(const String& path) { return exists(path.c_str()); }
+    bool remove(const char* path) { return _files.erase(path) > 0; }
+    bool remove(const String& path) { return remove(path.c_str()); }
+    bool rename(const char* pathFrom, const char* pathTo);
+
+    // Removes all files (host tests only)
+    void HostClear() { _files.clear(); }
+
+  protected:
+    std::map<std::string, std::shared_ptr<std::string>> _files;
+};
+}
+
+using fs::FS;
+using fs::File;
+
+
+#endif
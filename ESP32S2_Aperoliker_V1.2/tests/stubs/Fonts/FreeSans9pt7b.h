@@ -0,0 +1,14 @@
+/**
+ * Includes the host stand-in of the display font (tests only)
+ *
+ * @author    Florian Staeblein
+ * @date      2024/01/28
+ * @copyright © 2024 Florian Staeblein
+ */
+
+#ifndef HOST_FREESANS9PT7B_H
+#define HOST_FREESANS9PT7B_H
+
+#include <Adafruit_GFX.h>
+
+#endif
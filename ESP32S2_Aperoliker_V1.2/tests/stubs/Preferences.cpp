@@ -0,0 +1,92 @@
+/**
+ * Includes the host stand-in of the preferences library (values are kept in memory) (tests only)
+ *
+ * @author    Florian Staeblein
+ * @date      2024/01/28
+ * @copyright © 2024 Florian Staeblein
+ */
+
+#include <Preferences.h>
+
+//===============================================================
+// Global variables
+//===============================================================
+static std::map<std::string, std::map<std::string, std::string>> namespaces;
+uint32_t Preferences::HostWriteCount = 0;
+void (*Preferences::HostWriteHook)(const char* key) = NULL;
+
+//===============================================================
+// Preferences in memory
+//===============================================================
+bool Preferences::begin(const char* name, bool readOnly, const char* partitionLabel)
+{
+  _values = &namespaces[name];
+  _isReadOnly = readOnly;
+  return true;
+}
+
+bool Preferences::clear()
+{
+  if (!_values || _isReadOnly)
+  {
+    return false;
+  }
+  _values->clear();
+  HostWriteCount++;
+  return true;
+}
+
+bool Preferences::remove(const char* key)
+{
+  if (!_values || _isReadOnly)
+  {
+    return false;
+  }
+  HostWriteCount++;
+  return _values->erase(key) > 0;
+}
+
+bool Preferences::isKey(const char* key)
+{
+  return _values && _values->count(key) > 0;
+}
+
+size_t Preferences::putBytes(const char* key, const void* value, size_t length)
+{
+  if (!_values || _isReadOnly)
+  {
+    return 0;
+  }
+  (*_values)[key] = std::string((const char*)value, length);
+  HostWriteCount++;
+  if (HostWriteHook != NULL)
+  {
+    HostWriteHook(key);
+  }
+  return length;
+}
+
+String Preferences::getString(const char* key, const String& defaultValue)
+{
+  if (!isKey(key))
+  {
+    return defaultValue;
+  }
+  return String(_values->at(key));
+}
+
+size_t Preferences::getBytes(const char* key, void* buffer, size_t length)
+{
+  if (!isKey(key) || _values->at(key).size() > length)
+  {
+    return 0;
+  }
+  const std::string& value = _values->at(key);
+  memcpy(buffer, value.data(), value.size());
+  return value.size();
+}
+
+void Preferences::HostClear()
+{
+  namespaces.clear();
+}
@@ -0,0 +1,69 @@
+/**
+ * Includes the host stand-in of the preferences library (values are kept in memory) (tests only)
+ *
+ * @author    Florian Staeblein
+ * @date      2024/01/28
+ * @copyright © 2024 Florian Staeblein
+ */
+
+#ifndef HOST_PREFERENCES_H
+#define HOST_PREFERENCES_H
+
+//===============================================================
+// Includes
+//===============================================================
+#include <Arduino.h>
+#include <map>
+
+
+//===============================================================
+// Preferences in memory (every put counts as one flash write)
+//===============================================================
+class Preferences
+{
+  public:
+    bool begin(const char* name, bool readOnly = false, const char* partitionLabel = NULL);
+    void end() { _values = NULL; }
+    bool clear();
+    bool remove(const char* key);
+    bool isKey(const char* key);
+
+    size_t putShort(const char* key, int16_t value) { return Put(key, value); }
+    size_t putInt(const char* key, int32_t value) { return Put(key, value); }
+    size_t putLong(const char* key, int32_t value) { return Put(key, value); }
+    size_t putULong(const char* key, uint32_t value) { return Put(key, value); }
+    size_t putULong64(const char* key, uint64_t value) { return Put(key, value); }
+    size_t putDouble(const char* key, double value) { return Put(key, value); }
+    size_t putBool(const char* key, bool value) { return Put(key, (uint8_t)value); }
+    size_t putString(const char* key, const String& value) { return putBytes(key, value.c_str(), value.length()); }
+    size_t putBytes(const char* key, const void* value, size_t length);
+
+    int16_t getShort(const char* key, int16_t defaultValue = 0) { return Get(key, defaultValue); }
+    int32_t getInt(const char* key, int32_t defaultValue = 0) { return Get(key, defaultValue); }
+    int32_t getLong(const char* key, int32_t defaultValue = 0) { return Get(key, defaultValue); }
+    uint32_t getULong(const char* key, uint32_t defaultValue = 0) { return Get(key, defaultValue); }
+    uint64_t getULong64(const char* key, uint64_t defaultValue = 0) { return Get(key, defaultValue); }
+    double getDouble(const char* key, double defaultValue = NAN) { return Get(key, defaultValue); }
+    bool getBool(const char* key, bool defaultValue = false) { return Get(key, (uint8_t)defaultValue) != 0; }
+    String getString(const char* key, const String& defaultValue = String());
+    size_t getBytes(const char* key, void* buffer, size_t length);
+
+    // Count of put calls (each one is a flash write on the ESP32)
+    static uint32_t HostWriteCount;
+
+    // Called after each put (host tests only, e.g. to start the pumps during a commit)
+    static void (*HostWriteHook)(const char* key);
+
+    // Removes all namespaces (host tests only)
+    static void HostClear();
+
+  private:
+    std::map<std::string, std::string>* _values = NULL;
+    bool _isReadOnly = false;
+
+    template <typename T> size_t Put(const char* key, T value) { return putBytes(key, &value, sizeof(value)) == sizeof(value) ? sizeof(value) : 0; }
+    template <typename T> T Get(const char* key, T defaultValue) { T value; return getBytes(key, &value, sizeof(value)) == sizeof(value) ? value : defaultValue; }
+};
+
+
+#endif
@@ -0,0 +1,20 @@
+/**
+ * Includes the host stand-in of the SPI bus (tests only)
+ *
+ * @author    Florian Staeblein
+ * @date      2024/01/28
+ * @copyright © 2024 Florian Staeblein
+ */
+
+#ifndef HOST_SPI_H
+#define HOST_SPI_H
+
+#include <Arduino.h>
+
+#define HSPI              2
+#define FSPI              1
+
+// Types only, the display is replaced by a fake in the host tests
+class SPIClass;
+
+#endif
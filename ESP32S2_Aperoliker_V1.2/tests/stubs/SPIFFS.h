@@ -0,0 +1,26 @@
+/**
+ * Includes the host stand-in of the SPIFFS file system (files are kept in memory) (tests only)
+ *
+ * @author    Florian Staeblein
+ * @date      2024/01/28
+ * @copyright © 2024 Florian Staeblein
+ */
+
+#ifndef HOST_SPIFFS_H
+#define HOST_SPIFFS_H
+
+#include <FS.h>
+
+class SPIFFSFS : public fs::FS
+{
+  public:
+    bool begin(bool formatOnFail = false) { return true; }
+    void end() {}
+    bool format() { HostClear(); return true; }
+    size_t totalBytes() { return 1441792; }
+    size_t usedBytes();
+};
+
+extern SPIFFSFS SPIFFS;
+
+#endif
@@ -0,0 +1,114 @@
+/**
+ * Includes the host stand-in of the wifi library (tests only). The
+ * radio only keeps its settings, the network tests replace it by a
+ * local network backend.
+ *
+ * @author    Florian Staeblein
+ * @date      2024/01/28
+ * @copyright © 2024 Florian Staeblein
+ */
+
+#ifndef HOST_WIFI_H
+#define HOST_WIFI_H
+
+#include <Arduino.h>
+
+typedef enum
+{
+  WIFI_MODE_NULL = 0,
+  WIFI_MODE_STA,
+  WIFI_MODE_AP,
+  WIFI_MODE_APSTA,
+  WIFI_MODE_MAX,
+} wifi_mode_t;
+
+#define WIFI_OFF          WIFI_MODE_NULL
+#define WIFI_STA          WIFI_MODE_STA
+#define WIFI_AP           WIFI_MODE_AP
+#define WIFI_AP_STA       WIFI_MODE_APSTA
+
+typedef enum
+{
+  WL_IDLE_STATUS = 0,
+  WL_NO_SSID_AVAIL,
+  WL_SCAN_COMPLETED,
+  WL_CONNECTED,
+  WL_CONNECT_FAILED,
+  WL_CONNECTION_LOST,
+  WL_DISCONNECTED,
+} wl_status_t;
+
+typedef enum
+{
+  WIFI_POWER_19_5dBm = 78,
+  WIFI_POWER_19dBm = 76,
+  WIFI_POWER_18_5dBm = 74,
+  WIFI_POWER_17dBm = 68,
+  WIFI_POWER_15dBm = 60,
+  WIFI_POWER_13dBm = 52,
+  WIFI_POWER_11dBm = 44,
+  WIFI_POWER_8_5dBm = 34,
+  WIFI_POWER_7dBm = 28,
+  WIFI_POWER_5dBm = 20,
+  WIFI_POWER_2dBm = 8,
+  WIFI_POWER_MINUS_1dBm = -4,
+} wifi_power_t;
+
+//===============================================================
+// IPv4 address
+//===============================================================
+class IPAddress
+{
+  public:
+    IPAddress() {}
+    IPAddress(uint8_t first, uint8_t second, uint8_t third, uint8_t fourth) : _address((uint32_t)first | ((uint32_t)second << 8) | ((uint32_t)third << 16) | ((uint32_t)fourth << 24)) {}
+    explicit IPAddress(uint32_t address) : _address(address) {}
+    uint8_t operator[](int index) const { return (uint8_t)(_address >> (8 * index)); }
+    operator uint32_t() const { return _address; }
+    bool operator==(const IPAddress& address) const { return _address == address._address; }
+    String toString() const { return String((*this)[0]) + "." + String((*this)[1]) + "." + String((*this)[2]) + "." + String((*this)[3]); }
+
+  private:
+    uint32_t _address = 0;
+};
+
+//===============================================================
+// Radio state of the host (no network access, never connects)
+//===============================================================
+class WiFiClass
+{
+  public:
+    bool mode(wifi_mode_t mode) { _mode = mode; return true; }
+    wifi_mode_t getMode() { return _mode; }
+    bool setSleep(bool enable) { _isSleepEnabled = enable; return true; }
+    bool getSleep() { return _isSleepEnabled; }
+    bool setTxPower(wifi_power_t power) { _power = power; return true; }
+    wifi_power_t getTxPower() { return _power; }
+    bool setAutoReconnect(bool) { return true; }
+    bool setHostname(const char*) { return true; }
+
+    bool softAP(const char*, const char* = NULL) { return true; }
+    bool softAPConfig(IPAddress, IPAddress, IPAddress) { return true; }
+    bool softAPdisconnect(bool = false) { return true; }
+    uint8_t softAPgetStationNum() { return 0; }
+    IPAddress softAPIP() { return IPAddress(192, 168, 1, 1); }
+
+    wl_status_t begin(const char*, const char* = NULL, int32_t = 0, const uint8_t* = NULL) { return WL_DISCONNECTED; }
+    bool disconnect(bool = false) { return true; }
+    wl_status_t status() { return WL_DISCONNECTED; }
+    IPAddress localIP() { return IPAddress(); }
+    uint8_t* BSSID() { return NULL; }
+    int32_t channel() { return 0; }
+    String SSID() { return ""; }
+    String BSSIDstr() { return ""; }
+    String macAddress() { return "00:00:00:00:00:00"; }
+
+  private:
+    wifi_mode_t _mode = WIFI_MODE_NULL;
+    wifi_power_t _power = WIFI_POWER_19_5dBm;
+    bool _isSleepEnabled = false;
+};
+
+inline WiFiClass WiFi;
+
+#endif
@@ -0,0 +1,27 @@
+/**
+ * Includes the host stand-in of the UDP library (tests only). No
+ * packets are sent or received.
+ *
+ * @author    Florian Staeblein
+ * @date      2024/01/28
+ * @copyright © 2024 Florian Staeblein
+ */
+
+#ifndef HOST_WIFIUDP_H
+#define HOST_WIFIUDP_H
+
+#include <WiFi.h>
+
+class WiFiUDP
+{
+  public:
+    uint8_t beginMulticast(IPAddress, uint16_t) { return 1; }
+    void stop() {}
+    int beginMulticastPacket() { return 1; }
+    size_t write(const uint8_t*, size_t size) { return size; }
+    int endPacket() { return 1; }
+    int parsePacket() { return 0; }
+    int read(uint8_t*, size_t) { return 0; }
+};
+
+#endif
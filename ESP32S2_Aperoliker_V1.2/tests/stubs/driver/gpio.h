@@ -0,0 +1,44 @@
+/**
+ * Includes the host stand-in of the gpio driver (tests only)
+ *
+ * @author    Florian Staeblein
+ * @date      2024/01/28
+ * @copyright © 2024 Florian Staeblein
+ */
+
+#ifndef HOST_DRIVER_GPIO_H
+#define HOST_DRIVER_GPIO_H
+
+typedef int esp_err_t;
+
+typedef enum
+{
+  GPIO_NUM_0 = 0,
+} gpio_num_t;
+
+typedef enum
+{
+  GPIO_INTR_DISABLE = 0,
+  GPIO_INTR_POSEDGE,
+  GPIO_INTR_NEGEDGE,
+  GPIO_INTR_ANYEDGE,
+  GPIO_INTR_LOW_LEVEL,
+  GPIO_INTR_HIGH_LEVEL,
+} gpio_int_type_t;
+
+inline esp_err_t gpio_wakeup_enable(gpio_num_t, gpio_int_type_t)
+{
+  return 0;
+}
+
+inline esp_err_t gpio_wakeup_disable(gpio_num_t)
+{
+  return 0;
+}
+
+inline esp_err_t gpio_set_intr_type(gpio_num_t, gpio_int_type_t)
+{
+  return 0;
+}
+
+#endif
@@ -0,0 +1,161 @@
+/**
+ * Includes the host stand-in of the pulse counter driver (tests
+ * only)
+ *
+ * @author    Florian Staeblein
+ * @date      2024/01/28
+ * @copyright © 2024 Florian Staeblein
+ */
+
+#include <Arduino.h>
+#include <driver/pcnt.h>
+
+//===============================================================
+// Global variables
+//===============================================================
+// Channel configurations of the unit
+static pcnt_config_t channels[2] = {};
+static bool isChannelConfigured[2] = {};
+
+// Glitch filter: A level must be stable for the filter time to be counted
+static uint16_t filter_Cycles = 0;
+static bool isFilterEnabled = false;
+static bool isPaused = false;
+
+// Filtered level and not yet stable level change of every pin
+struct PendingEdge
+{
+  bool IsPending;
+  uint8_t Level;
+  uint64_t Time_us;
+};
+static uint8_t filteredLevels[64] = {};
+static PendingEdge pendingEdges[64] = {};
+
+//===============================================================
+// Counts a filtered edge of a pin
+//===============================================================
+static void CountEdge(uint8_t pin, uint8_t level)
+{
+  filteredLevels[pin] = level;
+  for (uint8_t channel = 0; channel < 2; channel++)
+  {
+    const pcnt_config_t& config = channels[channel];
+    if (!isChannelConfigured[channel] || config.pulse_gpio_num != pin || isPaused)
+    {
+      continue;
+    }
+
+    // Edge mode, modified by the level of the control pin
+    int16_t count = 0;
+    pcnt_count_mode_t edgeMode = level ? config.pos_mode : config.neg_mode;
+    count = edgeMode == PCNT_COUNT_INC ? 1 : (edgeMode == PCNT_COUNT_DEC ? -1 : 0);
+    pcnt_ctrl_mode_t controlMode = filteredLevels[config.ctrl_gpio_num & 63] ? config.hctrl_mode : config.lctrl_mode;
+    count = controlMode == PCNT_MODE_REVERSE ? -count : (controlMode == PCNT_MODE_DISABLE ? 0 : count);
+
+    // The counter restarts at zero, if a limit is reached
+    HostPcntCounter += count;
+    if (HostPcntCounter >= config.counter_h_lim || HostPcntCounter <= config.counter_l_lim)
+    {
+      HostPcntCounter = 0;
+    }
+  }
+}
+
+//===============================================================
+// Counts all pending edges, which are stable for the filter time
+//===============================================================
+static void CountStableEdges()
+{
+  while (true)
+  {
+    // Oldest stable pending edge first
+    int16_t oldestPin = -1;
+    for (uint8_t pin = 0; pin < 64; pin++)
+    {
+      const PendingEdge& edge = pendingEdges[pin];
+      bool isStable = edge.IsPending && (HostTime_us - edge.Time_us) * 80 >= (uint64_t)(isFilterEnabled ? filter_Cycles : 0);
+      if (isStable && (oldestPin < 0 || edge.Time_us < pendingEdges[oldestPin].Time_us))
+      {
+        oldestPin = pin;
+      }
+    }
+    if (oldestPin < 0)
+    {
+      return;
+    }
+
+    pendingEdges[oldestPin].IsPending = false;
+    CountEdge(oldestPin, pendingEdges[oldestPin].Level);
+  }
+}
+
+//===============================================================
+// Pin listener: A level change shorter than the filter time is a
+// glitch and removes the pending edge
+//===============================================================
+static void OnPinChange(uint8_t pin, uint8_t level)
+{
+  CountStableEdges();
+
+  PendingEdge& edge = pendingEdges[pin];
+  if (edge.IsPending)
+  {
+    edge.IsPending = false;
+  }
+  else if (level != filteredLevels[pin])
+  {
+    edge = { true, level, HostTime_us };
+  }
+  CountStableEdges();
+}
+
+//===============================================================
+// Pulse counter driver functions
+//===============================================================
+esp_err_t pcnt_unit_config(const pcnt_config_t* config)
+{
+  channels[config->channel] = *config;
+  isChannelConfigured[config->channel] = true;
+  filteredLevels[config->pulse_gpio_num & 63] = HostPinReads[config->pulse_gpio_num & 63];
+  filteredLevels[config->ctrl_gpio_num & 63] = HostPinReads[config->ctrl_gpio_num & 63];
+  HostAddPinListener(OnPinChange);
+  return ESP_OK;
+}
+
+esp_err_t pcnt_set_filter_value(pcnt_unit_t, uint16_t filter)
+{
+  filter_Cycles = min(filter, (uint16_t)1023);
+  return ESP_OK;
+}
+
+esp_err_t pcnt_filter_enable(pcnt_unit_t)
+{
+  isFilterEnabled = true;
+  return ESP_OK;
+}
+
+esp_err_t pcnt_counter_pause(pcnt_unit_t)
+{
+  isPaused = true;
+  return ESP_OK;
+}
+
+esp_err_t pcnt_counter_clear(pcnt_unit_t)
+{
+  HostPcntCounter = 0;
+  return ESP_OK;
+}
+
+esp_err_t pcnt_counter_resume(pcnt_unit_t)
+{
+  isPaused = false;
+  return ESP_OK;
+}
+
+esp_err_t pcnt_get_counter_value(pcnt_unit_t, int16_t* count)
+{
+  CountStableEdges();
+  *count = HostPcntCounter;
+  return ESP_OK;
+}
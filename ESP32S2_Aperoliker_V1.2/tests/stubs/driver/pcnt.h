@@ -0,0 +1,70 @@
+/**
+ * Includes the host stand-in of the pulse counter driver (tests
+ * only). Counts the edges of HostSetPin with the configured edge
+ * and control modes, the glitch filter and the counter limits
+ *
+ * @author    Florian Staeblein
+ * @date      2024/01/28
+ * @copyright © 2024 Florian Staeblein
+ */
+
+#ifndef HOST_DRIVER_PCNT_H
+#define HOST_DRIVER_PCNT_H
+
+#include <stdint.h>
+
+#define ESP_OK            0
+
+typedef int esp_err_t;
+
+typedef enum
+{
+  PCNT_UNIT_0 = 0,
+} pcnt_unit_t;
+
+typedef enum
+{
+  PCNT_CHANNEL_0 = 0,
+  PCNT_CHANNEL_1 = 1,
+} pcnt_channel_t;
+
+typedef enum
+{
+  PCNT_COUNT_DIS = 0,
+  PCNT_COUNT_INC,
+  PCNT_COUNT_DEC,
+} pcnt_count_mode_t;
+
+typedef enum
+{
+  PCNT_MODE_KEEP = 0,
+  PCNT_MODE_REVERSE,
+  PCNT_MODE_DISABLE,
+} pcnt_ctrl_mode_t;
+
+typedef struct
+{
+  int pulse_gpio_num;
+  int ctrl_gpio_num;
+  pcnt_ctrl_mode_t lctrl_mode;
+  pcnt_ctrl_mode_t hctrl_mode;
+  pcnt_count_mode_t pos_mode;
+  pcnt_count_mode_t neg_mode;
+  int16_t counter_h_lim;
+  int16_t counter_l_lim;
+  pcnt_unit_t unit;
+  pcnt_channel_t channel;
+} pcnt_config_t;
+
+// Counter value of the single host unit (tests may also add transitions directly)
+inline int16_t HostPcntCounter = 0;
+
+esp_err_t pcnt_unit_config(const pcnt_config_t* config);
+esp_err_t pcnt_set_filter_value(pcnt_unit_t unit, uint16_t filter);
+esp_err_t pcnt_filter_enable(pcnt_unit_t unit);
+esp_err_t pcnt_counter_pause(pcnt_unit_t unit);
+esp_err_t pcnt_counter_clear(pcnt_unit_t unit);
+esp_err_t pcnt_counter_resume(pcnt_unit_t unit);
+esp_err_t pcnt_get_counter_value(pcnt_unit_t unit, int16_t* count);
+
+#endif
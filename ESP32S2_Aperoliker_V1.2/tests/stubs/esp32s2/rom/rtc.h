@@ -0,0 +1,14 @@
+/**
+ * Includes the host stand-in of the reset reason functions (tests only)
+ *
+ * @author    Florian Staeblein
+ * @date      2024/01/28
+ * @copyright © 2024 Florian Staeblein
+ */
+
+#ifndef HOST_RTC_H
+#define HOST_RTC_H
+
+#include <stdint.h>
+
+#endif
@@ -0,0 +1,41 @@
+/**
+ * Includes the host stand-in of the light sleep functions (tests only)
+ *
+ * @author    Florian Staeblein
+ * @date      2024/01/28
+ * @copyright © 2024 Florian Staeblein
+ */
+
+#ifndef HOST_ESP_SLEEP_H
+#define HOST_ESP_SLEEP_H
+
+#include <Arduino.h>
+
+typedef int esp_err_t;
+
+typedef enum
+{
+  ESP_SLEEP_WAKEUP_UNDEFINED = 0,
+  ESP_SLEEP_WAKEUP_GPIO = 7,
+} esp_sleep_wakeup_cause_t;
+
+// Count of light sleeps (the host returns immediately)
+inline uint32_t HostLightSleepCount = 0;
+
+inline esp_err_t esp_sleep_enable_gpio_wakeup()
+{
+  return 0;
+}
+
+inline esp_err_t esp_light_sleep_start()
+{
+  HostLightSleepCount++;
+  return 0;
+}
+
+inline esp_sleep_wakeup_cause_t esp_sleep_get_wakeup_cause()
+{
+  return ESP_SLEEP_WAKEUP_GPIO;
+}
+
+#endif
@@ -0,0 +1,115 @@
+/**
+ * Includes the host stand-in of FreeRTOS (tests only). Mutexes
+ * and critical sections are real locks, so tests can run
+ * producers in threads.
+ *
+ * @author    Florian Staeblein
+ * @date      2024/01/28
+ * @copyright © 2024 Florian Staeblein
+ */
+
+#ifndef HOST_FREERTOS_H
+#define HOST_FREERTOS_H
+
+//===============================================================
+// Includes
+//===============================================================
+#include <stdint.h>
+#include <mutex>
+
+
+//===============================================================
+// Types and defines
+//===============================================================
+typedef void* TaskHandle_t;
+typedef std::recursive_mutex* SemaphoreHandle_t;
+typedef uint32_t* EventGroupHandle_t;
+typedef uint32_t TickType_t;
+typedef uint32_t EventBits_t;
+typedef int BaseType_t;
+typedef unsigned UBaseType_t;
+typedef void (*TaskFunction_t)(void*);
+
+// Critical section (one lock per mux, recursive like on the ESP32)
+struct portMUX_TYPE
+{
+  std::recursive_mutex Lock;
+  portMUX_TYPE() {}
+  portMUX_TYPE(int) {}
+};
+
+#define portMUX_INITIALIZER_UNLOCKED      0
+#define portENTER_CRITICAL(mux)           (mux)->Lock.lock()
+#define portEXIT_CRITICAL(mux)            (mux)->Lock.unlock()
+#define portENTER_CRITICAL_ISR(mux)       (mux)->Lock.lock()
+#define portEXIT_CRITICAL_ISR(mux)        (mux)->Lock.unlock()
+#define pdMS_TO_TICKS(time_ms)            (time_ms)
+#define portTICK_PERIOD_MS                1
+#define portMAX_DELAY                     0xFFFFFFFF
+#define pdTRUE                            1
+#define pdFALSE                           0
+#define pdPASS                            1
+#define tskNO_AFFINITY                    0x7FFFFFFF
+
+
+//===============================================================
+// Mutexes
+//===============================================================
+inline SemaphoreHandle_t xSemaphoreCreateMutex()
+{
+  return new std::recursive_mutex();
+}
+
+inline BaseType_t xSemaphoreTake(SemaphoreHandle_t mutex, TickType_t)
+{
+  mutex->lock();
+  return pdTRUE;
+}
+
+inline BaseType_t xSemaphoreGive(SemaphoreHandle_t mutex)
+{
+  mutex->unlock();
+  return pdTRUE;
+}
+
+
+//===============================================================
+// Event groups (no waiting, the host tests are single threaded)
+//===============================================================
+inline EventGroupHandle_t xEventGroupCreate()
+{
+  return new uint32_t(0);
+}
+
+inline EventBits_t xEventGroupSetBits(EventGroupHandle_t group, EventBits_t bits)
+{
+  return *group |= bits;
+}
+
+inline EventBits_t xEventGroupClearBits(EventGroupHandle_t group, EventBits_t bits)
+{
+  EventBits_t lastBits = *group;
+  *group &= ~bits;
+  return lastBits;
+}
+
+inline EventBits_t xEventGroupGetBits(EventGroupHandle_t group)
+{
+  return *group;
+}
+
+inline EventBits_t xEventGroupWaitBits(EventGroupHandle_t group, EventBits_t, BaseType_t, BaseType_t, TickType_t)
+{
+  return *group;
+}
+
+
+//===============================================================
+// Tasks (not available in the host tests)
+//===============================================================
+inline void vTaskDelay(TickType_t)
+{
+}
+
+
+#endif
@@ -1,332 +0,0 @@
-/**
- * Includes all display functions
- *
- * @author    Florian Staeblein
- * @date      2024/01/28
- * @copyright © 2024 Florian Staeblein
- */
- 
-#ifndef DISPLAYDRIVER_H
-#define DISPLAYDRIVER_H
-
-//===============================================================
-// Includes
-//===============================================================
-#include <Arduino.h>
-#include <SPI.h>
-#include <WiFi.h>
-#include <SPIFFS.h>
-#include <Adafruit_GFX.h>
-#include <Adafruit_ST7789.h>
-#include <Fonts/FreeSans9pt7b.h>
-#include "Config.h"
-#include "StateMachine.h"
-#include "SPIFFSImageReader.h"
-#include "FlowMeterDriver.h"
-
-
-//===============================================================
-// Defines
-//===============================================================
-#define TFT_DEG2RAD                 0.017453292519943295769236907684886F
-#define TFT_WIDTH                   240
-#define TFT_HEIGHT                  240
-
-#define HEADEROFFSET_Y              30
-#define HEADER_MARGIN               10
-
-#define INFOBOX_MARGIN_VERT         60
-#define INFOBOX_MARGIN_HORI         25
-#define INFOBOX_CORNERRADIUS        8
-
-#define MENU_MARGIN_HORI            18
-#define MENU_MARGIN_ICON            8
-#define MENU_MARGIN_TEXT            47
-#define MENU_SELECTOR_HEIGHT        38
-#define MENU_SELECTOR_CORNERRADIUS  8
-#define MENU_LINEOFFSET             43
-
-#define SHORTLINEOFFSET             20
-#define LONGLINEOFFSET              30
-#define LOONGLINEOFFSET             50
-
-#define SCREENSAVER_STARCOUNT       30
-
-
-//===============================================================
-// Icons
-//===============================================================
-// 'cleaning', 32x32px
-const unsigned char icon_cleaning [] PROGMEM =
-{
-	0x00, 0x04, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x88, 0x24, 0xc2, 0x01, 
-	0x90, 0x35, 0xc0, 0x21, 0x20, 0x84, 0xc0, 0x71, 0x40, 0x44, 0x00, 0x20, 0x88, 0x20, 0x03, 0x00, 
-	0x10, 0x04, 0x01, 0x00, 0x00, 0x0e, 0x00, 0x00, 0x7f, 0xdb, 0x1f, 0x03, 0x00, 0x0e, 0x00, 0x61, 
-	0x00, 0x0a, 0x01, 0xf0, 0x98, 0x20, 0x03, 0x60, 0x40, 0x44, 0x00, 0x20, 0x20, 0x84, 0x00, 0x00, 
-	0x10, 0x35, 0x11, 0x04, 0x88, 0x24, 0xa2, 0x04, 0x00, 0x04, 0xa0, 0x06, 0x00, 0x04, 0x68, 0x1a, 
-	0x00, 0x04, 0x51, 0xca, 0x18, 0x00, 0x0e, 0x70, 0x7c, 0x00, 0x98, 0x08, 0x38, 0x10, 0xc6, 0x73, 
-	0x38, 0x38, 0xc0, 0x01, 0x00, 0x10, 0x9c, 0x19, 0x00, 0x00, 0x05, 0xe0, 0x80, 0x01, 0x58, 0x0a, 
-	0xc0, 0x03, 0x28, 0x12, 0x80, 0x01, 0xa0, 0x04, 0x00, 0x00, 0x30, 0x04, 0x00, 0x00, 0x10, 0x04
-};
-// 'dashboard', 32x32px
-const unsigned char icon_dashboard [] PROGMEM =
-{
-	0x00, 0xf0, 0x0f, 0x00, 0x00, 0x1e, 0x78, 0x00, 0x80, 0xe3, 0xcf, 0x01, 0xc0, 0x3c, 0x3c, 0x03, 
-	0x60, 0xe7, 0xe7, 0x06, 0xb0, 0xf9, 0x9f, 0x0d, 0xd8, 0x8e, 0x71, 0x1b, 0x6c, 0x0f, 0xf0, 0x36, 
-	0xb4, 0x09, 0x90, 0x2d, 0xd6, 0x00, 0x00, 0x6b, 0xda, 0x00, 0x10, 0x5b, 0xea, 0x01, 0x88, 0x57, 
-	0x2b, 0x00, 0x0c, 0xd4, 0x3d, 0x00, 0x06, 0xbc, 0x35, 0x80, 0x03, 0xac, 0x75, 0xc0, 0x03, 0xae, 
-	0x65, 0xc0, 0x03, 0xa6, 0x05, 0x80, 0x01, 0xa0, 0x0d, 0x00, 0x00, 0xb0, 0xfb, 0xff, 0xff, 0xdf, 
-	0x02, 0x00, 0x00, 0x40, 0x02, 0xfe, 0x7f, 0x40, 0x06, 0x03, 0xc0, 0x60, 0x84, 0xf1, 0x8f, 0x21, 
-	0x8c, 0xf1, 0x8f, 0x31, 0x18, 0x03, 0xc0, 0x18, 0x30, 0xfe, 0x7f, 0x0c, 0x60, 0x00, 0x00, 0x06, 
-	0xc0, 0x00, 0x00, 0x03, 0x80, 0x03, 0xc0, 0x01, 0x00, 0x1e, 0x78, 0x00, 0x00, 0xf0, 0x0f, 0x00
-};
-// 'eraser', 32x32px
-const unsigned char icon_eraser [] PROGMEM =
-{
-	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x3c, 0x00, 0x00, 0x00, 0x7e, 0x00, 0x00, 0x00, 0xe3, 0x00, 
-	0x00, 0x80, 0xc1, 0x01, 0x00, 0xc0, 0x80, 0x03, 0x00, 0x60, 0x00, 0x07, 0x00, 0x30, 0x00, 0x0e, 
-	0x00, 0x18, 0x00, 0x1c, 0x00, 0x0c, 0x00, 0x38, 0x00, 0x06, 0x00, 0x70, 0x00, 0x03, 0x00, 0x60, 
-	0x80, 0x01, 0x00, 0x40, 0xc0, 0x00, 0x00, 0x60, 0xe0, 0x00, 0x00, 0x30, 0xf0, 0x01, 0x00, 0x18, 
-	0x98, 0x03, 0x00, 0x0c, 0x0c, 0x07, 0x00, 0x06, 0x06, 0x0e, 0x00, 0x03, 0x06, 0x1c, 0x80, 0x01, 
-	0x06, 0x38, 0xc0, 0x00, 0x02, 0x70, 0x60, 0x00, 0x06, 0xe0, 0x30, 0x00, 0x06, 0xc0, 0x19, 0x00, 
-	0x06, 0x80, 0x0f, 0x00, 0x0c, 0x00, 0x07, 0x00, 0x18, 0x00, 0x03, 0x00, 0x30, 0x80, 0x01, 0x00, 
-	0x60, 0xc0, 0x00, 0x00, 0xc0, 0xfb, 0x00, 0x00, 0x80, 0xff, 0xff, 0x7f, 0x00, 0x00, 0x00, 0x00
-};
-// 'cocktails', 32x32px
-const unsigned char icon_cocktails [] PROGMEM = {
-	0x00, 0x00, 0x00, 0x03, 0x00, 0x00, 0xc0, 0x02, 0x00, 0x00, 0xa0, 0x01, 0x00, 0x3e, 0xd0, 0x00, 
-	0x00, 0x7f, 0x50, 0x00, 0x80, 0xb7, 0x30, 0x00, 0xc0, 0x55, 0x21, 0x00, 0xc0, 0xff, 0x39, 0x00, 
-	0xc0, 0xfc, 0xff, 0x01, 0xc0, 0x0f, 0x1a, 0x01, 0xc0, 0xed, 0x7f, 0x01, 0x80, 0xaf, 0x43, 0x01, 
-	0x00, 0xaf, 0x42, 0x01, 0x00, 0xae, 0x44, 0x01, 0x00, 0xb8, 0xc3, 0x00, 0x00, 0x30, 0xc0, 0x00, 
-	0x00, 0x70, 0xe0, 0x00, 0x00, 0x50, 0xa0, 0x00, 0x00, 0x50, 0xa0, 0x00, 0x00, 0x50, 0xa0, 0x00, 
-	0x00, 0x50, 0xe0, 0x00, 0x00, 0x70, 0xe0, 0x00, 0x00, 0x60, 0x60, 0x00, 0x00, 0x60, 0x60, 0x00, 
-	0x00, 0x60, 0x60, 0x00, 0x00, 0xe0, 0x70, 0x00, 0x00, 0xa0, 0x5f, 0x00, 0x00, 0xa0, 0x5f, 0x00, 
-	0x00, 0xa0, 0x50, 0x00, 0x00, 0xa0, 0x5f, 0x00, 0x00, 0x20, 0x40, 0x00, 0x00, 0xc0, 0x3f, 0x00
-};
-// 'settings', 32x32px
-const unsigned char icon_settings [] PROGMEM =
-{
-	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x30, 0x80, 0x01, 0x0c, 0x30, 0x80, 0x01, 0x0c, 
-	0x30, 0x80, 0x01, 0x0c, 0x30, 0xe0, 0x07, 0x0c, 0x30, 0xe0, 0x07, 0x0c, 0x30, 0x60, 0x06, 0x0c, 
-	0x30, 0xe0, 0x07, 0x0c, 0x30, 0xe0, 0x07, 0x0c, 0xfc, 0x80, 0x01, 0x3f, 0xfc, 0x80, 0x01, 0x3f, 
-	0xcc, 0x80, 0x01, 0x33, 0xfc, 0x80, 0x01, 0x3f, 0xfc, 0xbc, 0x3d, 0x3f, 0x30, 0xbe, 0x7d, 0x0c, 
-	0x30, 0x36, 0x6c, 0x0c, 0x30, 0xce, 0x73, 0x0c, 0x30, 0xee, 0x77, 0x0c, 0xb0, 0x77, 0xee, 0x0d, 
-	0xb0, 0x33, 0xcc, 0x0d, 0xb0, 0x33, 0xcc, 0x0d, 0xb0, 0x77, 0xee, 0x0d, 0x30, 0xee, 0x77, 0x0c, 
-	0x30, 0xce, 0x73, 0x0c, 0x30, 0x36, 0x6c, 0x0c, 0x30, 0x7e, 0x7e, 0x0c, 0x30, 0xfc, 0x3f, 0x0c, 
-	0x30, 0xc0, 0x03, 0x0c, 0x30, 0xc0, 0x03, 0x0c, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
-};
-
-// 'noWifi', 24x24px
-const unsigned char icon_noWifi [] PROGMEM =
-{
-	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x30, 0x00, 0x00, 0x70, 0xfe, 0x00, 0xe0, 
-	0xff, 0x03, 0xd0, 0x81, 0x0f, 0x98, 0x03, 0x1c, 0x1c, 0x1f, 0x38, 0x00, 0xfe, 0x01, 0xc0, 0xfc, 
-	0x03, 0xe0, 0x18, 0x07, 0x70, 0x30, 0x0c, 0x00, 0x76, 0x00, 0x00, 0xe7, 0x00, 0x80, 0xc3, 0x01, 
-	0x00, 0x80, 0x03, 0x00, 0x00, 0x07, 0x00, 0x18, 0x0e, 0x00, 0x18, 0x0c, 0x00, 0x00, 0x00, 0x00, 
-	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
-};
-// 'wifi', 24x24px
-const unsigned char icon_wifi [] PROGMEM =
-{
-	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xff, 0x00, 0xc0, 
-	0xff, 0x03, 0xf0, 0x01, 0x0f, 0x38, 0x00, 0x1c, 0x1c, 0x00, 0x38, 0x00, 0x7e, 0x00, 0x80, 0xff, 
-	0x01, 0xc0, 0xc3, 0x03, 0xe0, 0x00, 0x07, 0x00, 0x00, 0x00, 0x00, 0x3c, 0x00, 0x00, 0xff, 0x00, 
-	0x00, 0xc3, 0x00, 0x00, 0x00, 0x00, 0x00, 0x18, 0x00, 0x00, 0x18, 0x00, 0x00, 0x00, 0x00, 0x00, 
-	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
-};
-// 'device', 24x24px
-const unsigned char icon_device [] PROGMEM =
-{
-	0x00, 0x00, 0x00, 0xc0, 0xff, 0x03, 0x20, 0x18, 0x04, 0xa0, 0xff, 0x05, 0x60, 0x00, 0x06, 0x60, 
-	0x00, 0x06, 0x60, 0x00, 0x06, 0x60, 0x00, 0x06, 0x60, 0x00, 0x06, 0x60, 0x00, 0x06, 0x60, 0x00, 
-	0x06, 0x60, 0x00, 0x06, 0x60, 0x00, 0x06, 0x60, 0x00, 0x06, 0x60, 0x00, 0x06, 0x60, 0x00, 0x06, 
-	0x60, 0x00, 0x06, 0x60, 0x00, 0x06, 0x60, 0x00, 0x06, 0xe0, 0xff, 0x07, 0x20, 0x00, 0x04, 0x20, 
-	0x00, 0x04, 0xc0, 0xff, 0x03, 0x00, 0x00, 0x00
-};
-
-// 'copyright', 20x20px
-const unsigned char icon_copyright [] PROGMEM = {
-	0x80, 0x1f, 0x00, 0xe0, 0x7f, 0x00, 0x70, 0xe0, 0x00, 0x18, 0x80, 0x01, 0x0c, 0x00, 0x03, 0x06, 
-	0x06, 0x06, 0x86, 0x1f, 0x06, 0xc3, 0x19, 0x0c, 0xc3, 0x00, 0x0c, 0x63, 0x00, 0x0c, 0x63, 0x00, 
-	0x0c, 0xc3, 0x00, 0x0c, 0xc3, 0x19, 0x0c, 0x86, 0x1f, 0x06, 0x06, 0x06, 0x06, 0x0c, 0x00, 0x03, 
-	0x18, 0x80, 0x01, 0x70, 0xe0, 0x00, 0xe0, 0x7f, 0x00, 0x80, 0x1f, 0x00
-};
-
-//===============================================================
-// Class for screen saver stars
-//===============================================================
-class Star
-{
-  public:
-    int16_t X = 0;
-    int16_t Y = 0;
-    int16_t Size = 5;
-    int16_t MaxSize = 0;
-    bool FullStars = false;
-};
-
-//===============================================================
-// Class for handling display functions
-//===============================================================
-class DisplayDriver
-{
-  public:
-    // Constructor
-    DisplayDriver();
-
-    // Initializes the display driver
-    void Begin(Adafruit_ST7789* tft, bool spiffsAvailable);
-
-    // Sets the menu state
-    void SetMenuState(MixerState state);
-
-    // Sets the dashboard liquid value
-    void SetDashboardLiquid(MixtureLiquid liquid);
-
-    // Sets the cleaning liquid value
-    void SetCleaningLiquid(MixtureLiquid liquid);
-    
-    // Sets the percentage values
-    void SetPercentages(int16_t liquid1_Percentage, int16_t liquid2_Percentage, int16_t liquid3_Percentage);
-
-    // Sets the bar stock
-    void SetBar(BarBottle barBottle1, BarBottle barBottle2, BarBottle barBottle3);
-
-    // Shows intro page
-    void ShowIntroPage();
-    
-    // Shows help page
-    void ShowHelpPage();
-
-    // Shows menu page
-    void ShowMenuPage();
-
-    // Shows dashboard page
-    void ShowDashboardPage();
-    
-    // Shows cleaning page
-    void ShowCleaningPage();
-
-    // Shows bar page
-    void ShowBarPage();
-
-    // Shows settings page
-    void ShowSettingsPage();
-    
-    // Shows screen saver page
-    void ShowScreenSaverPage();
-
-    // Draws the Wifi icon
-    void DrawWifiIcons(bool isfullUpdate = false);
-    
-    // Draws the info box
-    void DrawInfoBox(const String &line1, const String &line2);
-
-    // Draws the menu partially
-    void DrawMenu(bool isfullUpdate = false);
-
-    // Draw bar
-    void DrawBar(bool isDashboard, bool isfullUpdate = false);
-
-    // Draw checkboxes
-    void DrawCheckBoxes(MixtureLiquid liquid);
-
-    // Draws settings partially
-    void DrawSettings(bool isfullUpdate = false);
-    
-    // Draws screen saver
-    void DrawScreenSaver();
-
-  private:
-    // Display variable
-    Adafruit_ST7789* _tft;
-    char _output[30];
-
-    // Image pointer
-    SPIFFSImage* _imageBottle;
-    SPIFFSImage* _imageGlass;
-    SPIFFSImage* _imageLogo;
-    SPIFFSImage* _imageBottleWhiteWine;
-    SPIFFSImage* _imageBottleRoseWine;
-    SPIFFSImage* _imageBottleSparklingWater;
-
-    SPIFFSImageReader reader;
-    ImageReturnCode _imagesAvailable = IMAGE_ERR_FILE_NOT_FOUND;
-
-    // Current mixture settings
-    MixerState _menuState = eDashboard;
-    MixtureLiquid _dashboardLiquid = eLiquid1;
-    int16_t _liquid1_Percentage = 50; // 0% to 95% for wine spritzer
-    int16_t _liquid2_Percentage = 50; // 0% to 95% for wine spritzer
-    int16_t _liquid3_Percentage = 50; // 0% to 95% for wine spritzer
-    
-    // Cleaning mode settings
-    MixtureLiquid _cleaningLiquid = eLiquidAll;
-    
-    // Bar settings
-    BarBottle _barBottle1 = eRedWine;
-    BarBottle _barBottle2 = eWhiteWine;
-    BarBottle _barBottle3 = eRoseWine;
-        
-    // Last draw values
-    MixerState _lastDraw_MenuState = eDashboard;
-    MixtureLiquid _lastDraw_SelectedLiquid = eLiquidNone;
-    BarBottle _lastDraw_barBottle1 = eEmpty;
-    BarBottle _lastDraw_barBottle2 = eEmpty;
-    BarBottle _lastDraw_barBottle3 = eEmpty;
-    int16_t _lastDraw_liquid1_Percentage = 0;
-    int16_t _lastDraw_liquid2_Percentage = 0;
-    int16_t _lastDraw_liquid3_Percentage = 0;
-    uint32_t _lastDraw_cycleTimespan_ms = 0;
-    wifi_mode_t _lastDraw_wifiMode = WIFI_MODE_NULL;
-    uint16_t _lastDraw_ConnectedClients = 0;
-    
-    // Screen saver variables
-    Star _stars[SCREENSAVER_STARCOUNT];
-    int16_t _lastLogo_x = 10;
-    int16_t _lastLogo_y = TFT_HEIGHT / 2;
-    int16_t _xDir = 1;
-    int16_t _yDir = 1;
-
-    // Draws default header Text
-    void DrawHeader();
-    
-    // Draws header Text
-    void DrawHeader(const String &text, bool withIcons = true);
-
-    // Draws a star
-    void DrawStar(int16_t x0, int16_t y0, bool fullStars, uint16_t color, int16_t size = 0);
-
-    // Draws a star tail
-    void DrawStarTail(int16_t x0, int16_t y0, int16_t start, int16_t end, bool fullStars, uint16_t color);
-    
-    // Draws a part of the bar
-    void DrawBarPart(int16_t x0, int16_t y, MixtureLiquid liquid, BarBottle barBottle, BarBottle lastDraw_barBottle, int16_t liquid_Percentage, int16_t lastDraw_liquid_Percentage, String name, uint16_t color, bool isDashboard, bool isfullUpdate);
-    
-    // Clears the difference from a bar bottle to the next bottle
-    void ClearBarBottle(BarBottle lastDraw_barBottle, BarBottle barBottle, int16_t x0, int16_t y, uint16_t clearColor);
-
-    // Draws a bar bottle
-    void DrawBarBottle(BarBottle barBottle, int16_t x0, int16_t y);
-
-    // Draws a selection around a bar bottle
-    void SelectBarBottle(BarBottle barBottle, int16_t x0, int16_t y, uint16_t color);
-
-    // Returns a pointer to the requested bar bottle image
-    SPIFFSImage* GetBarBottlePointer(BarBottle barBottle);
-    
-    // Draws a string centered
-    void DrawCenteredString(const String &text, int16_t x, int16_t y, bool underlined = false, bool backGround = false, uint16_t lineColor = 0, uint16_t backGroundColor = 0);
-    
-    // Formats double value
-    String FormatValue(double value, int mainPlaces, int decimalPlaces);
-};
-
-
-//===============================================================
-// Global variables
-//===============================================================
-extern DisplayDriver Display;
-
-
-#endif